@@ -0,0 +1,85 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Headless benchmark runner for the host: runs the scripted scenes of source/benchmark.cpp with a
+// null renderer and writes the CSV report.
+
+#include "benchmark.h"
+
+#include "3ds/jobs.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+/// \brief Screen size the scenes are laid out for (both 3DS screens stacked)
+constexpr auto DISPLAY_SIZE = ImVec2 (400.0f, 480.0f);
+
+/// \brief Null renderer: walks the commands like a backend would, without drawing anything
+/// \param drawData_ Draw data for the frame
+void render (ImDrawData *const drawData_)
+{
+	for (auto const &cmdList : drawData_->CmdLists)
+	{
+		for (auto const &cmd : cmdList->CmdBuffer)
+		{
+			if (cmd.UserCallback && cmd.UserCallback != ImDrawCallback_ResetRenderState)
+				cmd.UserCallback (cmdList, &cmd);
+		}
+	}
+}
+}
+
+int main (int argc_, char *argv_[])
+{
+	// bench [output.csv [frames]]
+	auto const path   = argc_ > 1 ? argv_[1] : "/dev/stdout";
+	auto const frames = argc_ > 2 ? std::strtoul (argv_[2], nullptr, 0) : 300ul;
+
+	IMGUI_CHECKVERSION ();
+	ImGui::CreateContext ();
+
+	auto &io       = ImGui::GetIO ();
+	io.DisplaySize = DISPLAY_SIZE;
+	io.IniFilename = nullptr;
+
+	// the atlas only has to be built; nothing samples it
+	unsigned char *pixels;
+	int width;
+	int height;
+	io.Fonts->GetTexDataAsAlpha8 (&pixels, &width, &height);
+	io.Fonts->SetTexID (reinterpret_cast<ImTextureID> (io.Fonts));
+
+	if (!jobs::init ())
+		std::fprintf (stderr, "Failed to start job workers\n");
+
+	auto const ok = benchmark::run (path, frames, &render);
+	if (!ok)
+		std::fprintf (stderr, "Failed to write %s\n", path);
+
+	jobs::exit ();
+	ImGui::DestroyContext ();
+
+	return ok ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -0,0 +1,87 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+
+// Host throughput of LogBuffer: 1, 2 and 4 producers appending formatted lines while a reader
+// follows the newest ones, as the log view does.
+
+#include "3ds/imgui_log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <thread>
+#include <vector>
+
+int main (int argc_, char *argv_[])
+{
+	// log [lines per producer]
+	auto const lines = argc_ > 1 ? std::strtoul (argv_[1], nullptr, 0) : 1000000ul;
+
+	std::printf ("producers,lines,append_ns_per_line,lines_per_sec,lines_read\n");
+	for (unsigned const producers : {1u, 2u, 4u})
+	{
+		imgui::LogBuffer log;
+		std::atomic<unsigned> running = producers;
+
+		auto const start = std::chrono::steady_clock::now ();
+
+		std::vector<std::thread> threads;
+		for (unsigned p = 0; p < producers; ++p)
+		{
+			threads.emplace_back ([&log, &running, lines, p] {
+				for (unsigned long i = 0; i < lines; ++i)
+					log.appendf ("producer %u line %lu: lorem ipsum dolor sit amet", p, i);
+				--running;
+			});
+		}
+
+		// the reader copies every line it gets to before it is overwritten
+		std::uint64_t read      = 0;
+		std::uint64_t linesRead = 0;
+		char out[imgui::LogBuffer::LINE_SIZE];
+		while (running)
+		{
+			auto const end = log.end ();
+			for (auto index = std::max (read, log.begin ()); index < end; ++index)
+				linesRead += log.read (index, out) >= 0;
+			read = end;
+		}
+
+		for (auto &thread : threads)
+			thread.join ();
+
+		auto const seconds =
+		    std::chrono::duration<double> (std::chrono::steady_clock::now () - start).count ();
+		auto const total = double (producers) * lines;
+		std::printf ("%u,%.0f,%.1f,%.0f,%llu\n",
+		    producers,
+		    total,
+		    seconds * 1e9 / total,
+		    total / seconds,
+		    static_cast<unsigned long long> (linesRead));
+	}
+}
@@ -0,0 +1,157 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+
+// Host timing of the citro3d backend's prepare phase (the per-list vertex and index work done
+// in parallel before any draw is issued) at 1, 2 and 4 threads, and of the command walk that
+// issues the packed draws to each target afterwards, in mono and stereo, against the citro3d stub.
+
+#include "3ds/imgui_citro3d.h"
+#include "3ds/jobs.h"
+
+#include "stub.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+
+namespace
+{
+/// \brief Top screen render target
+C3D_RenderTarget s_top{GFX_TOP, GFX_LEFT};
+/// \brief Bottom screen render target
+C3D_RenderTarget s_bottom{GFX_BOTTOM, GFX_LEFT};
+/// \brief Top screen right eye render target
+C3D_RenderTarget s_right{GFX_TOP, GFX_RIGHT};
+
+/// \brief Windows per frame; each is its own draw list
+constexpr int WINDOWS = 16;
+/// \brief Text lines per window
+constexpr int LINES = 24;
+
+/// \brief Frames rendered before timing starts
+constexpr unsigned WARMUP = 10;
+
+/// \brief Submit the frame's windows
+void build ()
+{
+	for (int i = 0; i < WINDOWS; ++i)
+	{
+		char name[16];
+		std::snprintf (name, sizeof (name), "Window %d", i);
+
+		// overlapping full-screen windows, so none of the text is clipped away
+		ImGui::SetNextWindowPos (ImVec2 (i * 4.0f, i * 4.0f));
+		ImGui::SetNextWindowSize (ImVec2 (340.0f, 400.0f));
+		ImGui::Begin (name);
+		for (int line = 0; line < LINES; ++line)
+			ImGui::Text ("Line %d: lorem ipsum", line);
+		ImGui::End ();
+	}
+}
+}
+
+int main (int argc_, char *argv_[])
+{
+	// prepare [frames]
+	auto const frames = argc_ > 1 ? std::strtoul (argv_[1], nullptr, 0) : 300ul;
+
+	C3D_Init (C3D_DEFAULT_CMDBUF_SIZE);
+
+	IMGUI_CHECKVERSION ();
+	ImGui::CreateContext ();
+
+	auto &io       = ImGui::GetIO ();
+	io.DisplaySize = ImVec2 (400.0f, 480.0f);
+	io.IniFilename = nullptr;
+
+	imgui::citro3d::init ();
+
+	std::printf ("threads,stereo,lists,vertices,prepare_avg_ms,prepare_min_ms,walk_avg_ms,"
+	             "walk_min_ms\n");
+	for (unsigned const threads : {1u, 2u, 4u})
+	{
+		// the thread that waits on the group runs jobs too
+		jobs::exit ();
+		if (threads > 1 && !jobs::init (threads - 1))
+		{
+			std::fprintf (stderr, "Failed to start job workers\n");
+			return EXIT_FAILURE;
+		}
+
+		for (bool const stereo : {false, true})
+		{
+			imgui::citro3d::setStereo (stereo ? &s_right : nullptr, 8.0f);
+
+			auto prepareTotal = 0.0f;
+			auto prepareBest  = 0.0f;
+			auto walkTotal    = 0.0f;
+			auto walkBest     = 0.0f;
+			for (unsigned frame = 0; frame < WARMUP + frames; ++frame)
+			{
+				io.DeltaTime = 1.0f / 60.0f;
+
+				C3D_FrameBegin (0);
+				ImGui::NewFrame ();
+				build ();
+				ImGui::Render ();
+				imgui::citro3d::render (&s_top, &s_bottom);
+				C3D_FrameEnd (0);
+
+				if (frame < WARMUP)
+					continue;
+
+				auto const &stats = imgui::citro3d::stats ();
+				prepareTotal += stats.prepareTime;
+				walkTotal += stats.walkTime;
+				if (frame == WARMUP)
+				{
+					prepareBest = stats.prepareTime;
+					walkBest    = stats.walkTime;
+				}
+				else
+				{
+					prepareBest = std::min (prepareBest, stats.prepareTime);
+					walkBest    = std::min (walkBest, stats.walkTime);
+				}
+			}
+
+			auto const drawData = ImGui::GetDrawData ();
+			std::printf ("%u,%d,%d,%d,%.4f,%.4f,%.4f,%.4f\n",
+			    threads,
+			    stereo,
+			    drawData->CmdListsCount,
+			    drawData->TotalVtxCount,
+			    prepareTotal / frames,
+			    prepareBest,
+			    walkTotal / frames,
+			    walkBest);
+		}
+	}
+
+	jobs::exit ();
+	imgui::citro3d::exit ();
+	ImGui::DestroyContext ();
+	C3D_Fini ();
+}
@@ -0,0 +1,226 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "raster.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace
+{
+/// \brief Color with float channels
+struct Color
+{
+	float r;
+	float g;
+	float b;
+	float a;
+};
+
+/// \brief Unpack vertex color
+/// \param color_ Packed color (IM_COL32 layout)
+Color unpack (ImU32 const color_)
+{
+	return {((color_ >> IM_COL32_R_SHIFT) & 0xFF) / 255.0f,
+	    ((color_ >> IM_COL32_G_SHIFT) & 0xFF) / 255.0f,
+	    ((color_ >> IM_COL32_B_SHIFT) & 0xFF) / 255.0f,
+	    ((color_ >> IM_COL32_A_SHIFT) & 0xFF) / 255.0f};
+}
+
+/// \brief Blend a channel over the framebuffer
+/// \param src_ Source channel
+/// \param alpha_ Source alpha
+/// \param dst_ Framebuffer channel
+std::uint8_t blend (float const src_, float const alpha_, std::uint8_t const dst_)
+{
+	return static_cast<std::uint8_t> (std::lround (src_ * alpha_ * 255.0f + dst_ * (1.0f - alpha_)));
+}
+
+/// \brief Edge function: twice the signed area of (a, b, p)
+float edge (ImVec2 const &a_, ImVec2 const &b_, float const x_, float const y_)
+{
+	return (b_.x - a_.x) * (y_ - a_.y) - (b_.y - a_.y) * (x_ - a_.x);
+}
+
+/// \brief Whether an edge of a triangle with positive area is a top or left edge
+/// \param a_ Edge start
+/// \param b_ Edge end
+bool topLeft (ImVec2 const &a_, ImVec2 const &b_)
+{
+	return (a_.y == b_.y && b_.x > a_.x) || b_.y < a_.y;
+}
+
+/// \brief Whether a pixel center on an edge belongs to the triangle
+/// \param w_ Edge function value
+/// \param topLeft_ Whether the edge is a top or left edge
+bool inside (float const w_, bool const topLeft_)
+{
+	return w_ > 0.0f || (w_ == 0.0f && topLeft_);
+}
+
+/// \brief Rasterize a triangle
+/// \param image_ Output
+/// \param clip_ Clip rect in framebuffer space (x1, y1, x2, y2)
+/// \param pos_ Vertex positions in framebuffer space
+/// \param vtx_ Vertices
+/// \param texture_ Texture, or nullptr for untextured
+void triangle (raster::Image &image_,
+    ImVec4 const &clip_,
+    ImVec2 pos_[3],
+    ImDrawVert const *vtx_[3],
+    raster::Texture const *const texture_)
+{
+	auto area = edge (pos_[0], pos_[1], pos_[2].x, pos_[2].y);
+	if (area == 0.0f)
+		return;
+
+	// ImGui emits both windings; make every triangle positive
+	if (area < 0.0f)
+	{
+		std::swap (pos_[1], pos_[2]);
+		std::swap (vtx_[1], vtx_[2]);
+		area = -area;
+	}
+
+	// pixels whose centers may be covered, within the clip rect and the image
+	auto const minX = std::max ({std::min ({pos_[0].x, pos_[1].x, pos_[2].x}), clip_.x, 0.0f});
+	auto const minY = std::max ({std::min ({pos_[0].y, pos_[1].y, pos_[2].y}), clip_.y, 0.0f});
+	auto const maxX = std::min ({std::max ({pos_[0].x, pos_[1].x, pos_[2].x}),
+	    clip_.z,
+	    static_cast<float> (image_.width)});
+	auto const maxY = std::min ({std::max ({pos_[0].y, pos_[1].y, pos_[2].y}),
+	    clip_.w,
+	    static_cast<float> (image_.height)});
+
+	auto const left   = static_cast<int> (std::floor (minX));
+	auto const top    = static_cast<int> (std::floor (minY));
+	auto const right  = static_cast<int> (std::ceil (maxX));
+	auto const bottom = static_cast<int> (std::ceil (maxY));
+
+	bool const topLeft0 = topLeft (pos_[1], pos_[2]);
+	bool const topLeft1 = topLeft (pos_[2], pos_[0]);
+	bool const topLeft2 = topLeft (pos_[0], pos_[1]);
+
+	Color const color[] = {unpack (vtx_[0]->col), unpack (vtx_[1]->col), unpack (vtx_[2]->col)};
+
+	for (int y = top; y < bottom; ++y)
+	{
+		auto const py = y + 0.5f;
+		if (py < clip_.y || py >= clip_.w)
+			continue;
+
+		for (int x = left; x < right; ++x)
+		{
+			auto const px = x + 0.5f;
+			if (px < clip_.x || px >= clip_.z)
+				continue;
+
+			auto const w0 = edge (pos_[1], pos_[2], px, py);
+			auto const w1 = edge (pos_[2], pos_[0], px, py);
+			auto const w2 = edge (pos_[0], pos_[1], px, py);
+			if (!inside (w0, topLeft0) || !inside (w1, topLeft1) || !inside (w2, topLeft2))
+				continue;
+
+			auto const l0 = w0 / area;
+			auto const l1 = w1 / area;
+			auto const l2 = w2 / area;
+
+			Color src{l0 * color[0].r + l1 * color[1].r + l2 * color[2].r,
+			    l0 * color[0].g + l1 * color[1].g + l2 * color[2].g,
+			    l0 * color[0].b + l1 * color[1].b + l2 * color[2].b,
+			    l0 * color[0].a + l1 * color[1].a + l2 * color[2].a};
+
+			if (texture_)
+			{
+				auto const u = l0 * vtx_[0]->uv.x + l1 * vtx_[1]->uv.x + l2 * vtx_[2]->uv.x;
+				auto const v = l0 * vtx_[0]->uv.y + l1 * vtx_[1]->uv.y + l2 * vtx_[2]->uv.y;
+				auto const tx =
+				    std::clamp (static_cast<int> (u * texture_->width), 0, texture_->width - 1);
+				auto const ty =
+				    std::clamp (static_cast<int> (v * texture_->height), 0, texture_->height - 1);
+				src.a *= texture_->alpha[ty * texture_->width + tx] / 255.0f;
+			}
+
+			auto const out = &image_.rgb[(y * image_.width + x) * 3];
+			out[0]         = blend (src.r, src.a, out[0]);
+			out[1]         = blend (src.g, src.a, out[1]);
+			out[2]         = blend (src.b, src.a, out[2]);
+		}
+	}
+}
+}
+
+void raster::render (ImDrawData const &drawData_,
+    std::vector<Texture> const &textures_,
+    Image &image_,
+    ImU32 const clear_)
+{
+	auto const scale = drawData_.FramebufferScale;
+	auto const off   = drawData_.DisplayPos;
+
+	image_.width  = static_cast<unsigned> (drawData_.DisplaySize.x * scale.x);
+	image_.height = static_cast<unsigned> (drawData_.DisplaySize.y * scale.y);
+	image_.rgb.resize (image_.width * image_.height * 3);
+
+	auto const clear = unpack (clear_);
+	for (std::size_t i = 0; i < image_.rgb.size (); i += 3)
+	{
+		image_.rgb[i + 0] = blend (clear.r, 1.0f, 0);
+		image_.rgb[i + 1] = blend (clear.g, 1.0f, 0);
+		image_.rgb[i + 2] = blend (clear.b, 1.0f, 0);
+	}
+
+	for (auto const &cmdList : drawData_.CmdLists)
+	{
+		for (auto const &cmd : cmdList->CmdBuffer)
+		{
+			if (cmd.UserCallback)
+				continue;
+
+			auto const clip = ImVec4 ((cmd.ClipRect.x - off.x) * scale.x,
+			    (cmd.ClipRect.y - off.y) * scale.y,
+			    (cmd.ClipRect.z - off.x) * scale.x,
+			    (cmd.ClipRect.w - off.y) * scale.y);
+
+			auto const it = std::find_if (std::begin (textures_),
+			    std::end (textures_),
+			    [&] (Texture const &texture_) { return texture_.id == cmd.TextureId; });
+			auto const texture = it != std::end (textures_) ? &*it : nullptr;
+
+			auto const indices  = &cmdList->IdxBuffer.Data[cmd.IdxOffset];
+			auto const vertices = &cmdList->VtxBuffer.Data[cmd.VtxOffset];
+			for (unsigned i = 0; i + 2 < cmd.ElemCount; i += 3)
+			{
+				ImDrawVert const *vtx[3];
+				ImVec2 pos[3];
+				for (unsigned j = 0; j < 3; ++j)
+				{
+					vtx[j] = &vertices[indices[i + j]];
+					pos[j] = ImVec2 ((vtx[j]->pos.x - off.x) * scale.x, (vtx[j]->pos.y - off.y) * scale.y);
+				}
+
+				triangle (image_, clip, pos, vtx, texture);
+			}
+		}
+	}
+}
@@ -0,0 +1,73 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+
+// Software renderer for ImDrawData on the host: what the remote viewer shows and what host
+// screenshots are taken from.
+
+#pragma once
+
+#include "imgui/imgui.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace raster
+{
+/// \brief Alpha-only texture, like the ImGui font atlas from GetTexDataAsAlpha8
+struct Texture
+{
+	/// \brief Texture ID commands refer to it by
+	ImTextureID id;
+	/// \brief Texels, row-major
+	unsigned char const *alpha;
+	/// \brief Width
+	int width;
+	/// \brief Height
+	int height;
+};
+
+/// \brief RGB image, row-major, top row first
+struct Image
+{
+	/// \brief Width
+	unsigned width = 0;
+	/// \brief Height
+	unsigned height = 0;
+	/// \brief Pixels, 3 bytes each
+	std::vector<std::uint8_t> rgb;
+};
+
+/// \brief Render draw data
+/// \param drawData_ Draw data
+/// \param textures_ Known textures; commands using any other texture are drawn untextured
+/// \param image_ Output, sized to the framebuffer (DisplaySize * FramebufferScale)
+/// \param clear_ Color the image is cleared to
+/// \note Triangles are sampled at pixel centers with a top-left fill rule, so the two triangles
+/// of a quad don't blend their shared edge twice; textures are sampled nearest
+void render (ImDrawData const &drawData_,
+    std::vector<Texture> const &textures_,
+    Image &image_,
+    ImU32 clear_ = IM_COL32_BLACK);
+}
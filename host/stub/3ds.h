@@ -0,0 +1,262 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Host stand-in for the parts of libctru the backends use, so they can be built and tested
+// without devkitPro. Only declarations the sources need are here; see stub.h for the state the
+// tests drive them with.
+
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+typedef std::uint8_t u8;
+typedef std::uint16_t u16;
+typedef std::uint32_t u32;
+typedef std::uint64_t u64;
+typedef std::int8_t s8;
+typedef std::int16_t s16;
+typedef std::int32_t s32;
+typedef std::int64_t s64;
+typedef volatile u32 vu32;
+typedef s32 Result;
+
+#define R_FAILED(res_) ((res_) < 0)
+#define R_SUCCEEDED(res_) ((res_) >= 0)
+#define BIT(n_) (1U << (n_))
+
+#define SYSCLOCK_ARM11 268111856
+#define CPU_TICKS_PER_MSEC (SYSCLOCK_ARM11 / 1000.0)
+
+// hid
+enum
+{
+	KEY_A            = BIT (0),
+	KEY_B            = BIT (1),
+	KEY_SELECT       = BIT (2),
+	KEY_START        = BIT (3),
+	KEY_DRIGHT       = BIT (4),
+	KEY_DLEFT        = BIT (5),
+	KEY_DUP          = BIT (6),
+	KEY_DDOWN        = BIT (7),
+	KEY_R            = BIT (8),
+	KEY_L            = BIT (9),
+	KEY_X            = BIT (10),
+	KEY_Y            = BIT (11),
+	KEY_ZL           = BIT (14),
+	KEY_ZR           = BIT (15),
+	KEY_TOUCH        = BIT (20),
+	KEY_CSTICK_RIGHT = BIT (24),
+	KEY_CSTICK_LEFT  = BIT (25),
+	KEY_CSTICK_UP    = BIT (26),
+	KEY_CSTICK_DOWN  = BIT (27),
+	KEY_CPAD_RIGHT   = BIT (28),
+	KEY_CPAD_LEFT    = BIT (29),
+	KEY_CPAD_UP      = BIT (30),
+	KEY_CPAD_DOWN    = BIT (31),
+};
+
+typedef struct
+{
+	u16 px;
+	u16 py;
+} touchPosition;
+
+typedef struct
+{
+	s16 dx;
+	s16 dy;
+} circlePosition;
+
+extern vu32 *hidSharedMem;
+
+void hidScanInput (void);
+u32 hidKeysHeld (void);
+u32 hidKeysDown (void);
+u32 hidKeysUp (void);
+void hidTouchRead (touchPosition *pos);
+void hidCircleRead (circlePosition *pos);
+
+// svc
+u64 svcGetSystemTick (void);
+
+// gfx
+typedef enum
+{
+	GFX_TOP    = 0,
+	GFX_BOTTOM = 1,
+} gfxScreen_t;
+
+typedef enum
+{
+	GFX_LEFT  = 0,
+	GFX_RIGHT = 1,
+} gfx3dSide_t;
+
+float osGet3DSliderState (void);
+
+// gpu
+void GPUCMD_GetBuffer (u32 **addr, u32 *size, u32 *offset);
+
+// allocator
+void *linearAlloc (std::size_t size);
+void linearFree (void *mem);
+
+// swkbd
+typedef struct
+{
+	int type;
+} SwkbdState;
+
+typedef enum
+{
+	SWKBD_TYPE_NORMAL = 0,
+} SwkbdType;
+
+typedef enum
+{
+	SWKBD_BUTTON_LEFT   = 0,
+	SWKBD_BUTTON_MIDDLE = 1,
+	SWKBD_BUTTON_RIGHT  = 2,
+	SWKBD_BUTTON_NONE   = -1,
+} SwkbdButton;
+
+typedef enum
+{
+	SWKBD_PASSWORD_NONE       = 0,
+	SWKBD_PASSWORD_HIDE       = 1,
+	SWKBD_PASSWORD_HIDE_DELAY = 2,
+} SwkbdPasswordMode;
+
+void swkbdInit (SwkbdState *swkbd, SwkbdType type, int numButtons, int maxTextLength);
+void swkbdSetButton (SwkbdState *swkbd, SwkbdButton button, char const *text, bool submit);
+void swkbdSetInitialText (SwkbdState *swkbd, char const *text);
+void swkbdSetPasswordMode (SwkbdState *swkbd, SwkbdPasswordMode mode);
+SwkbdButton swkbdInputText (SwkbdState *swkbd, char *buf, std::size_t bufsize);
+
+// system font
+typedef struct CFNT_s CFNT_s;
+
+enum
+{
+	CMAP_TYPE_DIRECT = 0,
+	CMAP_TYPE_TABLE  = 1,
+	CMAP_TYPE_SCAN   = 2,
+};
+
+typedef struct
+{
+	u16 code;
+	u16 glyphIndex;
+} scanEntry;
+
+typedef struct CMAP_s
+{
+	u16 codeBegin;
+	u16 codeEnd;
+	u16 mappingMethod;
+	u16 reserved;
+	struct CMAP_s *next;
+	union
+	{
+		u16 indexOffset;
+		u16 indexTable[1];
+		struct
+		{
+			u16 nScanEntries;
+			scanEntry scanEntries[1];
+		};
+	};
+} CMAP_s;
+
+typedef struct
+{
+	s8 left;
+	u8 glyphWidth;
+	u8 charWidth;
+} charWidthInfo_s;
+
+typedef struct
+{
+	u8 cellWidth;
+	u8 cellHeight;
+	u8 baselinePos;
+	u8 maxCharWidth;
+	u32 sheetSize;
+	u16 nSheets;
+	u16 sheetFmt;
+	u16 nRows;
+	u16 nLines;
+	u16 sheetWidth;
+	u16 sheetHeight;
+	u8 *sheetData;
+} TGLP_s;
+
+typedef struct
+{
+	u8 fontType;
+	u8 lineFeed;
+	u16 alterCharIndex;
+	charWidthInfo_s defaultWidth;
+	u8 encoding;
+	TGLP_s *tglp;
+	CMAP_s *cmap;
+	u8 height;
+	u8 width;
+	u8 ascent;
+} FINF_s;
+
+typedef struct
+{
+	int sheetIndex;
+	float xOffset;
+	float xAdvance;
+	float width;
+	struct
+	{
+		float left;
+		float top;
+		float right;
+		float bottom;
+	} texcoord, vtxcoord;
+} fontGlyphPos_s;
+
+enum
+{
+	GLYPH_POS_CALC_VTXCOORD = BIT (0),
+	GLYPH_POS_AT_BASELINE   = BIT (1),
+	GLYPH_POS_Y_POINTS_UP   = BIT (2),
+};
+
+Result fontEnsureMapped (void);
+CFNT_s *fontGetSystemFont (void);
+FINF_s *fontGetInfo (CFNT_s *font);
+TGLP_s *fontGetGlyphInfo (CFNT_s *font);
+void *fontGetGlyphSheetTex (CFNT_s *font, int sheetIndex);
+int fontGlyphIndexFromCodePoint (CFNT_s *font, u32 codePoint);
+void fontCalcGlyphPos (fontGlyphPos_s *out,
+    CFNT_s *font,
+    int glyphIndex,
+    u32 flags,
+    float scaleX,
+    float scaleY);
@@ -0,0 +1,365 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Host citro3d stub: nothing is rendered, draw calls are recorded into stub::draws with the state
+// they were issued with, and command buffer use is modeled so splits and overflow can be tested.
+
+#include "stub.h"
+#include "vshader_shbin.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+
+namespace stub
+{
+std::vector<Draw> draws;
+unsigned frameSplits   = 0;
+std::size_t cmdBufSize = 0;
+std::size_t cmdBufUsed = 0;
+std::size_t cmdBufPeak = 0;
+bool cmdBufOverflowed  = false;
+}
+
+namespace
+{
+/// \brief Uniform location of "projection"
+constexpr int PROJECTION_LOCATION = 0;
+/// \brief Uniform location of "shift"
+constexpr int SHIFT_LOCATION = 4;
+
+/// \brief Current render target
+C3D_RenderTarget *s_target = nullptr;
+/// \brief Bound texture
+C3D_Tex *s_texture = nullptr;
+/// \brief Current scissor
+u32 s_scissor[4] = {};
+/// \brief Current "shift" uniform
+float s_shift = 0.0f;
+/// \brief Current "projection" uniform
+C3D_Mtx s_projection = {};
+/// \brief Bound vertex buffer
+void const *s_vertices = nullptr;
+
+/// \brief Command buffer
+std::vector<u32> s_cmdBuf;
+/// \brief Command buffer bytes handed to the GPU this frame
+std::size_t s_cmdBufSubmitted = 0;
+/// \brief What C3D_GetCmdBufUsage () reports; like citro3d, only updated on submit
+float s_cmdBufUsage = 0.0f;
+
+C3D_AttrInfo s_attrInfo;
+C3D_BufInfo s_bufInfo;
+
+DVLE_s s_dvle = {0};
+DVLB_s s_dvlb = {1, &s_dvle};
+
+/// \brief Account for a command written to the command buffer
+/// \param words_ Command size in 32-bit words
+void issue (std::size_t const words_)
+{
+	stub::cmdBufUsed += words_ * sizeof (u32);
+	if (stub::cmdBufUsed > stub::cmdBufSize)
+		stub::cmdBufOverflowed = true;
+}
+
+/// \brief Submit the commands issued since the last submit
+/// \note Like GPUCMD_Split, the rest of the frame continues after them in the same buffer
+void submit ()
+{
+	s_cmdBufSubmitted = stub::cmdBufUsed;
+	s_cmdBufUsage     = float (stub::cmdBufUsed) / stub::cmdBufSize;
+	stub::cmdBufPeak  = std::max (stub::cmdBufPeak, stub::cmdBufUsed);
+}
+}
+
+extern u8 const vshader_shbin[4] = {};
+extern u32 const vshader_shbin_size = sizeof (vshader_shbin);
+
+DVLB_s *DVLB_ParseFile (u32 *, u32)
+{
+	return &s_dvlb;
+}
+
+void DVLB_Free (DVLB_s *)
+{
+}
+
+Result shaderProgramInit (shaderProgram_s *const sp)
+{
+	std::memset (sp, 0, sizeof (*sp));
+	return 0;
+}
+
+Result shaderProgramFree (shaderProgram_s *)
+{
+	return 0;
+}
+
+Result shaderProgramSetVsh (shaderProgram_s *, DVLE_s *)
+{
+	return 0;
+}
+
+s8 shaderInstanceGetUniformLocation (shaderInstance_s *, char const *const name)
+{
+	if (std::strcmp (name, "shift") == 0)
+		return SHIFT_LOCATION;
+	return std::strcmp (name, "projection") == 0 ? PROJECTION_LOCATION : -1;
+}
+
+void GPUCMD_GetBuffer (u32 **const addr, u32 *const size, u32 *const offset)
+{
+	auto const submitted = std::min (s_cmdBufSubmitted, stub::cmdBufSize) / sizeof (u32);
+	auto const used      = std::min (stub::cmdBufUsed, stub::cmdBufSize) / sizeof (u32);
+	if (addr)
+		*addr = s_cmdBuf.data () + submitted;
+	if (size)
+		*size = s_cmdBuf.size () - submitted;
+	if (offset)
+		*offset = used - submitted;
+}
+
+bool C3D_Init (std::size_t const cmdBufSize)
+{
+	stub::cmdBufSize = cmdBufSize;
+	stub::cmdBufUsed = 0;
+	stub::cmdBufPeak = 0;
+	s_cmdBuf.assign (cmdBufSize / sizeof (u32), 0);
+	s_cmdBufSubmitted = 0;
+	s_cmdBufUsage     = 0.0f;
+	return true;
+}
+
+void C3D_Fini (void)
+{
+}
+
+float C3D_GetCmdBufUsage (void)
+{
+	return s_cmdBufUsage;
+}
+
+bool C3D_FrameBegin (u8)
+{
+	stub::draws.clear ();
+	stub::frameSplits      = 0;
+	stub::cmdBufUsed       = 0;
+	stub::cmdBufOverflowed = false;
+	s_cmdBufSubmitted      = 0;
+	return true;
+}
+
+void C3D_FrameSplit (u8)
+{
+	++stub::frameSplits;
+	submit ();
+}
+
+void C3D_FrameEnd (u8)
+{
+	submit ();
+}
+
+bool C3D_FrameDrawOn (C3D_RenderTarget *const target)
+{
+	s_target = target;
+	issue (32);
+	return true;
+}
+
+void C3D_CullFace (GPU_CULLMODE)
+{
+	issue (2);
+}
+
+void C3D_DepthTest (bool, GPU_TESTFUNC, int)
+{
+	issue (4);
+}
+
+void C3D_AlphaBlend (GPU_BLENDEQUATION,
+    GPU_BLENDEQUATION,
+    GPU_BLENDFACTOR,
+    GPU_BLENDFACTOR,
+    GPU_BLENDFACTOR,
+    GPU_BLENDFACTOR)
+{
+	issue (4);
+}
+
+void C3D_SetScissor (GPU_SCISSORMODE const mode, u32 const left, u32 const top, u32 const right, u32 const bottom)
+{
+	if (mode == GPU_SCISSOR_DISABLE)
+		std::memset (s_scissor, 0, sizeof (s_scissor));
+	else
+	{
+		s_scissor[0] = left;
+		s_scissor[1] = top;
+		s_scissor[2] = right;
+		s_scissor[3] = bottom;
+	}
+	issue (6);
+}
+
+void C3D_BindProgram (shaderProgram_s *)
+{
+	issue (32);
+}
+
+C3D_AttrInfo *C3D_GetAttrInfo (void)
+{
+	return &s_attrInfo;
+}
+
+void AttrInfo_Init (C3D_AttrInfo *const info)
+{
+	info->loaders = 0;
+}
+
+int AttrInfo_AddLoader (C3D_AttrInfo *const info, int, GPU_FORMATS, int)
+{
+	issue (4);
+	return info->loaders++;
+}
+
+C3D_BufInfo *C3D_GetBufInfo (void)
+{
+	return &s_bufInfo;
+}
+
+void BufInfo_Init (C3D_BufInfo *const info)
+{
+	info->data = nullptr;
+}
+
+int BufInfo_Add (C3D_BufInfo *const info, void const *const data, std::ptrdiff_t, int, u64)
+{
+	info->data = data;
+	s_vertices = data;
+	issue (16);
+	return 0;
+}
+
+void C3D_FVUnifMtx4x4 (GPU_SHADER_TYPE, int const id, C3D_Mtx const *const mtx)
+{
+	if (id == PROJECTION_LOCATION)
+		s_projection = *mtx;
+	issue (18);
+}
+
+void C3D_FVUnifSet (GPU_SHADER_TYPE, int const id, float const x, float, float, float)
+{
+	if (id == SHIFT_LOCATION)
+		s_shift = x;
+	issue (6);
+}
+
+void C3D_DrawElements (GPU_Primitive_t, int const count, int, void const *const indices)
+{
+	stub::draws.push_back (stub::Draw{s_target,
+	    s_texture,
+	    {s_scissor[0], s_scissor[1], s_scissor[2], s_scissor[3]},
+	    s_shift,
+	    s_projection,
+	    s_vertices,
+	    static_cast<u16 const *> (indices),
+	    count});
+	issue (32);
+}
+
+bool C3D_TexInit (C3D_Tex *const tex, u16 const width, u16 const height, GPU_TEXCOLOR const format)
+{
+	tex->size   = std::size_t (width) * height;
+	tex->data   = std::calloc (tex->size, 1);
+	tex->fmt    = format;
+	tex->width  = width;
+	tex->height = height;
+	return tex->data;
+}
+
+void C3D_TexDelete (C3D_Tex *const tex)
+{
+	std::free (tex->data);
+	tex->data = nullptr;
+}
+
+void C3D_TexBind (int, C3D_Tex *const tex)
+{
+	s_texture = tex;
+	issue (12);
+}
+
+void *C3D_Tex2DGetImagePtr (C3D_Tex *const tex, int, u32 *const size)
+{
+	if (size)
+		*size = tex->size;
+	return tex->data;
+}
+
+void C3D_TexEnvInit (C3D_TexEnv *const env)
+{
+	std::memset (env, 0, sizeof (*env));
+}
+
+void C3D_TexEnvSrc (C3D_TexEnv *const env, int const mode, GPU_TEVSRC const s1, GPU_TEVSRC, GPU_TEVSRC)
+{
+	if (mode & C3D_RGB)
+		env->srcRgb = s1;
+	if (mode & C3D_Alpha)
+		env->srcAlpha = s1;
+}
+
+void C3D_TexEnvFunc (C3D_TexEnv *const env, int const mode, GPU_COMBINEFUNC const param)
+{
+	if (mode & C3D_RGB)
+		env->funcRgb = param;
+	if (mode & C3D_Alpha)
+		env->funcAlpha = param;
+}
+
+void C3D_SetTexEnv (int, C3D_TexEnv const *)
+{
+	issue (8);
+}
+
+void Mtx_OrthoTilt (C3D_Mtx *const mtx,
+    float const left,
+    float const right,
+    float const bottom,
+    float const top,
+    float const near,
+    float const far,
+    bool const isLeftHanded)
+{
+	// citro3d's orthographic projection: depth range [-1, 0] and rotated a quarter turn
+	// counterclockwise for the 3DS screens, so x on screen is y in clip space
+	std::memset (mtx, 0, sizeof (*mtx));
+	mtx->m[1]  = 2.0f / (top - bottom);
+	mtx->m[3]  = (bottom + top) / (bottom - top);
+	mtx->m[4]  = 2.0f / (left - right);
+	mtx->m[7]  = (left + right) / (right - left);
+	mtx->m[10] = isLeftHanded ? 1.0f / (far - near) : 1.0f / (near - far);
+	mtx->m[11] = 0.5f * (near + far) / (near - far) - 0.5f;
+	mtx->m[15] = 1.0f;
+}
@@ -0,0 +1,264 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Host stand-in for the parts of citro3d the backend uses. The stub records what is issued
+// instead of building GPU commands; see stub.h.
+
+#pragma once
+
+#include <3ds.h>
+
+#define C3D_DEFAULT_CMDBUF_SIZE 0x40000
+
+/// \brief 4x4 matrix, row-major with columns x, y, z, w
+typedef struct
+{
+	float m[16];
+} C3D_Mtx;
+
+// shaders
+typedef struct
+{
+	int index;
+} DVLE_s;
+
+typedef struct
+{
+	u32 numDVLE;
+	DVLE_s *DVLE;
+} DVLB_s;
+
+typedef struct shaderInstance_s shaderInstance_s;
+
+typedef struct
+{
+	shaderInstance_s *vertexShader;
+	shaderInstance_s *geometryShader;
+} shaderProgram_s;
+
+typedef enum
+{
+	GPU_VERTEX_SHADER   = 0,
+	GPU_GEOMETRY_SHADER = 1,
+} GPU_SHADER_TYPE;
+
+DVLB_s *DVLB_ParseFile (u32 *shbinData, u32 shbinSize);
+void DVLB_Free (DVLB_s *dvlb);
+Result shaderProgramInit (shaderProgram_s *sp);
+Result shaderProgramFree (shaderProgram_s *sp);
+Result shaderProgramSetVsh (shaderProgram_s *sp, DVLE_s *dvle);
+s8 shaderInstanceGetUniformLocation (shaderInstance_s *si, char const *name);
+
+// GPU enums
+typedef enum
+{
+	GPU_BYTE          = 0,
+	GPU_UNSIGNED_BYTE = 1,
+	GPU_SHORT         = 2,
+	GPU_FLOAT         = 3,
+} GPU_FORMATS;
+
+typedef enum
+{
+	GPU_CULL_NONE = 0,
+} GPU_CULLMODE;
+
+typedef enum
+{
+	GPU_ALWAYS  = 1,
+	GPU_GREATER = 6,
+} GPU_TESTFUNC;
+
+enum
+{
+	GPU_WRITE_COLOR = 0x0F,
+	GPU_WRITE_ALL   = 0x1F,
+};
+
+typedef enum
+{
+	GPU_BLEND_ADD = 0,
+} GPU_BLENDEQUATION;
+
+typedef enum
+{
+	GPU_SRC_ALPHA           = 6,
+	GPU_ONE_MINUS_SRC_ALPHA = 7,
+} GPU_BLENDFACTOR;
+
+typedef enum
+{
+	GPU_SCISSOR_DISABLE = 0,
+	GPU_SCISSOR_NORMAL  = 3,
+} GPU_SCISSORMODE;
+
+typedef enum
+{
+	GPU_TRIANGLES = 0,
+} GPU_Primitive_t;
+
+typedef enum
+{
+	GPU_RGBA8 = 0,
+	GPU_L8    = 7,
+	GPU_A4    = 11,
+} GPU_TEXCOLOR;
+
+typedef enum
+{
+	GPU_PRIMARY_COLOR = 0,
+	GPU_TEXTURE0      = 3,
+	GPU_CONSTANT      = 14,
+	GPU_PREVIOUS      = 15,
+} GPU_TEVSRC;
+
+typedef enum
+{
+	GPU_REPLACE  = 0,
+	GPU_MODULATE = 1,
+} GPU_COMBINEFUNC;
+
+enum
+{
+	GPU_NEAREST = 0,
+	GPU_LINEAR  = 1,
+};
+
+enum
+{
+	GPU_CLAMP_TO_EDGE = 0,
+	GPU_REPEAT        = 2,
+};
+
+#define GPU_TEXTURE_MAG_FILTER(v_) (((v_) & 0x1) << 1)
+#define GPU_TEXTURE_MIN_FILTER(v_) (((v_) & 0x1) << 2)
+#define GPU_TEXTURE_WRAP_S(v_) (((v_) & 0x3) << 12)
+#define GPU_TEXTURE_WRAP_T(v_) (((v_) & 0x3) << 8)
+
+enum
+{
+	C3D_RGB   = BIT (0),
+	C3D_Alpha = BIT (1),
+	C3D_Both  = C3D_RGB | C3D_Alpha,
+};
+
+enum
+{
+	C3D_UNSIGNED_BYTE  = 0,
+	C3D_UNSIGNED_SHORT = 1,
+};
+
+enum
+{
+	C3D_FRAME_SYNCDRAW = BIT (0),
+	C3D_FRAME_NONBLOCK = BIT (1),
+};
+
+// state
+typedef struct
+{
+	u16 srcRgb;
+	u16 srcAlpha;
+	u16 funcRgb;
+	u16 funcAlpha;
+} C3D_TexEnv;
+
+typedef struct
+{
+	void *data;
+	GPU_TEXCOLOR fmt;
+	std::size_t size;
+	u16 width;
+	u16 height;
+	u32 param;
+	u32 border;
+	u32 lodParam;
+} C3D_Tex;
+
+typedef struct
+{
+	int loaders;
+} C3D_AttrInfo;
+
+typedef struct
+{
+	void const *data;
+} C3D_BufInfo;
+
+typedef struct C3D_RenderTarget
+{
+	gfxScreen_t screen;
+	gfx3dSide_t side;
+} C3D_RenderTarget;
+
+bool C3D_Init (std::size_t cmdBufSize);
+void C3D_Fini (void);
+float C3D_GetCmdBufUsage (void);
+
+bool C3D_FrameBegin (u8 flags);
+void C3D_FrameSplit (u8 flags);
+void C3D_FrameEnd (u8 flags);
+bool C3D_FrameDrawOn (C3D_RenderTarget *target);
+
+void C3D_CullFace (GPU_CULLMODE mode);
+void C3D_DepthTest (bool enable, GPU_TESTFUNC function, int writemask);
+void C3D_AlphaBlend (GPU_BLENDEQUATION colorEq,
+    GPU_BLENDEQUATION alphaEq,
+    GPU_BLENDFACTOR srcClr,
+    GPU_BLENDFACTOR dstClr,
+    GPU_BLENDFACTOR srcAlpha,
+    GPU_BLENDFACTOR dstAlpha);
+void C3D_SetScissor (GPU_SCISSORMODE mode, u32 left, u32 top, u32 right, u32 bottom);
+void C3D_BindProgram (shaderProgram_s *program);
+
+C3D_AttrInfo *C3D_GetAttrInfo (void);
+void AttrInfo_Init (C3D_AttrInfo *info);
+int AttrInfo_AddLoader (C3D_AttrInfo *info, int regId, GPU_FORMATS format, int count);
+
+C3D_BufInfo *C3D_GetBufInfo (void);
+void BufInfo_Init (C3D_BufInfo *info);
+int BufInfo_Add (C3D_BufInfo *info, void const *data, std::ptrdiff_t stride, int attribCount, u64 permutation);
+
+void C3D_FVUnifMtx4x4 (GPU_SHADER_TYPE type, int id, C3D_Mtx const *mtx);
+void C3D_FVUnifSet (GPU_SHADER_TYPE type, int id, float x, float y, float z, float w);
+
+void C3D_DrawElements (GPU_Primitive_t primitive, int count, int type, void const *indices);
+
+bool C3D_TexInit (C3D_Tex *tex, u16 width, u16 height, GPU_TEXCOLOR format);
+void C3D_TexDelete (C3D_Tex *tex);
+void C3D_TexBind (int unitId, C3D_Tex *tex);
+void *C3D_Tex2DGetImagePtr (C3D_Tex *tex, int level, u32 *size);
+
+void C3D_TexEnvInit (C3D_TexEnv *env);
+void C3D_TexEnvSrc (C3D_TexEnv *env, int mode, GPU_TEVSRC s1, GPU_TEVSRC s2, GPU_TEVSRC s3);
+void C3D_TexEnvFunc (C3D_TexEnv *env, int mode, GPU_COMBINEFUNC param);
+void C3D_SetTexEnv (int id, C3D_TexEnv const *env);
+
+void Mtx_OrthoTilt (C3D_Mtx *mtx,
+    float left,
+    float right,
+    float bottom,
+    float top,
+    float near,
+    float far,
+    bool isLeftHanded);
@@ -0,0 +1,207 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Host libctru stub: input comes from the stub:: state, time from the host clock and the system
+// font is a fake 4-sheet ASCII font.
+
+#include "stub.h"
+
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+
+namespace stub
+{
+u32 held                   = 0;
+circlePosition circlePad   = {0, 0};
+touchPosition touch        = {0, 0};
+float slider3D             = 0.0f;
+std::string keyboardText   = {};
+SwkbdButton keyboardButton = SWKBD_BUTTON_RIGHT;
+unsigned keyboardOpens     = 0;
+}
+
+namespace
+{
+/// \brief Buttons held at the last scan
+u32 s_held = 0;
+/// \brief Buttons pressed at the last scan
+u32 s_down = 0;
+/// \brief Buttons released at the last scan
+u32 s_up = 0;
+/// \brief Touch position latched at the last scan
+touchPosition s_touch = {0, 0};
+
+/// \brief HID shared memory; only the touch screen section is filled in
+vu32 s_hidSharedMem[0x400] = {};
+
+/// \brief Fake system font glyph info: 4 sheets of 20x30 cells
+TGLP_s s_glyphInfo = {20, 30, 24, 20, 256 * 128 / 2, 4, GPU_A4, 8, 4, 256, 128, nullptr};
+/// \brief Fake system font character map: printable ASCII
+CMAP_s s_cmap = {32, 126, CMAP_TYPE_DIRECT, 0, nullptr, {0}};
+/// \brief Fake system font info
+FINF_s s_fontInfo = {1, 18, 0, {0, 10, 10}, 1, &s_glyphInfo, &s_cmap, 30, 20, 24};
+/// \brief Fake glyph sheet data
+u8 s_sheets[4][16] = {};
+}
+
+vu32 *hidSharedMem = s_hidSharedMem;
+
+void hidScanInput (void)
+{
+	s_down  = stub::held & ~s_held;
+	s_up    = s_held & ~stub::held;
+	s_held  = stub::held;
+	s_touch = stub::touch;
+
+	// the latched sample is also the latest one until a newer one is published
+	stub::setLatestTouch (s_touch, s_held & KEY_TOUCH);
+}
+
+u32 hidKeysHeld (void)
+{
+	return s_held;
+}
+
+u32 hidKeysDown (void)
+{
+	return s_down;
+}
+
+u32 hidKeysUp (void)
+{
+	return s_up;
+}
+
+void hidTouchRead (touchPosition *const pos)
+{
+	*pos = s_touch;
+}
+
+void hidCircleRead (circlePosition *const pos)
+{
+	*pos = stub::circlePad;
+}
+
+void stub::setLatestTouch (touchPosition const &pos_, bool const pressed_)
+{
+	// touch screen section: latest entry index, then (position, pressed) entries
+	auto const section = &s_hidSharedMem[42];
+	section[4]         = 0;
+	section[8]         = pos_.px | (u32 (pos_.py) << 16);
+	section[9]         = pressed_;
+}
+
+u64 svcGetSystemTick (void)
+{
+	auto const now = std::chrono::steady_clock::now ().time_since_epoch ();
+	return std::chrono::duration_cast<std::chrono::duration<u64, std::ratio<1, SYSCLOCK_ARM11>>> (now)
+	    .count ();
+}
+
+float osGet3DSliderState (void)
+{
+	return stub::slider3D;
+}
+
+void *linearAlloc (std::size_t const size)
+{
+	return std::malloc (size);
+}
+
+void linearFree (void *const mem)
+{
+	std::free (mem);
+}
+
+void swkbdInit (SwkbdState *const swkbd, SwkbdType const type, int, int)
+{
+	swkbd->type = type;
+}
+
+void swkbdSetButton (SwkbdState *, SwkbdButton, char const *, bool)
+{
+}
+
+void swkbdSetInitialText (SwkbdState *, char const *)
+{
+}
+
+void swkbdSetPasswordMode (SwkbdState *, SwkbdPasswordMode)
+{
+}
+
+SwkbdButton swkbdInputText (SwkbdState *, char *const buf, std::size_t const bufsize)
+{
+	++stub::keyboardOpens;
+	std::snprintf (buf, bufsize, "%s", stub::keyboardText.c_str ());
+	return stub::keyboardButton;
+}
+
+Result fontEnsureMapped (void)
+{
+	return 0;
+}
+
+CFNT_s *fontGetSystemFont (void)
+{
+	return reinterpret_cast<CFNT_s *> (&s_fontInfo);
+}
+
+FINF_s *fontGetInfo (CFNT_s *)
+{
+	return &s_fontInfo;
+}
+
+TGLP_s *fontGetGlyphInfo (CFNT_s *)
+{
+	return &s_glyphInfo;
+}
+
+void *fontGetGlyphSheetTex (CFNT_s *, int const sheetIndex)
+{
+	return s_sheets[sheetIndex];
+}
+
+int fontGlyphIndexFromCodePoint (CFNT_s *, u32 const codePoint)
+{
+	if (codePoint < s_cmap.codeBegin || codePoint > s_cmap.codeEnd)
+		return s_fontInfo.alterCharIndex;
+	return codePoint - s_cmap.codeBegin;
+}
+
+void fontCalcGlyphPos (fontGlyphPos_s *const out, CFNT_s *, int const glyphIndex, u32, float, float)
+{
+	// 24 glyphs per sheet, each cell 1/8 of the sheet wide and 1/4 high
+	auto const cell = glyphIndex % 24;
+	auto const u    = (cell % 8) / 8.0f;
+	auto const v    = (cell / 8) / 4.0f;
+
+	out->sheetIndex = glyphIndex / 24 % 4;
+	out->xOffset    = 0.0f;
+	out->xAdvance   = 10.0f;
+	out->width      = 10.0f;
+	out->texcoord   = {u, 1.0f - v, u + 0.125f, 1.0f - v - 0.25f};
+	out->vtxcoord   = {0.0f, 0.0f, 10.0f, 30.0f};
+}
@@ -0,0 +1,92 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// State behind the host libctru/citro3d stubs: tests set the inputs the stubs report and read
+// back what the backends issued.
+
+#pragma once
+
+#include <3ds.h>
+#include <citro3d.h>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace stub
+{
+/// \brief Buttons held; hidScanInput () derives the down/up edges from the previous scan
+extern u32 held;
+/// \brief Circle pad position
+extern circlePosition circlePad;
+/// \brief Touch position latched by hidScanInput ()
+extern touchPosition touch;
+/// \brief 3D slider position
+extern float slider3D;
+
+/// \brief Publish a touch sample newer than the last hidScanInput (), as the HID module does
+/// \param pos_ Touch position
+/// \param pressed_ Whether the touch screen is pressed
+void setLatestTouch (touchPosition const &pos_, bool pressed_);
+
+/// \brief Text the software keyboard returns
+extern std::string keyboardText;
+/// \brief Button the software keyboard is closed with
+extern SwkbdButton keyboardButton;
+/// \brief Number of times the software keyboard was opened
+extern unsigned keyboardOpens;
+
+/// \brief Recorded draw call
+struct Draw
+{
+	/// \brief Render target drawn on
+	C3D_RenderTarget *target;
+	/// \brief Bound texture
+	C3D_Tex *texture;
+	/// \brief Scissor (left, top, right, bottom), or all zero when disabled
+	u32 scissor[4];
+	/// \brief Value of the "shift" vertex shader uniform
+	float shift;
+	/// \brief Value of the "projection" vertex shader uniform
+	C3D_Mtx projection;
+	/// \brief Bound vertex buffer
+	void const *vertices;
+	/// \brief Index data
+	u16 const *indices;
+	/// \brief Number of indices
+	int count;
+};
+
+/// \brief Draw calls since C3D_FrameBegin ()
+extern std::vector<Draw> draws;
+/// \brief C3D_FrameSplit () calls since C3D_FrameBegin ()
+extern unsigned frameSplits;
+/// \brief Command buffer size passed to C3D_Init ()
+extern std::size_t cmdBufSize;
+/// \brief Command buffer bytes used since C3D_FrameBegin (); splits don't give any back
+extern std::size_t cmdBufUsed;
+/// \brief Largest cmdBufUsed reached by a frame
+extern std::size_t cmdBufPeak;
+/// \brief Whether commands were issued past the end of the command buffer, which citro3d drops
+extern bool cmdBufOverflowed;
+}
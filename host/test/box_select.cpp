@@ -0,0 +1,251 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+
+// Box-select ranges: dragging a box that auto-scrolls a clipped 1-D list, a BoxSelect2d list and
+// an 8-column grid selects exactly what the per-item path selects, frame by frame, including
+// Ctrl-drags over an existing selection and the first box-selected item taking NavId, while
+// submitting fewer items.
+
+#include "test.h"
+
+#include "imgui/imgui_internal.h"
+
+#include <algorithm>
+#include <array>
+#include <vector>
+
+namespace
+{
+/// \brief Item layout under test
+enum class Layout
+{
+	List1d,
+	List2d,
+	Grid,
+};
+
+/// \brief Grid columns
+constexpr int GRID_COLUMNS = 8;
+
+/// \brief Frames in a drag
+constexpr int DRAG_FRAMES = 260;
+
+/// \brief Frame on which the box first reaches an item
+constexpr int REACH_FRAME = 6;
+
+/// \brief What a drag did
+struct Run
+{
+	/// \brief Selected items after each frame, sorted
+	std::vector<std::vector<ImGuiID>> selections;
+	/// \brief Item NavId was on after the click
+	int navItemBefore = -1;
+	/// \brief Item NavId was on after the last frame
+	int navItem = -1;
+	/// \brief Items submitted over the drag
+	int submitted = 0;
+	/// \brief Frames that had a learned layout to compute ranges from
+	int layoutFrames = 0;
+};
+
+/// \brief Submit the clipped items in a multi-select scope
+/// \param layout_ Item layout
+/// \param perItem_ Whether to force the per-item path
+/// \param selection_ Selection
+/// \param run_ Run to count submitted items and layout frames and find NavId in
+void items (Layout const layout_, bool const perItem_, ImGuiSelectionBasicStorage &selection_, Run &run_)
+{
+	auto const columns = layout_ == Layout::Grid ? GRID_COLUMNS : 1;
+	auto const count   = layout_ == Layout::Grid ? 600 * GRID_COLUMNS : 3000;
+	auto const size    = layout_ == Layout::Grid ? ImVec2 (32.0f, 24.0f) : ImVec2 (200.0f, 0.0f);
+
+	ImGui::SetNextWindowPos (ImVec2 (0.0f, 0.0f));
+	ImGui::SetNextWindowSize (ImGui::GetIO ().DisplaySize);
+	ImGui::Begin ("Items",
+	    nullptr,
+	    ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove);
+
+	auto const flags = ImGuiMultiSelectFlags_ClearOnClickVoid |
+	                   (layout_ == Layout::List1d ? ImGuiMultiSelectFlags_BoxSelect1d :
+	                                                ImGuiMultiSelectFlags_BoxSelect2d);
+	auto io = ImGui::BeginMultiSelect (flags, selection_.Size, count);
+	selection_.ApplyRequests (io);
+
+#ifdef IMGUI_ENABLE_BOX_SELECT_RANGES
+	// without a learned layout MultiSelectAddBoxSelectRanges () leaves every item to the footer
+	auto &layout = ImGui::GetCurrentContext ()->BoxSelectState.Layout;
+	if (perItem_)
+		layout.Columns = 0;
+	else if (layout.Columns == columns)
+		++run_.layoutFrames;
+#else
+	(void)perItem_;
+#endif
+
+	ImGuiListClipper clipper;
+	clipper.Begin ((count + columns - 1) / columns);
+	if (io->RangeSrcItem != -1)
+		clipper.IncludeItemByIndex (static_cast<int> (io->RangeSrcItem / columns));
+	while (clipper.Step ())
+	{
+		for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
+		{
+			for (int column = 0; column < columns; ++column)
+			{
+				auto const item = row * columns + column;
+				if (item >= count)
+					break;
+
+				if (column)
+					ImGui::SameLine ();
+				ImGui::PushID (item);
+				ImGui::SetNextItemSelectionUserData (item);
+				ImGui::Selectable ("##item", selection_.Contains (item), 0, size);
+				if (ImGui::GetItemID () == ImGui::GetCurrentContext ()->NavId)
+					run_.navItem = item;
+				ImGui::PopID ();
+				++run_.submitted;
+			}
+		}
+	}
+
+	io = ImGui::EndMultiSelect ();
+	selection_.ApplyRequests (io);
+	ImGui::End ();
+}
+
+/// \brief Drag a box from empty space down, wiggling sideways, then back up past its start, and
+/// release it
+/// \param layout_ Item layout
+/// \param perItem_ Whether to force the per-item path
+/// \param ctrl_ Whether Ctrl is held over a few items selected beforehand
+/// \param scroll_ Whether to start right of the items and drag past the bottom and top of the
+/// window, auto-scrolling, or to start in the window padding left of the items and stay in view
+/// \note Out of view, the per-item path only submits the items of a 2D box's rows that fall in its
+/// unclip rect and merges the ones it toggles across the skipped ones, so the box only toggles
+/// columns short of the end of the rows there
+Run drag (Layout const layout_, bool const perItem_, bool const ctrl_, bool const scroll_)
+{
+	test::createContext ();
+	auto &io = ImGui::GetIO ();
+
+	auto const startX = scroll_ ? 380.0f : 2.0f;
+	auto const bottom = scroll_ ? io.DisplaySize.y + 80.0f : 400.0f;
+	auto const top    = scroll_ ? -80.0f : 40.0f;
+
+	ImGuiSelectionBasicStorage selection;
+	if (ctrl_)
+	{
+		for (int const item : {3, 5, 40, 41, 42, 200, 201})
+			selection.SetItemSelected (item, true);
+	}
+
+	auto const wiggle = layout_ == Layout::List1d || scroll_ ? 2 : 3;
+
+	Run run;
+	for (int frame = 0; frame < DRAG_FRAMES; ++frame)
+	{
+		// every other frame the edge moves; in view and in 2D sometimes back to the start to leave
+		// the items entirely, BoxSelect1d lists only keep the rows a box spans vertically
+		auto const x = std::array{180.0f, 100.0f, startX + 1.0f}[frame / 2 % wiggle];
+		if (frame < 2)
+			io.AddMousePosEvent (startX, 100.0f);
+		else if (frame < REACH_FRAME) // the box activates over void and learns the layout first
+			io.AddMousePosEvent (startX + 1.0f, 200.0f);
+		else if (frame < 100)
+			io.AddMousePosEvent (x, bottom);
+		else
+			io.AddMousePosEvent (x, top);
+		io.AddKeyEvent (ImGuiMod_Ctrl, ctrl_);
+		io.AddMouseButtonEvent (0, frame >= 1 && frame < DRAG_FRAMES - 5);
+
+		ImGui::NewFrame ();
+		run.navItem = -1;
+		items (layout_, perItem_, selection, run);
+		ImGui::Render ();
+		if (frame == 1)
+			run.navItemBefore = run.navItem;
+
+		std::vector<ImGuiID> selected;
+		void *it = nullptr;
+		ImGuiID id;
+		while (selection.GetNextSelectedItem (&it, &id))
+			selected.emplace_back (id);
+		std::sort (selected.begin (), selected.end ());
+		run.selections.emplace_back (std::move (selected));
+	}
+
+	ImGui::DestroyContext ();
+	return run;
+}
+
+/// \brief The ranges path selects what the per-item path does
+void compare (Layout const layout_, bool const ctrl_, bool const scroll_)
+{
+	auto const ranges  = drag (layout_, false, ctrl_, scroll_);
+	auto const perItem = drag (layout_, true, ctrl_, scroll_);
+
+	CHECK (ranges.selections == perItem.selections);
+	CHECK (ranges.navItemBefore == perItem.navItemBefore);
+	CHECK (ranges.navItem == perItem.navItem);
+
+	// a scrolling box covered a lot of items at some point, and some were left selected at the end
+	auto const most = std::max_element (ranges.selections.begin (),
+	    ranges.selections.end (),
+	    [] (auto const &a_, auto const &b_) { return a_.size () < b_.size (); });
+	CHECK (most->size () > (scroll_ ? 100u : 10u));
+	CHECK (!ranges.selections.back ().empty ());
+
+	// the click focuses the window, which puts NavId on its first item; a drag over an empty
+	// selection then lets the first item the box reaches take NavId, a Ctrl-drag over
+	// an existing selection leaves it alone
+	CHECK (ranges.navItemBefore == 0);
+	CHECK (!ranges.selections[REACH_FRAME].empty ());
+	if (ctrl_)
+		CHECK (ranges.navItem == ranges.navItemBefore);
+	else
+		CHECK (ranges.navItem == static_cast<int> (ranges.selections[REACH_FRAME].front ()));
+
+#ifdef IMGUI_ENABLE_BOX_SELECT_RANGES
+	// the ranges path was used for most of the drag; in 2D the per-item path had to submit every
+	// row of the box whenever it moved sideways, the ranges path only the visible ones
+	CHECK (ranges.layoutFrames > DRAG_FRAMES / 2);
+	if (scroll_ && layout_ != Layout::List1d)
+		CHECK (ranges.submitted * 3 < perItem.submitted * 2);
+#endif
+}
+}
+
+int main ()
+{
+	for (auto const layout : {Layout::List1d, Layout::List2d, Layout::Grid})
+	{
+		for (auto const scroll : {false, true})
+		{
+			compare (layout, false, scroll);
+			compare (layout, true, scroll);
+		}
+	}
+}
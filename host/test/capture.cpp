@@ -0,0 +1,283 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+
+// Capture and replay: recorded frames replay to the same draw data, and truncated or corrupted
+// files are rejected rather than read out of bounds or allocated for.
+
+#include "test.h"
+
+#include "3ds/imgui_capture.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace
+{
+/// \brief Frames captured
+constexpr unsigned FRAMES = 3;
+
+/// \brief A draw list as it should replay: callbacks are not captured
+struct List
+{
+	/// \brief Commands, without callbacks
+	std::vector<ImDrawCmd> cmds;
+	/// \brief Vertices
+	std::vector<ImDrawVert> vtx;
+	/// \brief Indices
+	std::vector<ImDrawIdx> idx;
+};
+
+/// \brief Capture file path
+std::string s_path;
+
+/// \brief Callback recorded into a draw list; never replayed
+void callback (ImDrawList const *, ImDrawCmd const *)
+{
+}
+
+/// \brief Build a frame: text, a second texture and a callback
+/// \param frame_ Frame number
+void build (unsigned const frame_)
+{
+	ImGui::NewFrame ();
+	ImGui::SetNextWindowPos (ImVec2 (10.0f + frame_ * 5.0f, 10.0f));
+	ImGui::SetNextWindowSize (ImVec2 (200.0f, 150.0f));
+	ImGui::Begin ("Capture");
+	ImGui::Text ("Frame %u", frame_);
+	ImGui::Button ("Button");
+	ImGui::GetWindowDrawList ()->AddCallback (&callback, nullptr);
+	ImGui::Image (reinterpret_cast<ImTextureID> (&s_path), ImVec2 (32.0f, 32.0f));
+	ImGui::End ();
+	ImGui::Render ();
+}
+
+/// \brief Snapshot of draw data
+/// \param drawData_ Draw data
+std::vector<List> snapshot (ImDrawData const &drawData_)
+{
+	std::vector<List> lists;
+	for (auto const cmdList : drawData_.CmdLists)
+	{
+		auto &list = lists.emplace_back ();
+		for (auto const &cmd : cmdList->CmdBuffer)
+		{
+			if (!cmd.UserCallback)
+				list.cmds.emplace_back (cmd);
+		}
+		list.vtx.assign (cmdList->VtxBuffer.begin (), cmdList->VtxBuffer.end ());
+		list.idx.assign (cmdList->IdxBuffer.begin (), cmdList->IdxBuffer.end ());
+	}
+	return lists;
+}
+
+/// \brief Whether replayed draw data matches a snapshot
+/// \param drawData_ Replayed draw data
+/// \param lists_ Snapshot of the captured draw data
+bool matches (ImDrawData const &drawData_, std::vector<List> const &lists_)
+{
+	auto const replayed = snapshot (drawData_);
+	if (replayed.size () != lists_.size ())
+		return false;
+
+	for (std::size_t i = 0; i < lists_.size (); ++i)
+	{
+		auto const &a = replayed[i];
+		auto const &b = lists_[i];
+		if (a.cmds.size () != b.cmds.size () || a.vtx.size () != b.vtx.size () ||
+		    a.idx != b.idx ||
+		    std::memcmp (a.vtx.data (), b.vtx.data (), a.vtx.size () * sizeof (ImDrawVert)) != 0)
+			return false;
+
+		for (std::size_t j = 0; j < a.cmds.size (); ++j)
+		{
+			auto const &x = a.cmds[j];
+			auto const &y = b.cmds[j];
+			if (std::memcmp (&x.ClipRect, &y.ClipRect, sizeof (x.ClipRect)) != 0 ||
+			    x.TextureId != y.TextureId || x.VtxOffset != y.VtxOffset ||
+			    x.IdxOffset != y.IdxOffset || x.ElemCount != y.ElemCount)
+				return false;
+		}
+	}
+
+	return drawData_.CmdListsCount == static_cast<int> (lists_.size ());
+}
+
+/// \brief Read a file
+std::vector<char> load (std::string const &path_)
+{
+	std::ifstream file (path_, std::ios::binary);
+	return {std::istreambuf_iterator<char> (file), std::istreambuf_iterator<char> ()};
+}
+
+/// \brief Write a file
+void save (std::string const &path_, std::vector<char> const &data_)
+{
+	std::ofstream file (path_, std::ios::binary | std::ios::trunc);
+	file.write (data_.data (), data_.size ());
+}
+
+/// \brief Set a field of the capture file
+template <typename T>
+void poke (std::vector<char> &data_, std::size_t const offset_, T const value_)
+{
+	CHECK (offset_ + sizeof (value_) <= data_.size ());
+	std::memcpy (&data_[offset_], &value_, sizeof (value_));
+}
+
+/// \brief Open a modified capture and replay every frame
+/// \returns Whether every frame replayed
+bool replays (std::vector<char> const &data_)
+{
+	auto const path = s_path + ".damaged";
+	save (path, data_);
+
+	imgui::capture::Replay replay;
+	auto const opened = replay.open (path.c_str ());
+	std::remove (path.c_str ());
+	if (!opened)
+		return false;
+
+	for (unsigned i = 0; i < replay.frameCount (); ++i)
+	{
+		if (!replay.frame (i))
+			return false;
+	}
+	return replay.frameCount () == FRAMES;
+}
+
+/// \brief Record frames and replay them
+void roundTrip ()
+{
+	std::vector<std::vector<List>> frames;
+
+	CHECK (imgui::capture::start (s_path.c_str (), FRAMES));
+	for (unsigned i = 0; i < FRAMES; ++i)
+	{
+		CHECK (imgui::capture::active ());
+		build (i);
+		imgui::capture::frame (ImGui::GetDrawData ());
+		frames.emplace_back (snapshot (*ImGui::GetDrawData ()));
+	}
+	CHECK (!imgui::capture::active ());
+
+	imgui::capture::Replay replay;
+	replay.textures = {ImGui::GetIO ().Fonts->TexID, reinterpret_cast<ImTextureID> (&s_path)};
+	CHECK (replay.open (s_path.c_str ()));
+	CHECK (replay.frameCount () == FRAMES);
+
+	// out of order, and twice, since replay reuses its lists
+	for (unsigned const i : {2u, 0u, 1u, 0u})
+	{
+		auto const drawData = replay.frame (i);
+		CHECK (drawData);
+		CHECK (drawData->DisplaySize.x == 400.0f && drawData->DisplaySize.y == 480.0f);
+		CHECK (matches (*drawData, frames[i]));
+	}
+	CHECK (!replay.frame (FRAMES));
+}
+
+/// \brief Truncated files either fail to open or have no frames that read past the end
+void truncated ()
+{
+	auto const data = load (s_path);
+	CHECK (replays (data));
+
+	for (std::size_t size = 0; size < data.size (); size += 7)
+		CHECK (!replays (std::vector<char> (data.begin (), data.begin () + size)));
+
+	CHECK (!replays (std::vector<char> (data.begin (), data.end () - 1)));
+}
+
+/// \brief Corrupted counts are rejected before anything is allocated or copied for them
+void corrupted ()
+{
+	using namespace imgui::capture;
+
+	auto const data = load (s_path);
+
+	// first frame, first list
+	auto const frame = sizeof (FileHeader);
+	auto const list  = frame + sizeof (FrameHeader);
+	auto const cmds  = list + sizeof (ListHeader);
+
+	ListHeader listHeader;
+	std::memcpy (&listHeader, &data[list], sizeof (listHeader));
+	CHECK (listHeader.cmdCount > 0 && listHeader.vtxCount > 3);
+
+	auto const damaged = [&] (std::size_t const offset_, std::uint32_t const value_) {
+		auto copy = data;
+		poke (copy, offset_, value_);
+		return !replays (copy);
+	};
+
+	CHECK (damaged (frame + offsetof (FrameHeader, listCount), 0xFFFFFFFF));
+	CHECK (damaged (frame + offsetof (FrameHeader, listCount), 1000));
+
+	// counts whose section size wraps a 32-bit size_t, and counts past the frame
+	CHECK (damaged (list + offsetof (ListHeader, cmdCount), 0x08000000));
+	CHECK (damaged (list + offsetof (ListHeader, cmdCount), 0xFFFFFFFF));
+	CHECK (damaged (list + offsetof (ListHeader, vtxCount), 0xCCCCCCCD));
+	CHECK (damaged (list + offsetof (ListHeader, vtxCount), 0xFFFFFFFF));
+	CHECK (damaged (list + offsetof (ListHeader, idxCount), 0x80000000));
+	CHECK (damaged (list + offsetof (ListHeader, idxCount), 0xFFFFFFFF));
+
+	// commands reaching past the indices, or indices past the vertices
+	CHECK (damaged (cmds + offsetof (Command, elemCount), 0xFFFFFFFF));
+	CHECK (damaged (cmds + offsetof (Command, idxOffset), listHeader.idxCount));
+	CHECK (damaged (cmds + offsetof (Command, vtxOffset), listHeader.vtxCount));
+	CHECK (damaged (cmds + offsetof (Command, vtxOffset), 0xFFFFFFFF));
+
+	// index and frame entries pointing outside the file
+	FileHeader header;
+	std::memcpy (&header, data.data (), sizeof (header));
+	CHECK (damaged (offsetof (FileHeader, frameCount), 0x20000000));
+	CHECK (damaged (offsetof (FileHeader, indexOffset), 0xFFFFFFF0));
+	CHECK (damaged (header.indexOffset + offsetof (FrameEntry, offset), 0xFFFFFFF0));
+	CHECK (damaged (header.indexOffset + offsetof (FrameEntry, size), 0xFFFFFFF0));
+
+	// a harmless change still replays
+	CHECK (!damaged (cmds + offsetof (Command, texture), 0xFFFFFFFF));
+}
+}
+
+int main ()
+{
+	test::createContext ();
+	s_path = (std::filesystem::temp_directory_path () / "imgui_capture_test.imcp").string ();
+
+	roundTrip ();
+	truncated ();
+	corrupted ();
+
+	std::remove (s_path.c_str ());
+	ImGui::DestroyContext ();
+}
@@ -0,0 +1,164 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+
+// Detached draw lists filled by other threads: they are spliced into the window in order, and
+// what their growth allocates is still counted by the allocator debug counters.
+
+#include "test.h"
+
+#include "imgui/imgui_internal.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace
+{
+#ifdef IMGUI_ENABLE_DETACHED_DRAWLISTS
+/// \brief Allocations made through ImGui
+std::atomic<int> s_allocs = 0;
+/// \brief Frees made through ImGui
+std::atomic<int> s_frees = 0;
+
+/// \brief Counting allocator
+void *countingAlloc (std::size_t const size_, void *)
+{
+	s_allocs.fetch_add (1, std::memory_order_relaxed);
+	return std::malloc (size_);
+}
+
+/// \brief Counting free
+void countingFree (void *const ptr_, void *)
+{
+	if (ptr_)
+		s_frees.fetch_add (1, std::memory_order_relaxed);
+	std::free (ptr_);
+}
+
+/// \brief Lists filled by worker threads
+constexpr int WORKERS = 4;
+
+/// \brief Draw enough lines that a fresh list has to grow several times
+/// \param list_ Detached list
+void fill (ImDrawList *const list_)
+{
+	for (int i = 0; i < 2000; ++i)
+		list_->AddLine (ImVec2 (i % 400, 0.0f), ImVec2 (i % 400, 100.0f), IM_COL32_WHITE, 2.0f);
+}
+
+/// \brief Run a frame splicing lists filled by worker threads between two widgets
+/// \param lists_ Detached lists
+void frame (std::vector<ImDrawList> &lists_)
+{
+	ImGui::NewFrame ();
+	ImGui::SetNextWindowPos (ImVec2 (0.0f, 0.0f));
+	ImGui::SetNextWindowSize (ImVec2 (400.0f, 240.0f));
+	ImGui::Begin ("Canvas");
+	ImGui::Text ("Before");
+
+	std::vector<std::thread> workers;
+	for (auto &list : lists_)
+	{
+		ImGui::AddDetachedDrawList (&list);
+		workers.emplace_back (&fill, &list);
+		ImGui::Text ("Between");
+	}
+
+	ImGui::End ();
+	for (auto &worker : workers)
+		worker.join ();
+	ImGui::Render ();
+}
+
+/// \brief Detached lists are drawn in order between the parts of their window
+void spliceOrder ()
+{
+	std::vector<ImDrawList> lists (WORKERS, ImDrawList (ImGui::GetDrawListSharedData ()));
+	for (int i = 0; i < 2; ++i)
+		frame (lists);
+
+	auto const window   = ImGui::FindWindowByName ("Canvas");
+	auto const drawData = ImGui::GetDrawData ();
+	auto const it =
+	    std::find (drawData->CmdLists.begin (), drawData->CmdLists.end (), &window->DrawListInst);
+	CHECK (it != drawData->CmdLists.end ());
+
+	// the window's first part, then each detached list followed by the window's continuation
+	auto const first = drawData->CmdLists.index_from_ptr (it);
+	CHECK (first + 2 * WORKERS < drawData->CmdLists.Size);
+	for (int i = 0; i < WORKERS; ++i)
+	{
+		CHECK (drawData->CmdLists[first + 1 + 2 * i] == &lists[i]);
+		CHECK (drawData->CmdLists[first + 2 + 2 * i] == window->DrawListsContinued[i]);
+		CHECK (lists[i].VtxBuffer.Size > 0);
+	}
+}
+
+/// \brief Growth of detached lists on worker threads is counted by the next NewFrame
+void allocCounts ()
+{
+	auto const &info = GImGui->DebugAllocInfo;
+
+	std::vector<ImDrawList> lists (WORKERS, ImDrawList (ImGui::GetDrawListSharedData ()));
+	for (int i = 0; i < 2; ++i)
+		frame (lists);
+
+	auto const allocs       = s_allocs.load ();
+	auto const frees        = s_frees.load ();
+	auto const countedAlloc = info.TotalAllocCount;
+	auto const countedFree  = info.TotalFreeCount;
+
+	// fresh lists grow on the workers
+	std::vector<ImDrawList> fresh (WORKERS, ImDrawList (ImGui::GetDrawListSharedData ()));
+	frame (fresh);
+	ImGui::NewFrame ();
+	ImGui::EndFrame ();
+
+	CHECK (s_allocs - allocs > 0);
+	CHECK (info.TotalAllocCount - countedAlloc == s_allocs - allocs);
+	CHECK (info.TotalFreeCount - countedFree == s_frees - frees);
+
+	// the worker allocations are counted in the frame they were made in
+	auto const &entry = info.LastEntriesBuf[info.LastEntriesIdx];
+	CHECK (entry.FrameCount == ImGui::GetFrameCount () - 1);
+}
+#endif
+}
+
+int main ()
+{
+#ifdef IMGUI_ENABLE_DETACHED_DRAWLISTS
+	ImGui::SetAllocatorFunctions (&countingAlloc, &countingFree);
+#endif
+	test::createContext ();
+
+#ifdef IMGUI_ENABLE_DETACHED_DRAWLISTS
+	spliceOrder ();
+	allocCounts ();
+#endif
+
+	ImGui::DestroyContext ();
+}
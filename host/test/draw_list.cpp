@@ -0,0 +1,129 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+// Draw list growth accounting: every reallocation of the output buffers is counted, and a steady
+// frame with capacity prediction reallocates nothing.
+
+#include "test.h"
+
+#include "imgui/imgui_internal.h"
+
+namespace
+{
+#ifdef IMGUI_ENABLE_DRAWLIST_CAPACITY_PREDICTION
+/// \brief Start a draw list over the whole display
+void reset (ImDrawList &list_)
+{
+	list_._ResetForNewFrame ();
+	list_.PushClipRectFullScreen ();
+	list_.PushTextureID (ImGui::GetIO ().Fonts->TexID);
+}
+
+/// \brief Draw some rectangles
+void rects (ImDrawList &list_, int const count_)
+{
+	for (int i = 0; i < count_; ++i)
+		list_.AddRectFilled (ImVec2 (i, 0.0f), ImVec2 (i + 1.0f, 1.0f), IM_COL32_WHITE);
+}
+
+/// \brief Merging channels into a list whose buffers are too small counts the growth
+void splitterMerge ()
+{
+	ImDrawList list (ImGui::GetDrawListSharedData ());
+	reset (list);
+	list.CmdBuffer.reserve (64);
+	list.IdxBuffer.reserve (64);
+	list.VtxBuffer.reserve (64);
+
+	list.ChannelsSplit (2);
+	list.ChannelsSetCurrent (1);
+	rects (list, 100);
+	list.ChannelsSetCurrent (0);
+	rects (list, 1);
+
+	// channel 1 grew while it was current; merging appends it to the list's own buffers
+	CHECK (list._GrowCount > 0);
+	auto const before = list._GrowCount;
+	CHECK (list.IdxBuffer.Size + 600 > list.IdxBuffer.Capacity);
+
+	list.ChannelsMerge ();
+	CHECK (list.IdxBuffer.Size == 101 * 6);
+	CHECK (list._GrowCount == before + 1);
+}
+
+/// \brief Callback user data copied into the list counts its growth
+void callbackData ()
+{
+	ImDrawList list (ImGui::GetDrawListSharedData ());
+	reset (list);
+	list.CmdBuffer.reserve (16);
+	CHECK (list._GrowCount == 0);
+
+	char data[64] = {};
+	list.AddCallback ([] (ImDrawList const *, ImDrawCmd const *) {}, data, sizeof (data));
+	CHECK (list._GrowCount == 1);
+
+	// fits in what the previous callback allocated
+	list._CallbacksDataBuf.reserve (256);
+	list.AddCallback ([] (ImDrawList const *, ImDrawCmd const *) {}, data, sizeof (data));
+	CHECK (list._GrowCount == 1);
+}
+
+/// \brief Frames that repeat the previous frame's output reallocate nothing
+void steadyFrames ()
+{
+	auto &io  = ImGui::GetIO ();
+	int grown = 0;
+	for (int frame = 0; frame < 8; ++frame)
+	{
+		ImGui::NewFrame ();
+		ImGui::Begin ("Window");
+		for (int i = 0; i < 50; ++i)
+			ImGui::Text ("line %d", i);
+		ImGui::End ();
+		ImGui::Render ();
+
+		// the window only shows up on its second frame, once it has been sized
+		if (frame < 2)
+			grown += io.MetricsRenderReallocations;
+		else if (frame > 2)
+			CHECK (io.MetricsRenderReallocations == 0);
+	}
+	CHECK (grown > 0);
+}
+#endif
+}
+
+int main ()
+{
+	test::createContext ();
+
+#ifdef IMGUI_ENABLE_DRAWLIST_CAPACITY_PREDICTION
+	splitterMerge ();
+	callbackData ();
+	steadyFrames ();
+#endif
+
+	ImGui::DestroyContext ();
+}
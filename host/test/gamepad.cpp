@@ -0,0 +1,153 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Gamepad input replay through the 3DS platform backend against stubbed HID: idle frames send
+// nothing, buttons sharing a key keep it down, the circle pad matches the original response,
+// remaps release the old key and profiles round trip through the settings.
+
+#include "test.h"
+
+#include "3ds/imgui_ctru.h"
+#include "stub.h"
+
+#include "imgui/imgui_internal.h"
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+namespace
+{
+/// \brief Scan stubbed HID and run one frame
+/// \returns Number of key events the backend queued
+int frame ()
+{
+	hidScanInput ();
+	imgui::ctru::newFrame ();
+
+	auto const &queue = GImGui->InputEventsQueue;
+	auto const events = std::count_if (queue.begin (), queue.end (), [] (auto const &event_) {
+		return event_.Type == ImGuiInputEventType_Key;
+	});
+
+	ImGui::NewFrame ();
+	ImGui::EndFrame ();
+	return events;
+}
+
+/// \brief Circle pad response before input profiles: linear between 30% and 90% travel
+/// \param travel_ Circle pad position
+/// \param min_ Travel reading as zero
+/// \param max_ Travel reading as one
+float originalResponse (float const travel_, float const min_, float const max_)
+{
+	return std::clamp ((travel_ / 156.0f - min_) / (max_ - min_), 0.0f, 1.0f);
+}
+
+/// \brief Analog value of a key
+float analog (ImGuiKey const key_)
+{
+	return ImGui::GetKeyData (key_)->AnalogValue;
+}
+}
+
+int main ()
+{
+	test::createContext ();
+	CHECK (imgui::ctru::init ());
+	frame ();
+
+	// idle: nothing is sent
+	for (int i = 0; i < 10; ++i)
+		CHECK (frame () == 0);
+
+	// a press sends one event, holding it sends nothing more
+	stub::held = KEY_A;
+	CHECK (frame () == 1);
+	CHECK (ImGui::IsKeyDown (ImGuiKey_GamepadFaceDown));
+	CHECK (frame () == 0);
+
+	// L and ZL share L1: it stays down until both are released
+	stub::held = KEY_A | KEY_L;
+	CHECK (frame () == 1);
+	stub::held = KEY_A | KEY_L | KEY_ZL;
+	CHECK (frame () == 0);
+	stub::held = KEY_A | KEY_ZL;
+	CHECK (frame () == 0);
+	CHECK (ImGui::IsKeyDown (ImGuiKey_GamepadL1));
+	stub::held = 0;
+	CHECK (frame () == 2);
+	CHECK (!ImGui::IsKeyDown (ImGuiKey_GamepadL1));
+
+	// the default profile keeps the original circle pad response across the full range
+	for (int dx = -156; dx <= 156; dx += 13)
+	{
+		stub::circlePad = {static_cast<s16> (dx), static_cast<s16> (-dx / 2)};
+		frame ();
+		frame ();
+
+		auto const pad = stub::circlePad;
+		CHECK (std::fabs (analog (ImGuiKey_GamepadLStickLeft) - originalResponse (pad.dx, -0.3f, -0.9f)) < 1e-5f);
+		CHECK (std::fabs (analog (ImGuiKey_GamepadLStickRight) - originalResponse (pad.dx, 0.3f, 0.9f)) < 1e-5f);
+		CHECK (std::fabs (analog (ImGuiKey_GamepadLStickUp) - originalResponse (pad.dy, 0.3f, 0.9f)) < 1e-5f);
+		CHECK (std::fabs (analog (ImGuiKey_GamepadLStickDown) - originalResponse (pad.dy, -0.3f, -0.9f)) < 1e-5f);
+	}
+
+	// a circle pad held still sends nothing
+	stub::circlePad = {100, 0};
+	frame ();
+	CHECK (frame () == 0);
+
+	// remapping a held button releases its old key; deadzone and curve apply to the circle pad
+	stub::held = KEY_A;
+	frame ();
+	auto &profile      = imgui::ctru::inputProfile ();
+	profile.buttons[0] = ImGuiKey_GamepadStart;
+	profile.deadzone   = 0.1f;
+	profile.curve      = 2.0f;
+	frame ();
+	frame ();
+	CHECK (!ImGui::IsKeyDown (ImGuiKey_GamepadFaceDown));
+	CHECK (ImGui::IsKeyDown (ImGuiKey_GamepadStart));
+	auto const travel = (100 / 156.0f - 0.1f) / 0.8f;
+	CHECK (std::fabs (analog (ImGuiKey_GamepadLStickRight) - travel * travel) < 1e-5f);
+
+	// profiles round trip through the settings, as only the entries which differ
+	imgui::ctru::setInputProfile ("Left");
+	imgui::ctru::inputProfile ().deadzone = 0.25f;
+
+	std::string const ini = ImGui::SaveIniSettingsToMemory ();
+	CHECK (ini.find ("[3DSInput][Left]\nActive=1\nDeadzone=0.25\n") != std::string::npos);
+	CHECK (ini.find ("Saturation=") == std::string::npos);
+
+	ImGui::ClearIniSettings ();
+	CHECK (imgui::ctru::inputProfile ().deadzone == 0.3f);
+
+	ImGui::LoadIniSettingsFromMemory (ini.c_str ());
+	CHECK (imgui::ctru::inputProfile ().deadzone == 0.25f);
+	imgui::ctru::setInputProfile ("Default");
+	CHECK (imgui::ctru::inputProfile ().buttons[0] == ImGuiKey_GamepadStart);
+	CHECK (imgui::ctru::inputProfile ().curve == 2.0f);
+
+	ImGui::DestroyContext ();
+}
@@ -0,0 +1,189 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Hovered window lookup: with IMGUI_ENABLE_HOVER_GRID, FindHoveredWindowEx() must return the same
+// windows as the linear scan over g.Windows while windows move, resize, appear and get refocused.
+
+#define IMGUI_DEFINE_MATH_OPERATORS
+#include "test.h"
+
+#include "imgui/imgui_internal.h"
+
+#include <cstdio>
+#include <random>
+
+namespace
+{
+/// \brief Random number source, seeded so failures reproduce
+std::mt19937 s_rng (1234);
+
+/// \brief Random float in [min_, max_)
+float random (float const min_, float const max_)
+{
+	return std::uniform_real_distribution<float> (min_, max_) (s_rng);
+}
+
+/// \brief Random integer in [0, max_)
+int random (int const max_)
+{
+	return std::uniform_int_distribution<int> (0, max_ - 1) (s_rng);
+}
+
+/// \brief Reference lookup: the linear scan FindHoveredWindowEx() does without the grid
+/// \param pos_ Position to test
+/// \param hovered_ Output hovered window
+/// \param hoveredUnderMoving_ Output hovered window ignoring the moving window
+void linearScan (ImVec2 const &pos_, ImGuiWindow **hovered_, ImGuiWindow **hoveredUnderMoving_)
+{
+	auto &g = *GImGui;
+
+	ImGuiWindow *hovered            = nullptr;
+	ImGuiWindow *hoveredUnderMoving = nullptr;
+	if (g.MovingWindow && !(g.MovingWindow->Flags & ImGuiWindowFlags_NoMouseInputs))
+		hovered = g.MovingWindow;
+
+	auto const paddingRegular = g.Style.TouchExtraPadding;
+	auto const paddingForResize =
+	    g.IO.ConfigWindowsResizeFromEdges ? g.WindowsHoverPadding : paddingRegular;
+
+	for (int i = g.Windows.Size - 1; i >= 0; --i)
+	{
+		auto const window = g.Windows[i];
+		if (!window->WasActive || window->Hidden)
+			continue;
+		if (window->Flags & ImGuiWindowFlags_NoMouseInputs)
+			continue;
+
+		auto const padding =
+		    (window->Flags & (ImGuiWindowFlags_NoResize | ImGuiWindowFlags_AlwaysAutoResize))
+		        ? paddingRegular
+		        : paddingForResize;
+		if (!window->OuterRectClipped.ContainsWithPad (pos_, padding))
+			continue;
+
+		if (window->HitTestHoleSize.x != 0)
+		{
+			auto const holePos = ImVec2 (window->Pos.x + window->HitTestHoleOffset.x,
+			    window->Pos.y + window->HitTestHoleOffset.y);
+			auto const holeSize = ImVec2 (window->HitTestHoleSize.x, window->HitTestHoleSize.y);
+			if (ImRect (holePos, holePos + holeSize).Contains (pos_))
+				continue;
+		}
+
+		if (!hovered)
+			hovered = window;
+		if (!hoveredUnderMoving &&
+		    (!g.MovingWindow || window->RootWindow != g.MovingWindow->RootWindow))
+			hoveredUnderMoving = window;
+		if (hovered && hoveredUnderMoving)
+			break;
+	}
+
+	*hovered_            = hovered;
+	*hoveredUnderMoving_ = hoveredUnderMoving;
+}
+
+/// \brief Submit one frame of randomly moving, resizing and refocused windows with children
+/// \param frame_ Frame number
+void submitFrame (int const frame_)
+{
+	auto &io = ImGui::GetIO ();
+
+	io.ConfigWindowsResizeFromEdges     = (frame_ / 50) % 2;
+	ImGui::GetStyle ().TouchExtraPadding = ImVec2 ((frame_ / 100) % 2 ? 6.0f : 0.0f, 0.0f);
+	io.AddMousePosEvent (random (-20.0f, 820.0f), random (-20.0f, 500.0f));
+	io.AddMouseButtonEvent (0, random (8) == 0);
+
+	ImGui::NewFrame ();
+
+	auto const windows = 20 + frame_ % 7;
+	for (int i = 0; i < windows; ++i)
+	{
+		char name[16];
+		std::snprintf (name, sizeof (name), "W%d", i);
+
+		if (random (10) == 0)
+			ImGui::SetNextWindowPos (ImVec2 (random (-100.0f, 750.0f), random (-100.0f, 450.0f)));
+		if (random (10) == 0)
+			ImGui::SetNextWindowSize (ImVec2 (random (10.0f, 300.0f), random (10.0f, 300.0f)));
+		if (random (30) == 0)
+			ImGui::SetNextWindowFocus ();
+
+		// some windows come and go
+		if ((i + frame_ / 40) % 9 == 0)
+			continue;
+
+		auto const flags = (i % 5 == 0) ? ImGuiWindowFlags_NoResize
+		                   : (i % 7 == 0) ? ImGuiWindowFlags_NoMouseInputs
+		                                  : ImGuiWindowFlags_None;
+		ImGui::Begin (name, nullptr, flags);
+		for (int c = 0; c < 6; ++c)
+		{
+			ImGui::PushID (c);
+			ImGui::BeginChild ("child", ImVec2 (random (20.0f, 120.0f), 40.0f), ImGuiChildFlags_Borders);
+			ImGui::TextUnformatted ("x");
+			ImGui::EndChild ();
+			ImGui::PopID ();
+			if (c % 2 == 0)
+				ImGui::SameLine ();
+		}
+		if (i == 3)
+			ImGui::SetWindowHitTestHole (
+			    ImGui::GetCurrentWindow (), ImGui::GetWindowPos () + ImVec2 (10.0f, 30.0f), ImVec2 (40.0f, 40.0f));
+		ImGui::End ();
+	}
+
+	if (frame_ % 13 == 0)
+		ImGui::SetTooltip ("tip");
+
+	ImGui::Render ();
+}
+}
+
+int main ()
+{
+	test::createContext (ImVec2 (800.0f, 480.0f));
+
+	for (int frame = 0; frame < 400; ++frame)
+	{
+		submitFrame (frame);
+
+		for (int i = 0; i < 500; ++i)
+		{
+			auto const pos = ImVec2 (random (-30.0f, 830.0f), random (-30.0f, 510.0f));
+
+			ImGuiWindow *hovered;
+			ImGuiWindow *hoveredUnderMoving;
+			ImGui::FindHoveredWindowEx (pos, false, &hovered, &hoveredUnderMoving);
+
+			ImGuiWindow *expected;
+			ImGuiWindow *expectedUnderMoving;
+			linearScan (pos, &expected, &expectedUnderMoving);
+
+			CHECK (hovered == expected);
+			CHECK (hoveredUnderMoving == expectedUnderMoving);
+		}
+	}
+
+	ImGui::DestroyContext ();
+}
@@ -0,0 +1,140 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Input event queue: coalescing must never change which frame an input lands in.
+
+#include "test.h"
+
+#include "imgui/imgui_internal.h"
+
+namespace
+{
+/// \brief Run one frame; returns the pointer position the frame saw
+ImVec2 frame ()
+{
+	ImGui::NewFrame ();
+	auto const pos = ImGui::GetIO ().MousePos;
+	ImGui::EndFrame ();
+	return pos;
+}
+
+/// \brief A key press queued between two mouse moves keeps them in separate frames
+void moveAcrossKeyPress ()
+{
+	auto &io = ImGui::GetIO ();
+	io.AddMousePosEvent (10.0f, 10.0f);
+	io.AddKeyEvent (ImGuiKey_A, true);
+	io.AddMousePosEvent (20.0f, 20.0f);
+	CHECK (ImGui::GetCurrentContext ()->InputEventsQueue.Size == 3);
+
+	auto pos = frame ();
+	CHECK (pos.x == 10.0f && pos.y == 10.0f);
+	CHECK (ImGui::IsKeyDown (ImGuiKey_A));
+
+	pos = frame ();
+	CHECK (pos.x == 20.0f && pos.y == 20.0f);
+	CHECK (ImGui::IsKeyDown (ImGuiKey_A));
+
+	io.AddKeyEvent (ImGuiKey_A, false);
+	frame ();
+}
+
+#ifdef IMGUI_ENABLE_INPUT_COALESCING
+/// \brief Analog-only key changes don't split frames, so mouse moves still merge across them
+void moveAcrossAnalog ()
+{
+	auto &io = ImGui::GetIO ();
+	io.AddMousePosEvent (30.0f, 30.0f);
+	io.AddKeyAnalogEvent (ImGuiKey_GamepadLStickLeft, false, 0.1f);
+	io.AddMousePosEvent (40.0f, 40.0f);
+	io.AddKeyAnalogEvent (ImGuiKey_GamepadLStickLeft, false, 0.2f);
+	CHECK (ImGui::GetCurrentContext ()->InputEventsQueue.Size == 2);
+
+	auto const pos = frame ();
+	CHECK (pos.x == 40.0f && pos.y == 40.0f);
+	CHECK (ImGui::GetKeyData (ImGuiKey_GamepadLStickLeft)->AnalogValue == 0.2f);
+}
+#endif
+
+/// \brief A key release also splits, even when the key was pressed in an earlier frame
+void moveAcrossKeyRelease ()
+{
+	auto &io = ImGui::GetIO ();
+	io.AddKeyEvent (ImGuiKey_B, true);
+	frame ();
+
+	io.AddMousePosEvent (50.0f, 50.0f);
+	io.AddKeyEvent (ImGuiKey_B, false);
+	io.AddMousePosEvent (60.0f, 60.0f);
+	CHECK (ImGui::GetCurrentContext ()->InputEventsQueue.Size == 3);
+
+	auto pos = frame ();
+	CHECK (pos.x == 50.0f && pos.y == 50.0f);
+	CHECK (!ImGui::IsKeyDown (ImGuiKey_B));
+
+	pos = frame ();
+	CHECK (pos.x == 60.0f && pos.y == 60.0f);
+}
+
+/// \brief Mouse moves never merge across a focus change
+void moveAcrossFocus ()
+{
+	auto &io = ImGui::GetIO ();
+	io.AddMousePosEvent (70.0f, 70.0f);
+	io.AddFocusEvent (false);
+	io.AddMousePosEvent (80.0f, 80.0f);
+	io.AddFocusEvent (true);
+	CHECK (ImGui::GetCurrentContext ()->InputEventsQueue.Size == 4);
+	frame ();
+}
+
+#ifdef IMGUI_ENABLE_INPUT_COALESCING
+/// \brief Consecutive mouse moves collapse into the last one
+void consecutiveMoves ()
+{
+	auto &io = ImGui::GetIO ();
+	for (int i = 0; i < 10; ++i)
+		io.AddMousePosEvent (100.0f + i, 100.0f);
+	CHECK (ImGui::GetCurrentContext ()->InputEventsQueue.Size == 1);
+
+	auto const pos = frame ();
+	CHECK (pos.x == 109.0f && pos.y == 100.0f);
+}
+#endif
+}
+
+int main ()
+{
+	test::createContext ();
+	ImGui::GetIO ().BackendFlags |= ImGuiBackendFlags_HasGamepad;
+
+#ifdef IMGUI_ENABLE_INPUT_COALESCING
+	moveAcrossAnalog ();
+	consecutiveMoves ();
+#endif
+	moveAcrossKeyPress ();
+	moveAcrossKeyRelease ();
+	moveAcrossFocus ();
+
+	ImGui::DestroyContext ();
+}
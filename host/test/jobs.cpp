@@ -0,0 +1,91 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+// Job pool: parallelFor visits every index once and jobs::sort sorts, with any number of workers,
+// including restarting the pool between runs as the benchmark's scaling scenes do.
+
+#include "test.h"
+
+#include "3ds/jobs.h"
+
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <random>
+#include <vector>
+
+namespace
+{
+/// \brief Every index is visited exactly once, also from nested groups
+void parallelForOnce ()
+{
+	std::vector<std::atomic<unsigned>> visits (10000);
+	jobs::parallelFor (0, 100, 1, [&] (std::size_t const begin_, std::size_t const end_) {
+		for (auto i = begin_; i < end_; ++i)
+		{
+			jobs::parallelFor (
+			    i * 100, (i + 1) * 100, 8, [&] (std::size_t const b_, std::size_t const e_) {
+				    for (auto j = b_; j < e_; ++j)
+					    ++visits[j];
+			    });
+		}
+	});
+
+	for (auto const &count : visits)
+		CHECK (count == 1);
+}
+
+/// \brief jobs::sort agrees with std::sort, duplicates included
+void sortMatches ()
+{
+	std::mt19937 random (1234);
+	for (std::size_t const size : {0, 1, 1000, 1023, 1024, 4097, 100000})
+	{
+		std::vector<unsigned> data (size);
+		for (auto &value : data)
+			value = random () % (size / 2 + 1);
+
+		auto expected = data;
+		std::sort (std::begin (expected), std::end (expected), std::greater<> ());
+
+		jobs::sort (std::begin (data), std::end (data), std::greater<> ());
+		CHECK (data == expected);
+	}
+}
+}
+
+int main ()
+{
+	for (unsigned workers = 0; workers <= 4; ++workers)
+	{
+		if (workers)
+			CHECK (jobs::init (workers));
+		CHECK (jobs::workerCount () == workers);
+
+		parallelForOnce ();
+		sortMatches ();
+
+		jobs::exit ();
+	}
+}
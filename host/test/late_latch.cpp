@@ -0,0 +1,228 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+
+// Touch drag replay through the 3DS platform backend and the citro3d backend against the stubs:
+// with late latching, whatever follows the touch is drawn at the touch sample published after the
+// frame was built, not the one the frame was built from.
+
+#include "test.h"
+
+#include "3ds/imgui_citro3d.h"
+#include "3ds/imgui_ctru.h"
+#include "stub.h"
+
+#include <algorithm>
+#include <cfloat>
+#include <vector>
+
+namespace
+{
+/// \brief Top screen render target
+C3D_RenderTarget s_top{GFX_TOP, GFX_LEFT};
+/// \brief Bottom screen render target
+C3D_RenderTarget s_bottom{GFX_BOTTOM, GFX_LEFT};
+
+/// \brief Touch movement per frame (pixels)
+constexpr u16 STEP = 3;
+
+/// \brief Run one frame: build it from the latched touch, then publish the next touch sample
+/// before rendering, as the HID module does while the CPU is busy
+/// \param touch_ Touch position the frame is built from
+/// \param latest_ Touch position published before rendering
+/// \param lateLatch_ Whether to late-latch the touch
+/// \param draw_ Called between NewFrame and Render to submit the frame's contents
+template <typename F>
+void frame (touchPosition const &touch_, touchPosition const &latest_, bool const lateLatch_, F &&draw_)
+{
+	stub::held  = KEY_TOUCH;
+	stub::touch = touch_;
+	hidScanInput ();
+	imgui::ctru::newFrame ();
+
+	ImGui::NewFrame ();
+	draw_ ();
+	ImGui::Render ();
+
+	stub::setLatestTouch (latest_, true);
+
+	C3D_FrameBegin (0);
+	ImVec2 latch;
+	if (lateLatch_ && imgui::ctru::lateLatchTouch (latch))
+		imgui::citro3d::setLateLatch (latch);
+	imgui::citro3d::render (&s_top, &s_bottom);
+	C3D_FrameEnd (0);
+}
+
+/// \brief Release the touch and run an empty frame, so windows appear again on the next drag
+void release ()
+{
+	stub::held = 0;
+	hidScanInput ();
+	imgui::ctru::newFrame ();
+	ImGui::NewFrame ();
+	ImGui::Render ();
+	imgui::citro3d::render (&s_top, &s_bottom);
+}
+
+/// \brief Leftmost vertex drawn on the bottom screen
+float drawnLeft ()
+{
+	auto left = FLT_MAX;
+	for (auto const &draw : stub::draws)
+	{
+		if (draw.target != &s_bottom)
+			continue;
+
+		auto const vertices = static_cast<ImDrawVert const *> (draw.vertices);
+		for (int i = 0; i < draw.count; ++i)
+			left = std::min (left, vertices[draw.indices[i]].pos.x);
+	}
+
+	CHECK (left != FLT_MAX);
+	return left;
+}
+
+/// \brief Drag a touch to the right and measure where the dragged content is drawn relative to
+/// the latest touch sample
+/// \param start_ Touch position the drag starts at
+/// \param lateLatch_ Whether to late-latch the touch
+/// \param draw_ Frame contents
+/// \returns Drawn position minus latest touch position, for every frame of the drag
+template <typename F>
+std::vector<float> drag (touchPosition start_, bool const lateLatch_, F &&draw_)
+{
+	// press and hold still until ImGui has taken the press
+	for (int i = 0; i < 3; ++i)
+		frame (start_, start_, lateLatch_, draw_);
+
+	std::vector<float> offsets;
+	for (int i = 0; i < 10; ++i)
+	{
+		auto const touch  = start_;
+		auto const latest = touchPosition{static_cast<u16> (touch.px + STEP), touch.py};
+		frame (touch, latest, lateLatch_, draw_);
+
+		offsets.emplace_back (drawnLeft () - latest.px);
+		start_ = latest;
+	}
+
+	release ();
+	return offsets;
+}
+
+/// \brief A window on the bottom screen that is dragged by its title bar
+void dragWindow ()
+{
+	ImGui::SetNextWindowPos (ImVec2 (80.0f, 300.0f), ImGuiCond_Appearing);
+	ImGui::SetNextWindowSize (ImVec2 (100.0f, 60.0f), ImGuiCond_Appearing);
+	ImGui::Begin ("Drag");
+	ImGui::End ();
+}
+
+/// \brief An undecorated, transparent window holding a button that shows a tooltip while held, so
+/// the tooltip is all that is drawn
+void heldTooltip ()
+{
+	ImGui::SetNextWindowPos (ImVec2 (40.0f, 240.0f));
+	ImGui::SetNextWindowSize (ImVec2 (320.0f, 240.0f));
+	ImGui::Begin ("Tooltip", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoBackground);
+	ImGui::InvisibleButton ("Button", ImVec2 (320.0f, 240.0f));
+	if (ImGui::IsItemActive ())
+		ImGui::SetTooltip ("Held");
+	ImGui::End ();
+}
+
+/// \brief Whether every offset is the same
+bool constant (std::vector<float> const &offsets_)
+{
+	return std::all_of (std::begin (offsets_), std::end (offsets_), [&] (float const offset_) {
+		return offset_ == offsets_.front ();
+	});
+}
+
+/// \brief Content following the touch is drawn with no lag behind the latest touch sample when
+/// late-latched, and one frame of touch movement behind without
+/// \param draw_ Frame contents
+/// \param start_ Touch position the drag starts at
+template <typename F>
+void latency (F &&draw_, touchPosition const &start_)
+{
+	auto const latched = drag (start_, true, draw_);
+	CHECK (constant (latched));
+
+	auto const unlatched = drag (start_, false, draw_);
+	CHECK (constant (unlatched));
+
+	// without late latching the content trails the latest touch by the frame's touch movement
+	CHECK (unlatched.front () == latched.front () - STEP);
+}
+
+/// \brief A touch ring whose latest index is out of range falls back to the latched sample, so
+/// nothing moves, rather than reading a stale entry
+void unknownLayout ()
+{
+	auto const touch = touchPosition{100, 100};
+	stub::held       = KEY_TOUCH;
+	stub::touch      = touch;
+	hidScanInput ();
+	imgui::ctru::newFrame ();
+
+	stub::setLatestTouch (touchPosition{120, 110}, true);
+	hidSharedMem[42 + 4] = 8;
+
+	ImVec2 latch;
+	CHECK (imgui::ctru::lateLatchTouch (latch));
+	CHECK (latch.x == 0.0f && latch.y == 0.0f);
+
+	// in range again, the latest sample is read
+	hidSharedMem[42 + 4] = 0;
+	CHECK (imgui::ctru::lateLatchTouch (latch));
+	CHECK (latch.x == 20.0f && latch.y == 10.0f);
+
+	stub::held = 0;
+	hidScanInput ();
+	imgui::ctru::newFrame ();
+}
+}
+
+int main ()
+{
+	C3D_Init (C3D_DEFAULT_CMDBUF_SIZE);
+	test::createContext ();
+	CHECK (imgui::ctru::init ());
+	imgui::citro3d::init ();
+
+	// touch the title bar, 20px right of the window's left edge
+	latency (&dragWindow, touchPosition{60, 65});
+
+	// touch the middle of the bottom screen
+	latency (&heldTooltip, touchPosition{160, 120});
+
+	unknownLayout ();
+
+	imgui::citro3d::exit ();
+	ImGui::DestroyContext ();
+	C3D_Fini ();
+}
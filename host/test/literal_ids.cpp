@@ -0,0 +1,135 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+
+// Literal IDs: ImHashLiteral() matches ImHashStr() for every shape of label, including "###"
+// corner cases and hashed parts around the direct hash limit, and literal widget overloads produce
+// the same IDs as the string ones. Built twice: with the CRC32c table and with the legacy one.
+
+#include "test.h"
+
+#include "imgui/imgui_internal.h"
+
+#include <cstring>
+
+namespace
+{
+#ifdef IMGUI_ENABLE_LITERAL_IDS
+/// \brief Seeds to hash under
+constexpr ImGuiID SEEDS[] = {0, 1, 0x12345678, 0x80000000, 0xFFFFFFFF};
+
+/// \brief Check a literal hashes like its string under every seed
+/// \param literal_ Literal
+/// \param hashed_ Expected hashed part
+void check (ImGuiLiteral const &literal_, char const *const hashed_)
+{
+	CHECK (std::strcmp (literal_.HashStr, hashed_) == 0);
+	CHECK (literal_.HashLen == std::strlen (hashed_));
+
+	for (auto const seed : SEEDS)
+	{
+		CHECK (ImHashLiteral (literal_, seed) == ImHashStr (literal_.Str, 0, seed));
+		CHECK (ImHashLiteral (literal_, seed) ==
+		       ImHashStr (literal_.Str, std::strlen (literal_.Str), seed));
+	}
+}
+
+/// \brief Hashes of labels of every shape
+void hashes ()
+{
+	// the build's table: CRC32 of "a" is 0xE8B7BE43, CRC32c is 0xC1D04330
+#ifdef IMGUI_USE_LEGACY_CRC32_ADLER
+	CHECK (ImHashStr ("a", 0, 0) == 0xE8B7BE43);
+#else
+	CHECK (ImHashStr ("a", 0, 0) == 0xC1D04330);
+#endif
+
+	check (ImGuiLiteral (""), "");
+	check (ImGuiLiteral ("#"), "#");
+	check (ImGuiLiteral ("##"), "##");
+	check (ImGuiLiteral ("###"), "###");
+	check (ImGuiLiteral ("####"), "###");
+	check (ImGuiLiteral ("#####"), "###");
+	check (ImGuiLiteral ("Save"), "Save");
+	check (ImGuiLiteral ("Save##hidden"), "Save##hidden");
+	check (ImGuiLiteral ("Save###id"), "###id");
+	check (ImGuiLiteral ("a###b###c"), "###c");
+	check (ImGuiLiteral ("###a###"), "###");
+	check (ImGuiLiteral ("label###"), "###");
+
+	// hashed parts of 31, 32 and 33 bytes straddle the direct hash limit
+	check (ImGuiLiteral ("0123456789012345678901234567890"), "0123456789012345678901234567890");
+	check (ImGuiLiteral ("01234567890123456789012345678901"), "01234567890123456789012345678901");
+	check (ImGuiLiteral ("012345678901234567890123456789012"), "012345678901234567890123456789012");
+	check (ImGuiLiteral ("label###0123456789012345678901234567"), "###0123456789012345678901234567");
+	check (ImGuiLiteral ("label###01234567890123456789012345678"), "###01234567890123456789012345678");
+	check (ImGuiLiteral ("label###012345678901234567890123456789"),
+	    "###012345678901234567890123456789");
+	check (ImGuiLiteral ("A label long enough to take the multiply path, with a ## inside"),
+	    "A label long enough to take the multiply path, with a ## inside");
+}
+
+/// \brief Literal overloads give items the same IDs as string labels
+void widgets ()
+{
+	ImGui::NewFrame ();
+	ImGui::Begin ("Literals");
+
+	CHECK (ImGui::GetID (ImGuiLiteral ("Save")) == ImGui::GetID ("Save"));
+	CHECK (ImGui::GetID (ImGuiLiteral ("Restore defaults###restore")) == ImGui::GetID ("###restore"));
+
+	ImGui::PushID (ImGuiLiteral ("row"));
+	auto const literalId = ImGui::GetID ("item");
+	ImGui::PopID ();
+	ImGui::PushID ("row");
+	CHECK (ImGui::GetID ("item") == literalId);
+	ImGui::PopID ();
+
+	ImGui::Button (ImGuiLiteral ("Button"));
+	CHECK (ImGui::GetItemID () == ImGui::GetID ("Button"));
+	bool checked = false;
+	ImGui::Checkbox (ImGuiLiteral ("Checkbox##1"), &checked);
+	CHECK (ImGui::GetItemID () == ImGui::GetID ("Checkbox##1"));
+	ImGui::Selectable (ImGuiLiteral ("Selectable###selectable"));
+	CHECK (ImGui::GetItemID () == ImGui::GetID ("###selectable"));
+	ImGui::CollapsingHeader (ImGuiLiteral ("Header"));
+	CHECK (ImGui::GetItemID () == ImGui::GetID ("Header"));
+
+	ImGui::End ();
+	ImGui::Render ();
+}
+#endif
+}
+
+int main ()
+{
+#ifdef IMGUI_ENABLE_LITERAL_IDS
+	test::createContext ();
+
+	hashes ();
+	widgets ();
+
+	ImGui::DestroyContext ();
+#endif
+}
@@ -0,0 +1,188 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+
+// LogBuffer: producers on several threads and a reader racing them. Every line the reader gets
+// is one a producer wrote, whole; each producer's lines come back in order; and a full ring drops
+// its oldest lines.
+
+#include "test.h"
+
+#include "3ds/imgui_log.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace
+{
+/// \brief Producer threads
+constexpr unsigned PRODUCERS = 4;
+/// \brief Lines per producer
+constexpr unsigned LINES = 50000;
+
+/// \brief Line text: producer and sequence number, then a filler whose length and letter both
+/// depend on them, so a torn or mixed line doesn't parse back to itself
+/// \param producer_ Producer
+/// \param sequence_ Producer's line number
+std::string line (unsigned const producer_, unsigned const sequence_)
+{
+	char header[32];
+	std::snprintf (header, sizeof (header), "%u %u ", producer_, sequence_);
+	auto const filler = (sequence_ * 7 + producer_) % (imgui::LogBuffer::LINE_SIZE + 8);
+	return header + std::string (filler, char ('a' + (sequence_ + producer_) % 26));
+}
+
+/// \brief Parse and check a line read back
+/// \param text_ Line
+/// \param size_ Size of line
+/// \param producer_ Producer that wrote it
+/// \param sequence_ Producer's line number
+/// \returns Whether the line is exactly what the producer wrote (truncated to LINE_SIZE)
+bool parse (char const *const text_, int const size_, unsigned &producer_, unsigned &sequence_)
+{
+	std::string const text (text_, size_);
+	if (std::sscanf (text.c_str (), "%u %u ", &producer_, &sequence_) != 2 ||
+	    producer_ >= PRODUCERS || sequence_ >= LINES)
+		return false;
+
+	return text == line (producer_, sequence_).substr (0, imgui::LogBuffer::LINE_SIZE);
+}
+
+/// \brief A full ring keeps the newest lines; lines keep their index, and long lines are
+/// truncated with newlines read back as spaces
+void overwriteOldest ()
+{
+	imgui::LogBuffer log (5);
+	CHECK (log.capacity () == 8);
+	CHECK (log.begin () == 0 && log.end () == 0);
+
+	char out[imgui::LogBuffer::LINE_SIZE];
+	CHECK (log.read (0, out) < 0);
+
+	for (unsigned i = 0; i < 20; ++i)
+		CHECK (log.appendf ("line %u\nof 20", i) == i);
+
+	CHECK (log.begin () == 12 && log.end () == 20);
+	for (std::uint64_t i = 0; i < 12; ++i)
+		CHECK (log.read (i, out) < 0);
+	for (std::uint64_t i = 12; i < 20; ++i)
+	{
+		char expected[32];
+		auto const size = std::snprintf (expected, sizeof (expected), "line %u of 20", unsigned (i));
+		CHECK (log.read (i, out) == size);
+		CHECK (std::memcmp (out, expected, size) == 0);
+	}
+
+	std::string const longLine (imgui::LogBuffer::LINE_SIZE + 10, 'x');
+	auto const index = log.append (longLine.data (), longLine.size ());
+	CHECK (log.read (index, out) == int (imgui::LogBuffer::LINE_SIZE));
+	CHECK (log.begin () == 13);
+}
+
+/// \brief Producers racing a reader on a ring much smaller than what they write
+void concurrent ()
+{
+	imgui::LogBuffer log (16);
+
+	std::atomic<unsigned> running = PRODUCERS;
+	std::atomic<bool> failed      = false;
+
+	std::vector<std::thread> producers;
+	for (unsigned p = 0; p < PRODUCERS; ++p)
+	{
+		producers.emplace_back ([&log, &running, &failed, p] {
+			std::uint64_t last = 0;
+			for (unsigned i = 0; i < LINES; ++i)
+			{
+				auto const text  = line (p, i);
+				auto const index = log.append (text.data (), text.size ());
+
+				// this producer's lines get increasing indices
+				if (i && index <= last)
+					failed = true;
+				last = index;
+			}
+			--running;
+		});
+	}
+
+	// the reader follows the newest lines, skipping whatever was overwritten before it got there
+	std::uint64_t read = 0;
+	unsigned lastSequence[PRODUCERS];
+	bool seen[PRODUCERS] = {};
+	char out[imgui::LogBuffer::LINE_SIZE];
+	auto const drain = [&] {
+		auto const end = log.end ();
+		for (auto index = std::max (read, log.begin ()); index < end; ++index)
+		{
+			auto const size = log.read (index, out);
+			// a line still being written or already overwritten fails to read, and is skipped
+			if (size < 0)
+				continue;
+
+			unsigned producer;
+			unsigned sequence;
+			CHECK (parse (out, size, producer, sequence));
+
+			// lines from one producer come back in the order it wrote them
+			CHECK (!seen[producer] || sequence > lastSequence[producer]);
+			seen[producer]         = true;
+			lastSequence[producer] = sequence;
+			read                   = index + 1;
+		}
+	};
+
+	while (running)
+		drain ();
+	for (auto &producer : producers)
+		producer.join ();
+	CHECK (!failed);
+
+	// everything has landed: the ring holds the last capacity lines, all readable
+	CHECK (log.end () == std::uint64_t (PRODUCERS) * LINES);
+	CHECK (log.begin () == log.end () - log.capacity ());
+	for (auto index = log.begin (); index < log.end (); ++index)
+	{
+		auto const size = log.read (index, out);
+		unsigned producer;
+		unsigned sequence;
+		CHECK (size >= 0 && parse (out, size, producer, sequence));
+	}
+
+	drain ();
+	CHECK (read == log.end ());
+}
+}
+
+int main ()
+{
+	overwriteOldest ();
+	concurrent ();
+}
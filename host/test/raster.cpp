@@ -0,0 +1,156 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+
+// Host software renderer: coverage follows pixel centers with a top-left fill rule, clip rects and
+// alpha blending apply, and textured glyphs sample the atlas.
+
+#include "test.h"
+
+#include "../raster.h"
+
+#include <algorithm>
+#include <cstdint>
+
+namespace
+{
+/// \brief Font atlas texels
+unsigned char *s_atlas = nullptr;
+/// \brief Font atlas size
+int s_atlasWidth  = 0;
+int s_atlasHeight = 0;
+
+/// \brief Render a frame drawn into the foreground draw list
+template <typename F>
+raster::Image render (F &&draw_)
+{
+	ImGui::NewFrame ();
+	draw_ (*ImGui::GetForegroundDrawList ());
+	ImGui::Render ();
+
+	raster::Image image;
+	raster::render (*ImGui::GetDrawData (),
+	    {{ImGui::GetIO ().Fonts->TexID, s_atlas, s_atlasWidth, s_atlasHeight}},
+	    image);
+	return image;
+}
+
+/// \brief Red channel of a pixel
+std::uint8_t red (raster::Image const &image_, unsigned const x_, unsigned const y_)
+{
+	return image_.rgb[(y_ * image_.width + x_) * 3];
+}
+
+/// \brief A rectangle covers exactly the pixels whose centers it contains
+void coverage ()
+{
+	auto const image = render ([] (ImDrawList &list_) {
+		list_.AddRectFilled (ImVec2 (10.0f, 10.0f), ImVec2 (20.0f, 30.0f), IM_COL32 (255, 0, 0, 255));
+	});
+
+	CHECK (image.width == 400 && image.height == 480);
+	for (unsigned y = 0; y < 40; ++y)
+	{
+		for (unsigned x = 0; x < 30; ++x)
+		{
+			auto const covered = x >= 10 && x < 20 && y >= 10 && y < 30;
+			CHECK (red (image, x, y) == (covered ? 255 : 0));
+		}
+	}
+}
+
+/// \brief A translucent quad blends once everywhere, including along its diagonal
+void translucent ()
+{
+	auto const image = render ([] (ImDrawList &list_) {
+		list_.AddRectFilled (ImVec2 (0.0f, 0.0f), ImVec2 (16.0f, 16.0f), IM_COL32 (255, 0, 0, 128));
+	});
+
+	for (unsigned y = 0; y < 16; ++y)
+	{
+		for (unsigned x = 0; x < 16; ++x)
+			CHECK (red (image, x, y) == 128);
+	}
+}
+
+/// \brief Nothing is drawn outside the clip rect
+void clipped ()
+{
+	auto const image = render ([] (ImDrawList &list_) {
+		list_.PushClipRect (ImVec2 (5.0f, 5.0f), ImVec2 (8.0f, 9.0f));
+		list_.AddRectFilled (ImVec2 (0.0f, 0.0f), ImVec2 (20.0f, 20.0f), IM_COL32 (255, 0, 0, 255));
+		list_.PopClipRect ();
+	});
+
+	unsigned covered = 0;
+	for (unsigned y = 0; y < 20; ++y)
+	{
+		for (unsigned x = 0; x < 20; ++x)
+			covered += red (image, x, y) != 0;
+	}
+	CHECK (covered == 3 * 4);
+	CHECK (red (image, 5, 5) == 255 && red (image, 7, 8) == 255);
+}
+
+/// \brief Glyphs sample the atlas: text covers some of its box, not all of it, and unknown
+/// textures draw the whole box
+void glyphs ()
+{
+	auto const count = [] (raster::Image const &image_) {
+		unsigned lit = 0;
+		for (unsigned y = 0; y < 20; ++y)
+		{
+			for (unsigned x = 0; x < 100; ++x)
+				lit += red (image_, x, y) != 0;
+		}
+		return lit;
+	};
+
+	auto const text = render ([] (ImDrawList &list_) {
+		list_.AddText (ImVec2 (0.0f, 0.0f), IM_COL32_WHITE, "Hello");
+	});
+	auto const lit = count (text);
+	CHECK (lit > 20);
+
+	ImGui::NewFrame ();
+	ImGui::GetForegroundDrawList ()->AddText (ImVec2 (0.0f, 0.0f), IM_COL32_WHITE, "Hello");
+	ImGui::Render ();
+	raster::Image boxes;
+	raster::render (*ImGui::GetDrawData (), {}, boxes);
+	CHECK (count (boxes) > lit);
+}
+}
+
+int main ()
+{
+	test::createContext ();
+	ImGui::GetIO ().Fonts->GetTexDataAsAlpha8 (&s_atlas, &s_atlasWidth, &s_atlasHeight);
+
+	coverage ();
+	translucent ();
+	clipped ();
+	glyphs ();
+
+	ImGui::DestroyContext ();
+}
@@ -0,0 +1,402 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+// Remote UI stream: compress/decompress round trips, frames survive Encoder -> Decoder, damaged
+// frames are refused, and a viewer on a loopback socket gets the frames and drives the mouse.
+
+#include "test.h"
+
+#include "3ds/imgui_remote.h"
+
+#include "imgui/imgui_internal.h"
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <chrono>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <random>
+#include <thread>
+#include <vector>
+
+namespace
+{
+/// \brief Random generator with a fixed seed, so failures reproduce
+std::mt19937 s_random (1234);
+
+/// \brief Compress and decompress; checks the data comes back unchanged
+/// \returns Compressed size
+std::size_t roundTrip (std::vector<std::uint8_t> const &data_)
+{
+	std::vector<std::uint8_t> compressed;
+	imgui::remote::compress (data_.data (), data_.size (), compressed);
+
+	std::vector<std::uint8_t> out (data_.size ());
+	CHECK (imgui::remote::decompress (compressed.data (), compressed.size (), out));
+	CHECK (out == data_);
+	return compressed.size ();
+}
+
+/// \brief Random data, runs and repeats of every size round trip
+void compressRoundTrip ()
+{
+	for (std::size_t const size : {0, 1, 3, 4, 5, 15, 16, 19, 255, 270, 4096, 70000, 200000})
+	{
+		std::vector<std::uint8_t> data (size);
+
+		for (auto &byte : data)
+			byte = s_random ();
+		roundTrip (data);
+
+		// long runs, like unchanged XOR-delta bytes
+		std::fill (std::begin (data), std::end (data), 0);
+		auto const zeros = roundTrip (data);
+		CHECK (zeros <= size / 200 + 16);
+
+		// short repeats at every distance, some past the longest match offset
+		for (std::size_t i = 0; i < size; ++i)
+		{
+			if (i < 8 || s_random () % 4 == 0)
+				data[i] = s_random ();
+			else
+				data[i] = data[i - 1 - s_random () % std::min<std::size_t> (i, 0x11000)];
+		}
+		roundTrip (data);
+	}
+}
+
+/// \brief Damaged or truncated input fails instead of overrunning the output
+void corruptInput ()
+{
+	std::vector<std::uint8_t> data (5000);
+	for (std::size_t i = 0; i < data.size (); ++i)
+		data[i] = i % 97 < 50 ? 0 : s_random ();
+
+	std::vector<std::uint8_t> compressed;
+	imgui::remote::compress (data.data (), data.size (), compressed);
+
+	std::vector<std::uint8_t> out (data.size ());
+	CHECK (!imgui::remote::decompress (compressed.data (), compressed.size () - 1, out));
+
+	out.resize (data.size () - 1);
+	CHECK (!imgui::remote::decompress (compressed.data (), compressed.size (), out));
+
+	for (int i = 0; i < 2000; ++i)
+	{
+		auto damaged = compressed;
+		damaged[s_random () % damaged.size ()] ^= 1u << s_random () % 8;
+		out.assign (data.size (), 0);
+		if (imgui::remote::decompress (damaged.data (), damaged.size (), out))
+			CHECK (out.size () == data.size ());
+	}
+}
+
+/// \brief Check decoded draw data against the original
+void checkSame (ImDrawData const &decoded_, ImDrawData const &drawData_)
+{
+	CHECK (decoded_.CmdListsCount == drawData_.CmdListsCount);
+	CHECK (decoded_.DisplaySize.x == drawData_.DisplaySize.x);
+	CHECK (decoded_.DisplaySize.y == drawData_.DisplaySize.y);
+	CHECK (decoded_.TotalVtxCount == drawData_.TotalVtxCount);
+	CHECK (decoded_.TotalIdxCount == drawData_.TotalIdxCount);
+
+	for (int i = 0; i < drawData_.CmdListsCount; ++i)
+	{
+		auto const &a = *decoded_.CmdLists[i];
+		auto const &b = *drawData_.CmdLists[i];
+		CHECK (a.VtxBuffer.Size == b.VtxBuffer.Size);
+		CHECK (a.IdxBuffer.Size == b.IdxBuffer.Size);
+		CHECK (std::memcmp (a.VtxBuffer.Data, b.VtxBuffer.Data, a.VtxBuffer.size_in_bytes ()) == 0);
+		CHECK (std::memcmp (a.IdxBuffer.Data, b.IdxBuffer.Data, a.IdxBuffer.size_in_bytes ()) == 0);
+
+		CHECK (a.CmdBuffer.Size == b.CmdBuffer.Size);
+		for (int j = 0; j < a.CmdBuffer.Size; ++j)
+		{
+			auto const &ca = a.CmdBuffer[j];
+			auto const &cb = b.CmdBuffer[j];
+			CHECK (std::memcmp (&ca.ClipRect, &cb.ClipRect, sizeof (ca.ClipRect)) == 0);
+			CHECK (ca.TextureId == cb.TextureId);
+			CHECK (ca.VtxOffset == cb.VtxOffset);
+			CHECK (ca.IdxOffset == cb.IdxOffset);
+			CHECK (ca.ElemCount == cb.ElemCount);
+		}
+	}
+}
+
+/// \brief Build a frame with a static window and one whose contents change with frame_
+ImDrawData &buildFrame (int const frame_)
+{
+	ImGui::NewFrame ();
+
+	ImGui::SetNextWindowPos (ImVec2 (10.0f, 10.0f));
+	ImGui::Begin ("Static", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
+	ImGui::TextUnformatted ("unchanged");
+	ImGui::End ();
+
+	ImGui::SetNextWindowPos (ImVec2 (40.0f, 240.0f));
+	ImGui::Begin ("Changing", nullptr, ImGuiWindowFlags_AlwaysAutoResize);
+	// only some frames change, so unchanged lists are skipped in between
+	for (int i = 0; i < 1 + frame_ / 4 % 5; ++i)
+		ImGui::Text ("line %d of frame %d", i, frame_ / 4);
+	ImGui::End ();
+
+	ImGui::Render ();
+	return *ImGui::GetDrawData ();
+}
+
+/// \brief Every encoded frame decodes to the draw data it came from
+void frameRoundTrip ()
+{
+	imgui::remote::Encoder encoder;
+	std::unique_ptr<imgui::remote::Decoder> decoder;
+
+	imgui::remote::Stats stats{};
+	unsigned unchanged = 0;
+	for (int frame = 0; frame < 60; ++frame)
+	{
+		// a viewer that reconnects gets a full frame
+		if (frame == 0 || frame == 30)
+		{
+			encoder.reset ();
+			decoder = std::make_unique<imgui::remote::Decoder> ();
+			decoder->textures.emplace_back (ImGui::GetIO ().Fonts->TexID);
+		}
+
+		auto &drawData = buildFrame (frame);
+
+		std::vector<std::uint8_t> message;
+		encoder.encode (drawData, message, stats);
+		CHECK (stats.wireBytes == message.size ());
+		CHECK (decoder->decode (message.data (), message.size ()));
+		checkSame (decoder->drawData (), drawData);
+
+		if (frame == 30)
+			CHECK (stats.listsUnchanged == 0);
+		unchanged += stats.listsUnchanged;
+
+		// a damaged message is refused, not half-applied
+		message.back () ^= 0xFF;
+		message.pop_back ();
+		CHECK (!imgui::remote::Decoder ().decode (message.data (), message.size ()));
+	}
+	CHECK (unchanged > 60);
+}
+
+/// \brief Frame message around a payload
+/// \param payload_ Uncompressed payload
+/// \param rawSize_ Raw size to claim in the header
+std::vector<std::uint8_t> frameMessage (std::vector<std::uint8_t> const &payload_,
+    std::uint32_t const rawSize_)
+{
+	std::vector<std::uint8_t> message (sizeof (imgui::remote::FrameHeader));
+	imgui::remote::compress (payload_.data (), payload_.size (), message);
+
+	imgui::remote::FrameHeader header;
+	header.magic          = imgui::remote::FRAME_MAGIC;
+	header.compressedSize = message.size () - sizeof (header);
+	header.rawSize        = rawSize_;
+	std::memcpy (message.data (), &header, sizeof (header));
+	return message;
+}
+
+/// \brief Append a value to a payload
+template <typename T>
+void append (std::vector<std::uint8_t> &payload_, T const &value_)
+{
+	auto const p = reinterpret_cast<std::uint8_t const *> (&value_);
+	payload_.insert (std::end (payload_), p, p + sizeof (value_));
+}
+
+/// \brief Payload of a frame with one changed list holding a quad
+/// \param vtxCount_ Vertex count to claim
+/// \param idxCount_ Index count to claim
+/// \param cmdCount_ Command count to claim
+/// \param vtxOffset_ Vertex offset of the command
+/// \param lastIndex_ Value of the last index
+std::vector<std::uint8_t> quadPayload (std::uint32_t const vtxCount_,
+    std::uint32_t const idxCount_,
+    std::uint32_t const cmdCount_,
+    std::uint32_t const vtxOffset_,
+    ImDrawIdx const lastIndex_)
+{
+	std::vector<std::uint8_t> payload;
+	append (payload, std::uint32_t (0));
+	append (payload, ImVec2 (0.0f, 0.0f));
+	append (payload, ImVec2 (400.0f, 480.0f));
+	append (payload, ImVec2 (1.0f, 1.0f));
+	append (payload, std::uint32_t (1));
+
+	append (payload, std::uint8_t (1));
+	append (payload, vtxCount_);
+	append (payload, idxCount_);
+	append (payload, cmdCount_);
+
+	imgui::remote::Command cmd{{0.0f, 0.0f, 400.0f, 480.0f}, 0, vtxOffset_, 0, 6};
+	append (payload, cmd);
+
+	for (int i = 0; i < 4; ++i)
+		append (payload, ImDrawVert{ImVec2 (i & 1, i >> 1), ImVec2 (0.0f, 0.0f), IM_COL32_WHITE});
+	for (ImDrawIdx const index : {0, 1, 2, 1, 3})
+		append (payload, index);
+	append (payload, lastIndex_);
+	return payload;
+}
+
+/// \brief Frames with counts or indices the payload can't back are refused without sizing
+/// anything from them, and the decoder recovers on the next full frame
+void damagedFrames ()
+{
+	imgui::remote::Decoder decoder;
+	decoder.textures.emplace_back (ImGui::GetIO ().Fonts->TexID);
+
+	auto const valid = quadPayload (4, 6, 1, 0, 2);
+	auto const message = frameMessage (valid, valid.size ());
+	CHECK (decoder.decode (message.data (), message.size ()));
+	CHECK (decoder.drawData ().TotalVtxCount == 4);
+
+	auto const refused = [&] (std::vector<std::uint8_t> const &payload_, std::uint32_t rawSize_) {
+		auto const damaged = frameMessage (payload_, rawSize_);
+		CHECK (!decoder.decode (damaged.data (), damaged.size ()));
+
+		// nothing half-decoded is left behind
+		CHECK (!decoder.drawData ().Valid);
+		CHECK (decoder.drawData ().CmdListsCount == 0);
+		CHECK (decoder.drawData ().TotalVtxCount == 0);
+	};
+
+	// raw size the compressed data can't expand to
+	refused (valid, 0xFFFFFFFF);
+
+	// counts past the payload, including ones that are negative as an int
+	refused (quadPayload (4, 6, 0xFFFFFFFF, 0, 2), valid.size ());
+	refused (quadPayload (0x80000000, 6, 1, 0, 2), valid.size ());
+	refused (quadPayload (4, 0x80000000, 1, 0, 2), valid.size ());
+	refused (quadPayload (5, 6, 1, 0, 2), valid.size ());
+
+	// indices past the list's vertices, directly or through the vertex offset
+	refused (quadPayload (4, 6, 1, 0, 4), valid.size ());
+	refused (quadPayload (4, 6, 1, 1, 3), valid.size ());
+	refused (quadPayload (4, 6, 1, 0xFFFFFFFF, 2), valid.size ());
+
+	// list count past the payload
+	auto lists = valid;
+	std::uint32_t const count = 0xFFFFFFFF;
+	std::memcpy (&lists[sizeof (std::uint32_t) + 3 * sizeof (ImVec2)], &count, sizeof (count));
+	refused (lists, lists.size ());
+
+	CHECK (decoder.decode (message.data (), message.size ()));
+	CHECK (decoder.drawData ().TotalVtxCount == 4);
+	CHECK (decoder.drawData ().CmdLists[0]->CmdBuffer.Size == 1);
+}
+
+/// \brief Receive exactly size_ bytes
+void receive (int const fd_, void *const data_, std::size_t const size_)
+{
+	auto const p = static_cast<std::uint8_t *> (data_);
+	for (std::size_t pos = 0; pos < size_;)
+	{
+		auto const rc = ::recv (fd_, p + pos, size_ - pos, 0);
+		CHECK (rc > 0);
+		pos += rc;
+	}
+}
+
+/// \brief A viewer connected over loopback receives frames and its input reaches ImGuiIO
+void loopback ()
+{
+	auto const port = static_cast<std::uint16_t> (47000 + ::getpid () % 1000);
+	CHECK (imgui::remote::init (port));
+
+	auto const viewer = ::socket (AF_INET, SOCK_STREAM, 0);
+	CHECK (viewer >= 0);
+
+	struct sockaddr_in addr;
+	std::memset (&addr, 0, sizeof (addr));
+	addr.sin_family      = AF_INET;
+	addr.sin_port        = htons (port);
+	addr.sin_addr.s_addr = htonl (INADDR_LOOPBACK);
+	CHECK (::connect (viewer, reinterpret_cast<struct sockaddr *> (&addr), sizeof (addr)) == 0);
+
+	imgui::remote::Decoder decoder;
+	decoder.textures.emplace_back (ImGui::GetIO ().Fonts->TexID);
+	for (int frame = 0; frame < 10; ++frame)
+	{
+		auto &drawData = buildFrame (frame);
+		imgui::remote::send (&drawData);
+
+		imgui::remote::FrameHeader header;
+		receive (viewer, &header, sizeof (header));
+		CHECK (header.magic == imgui::remote::FRAME_MAGIC);
+
+		std::vector<std::uint8_t> message (sizeof (header) + header.compressedSize);
+		std::memcpy (message.data (), &header, sizeof (header));
+		receive (viewer, &message[sizeof (header)], header.compressedSize);
+		CHECK (decoder.decode (message.data (), message.size ()));
+		checkSame (decoder.drawData (), drawData);
+	}
+
+	// press, then release in the next message; both reach the device in order
+	imgui::remote::InputMessage input[2] = {
+	    {imgui::remote::INPUT_MAGIC, 123.0f, 45.0f, 1}, {imgui::remote::INPUT_MAGIC, 130.0f, 50.0f, 0}};
+	CHECK (::send (viewer, input, sizeof (input), 0) == sizeof (input));
+
+	auto &io = ImGui::GetIO ();
+	auto &g  = *ImGui::GetCurrentContext ();
+	for (int i = 0; i < 100 && g.InputEventsQueue.empty (); ++i)
+	{
+		std::this_thread::sleep_for (std::chrono::milliseconds (10));
+		imgui::remote::pollInput (io);
+	}
+
+	ImGui::NewFrame ();
+	CHECK (io.MousePos.x == 123.0f && io.MousePos.y == 45.0f);
+	CHECK (io.MouseDown[0]);
+	ImGui::EndFrame ();
+
+	ImGui::NewFrame ();
+	CHECK (io.MousePos.x == 130.0f && io.MousePos.y == 50.0f);
+	CHECK (!io.MouseDown[0]);
+	ImGui::EndFrame ();
+
+	::close (viewer);
+	imgui::remote::exit ();
+}
+}
+
+int main ()
+{
+	test::createContext ();
+
+	compressRoundTrip ();
+	corruptInput ();
+	frameRoundTrip ();
+	damagedFrames ();
+	loopback ();
+
+	ImGui::DestroyContext ();
+}
@@ -0,0 +1,319 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+// citro3d backend against the recording citro3d stub: what reaches the command buffer and the
+// render targets.
+
+#include "test.h"
+
+#include "3ds/imgui_citro3d.h"
+#include "stub.h"
+
+#include <algorithm>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+/// \brief Top screen render target
+C3D_RenderTarget s_top{GFX_TOP, GFX_LEFT};
+/// \brief Bottom screen render target
+C3D_RenderTarget s_bottom{GFX_BOTTOM, GFX_LEFT};
+/// \brief Top screen right eye render target
+C3D_RenderTarget s_right{GFX_TOP, GFX_RIGHT};
+
+/// \brief Start the backend with a command buffer size
+void start (std::size_t const cmdBufSize_)
+{
+	C3D_Init (cmdBufSize_);
+	test::createContext ();
+	imgui::citro3d::init ();
+}
+
+/// \brief Stop the backend
+void stop ()
+{
+	imgui::citro3d::exit ();
+	ImGui::DestroyContext ();
+	C3D_Fini ();
+}
+
+/// \brief Build and render a frame
+/// \param draw_ Called between NewFrame and Render to submit the frame's contents
+template <typename F>
+void frame (F &&draw_)
+{
+	C3D_FrameBegin (0);
+	ImGui::NewFrame ();
+	draw_ ();
+	ImGui::Render ();
+	imgui::citro3d::render (&s_top, &s_bottom);
+	C3D_FrameEnd (0);
+}
+
+/// \brief A window whose every rectangle has its own clip rect, so each is a draw call
+/// \param count_ Number of rectangles
+void clippedRects (int const count_)
+{
+	ImGui::SetNextWindowPos (ImVec2 (0.0f, 0.0f));
+	ImGui::SetNextWindowSize (ImVec2 (400.0f, 480.0f));
+	ImGui::Begin ("Rects", nullptr, ImGuiWindowFlags_NoDecoration);
+	auto const list = ImGui::GetWindowDrawList ();
+	for (int i = 0; i < count_; ++i)
+	{
+		auto const pos = ImVec2 (i % 20 * 20.0f, i / 20 % 24 * 20.0f);
+		list->PushClipRect (pos, ImVec2 (pos.x + 10.0f + i % 7, pos.y + 10.0f));
+		list->AddRectFilled (pos, ImVec2 (pos.x + 20.0f, pos.y + 20.0f), IM_COL32_WHITE);
+		list->PopClipRect ();
+	}
+	ImGui::End ();
+}
+
+/// \brief Number of times countCallback () ran
+unsigned s_callbacks = 0;
+
+/// \brief Draw callback counting its calls
+void countCallback (ImDrawList const *, ImDrawCmd const *)
+{
+	++s_callbacks;
+}
+
+/// \brief A window whose draw list is only a counting callback and a render state reset
+void callbackWindow ()
+{
+	ImGui::Begin ("Callback", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoBackground);
+	auto const list = ImGui::GetWindowDrawList ();
+	list->AddCallback (&countCallback, nullptr);
+	list->AddCallback (ImDrawCallback_ResetRenderState, nullptr);
+	ImGui::End ();
+}
+
+/// \brief A window with a single rectangle, so its draw list is one draw call
+/// \param name_ Window name
+/// \param pos_ Window position
+void rectWindow (char const *const name_, ImVec2 const &pos_)
+{
+	ImGui::SetNextWindowPos (pos_);
+	ImGui::SetNextWindowSize (ImVec2 (100.0f, 100.0f));
+	ImGui::Begin (name_, nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoBackground);
+	ImGui::GetWindowDrawList ()->AddRectFilled (
+	    pos_, ImVec2 (pos_.x + 50.0f, pos_.y + 50.0f), IM_COL32_WHITE);
+	ImGui::End ();
+}
+
+/// \brief Shifts of the draws recorded on a render target, in draw order
+/// \param target_ Render target
+std::vector<float> shifts (C3D_RenderTarget const *const target_)
+{
+	std::vector<float> result;
+	for (auto const &draw : stub::draws)
+	{
+		if (draw.target == target_)
+			result.emplace_back (draw.shift);
+	}
+	return result;
+}
+
+/// \brief Hash (FNV-1a) of the frame's recorded draw calls: their target, texture, scissor, shift
+/// and indexed vertices, in order, and the command buffer bytes the frame used
+std::uint64_t callSequenceHash ()
+{
+	auto hash       = std::uint64_t (0xCBF29CE484222325);
+	auto const feed = [&hash] (void const *const data_, std::size_t const size_) {
+		auto const bytes = static_cast<unsigned char const *> (data_);
+		for (std::size_t i = 0; i < size_; ++i)
+			hash = (hash ^ bytes[i]) * 0x100000001B3;
+	};
+
+	// textures by order of first use, since their addresses change from run to run
+	std::vector<C3D_Tex const *> textures;
+	for (auto const &draw : stub::draws)
+	{
+		auto const target = draw.target == &s_top ? 0 : draw.target == &s_right ? 1 : 2;
+		auto texture      = std::find (textures.begin (), textures.end (), draw.texture);
+		if (texture == textures.end ())
+			texture = textures.insert (texture, draw.texture);
+		auto const textureIndex = texture - textures.begin ();
+
+		feed (&target, sizeof (target));
+		feed (&textureIndex, sizeof (textureIndex));
+		feed (draw.scissor, sizeof (draw.scissor));
+		feed (&draw.shift, sizeof (draw.shift));
+		feed (&draw.count, sizeof (draw.count));
+
+		auto const vertices = static_cast<ImDrawVert const *> (draw.vertices);
+		for (int i = 0; i < draw.count; ++i)
+			feed (&vertices[draw.indices[i]], sizeof (ImDrawVert));
+	}
+
+	feed (&stub::cmdBufUsed, sizeof (stub::cmdBufUsed));
+	return hash;
+}
+
+/// \brief Frame contents for callSequence: text, clipped rectangles and images on both screens
+void callSequenceWindows ()
+{
+	ImGui::SetNextWindowPos (ImVec2 (10.0f, 10.0f));
+	ImGui::SetNextWindowSize (ImVec2 (300.0f, 200.0f));
+	ImGui::Begin ("Text");
+	for (int i = 0; i < 12; ++i)
+		ImGui::Text ("Line %d: lorem ipsum", i);
+	ImGui::End ();
+
+	ImGui::SetNextWindowPos (ImVec2 (150.0f, 120.0f));
+	ImGui::SetNextWindowSize (ImVec2 (200.0f, 200.0f));
+	ImGui::Begin ("Child");
+	ImGui::BeginChild ("Scrolled", ImVec2 (0.0f, 100.0f), ImGuiChildFlags_Borders);
+	for (int i = 0; i < 10; ++i)
+		ImGui::Button ("Button");
+	ImGui::EndChild ();
+	ImGui::End ();
+
+	// spans the bottom of the top screen and the top of the bottom screen
+	ImGui::SetNextWindowPos (ImVec2 (60.0f, 200.0f));
+	ImGui::SetNextWindowSize (ImVec2 (280.0f, 160.0f));
+	ImGui::Begin ("Split");
+	ImGui::Image (ImGui::GetIO ().Fonts->TexID, ImVec2 (64.0f, 64.0f));
+	ImGui::ProgressBar (0.5f);
+	ImGui::End ();
+}
+
+/// \brief The GPU call sequence for a fixed frame doesn't change, in mono and in stereo. When a
+/// change to the backend or the stubs means to change it, update the hashes from the failure
+/// output after checking the new output is right
+void callSequence ()
+{
+	constexpr std::uint64_t MONO   = 0x43C4EFFA08A74F2B;
+	constexpr std::uint64_t STEREO = 0x8124356E965A4F78;
+
+	start (C3D_DEFAULT_CMDBUF_SIZE);
+	for (int i = 0; i < 3; ++i)
+		frame (callSequenceWindows);
+	auto const mono = callSequenceHash ();
+	if (mono != MONO)
+		std::fprintf (stderr, "mono call sequence hash 0x%016llX\n", (unsigned long long)mono);
+	CHECK (mono == MONO);
+
+	imgui::citro3d::setStereo (&s_right, 8.0f);
+	frame (callSequenceWindows);
+	auto const stereo = callSequenceHash ();
+	if (stereo != STEREO)
+		std::fprintf (stderr, "stereo call sequence hash 0x%016llX\n", (unsigned long long)stereo);
+	CHECK (stereo == STEREO);
+
+	imgui::citro3d::setStereo (nullptr, 0.0f);
+	stop ();
+}
+
+/// \brief Each draw list is shifted by its window's depth, the right eye by the opposite amount,
+/// and nothing is shifted on the bottom screen or in mono
+void stereoShifts ()
+{
+	constexpr float PARALLAX = 8.0f;
+
+	auto const windows = [] {
+		// back to front: two windows on the top screen and one on the bottom screen
+		rectWindow ("Back", ImVec2 (10.0f, 10.0f));
+		rectWindow ("Front", ImVec2 (200.0f, 10.0f));
+		rectWindow ("Bottom", ImVec2 (100.0f, 300.0f));
+	};
+
+	start (C3D_DEFAULT_CMDBUF_SIZE);
+	imgui::citro3d::setStereo (&s_right, PARALLAX);
+	for (int i = 0; i < 3; ++i)
+		frame (windows);
+
+	// three layers: the backmost sits on the screen plane, the frontmost pops out by half the
+	// parallax per eye
+	CHECK ((shifts (&s_top) == std::vector<float>{0.0f, 0.25f * PARALLAX}));
+	CHECK ((shifts (&s_right) == std::vector<float>{0.0f, -0.25f * PARALLAX}));
+	CHECK ((shifts (&s_bottom) == std::vector<float>{0.0f}));
+
+	// mono draws nothing for the right eye and shifts nothing
+	imgui::citro3d::setStereo (nullptr, PARALLAX);
+	frame (windows);
+	CHECK ((shifts (&s_top) == std::vector<float>{0.0f, 0.0f}));
+	CHECK (shifts (&s_right).empty ());
+	CHECK ((shifts (&s_bottom) == std::vector<float>{0.0f}));
+	stop ();
+}
+
+/// \brief A frame too big for the command buffer drops draw calls instead of overflowing, still
+/// runs its callbacks on every target, and the suggested size fits it
+void cmdBufOverflow ()
+{
+	constexpr int RECTS = 400;
+
+	start (32 * 1024);
+	for (int i = 0; i < 3; ++i)
+	{
+		s_callbacks = 0;
+		frame ([] {
+			clippedRects (RECTS);
+			callbackWindow ();
+		});
+	}
+
+	auto const &stats = imgui::citro3d::stats ();
+	CHECK (!stub::cmdBufOverflowed);
+	CHECK (stats.droppedDrawCalls > 0);
+	CHECK (stats.droppedDrawCallsHighWater == stats.droppedDrawCalls);
+
+	// the command buffer was full before the bottom screen was drawn, and the callback ran on both
+	// screens anyway
+	CHECK (std::none_of (stub::draws.begin (), stub::draws.end (), [] (auto const &draw_) {
+		return draw_.target == &s_bottom;
+	}));
+	CHECK (s_callbacks == 2);
+
+	// the high-water mark is measured from the command buffer, not estimated
+	auto const measured = static_cast<std::size_t> (stats.cmdBufHighWater * stub::cmdBufSize + 0.5f);
+	CHECK (measured == stub::cmdBufPeak);
+
+	// drops stay visible after a frame that fits
+	frame ([] { clippedRects (1); });
+	CHECK (stats.droppedDrawCalls == 0);
+	CHECK (stats.droppedDrawCallsHighWater > 0);
+
+	auto const suggested = imgui::citro3d::suggestedCmdBufSize ();
+	CHECK (suggested > stub::cmdBufSize);
+	stop ();
+
+	// the same frames fit in the suggested size
+	start (suggested);
+	for (int i = 0; i < 3; ++i)
+		frame ([] { clippedRects (RECTS); });
+	CHECK (!stub::cmdBufOverflowed);
+	CHECK (imgui::citro3d::stats ().droppedDrawCalls == 0);
+	CHECK (stub::draws.size () >= RECTS);
+	stop ();
+}
+}
+
+int main ()
+{
+	cmdBufOverflow ();
+	stereoShifts ();
+	callSequence ();
+}
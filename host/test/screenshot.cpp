@@ -0,0 +1,229 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+
+// Screenshots: the software-rendered frame is rotated into the layout the display transfer
+// leaves, composed and written as PNG, and decoding the file gives back the frame's pixels, with
+// the bottom screen centered and black beside it, in normal and wide mode.
+
+#include "test.h"
+
+#include "3ds/screenshot_image.h"
+
+#include "../raster.h"
+
+#include <zlib.h>
+
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <filesystem>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace
+{
+/// \brief Decoded PNG
+struct Png
+{
+	/// \brief Width
+	unsigned width = 0;
+	/// \brief Height
+	unsigned height = 0;
+	/// \brief Pixels (RGB, row-major)
+	std::vector<std::uint8_t> rgb;
+};
+
+/// \brief Read a big-endian 32-bit value
+std::uint32_t be32 (std::uint8_t const *const data_)
+{
+	return std::uint32_t (data_[0]) << 24 | std::uint32_t (data_[1]) << 16 |
+	       std::uint32_t (data_[2]) << 8 | data_[3];
+}
+
+/// \brief Decode a PNG as writePng writes them: 8-bit RGB, unfiltered rows
+/// \param path_ PNG file
+Png readPng (char const *const path_)
+{
+	std::ifstream file (path_, std::ios::binary);
+	std::vector<std::uint8_t> const data{
+	    std::istreambuf_iterator<char> (file), std::istreambuf_iterator<char> ()};
+
+	static std::uint8_t const signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+	CHECK (data.size () > sizeof (signature));
+	CHECK (std::memcmp (data.data (), signature, sizeof (signature)) == 0);
+
+	Png png;
+	std::vector<std::uint8_t> compressed;
+	auto ended = false;
+	for (std::size_t pos = sizeof (signature); !ended;)
+	{
+		CHECK (data.size () - pos >= 12);
+		auto const size = be32 (&data[pos]);
+		CHECK (data.size () - pos - 12 >= size);
+
+		auto const type  = &data[pos + 4];
+		auto const chunk = &data[pos + 8];
+		CHECK (crc32 (crc32 (0, type, 4), chunk, size) == be32 (chunk + size));
+
+		if (std::memcmp (type, "IHDR", 4) == 0)
+		{
+			CHECK (size == 13);
+			png.width  = be32 (chunk);
+			png.height = be32 (chunk + 4);
+			CHECK (chunk[8] == 8 && chunk[9] == 2 && chunk[12] == 0);
+		}
+		else if (std::memcmp (type, "IDAT", 4) == 0)
+			compressed.insert (compressed.end (), chunk, chunk + size);
+		else
+			ended = std::memcmp (type, "IEND", 4) == 0;
+
+		pos += 12 + size;
+	}
+
+	auto const stride = 1 + png.width * 3;
+	std::vector<std::uint8_t> rows (stride * png.height);
+	auto size = uLongf (rows.size ());
+	CHECK (uncompress (rows.data (), &size, compressed.data (), compressed.size ()) == Z_OK);
+	CHECK (size == rows.size ());
+
+	for (unsigned y = 0; y < png.height; ++y)
+	{
+		CHECK (rows[y * stride] == 0);
+		png.rgb.insert (png.rgb.end (),
+		    rows.begin () + y * stride + 1,
+		    rows.begin () + (y + 1) * stride);
+	}
+
+	return png;
+}
+
+/// \brief Rotate part of the frame into the display transfer's layout: column-major from the
+/// left, each column bottom-up, BGR
+/// \param image_ Frame
+/// \param x_ Left of the screen in the frame
+/// \param y_ Top of the screen in the frame
+/// \param width_ Screen width
+std::vector<std::uint8_t> screen (raster::Image const &image_,
+    unsigned const x_,
+    unsigned const y_,
+    unsigned const width_)
+{
+	using screenshot::SCREEN_HEIGHT;
+
+	std::vector<std::uint8_t> screen (width_ * SCREEN_HEIGHT * 3);
+	for (unsigned x = 0; x < width_; ++x)
+	{
+		for (unsigned y = 0; y < SCREEN_HEIGHT; ++y)
+		{
+			auto const in  = &image_.rgb[((y_ + y) * image_.width + x_ + x) * 3];
+			auto const out = &screen[(x * SCREEN_HEIGHT + SCREEN_HEIGHT - 1 - y) * 3];
+			out[0]         = in[2];
+			out[1]         = in[1];
+			out[2]         = in[0];
+		}
+	}
+	return screen;
+}
+
+/// \brief Render a frame at a display width, screenshot it and compare the decoded PNG
+/// \param width_ Display width (the top screen width)
+void roundTrip (unsigned const width_)
+{
+	using screenshot::BOTTOM_WIDTH;
+	using screenshot::IMAGE_HEIGHT;
+	using screenshot::SCREEN_HEIGHT;
+
+	auto &io       = ImGui::GetIO ();
+	io.DisplaySize = ImVec2 (width_, IMAGE_HEIGHT);
+
+	// windows on both screens, one straddling them and one beside the bottom screen, which the
+	// screenshot leaves out
+	ImGui::NewFrame ();
+	auto const window = [] (char const *const name_, ImVec2 const &pos_) {
+		ImGui::SetNextWindowPos (pos_);
+		ImGui::SetNextWindowSize (ImVec2 (150.0f, 120.0f));
+		ImGui::Begin (name_);
+		ImGui::TextUnformatted (name_);
+		ImGui::Button ("Button");
+		ImGui::End ();
+	};
+	window ("Top", ImVec2 (10.0f, 10.0f));
+	window ("Across", ImVec2 (width_ * 0.5f - 75.0f, 180.0f));
+	window ("Corner", ImVec2 (0.0f, 350.0f));
+	ImGui::Render ();
+
+	unsigned char *atlas;
+	int atlasWidth;
+	int atlasHeight;
+	io.Fonts->GetTexDataAsAlpha8 (&atlas, &atlasWidth, &atlasHeight);
+
+	raster::Image frame;
+	raster::render (*ImGui::GetDrawData (),
+	    {{io.Fonts->TexID, atlas, atlasWidth, atlasHeight}},
+	    frame,
+	    IM_COL32 (40, 80, 120, 255));
+	CHECK (frame.width == width_ && frame.height == IMAGE_HEIGHT);
+
+	auto const left   = (width_ - BOTTOM_WIDTH) / 2;
+	auto const top    = screen (frame, 0, 0, width_);
+	auto const bottom = screen (frame, left, SCREEN_HEIGHT, BOTTOM_WIDTH);
+
+	std::vector<std::uint8_t> image (width_ * IMAGE_HEIGHT * 3);
+	screenshot::compose (image.data (), width_, top.data (), bottom.data ());
+
+	auto const path =
+	    (std::filesystem::temp_directory_path () / "imgui_screenshot_test.png").string ();
+	CHECK (screenshot::writePng (path.c_str (), image.data (), width_, IMAGE_HEIGHT));
+	auto const png = readPng (path.c_str ());
+	std::remove (path.c_str ());
+
+	CHECK (png.width == width_ && png.height == IMAGE_HEIGHT);
+	for (unsigned y = 0; y < IMAGE_HEIGHT; ++y)
+	{
+		for (unsigned x = 0; x < width_; ++x)
+		{
+			auto const shown = y < SCREEN_HEIGHT || (x >= left && x < left + BOTTOM_WIDTH);
+			auto const out   = &png.rgb[(y * width_ + x) * 3];
+			auto const in    = &frame.rgb[(y * width_ + x) * 3];
+			if (shown)
+				CHECK (std::memcmp (out, in, 3) == 0);
+			else
+				CHECK (out[0] == 0 && out[1] == 0 && out[2] == 0);
+		}
+	}
+}
+}
+
+int main ()
+{
+	test::createContext ();
+
+	roundTrip (400);
+	roundTrip (800);
+
+	ImGui::DestroyContext ();
+}
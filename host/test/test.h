@@ -0,0 +1,68 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Minimal support for the host tests: each test is its own executable that exits non-zero on the
+// first failed CHECK.
+
+#pragma once
+
+#include "imgui/imgui.h"
+
+#include <cstdio>
+#include <cstdlib>
+
+/// \brief Fail the test unless a condition holds
+#define CHECK(cond_)                                                                               \
+	do                                                                                             \
+	{                                                                                              \
+		if (!(cond_))                                                                              \
+		{                                                                                          \
+			std::fprintf (stderr, "%s:%d: CHECK failed: %s\n", __FILE__, __LINE__, #cond_);        \
+			std::exit (EXIT_FAILURE);                                                              \
+		}                                                                                          \
+	} while (0)
+
+namespace test
+{
+/// \brief Create an ImGui context that can run frames without a renderer
+/// \param displaySize_ Display size
+inline ImGuiContext *createContext (ImVec2 const displaySize_ = ImVec2 (400.0f, 480.0f))
+{
+	IMGUI_CHECKVERSION ();
+	auto const ctx = ImGui::CreateContext ();
+
+	auto &io       = ImGui::GetIO ();
+	io.DisplaySize = displaySize_;
+	io.DeltaTime   = 1.0f / 60.0f;
+	io.IniFilename = nullptr;
+
+	// the atlas only has to be built; nothing samples it
+	unsigned char *pixels;
+	int width;
+	int height;
+	io.Fonts->GetTexDataAsAlpha8 (&pixels, &width, &height);
+	io.Fonts->SetTexID (reinterpret_cast<ImTextureID> (io.Fonts));
+
+	return ctx;
+}
+}
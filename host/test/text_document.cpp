@@ -0,0 +1,214 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// TextDocument against std::string: random edits, undos and redos must keep the contents and
+// every line query in agreement, and undoing or redoing everything must step through the exact
+// snapshots.
+
+#include "test.h"
+
+#include "3ds/imgui_text_editor.h"
+
+#include <random>
+#include <string>
+#include <vector>
+
+namespace
+{
+/// \brief Random number source, seeded so failures reproduce
+std::mt19937 s_rng (1);
+
+/// \brief Random integer in [0, max_)
+std::size_t random (std::size_t const max_)
+{
+	return std::uniform_int_distribution<std::size_t> (0, max_ - 1) (s_rng);
+}
+
+/// \brief Random text of newlines and letters
+/// \param size_ Text size
+std::string randomText (std::size_t const size_)
+{
+	std::string text;
+	for (std::size_t i = 0; i < size_; ++i)
+		text.push_back ("xy\nz"[random (4)]);
+	return text;
+}
+
+/// \brief Whole document text
+std::string contents (imgui::TextDocument const &document_)
+{
+	std::string text;
+	document_.copy (0, document_.size (), text);
+	return text;
+}
+
+/// \brief Check every query of a document against its text
+/// \param document_ Document
+/// \param text_ Expected text
+void checkQueries (imgui::TextDocument const &document_, std::string const &text_)
+{
+	CHECK (document_.size () == text_.size ());
+
+	std::size_t lines = 1;
+	for (auto const c : text_)
+		lines += c == '\n';
+	CHECK (document_.lineCount () == lines);
+
+	std::size_t start = 0;
+	for (std::size_t line = 0; line < lines; ++line)
+	{
+		auto end = text_.find ('\n', start);
+		if (end == std::string::npos)
+			end = text_.size ();
+
+		CHECK (document_.lineStart (line) == start);
+		CHECK (document_.lineEnd (line) == end);
+		for (auto offset = start; offset <= end; ++offset)
+			CHECK (document_.lineOf (offset) == line);
+
+		start = end + 1;
+	}
+
+	for (std::size_t offset = 0; offset < text_.size (); ++offset)
+		CHECK (document_.at (offset) == text_[offset]);
+	CHECK (document_.at (text_.size ()) == 0);
+
+	auto begin = random (text_.size () + 1);
+	auto end   = random (text_.size () + 1);
+	if (begin > end)
+		std::swap (begin, end);
+
+	std::string range;
+	document_.copy (begin, end, range);
+	CHECK (range == text_.substr (begin, end - begin));
+}
+
+/// \brief Random edits, undos and redos against std::string
+void randomEdits ()
+{
+	for (int round = 0; round < 200; ++round)
+	{
+		auto text = randomText (random (200));
+
+		imgui::TextDocument document;
+		document.assign (text.data (), text.size ());
+
+		for (int step = 0; step < 300; ++step)
+		{
+			auto const op = random (10);
+			if (op < 5)
+			{
+				// deletes, inserts and replacements of a few bytes
+				auto const offset = random (text.size () + 1);
+				auto const erase  = std::min (op == 0 ? random (5) : 0, text.size () - offset);
+				auto const insert = randomText (op == 1 ? 0 : op == 2 ? random (6) : 1);
+				if (!erase && insert.empty ())
+					continue;
+
+				document.replace (offset, erase, insert.data (), insert.size ());
+				text.replace (offset, erase, insert);
+				CHECK (contents (document) == text);
+
+				if (random (3) == 0)
+					document.breakUndo ();
+			}
+			else
+			{
+				std::size_t cursor;
+				if (op < 7)
+					document.undo (cursor);
+				else if (op < 8)
+					document.redo (cursor);
+
+				// undo and redo are checked exactly below; here the queries must follow them
+				text = contents (document);
+			}
+
+			checkQueries (document, text);
+		}
+	}
+}
+
+/// \brief Undo everything then redo everything, checking each step against a snapshot
+void undoRedoAll ()
+{
+	for (int round = 0; round < 200; ++round)
+	{
+		std::string const base = "hello\nworld\n";
+
+		imgui::TextDocument document;
+		document.assign (base.data (), base.size ());
+
+		std::vector<std::string> snapshots{base};
+		auto const edits = 1 + random (40);
+		for (std::size_t i = 0; i < edits; ++i)
+		{
+			auto const size   = document.size ();
+			auto const offset = random (size + 1);
+			auto const erase  = std::min (random (4), size - offset);
+			auto insert       = random (2) ? std::string ("\n") : std::string (random (3), 'q');
+			if (!erase && insert.empty ())
+				insert = "k";
+
+			document.breakUndo ();
+			document.replace (offset, erase, insert.data (), insert.size ());
+			snapshots.emplace_back (contents (document));
+		}
+
+		std::size_t cursor;
+		auto step = edits;
+		while (document.undo (cursor))
+			CHECK (contents (document) == snapshots[--step]);
+		CHECK (step == 0);
+
+		while (document.redo (cursor))
+			CHECK (contents (document) == snapshots[++step]);
+		CHECK (step == edits);
+	}
+}
+
+/// \brief Consecutive typing is one undo step
+void typingCoalesces ()
+{
+	imgui::TextDocument document;
+	document.assign ("ab", 2);
+	for (int i = 0; i < 100; ++i)
+	{
+		char const c = 'a' + i % 26;
+		document.replace (1 + i, 0, &c, 1);
+	}
+
+	std::size_t cursor;
+	CHECK (document.undo (cursor));
+	CHECK (contents (document) == "ab");
+	CHECK (cursor == 1);
+	CHECK (!document.undo (cursor));
+}
+}
+
+int main ()
+{
+	randomEdits ();
+	undoRedoAll ();
+	typingCoalesces ();
+}
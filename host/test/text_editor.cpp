@@ -0,0 +1,133 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// TextEditor on the 3DS platform backend with stubbed HID: touching the editor doesn't bring up
+// the software keyboard, the D-pad moves the cursor, and the keyboard only opens on request and
+// inserts at the cursor without deactivating the editor.
+
+#include "test.h"
+
+#include "3ds/imgui_ctru.h"
+#include "3ds/imgui_text_editor.h"
+#include "stub.h"
+
+#include "imgui/imgui_internal.h"
+
+#include <string>
+
+namespace
+{
+/// \brief Editor under test
+imgui::TextEditor s_editor;
+
+/// \brief Whole document text
+std::string contents ()
+{
+	std::string text;
+	s_editor.document.copy (0, s_editor.document.size (), text);
+	return text;
+}
+
+/// \brief Scan stubbed HID and run one frame with the editor on the bottom screen
+void frame ()
+{
+	hidScanInput ();
+	imgui::ctru::newFrame ();
+	ImGui::NewFrame ();
+
+	// the touch screen maps to x 40-360 of the bottom half of the display
+	ImGui::SetNextWindowPos (ImVec2 (40.0f, 240.0f));
+	ImGui::SetNextWindowSize (ImVec2 (320.0f, 240.0f));
+	ImGui::Begin ("Editor", nullptr, ImGuiWindowFlags_NoDecoration);
+	s_editor.draw ("##text", ImVec2 (-FLT_MIN, -FLT_MIN));
+	ImGui::End ();
+
+	ImGui::EndFrame ();
+}
+
+/// \brief Press and release buttons
+/// \param buttons_ HID buttons
+void press (u32 const buttons_)
+{
+	stub::held = buttons_;
+	frame ();
+	stub::held = 0;
+	frame ();
+}
+
+/// \brief Whether the editor is the active item
+bool editorActive ()
+{
+	// the editor is the only item in its child window
+	auto const window = GImGui->ActiveIdWindow;
+	return GImGui->ActiveId && window && (window->Flags & ImGuiWindowFlags_ChildWindow);
+}
+}
+
+int main ()
+{
+	test::createContext ();
+	CHECK (imgui::ctru::init ());
+
+	s_editor.document.assign ("hello\nworld", 11);
+	frame ();
+
+	// touching the first line activates the editor, and doesn't open the keyboard
+	stub::touch = {30, 20};
+	stub::held  = KEY_TOUCH;
+	frame ();
+	frame ();
+	stub::held = 0;
+	for (int i = 0; i < 5; ++i)
+		frame ();
+	CHECK (editorActive ());
+	CHECK (stub::keyboardOpens == 0);
+
+	// D-pad moves the cursor: to the start of the line, two characters right, then down a line
+	for (int i = 0; i < 5; ++i)
+		press (KEY_DLEFT);
+	press (KEY_DRIGHT);
+	press (KEY_DRIGHT);
+	press (KEY_DDOWN);
+	CHECK (editorActive ());
+
+	// X opens the keyboard once; its text goes in at the cursor and the editor stays active
+	stub::keyboardText = "XY";
+	press (KEY_X);
+	for (int i = 0; i < 5; ++i)
+		frame ();
+	CHECK (stub::keyboardOpens == 1);
+	CHECK (contents () == "hello\nwoXYrld");
+	CHECK (editorActive ());
+
+	// the D-pad keeps editing after the keyboard closed
+	press (KEY_DLEFT);
+	stub::keyboardText = "!";
+	press (KEY_X);
+	for (int i = 0; i < 5; ++i)
+		frame ();
+	CHECK (stub::keyboardOpens == 2);
+	CHECK (contents () == "hello\nwoX!Yrld");
+
+	ImGui::DestroyContext ();
+}
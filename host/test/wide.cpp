@@ -0,0 +1,301 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+
+// Wide mode (800x480) against the stubs: the citro3d backend scissors and projects the 800px top
+// screen and the 320px bottom screen centered beneath it, touches land on that centered bottom
+// screen, the gamepad reaches the right half of the top screen, and the demo gives wide mode up
+// only after enough consecutive frames over its GPU budget.
+
+#include "test.h"
+
+#include "3ds/imgui_citro3d.h"
+#include "3ds/imgui_ctru.h"
+#include "stub.h"
+#include "wide_mode.h"
+
+#include <cmath>
+
+namespace
+{
+/// \brief Display size in wide mode
+constexpr auto WIDE_SIZE = ImVec2 (800.0f, 480.0f);
+
+/// \brief Top screen render target
+C3D_RenderTarget s_top{GFX_TOP, GFX_LEFT};
+/// \brief Bottom screen render target
+C3D_RenderTarget s_bottom{GFX_BOTTOM, GFX_LEFT};
+
+/// \brief Whether two points are the same, within float rounding
+bool same (ImVec2 const &a_, ImVec2 const &b_)
+{
+	return std::fabs (a_.x - b_.x) < 1e-5f && std::fabs (a_.y - b_.y) < 1e-5f;
+}
+
+/// \brief Map a point through a recorded projection to clip space
+/// \param mtx_ Projection
+/// \param pos_ Point
+ImVec2 project (C3D_Mtx const &mtx_, ImVec2 const &pos_)
+{
+	return ImVec2 (mtx_.m[0] * pos_.x + mtx_.m[1] * pos_.y + mtx_.m[3],
+	    mtx_.m[4] * pos_.x + mtx_.m[5] * pos_.y + mtx_.m[7]);
+}
+
+/// \brief The only draw recorded on a render target
+/// \param target_ Render target
+stub::Draw const &onlyDraw (C3D_RenderTarget const *const target_)
+{
+	stub::Draw const *result = nullptr;
+	for (auto const &draw : stub::draws)
+	{
+		if (draw.target != target_)
+			continue;
+
+		CHECK (!result);
+		result = &draw;
+	}
+
+	CHECK (result);
+	return *result;
+}
+
+/// \brief A rectangle drawn with its own clip rect, so it is a draw call of its own
+struct ClippedRect
+{
+	/// \brief Top left
+	ImVec2 min;
+	/// \brief Bottom right
+	ImVec2 max;
+};
+
+/// \brief Right half of the top screen, which only exists in wide mode
+constexpr ClippedRect TOP_RIGHT{{600.0f, 20.0f}, {700.0f, 120.0f}};
+/// \brief Bottom screen
+constexpr ClippedRect BOTTOM{{300.0f, 300.0f}, {400.0f, 400.0f}};
+/// \brief Beneath the top screen, left of the bottom screen: drawn nowhere
+constexpr ClippedRect OFF_SCREEN{{100.0f, 300.0f}, {200.0f, 400.0f}};
+
+/// \brief The citro3d backend scissors and projects both screens at 800px
+void render ()
+{
+	C3D_Init (C3D_DEFAULT_CMDBUF_SIZE);
+	test::createContext (WIDE_SIZE);
+	imgui::citro3d::init ();
+
+	for (int i = 0; i < 3; ++i)
+	{
+		C3D_FrameBegin (0);
+		ImGui::NewFrame ();
+
+		ImGui::SetNextWindowPos (ImVec2 (0.0f, 0.0f));
+		ImGui::SetNextWindowSize (WIDE_SIZE);
+		ImGui::Begin ("Rects", nullptr, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoBackground);
+		auto const list = ImGui::GetWindowDrawList ();
+		for (auto const &rect : {TOP_RIGHT, BOTTOM, OFF_SCREEN})
+		{
+			list->PushClipRect (rect.min, rect.max);
+			list->AddRectFilled (rect.min, rect.max, IM_COL32_WHITE);
+			list->PopClipRect ();
+		}
+		ImGui::End ();
+
+		ImGui::Render ();
+		imgui::citro3d::render (&s_top, &s_bottom);
+		C3D_FrameEnd (0);
+	}
+
+	// scissors are in rotated screen space: (left, top, right, bottom) counts from the screen's
+	// bottom edge and its right edge, which is x = 800 on the top screen and x = 560 on the bottom
+	// screen; the off-screen rectangle isn't drawn at all
+	CHECK (stub::draws.size () == 2);
+	auto const &top = onlyDraw (&s_top);
+	CHECK (top.scissor[0] == 240 - 120 && top.scissor[1] == 800 - 700);
+	CHECK (top.scissor[2] == 240 - 20 && top.scissor[3] == 800 - 600);
+	auto const &bottom = onlyDraw (&s_bottom);
+	CHECK (bottom.scissor[0] == 480 - 400 && bottom.scissor[1] == 560 - 400);
+	CHECK (bottom.scissor[2] == 480 - 300 && bottom.scissor[3] == 560 - 300);
+
+	// each screen's corners project to the corners of clip space, x on screen being y in clip
+	// space: the top screen is 800x240 and the bottom screen 320x240 from x = 240
+	CHECK (same (project (top.projection, ImVec2 (0.0f, 0.0f)), ImVec2 (1.0f, 1.0f)));
+	CHECK (same (project (top.projection, ImVec2 (800.0f, 240.0f)), ImVec2 (-1.0f, -1.0f)));
+	CHECK (same (project (bottom.projection, ImVec2 (240.0f, 240.0f)), ImVec2 (1.0f, 1.0f)));
+	CHECK (same (project (bottom.projection, ImVec2 (560.0f, 480.0f)), ImVec2 (-1.0f, -1.0f)));
+
+	// so the rectangles land where they were drawn
+	CHECK (same (project (top.projection, TOP_RIGHT.min), ImVec2 (1.0f - 20.0f / 120.0f, -0.5f)));
+	CHECK (same (project (bottom.projection, BOTTOM.max), ImVec2 (1.0f - 160.0f / 120.0f, 0.0f)));
+
+	imgui::citro3d::exit ();
+	ImGui::DestroyContext ();
+	C3D_Fini ();
+}
+
+/// \brief Scan stubbed HID and run one frame
+/// \param draw_ Called between NewFrame and EndFrame to submit the frame's contents
+template <typename F>
+void frame (F &&draw_)
+{
+	hidScanInput ();
+	imgui::ctru::newFrame ();
+	ImGui::NewFrame ();
+	draw_ ();
+	ImGui::EndFrame ();
+}
+
+/// \brief Touches land on the bottom screen centered beneath the 800px top screen, and the
+/// gamepad reaches the right half of the top screen
+void input ()
+{
+	test::createContext (WIDE_SIZE);
+	CHECK (imgui::ctru::init ());
+	auto const &io = ImGui::GetIO ();
+
+	// a button filling the bottom screen and one on each half of the top screen
+	auto clicked    = 0;
+	auto rightPress = 0;
+	auto const windows = [&] {
+		ImGui::SetNextWindowPos (ImVec2 (240.0f, 240.0f));
+		ImGui::SetNextWindowSize (ImVec2 (320.0f, 240.0f));
+		ImGui::Begin ("Bottom", nullptr, ImGuiWindowFlags_NoDecoration);
+		ImGui::SetCursorScreenPos (ImVec2 (240.0f, 240.0f));
+		if (ImGui::InvisibleButton ("Touch", ImVec2 (320.0f, 240.0f)))
+			++clicked;
+		ImGui::End ();
+
+		ImGui::SetNextWindowPos (ImVec2 (0.0f, 0.0f));
+		ImGui::SetNextWindowSize (ImVec2 (800.0f, 240.0f));
+		ImGui::Begin ("Top", nullptr, ImGuiWindowFlags_NoDecoration);
+		ImGui::SetCursorScreenPos (ImVec2 (20.0f, 20.0f));
+		ImGui::Button ("Left", ImVec2 (100.0f, 40.0f));
+		ImGui::SameLine (680.0f);
+		if (ImGui::Button ("Right", ImVec2 (100.0f, 40.0f)))
+			++rightPress;
+		ImGui::End ();
+	};
+
+	frame (windows);
+
+	// a drag over the corners of the bottom screen
+	struct
+	{
+		touchPosition touch;
+		ImVec2 pos;
+	} const corners[] = {
+	    {{0, 0}, {240.0f, 240.0f}},
+	    {{319, 0}, {559.0f, 240.0f}},
+	    {{319, 239}, {559.0f, 479.0f}},
+	    {{0, 239}, {240.0f, 479.0f}},
+	};
+	for (auto const &corner : corners)
+	{
+		stub::held  = KEY_TOUCH;
+		stub::touch = corner.touch;
+		// ImGui trickles the button press and the move that follows it over two frames
+		frame (windows);
+		frame (windows);
+		CHECK (same (io.MousePos, corner.pos));
+	}
+	stub::held = 0;
+	frame (windows);
+	frame (windows);
+
+	// a tap in the middle of the bottom screen clicks what is there
+	stub::held  = KEY_TOUCH;
+	stub::touch = touchPosition{160, 120};
+	frame (windows);
+	frame (windows);
+	CHECK (same (io.MousePos, ImVec2 (400.0f, 360.0f)));
+
+	// the late-latched touch moves by what the touch moved, wherever the bottom screen is
+	ImVec2 delta;
+	stub::setLatestTouch (touchPosition{170, 125}, true);
+	CHECK (imgui::ctru::lateLatchTouch (delta));
+	CHECK (same (delta, ImVec2 (10.0f, 5.0f)));
+
+	stub::held = 0;
+	frame (windows);
+	frame (windows);
+	CHECK (clicked == 1);
+
+	// the D-pad puts the nav cursor on the top screen, then moves it right, past x = 400
+	ImGui::SetWindowFocus ("Top");
+	for (auto const key : {KEY_DRIGHT, KEY_DRIGHT, KEY_A})
+	{
+		stub::held = key;
+		frame (windows);
+		stub::held = 0;
+		frame (windows);
+	}
+	CHECK (rightPress == 1);
+
+	ImGui::DestroyContext ();
+}
+
+/// \brief Wide mode is given up after OVER_BUDGET_FRAMES consecutive wide frames over budget, and
+/// not for frames in budget, at exactly the budget or in 400px mode
+void budget ()
+{
+	using namespace wide_mode;
+
+	Budget budget;
+	for (unsigned i = 1; i < OVER_BUDGET_FRAMES; ++i)
+		CHECK (!budget.frame (true, GPU_BUDGET + 0.1f));
+	CHECK (budget.frame (true, GPU_BUDGET + 0.1f));
+
+	// a frame in budget starts over; so does one at exactly the budget
+	for (auto const gpuTime : {GPU_BUDGET - 1.0f, GPU_BUDGET})
+	{
+		budget.reset ();
+		for (unsigned i = 1; i < OVER_BUDGET_FRAMES; ++i)
+			CHECK (!budget.frame (true, GPU_BUDGET + 0.1f));
+		CHECK (!budget.frame (true, gpuTime));
+		for (unsigned i = 1; i < OVER_BUDGET_FRAMES; ++i)
+			CHECK (!budget.frame (true, GPU_BUDGET + 0.1f));
+		CHECK (budget.frame (true, GPU_BUDGET + 0.1f));
+	}
+
+	// 400px frames never count, however slow, and they start over too
+	budget.reset ();
+	for (unsigned i = 1; i < OVER_BUDGET_FRAMES; ++i)
+		CHECK (!budget.frame (true, GPU_BUDGET + 0.1f));
+	for (unsigned i = 0; i < 2 * OVER_BUDGET_FRAMES; ++i)
+		CHECK (!budget.frame (false, 2 * GPU_BUDGET));
+	CHECK (!budget.frame (true, GPU_BUDGET + 0.1f));
+
+	// a mode change starts over
+	budget.reset ();
+	for (unsigned i = 1; i < OVER_BUDGET_FRAMES; ++i)
+		CHECK (!budget.frame (true, GPU_BUDGET + 0.1f));
+	budget.reset ();
+	CHECK (!budget.frame (true, GPU_BUDGET + 0.1f));
+}
+}
+
+int main ()
+{
+	render ();
+	input ();
+	budget ();
+}
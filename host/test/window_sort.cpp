@@ -0,0 +1,225 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+// Window display order: with IMGUI_ENABLE_WINDOW_SORT_CACHE, EndFrame() must leave g.Windows in
+// the order the full recursive sort produces, through random churn and through steady phases
+// where only the children's submission order changes.
+
+#include "test.h"
+
+#include "imgui/imgui_internal.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace
+{
+/// \brief Random number source, seeded so failures reproduce
+std::mt19937 s_rng (1234);
+
+/// \brief Children of each window, as submitted, for the reference sort
+std::map<ImGuiWindow *, std::vector<ImGuiWindow *>> s_children;
+
+/// \brief Whether leaf children are submitted in reverse order this frame
+bool s_reverseLeaves = false;
+
+/// \brief Random integer in [0, max_)
+int random (int const max_)
+{
+	return std::uniform_int_distribution<int> (0, max_ - 1) (s_rng);
+}
+
+/// \brief Child window order used by EndFrame(): popups, then tooltips, after regular children
+bool childLess (ImGuiWindow const *const lhs_, ImGuiWindow const *const rhs_)
+{
+	auto const lhsPopup = (lhs_->Flags & ImGuiWindowFlags_Popup) != 0;
+	auto const rhsPopup = (rhs_->Flags & ImGuiWindowFlags_Popup) != 0;
+	if (lhsPopup != rhsPopup)
+		return rhsPopup;
+
+	auto const lhsTooltip = (lhs_->Flags & ImGuiWindowFlags_Tooltip) != 0;
+	auto const rhsTooltip = (rhs_->Flags & ImGuiWindowFlags_Tooltip) != 0;
+	if (lhsTooltip != rhsTooltip)
+		return rhsTooltip;
+
+	return lhs_->BeginOrderWithinParent < rhs_->BeginOrderWithinParent;
+}
+
+/// \brief Reference sort: append a window and its sorted active children, recursively
+void addToSortBuffer (std::vector<ImGuiWindow *> &out_, ImGuiWindow *const window_)
+{
+	out_.emplace_back (window_);
+	if (!window_->Active)
+		return;
+
+	auto &children = s_children[window_];
+	std::stable_sort (children.begin (), children.end (), childLess);
+	for (auto const &child : children)
+	{
+		if (child->Active)
+			addToSortBuffer (out_, child);
+	}
+}
+
+/// \brief Submit up to 4 children, each with up to 2 more levels, some as pinned child tooltips
+/// \param depth_ Nesting depth
+/// \param root_ Root window index
+/// \param path_ Child path, for unique tooltip names
+void submitChildren (int const depth_, int const root_, int const path_)
+{
+	auto const count = random (5);
+
+	int order[5] = {0, 1, 2, 3, 4};
+	if (random (4) == 0)
+		std::shuffle (std::begin (order), std::end (order), s_rng);
+
+	int kind[5];
+	ImVec2 pos[5];
+	for (int i = 0; i < count; ++i)
+	{
+		kind[i] = random (10) == 0 ? 0 : random (12) == 0 ? 1 : 2;
+		pos[i]  = ImVec2 (random (300), random (200));
+	}
+
+	for (int j = 0; j < count; ++j)
+	{
+		// only leaf children get their submission order swapped
+		auto const i = (s_reverseLeaves && depth_ == 2) ? count - 1 - j : j;
+		if (kind[i] == 0)
+			continue;
+
+		char name[32];
+		if (kind[i] == 1)
+		{
+			// pinned child tooltip, sorts after regular children
+			std::snprintf (name, sizeof (name), "##tooltip%d_%d", root_, path_ * 5 + order[i]);
+			ImGui::SetNextWindowPos (pos[i]);
+			ImGui::Begin (name,
+			    nullptr,
+			    ImGuiWindowFlags_ChildWindow | ImGuiWindowFlags_Tooltip | ImGuiWindowFlags_NoTitleBar |
+			        ImGuiWindowFlags_NoInputs);
+			ImGui::TextUnformatted ("tooltip");
+			GImGui->WithinEndChild = true;
+			ImGui::End ();
+			GImGui->WithinEndChild = false;
+			continue;
+		}
+
+		std::snprintf (name, sizeof (name), "child%d", order[i]);
+		ImGui::BeginChild (name, ImVec2 (40.0f, 30.0f), ImGuiChildFlags_Borders);
+		if (depth_ < 2)
+			submitChildren (depth_ + 1, root_, path_ * 5 + order[i]);
+		ImGui::EndChild ();
+	}
+}
+}
+
+int main ()
+{
+	test::createContext ();
+
+	auto &io = ImGui::GetIO ();
+	auto &g  = *GImGui;
+
+	std::mt19937::result_type phaseSeed = 0;
+	for (int frame = 0; frame < 4000; ++frame)
+	{
+		// no clicks: EndFrame() would refocus the clicked window after the reference snapshot below,
+		// focus changes come from SetNextWindowFocus() and FocusWindow() instead
+		io.AddMousePosEvent (random (400), random (480));
+		ImGui::NewFrame ();
+
+		// alternate phases of random churn and steady frames; some steady phases only swap the
+		// submission order of leaf children
+		auto const steady = (frame / 50) % 2 == 1;
+		s_reverseLeaves   = steady && (frame / 100) % 2 == 1 && (frame & 1);
+
+		auto const roots = 3 + (steady ? 5 : random (6));
+		if (frame % 50 == 0)
+			phaseSeed = s_rng ();
+
+		// steady frames replay the same submissions
+		auto const savedRng = s_rng;
+		if (steady)
+			s_rng.seed (phaseSeed);
+
+		for (int r = 0; r < roots; ++r)
+		{
+			if (!steady && random (6) == 0)
+				continue;
+
+			char name[16];
+			std::snprintf (name, sizeof (name), "Root %d", r);
+			if (random (20) == 0)
+				ImGui::SetNextWindowFocus ();
+			ImGui::SetNextWindowPos (ImVec2 (r * 30.0f, r * 20.0f), ImGuiCond_Once);
+			ImGui::Begin (name, nullptr, r == 1 ? ImGuiWindowFlags_NoBringToFrontOnFocus : 0);
+			submitChildren (0, r, 0);
+			ImGui::End ();
+		}
+
+		if (steady)
+			s_rng = savedRng;
+		else if (random (10) == 0)
+			ImGui::TextUnformatted ("implicit debug window");
+
+		if (!steady && random (15) == 0 && !g.Windows.empty ())
+		{
+			auto const window = g.Windows[random (g.Windows.Size)];
+			if (!(window->Flags & ImGuiWindowFlags_Tooltip) && window->WasActive)
+				ImGui::FocusWindow (window);
+		}
+
+		std::vector<ImGuiWindow *> const windows (g.Windows.begin (), g.Windows.end ());
+		ImGui::EndFrame ();
+
+		// the reference runs on the children as submitted; EndFrame() may have activated the
+		// implicit debug window, so take the inputs after it
+		s_children.clear ();
+		for (auto const &window : windows)
+			s_children[window].assign (window->DC.ChildWindows.begin (), window->DC.ChildWindows.end ());
+
+		std::vector<ImGuiWindow *> expected;
+		for (auto const &window : windows)
+		{
+			if (window->Active && (window->Flags & ImGuiWindowFlags_ChildWindow))
+				continue;
+			addToSortBuffer (expected, window);
+		}
+
+		CHECK (std::equal (g.Windows.begin (), g.Windows.end (), expected.begin (), expected.end ()));
+		for (auto const &window : windows)
+		{
+			if (window->Active)
+				CHECK (std::is_sorted (
+				    window->DC.ChildWindows.begin (), window->DC.ChildWindows.end (), childLess));
+		}
+
+		ImGui::Render ();
+	}
+
+	ImGui::DestroyContext ();
+}
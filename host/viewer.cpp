@@ -0,0 +1,360 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+
+// Remote UI viewer for the host: connects to a 3DS streaming with imgui::remote, renders every
+// decoded frame with the software renderer in a GLUT window and sends the mouse back to the device
+// as touch input.
+//
+//   viewer [--headless] address [port]
+//
+// The 3DS glyph sheets aren't streamed, so text shows as solid glyph boxes. Built without GLUT, or
+// run with --headless, the viewer prints a summary of each frame instead and takes input as
+// "x y buttons" lines on stdin (display space, button bitmask), e.g. "120 80 1" then "120 80 0" to
+// tap at (120,80).
+
+#include "raster.h"
+
+#include "3ds/imgui_remote.h"
+
+#ifdef VIEWER_GL
+#include <GL/glut.h>
+#endif
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <memory>
+#include <vector>
+
+namespace
+{
+/// \brief Default port, as in source/main.cpp
+constexpr std::uint16_t DEFAULT_PORT = 5001;
+
+/// \brief Connection to the device
+int s_fd = -1;
+/// \brief Received bytes not decoded yet
+std::vector<std::uint8_t> s_buffer;
+/// \brief Decoder
+std::unique_ptr<imgui::remote::Decoder> s_decoder;
+/// \brief Frames decoded
+unsigned s_frames = 0;
+
+/// \brief Print a summary of a decoded frame
+/// \param frame_ Frame number
+/// \param drawData_ Decoded draw data
+/// \param wireBytes_ Size of the frame message
+/// \param rawBytes_ Size of the payload after decompression
+void print (unsigned const frame_,
+    ImDrawData const &drawData_,
+    std::size_t const wireBytes_,
+    std::size_t const rawBytes_)
+{
+	unsigned commands = 0;
+	for (auto const &cmdList : drawData_.CmdLists)
+		commands += cmdList->CmdBuffer.Size;
+
+	std::printf ("frame %u: %d lists, %d vertices, %d indices, %u commands, %zu bytes (%zu raw)\n",
+	    frame_,
+	    drawData_.CmdListsCount,
+	    drawData_.TotalVtxCount,
+	    drawData_.TotalIdxCount,
+	    commands,
+	    wireBytes_,
+	    rawBytes_);
+	std::fflush (stdout);
+}
+
+/// \brief Send input to the device
+/// \param x_ Mouse position in display space
+/// \param y_ Mouse position in display space
+/// \param buttons_ Mouse button bitmask
+bool sendInput (float const x_, float const y_, std::uint32_t const buttons_)
+{
+	imgui::remote::InputMessage const msg{imgui::remote::INPUT_MAGIC, x_, y_, buttons_};
+	return ::send (s_fd, &msg, sizeof (msg), 0) == sizeof (msg);
+}
+
+/// \brief Forward an input line to the device
+/// \param line_ "x y buttons"
+bool forward (char const *const line_)
+{
+	float x;
+	float y;
+	unsigned buttons;
+	if (std::sscanf (line_, "%f %f %u", &x, &y, &buttons) != 3)
+	{
+		std::fprintf (stderr, "expected \"x y buttons\"\n");
+		return true;
+	}
+
+	return sendInput (x, y, buttons);
+}
+
+/// \brief Receive what the socket has and decode complete frame messages
+/// \param verbose_ Whether to print a summary of each frame
+/// \param decoded_ Set when a frame was decoded
+/// \returns Whether the connection is still good
+bool receive (bool const verbose_, bool &decoded_)
+{
+	std::uint8_t chunk[16 * 1024];
+	auto const rc = ::recv (s_fd, chunk, sizeof (chunk), 0);
+	if (rc <= 0)
+		return false;
+	s_buffer.insert (std::end (s_buffer), chunk, chunk + rc);
+
+	std::size_t pos = 0;
+	while (s_buffer.size () - pos >= sizeof (imgui::remote::FrameHeader))
+	{
+		imgui::remote::FrameHeader header;
+		std::memcpy (&header, &s_buffer[pos], sizeof (header));
+		if (header.magic != imgui::remote::FRAME_MAGIC)
+		{
+			std::fprintf (stderr, "bad frame magic\n");
+			return false;
+		}
+
+		auto const size = sizeof (header) + header.compressedSize;
+		if (s_buffer.size () - pos < size)
+			break;
+
+		if (!s_decoder->decode (&s_buffer[pos], size))
+		{
+			std::fprintf (stderr, "failed to decode frame %u\n", s_frames);
+			return false;
+		}
+
+		if (verbose_)
+			print (s_frames, s_decoder->drawData (), size, header.rawSize);
+
+		++s_frames;
+		decoded_ = true;
+		pos += size;
+	}
+
+	s_buffer.erase (std::begin (s_buffer), std::begin (s_buffer) + pos);
+	return true;
+}
+
+/// \brief Print frame summaries and forward stdin until the device disconnects
+void runHeadless ()
+{
+	struct pollfd fds[2] = {{s_fd, POLLIN, 0}, {STDIN_FILENO, POLLIN, 0}};
+	auto nfds            = 2;
+	while (::poll (fds, nfds, -1) >= 0)
+	{
+		if (fds[1].revents & (POLLIN | POLLHUP))
+		{
+			char line[128];
+			if (!std::fgets (line, sizeof (line), stdin))
+				nfds = 1; // stdin closed; keep receiving
+			else if (!forward (line))
+				break;
+		}
+
+		bool decoded = false;
+		if ((fds[0].revents & (POLLIN | POLLHUP)) && !receive (true, decoded))
+			break;
+	}
+}
+
+#ifdef VIEWER_GL
+/// \brief Last rendered frame
+raster::Image s_image;
+/// \brief Rows of s_image bottom-up, as glDrawPixels takes them
+std::vector<std::uint8_t> s_flipped;
+/// \brief Mouse buttons held
+std::uint32_t s_buttons = 0;
+
+/// \brief Shut down when the device goes away
+void disconnected ()
+{
+	::close (s_fd);
+	s_decoder.reset ();
+	ImGui::DestroyContext ();
+	std::exit (EXIT_SUCCESS);
+}
+
+/// \brief Send the mouse to the device
+/// \param x_ Window x
+/// \param y_ Window y
+void sendMouse (int const x_, int const y_)
+{
+	// the window shows the framebuffer 1:1
+	auto const &drawData = s_decoder->drawData ();
+	auto const scale     = drawData.FramebufferScale;
+	auto const x         = drawData.DisplayPos.x + x_ / (scale.x > 0.0f ? scale.x : 1.0f);
+	auto const y         = drawData.DisplayPos.y + y_ / (scale.y > 0.0f ? scale.y : 1.0f);
+	if (!sendInput (x, y, s_buttons))
+		disconnected ();
+}
+
+/// \brief GLUT display callback
+void display ()
+{
+	glClear (GL_COLOR_BUFFER_BIT);
+
+	auto const stride = s_image.width * 3;
+	s_flipped.resize (s_image.rgb.size ());
+	for (unsigned y = 0; y < s_image.height; ++y)
+		std::memcpy (&s_flipped[y * stride], &s_image.rgb[(s_image.height - 1 - y) * stride], stride);
+
+	glPixelStorei (GL_UNPACK_ALIGNMENT, 1);
+	glRasterPos2i (0, std::max (glutGet (GLUT_WINDOW_HEIGHT) - static_cast<int> (s_image.height), 0));
+	glDrawPixels (s_image.width, s_image.height, GL_RGB, GL_UNSIGNED_BYTE, s_flipped.data ());
+	glutSwapBuffers ();
+}
+
+/// \brief GLUT reshape callback: one unit per window pixel, origin bottom left
+void reshape (int const width_, int const height_)
+{
+	glViewport (0, 0, width_, height_);
+	glMatrixMode (GL_PROJECTION);
+	glLoadIdentity ();
+	glOrtho (0.0, width_, 0.0, height_, -1.0, 1.0);
+	glMatrixMode (GL_MODELVIEW);
+	glLoadIdentity ();
+}
+
+/// \brief GLUT idle callback: receive, decode and render frames
+void idle ()
+{
+	struct pollfd fd = {s_fd, POLLIN, 0};
+	if (::poll (&fd, 1, 5) <= 0 || !(fd.revents & (POLLIN | POLLHUP)))
+		return;
+
+	bool decoded = false;
+	if (!receive (false, decoded))
+		disconnected ();
+	if (!decoded)
+		return;
+
+	auto const width  = s_image.width;
+	auto const height = s_image.height;
+	raster::render (s_decoder->drawData (), {}, s_image);
+	if (s_image.width != width || s_image.height != height)
+		glutReshapeWindow (s_image.width, s_image.height);
+
+	glutPostRedisplay ();
+}
+
+/// \brief GLUT mouse button callback
+void mouse (int const button_, int const state_, int const x_, int const y_)
+{
+	if (button_ != GLUT_LEFT_BUTTON)
+		return;
+
+	if (state_ == GLUT_DOWN)
+		s_buttons |= 1;
+	else
+		s_buttons &= ~1u;
+
+	sendMouse (x_, y_);
+}
+
+/// \brief GLUT mouse motion callback, with or without buttons held
+void motion (int const x_, int const y_)
+{
+	sendMouse (x_, y_);
+}
+
+/// \brief Show frames in a window and send the mouse until the device disconnects
+void runWindow (int &argc_, char *argv_[])
+{
+	glutInit (&argc_, argv_);
+	glutInitDisplayMode (GLUT_RGB | GLUT_DOUBLE);
+	glutInitWindowSize (400, 480);
+	glutCreateWindow ("3DS remote UI");
+
+	glutDisplayFunc (&display);
+	glutReshapeFunc (&reshape);
+	glutIdleFunc (&idle);
+	glutMouseFunc (&mouse);
+	glutMotionFunc (&motion);
+	glutPassiveMotionFunc (&motion);
+	glutMainLoop ();
+}
+#endif
+}
+
+int main (int argc_, char *argv_[])
+{
+	auto headless = false;
+	auto arg      = 1;
+	if (argc_ > 1 && std::strcmp (argv_[1], "--headless") == 0)
+	{
+		headless = true;
+		++arg;
+	}
+
+#ifndef VIEWER_GL
+	headless = true;
+#endif
+
+	if (argc_ <= arg)
+	{
+		std::fprintf (stderr, "usage: %s [--headless] address [port]\n", argv_[0]);
+		return EXIT_FAILURE;
+	}
+
+	struct sockaddr_in addr;
+	std::memset (&addr, 0, sizeof (addr));
+	addr.sin_family = AF_INET;
+	addr.sin_port = htons (argc_ > arg + 1 ? std::strtoul (argv_[arg + 1], nullptr, 0) : DEFAULT_PORT);
+	if (::inet_pton (AF_INET, argv_[arg], &addr.sin_addr) != 1)
+	{
+		std::fprintf (stderr, "invalid address %s\n", argv_[arg]);
+		return EXIT_FAILURE;
+	}
+
+	s_fd = ::socket (AF_INET, SOCK_STREAM, 0);
+	if (s_fd < 0 || ::connect (s_fd, reinterpret_cast<struct sockaddr *> (&addr), sizeof (addr)) != 0)
+	{
+		std::perror ("connect");
+		return EXIT_FAILURE;
+	}
+
+	// the decoder builds its draw lists against a context's shared data
+	ImGui::CreateContext ();
+	s_decoder = std::make_unique<imgui::remote::Decoder> ();
+
+#ifdef VIEWER_GL
+	if (!headless)
+		runWindow (argc_, argv_);
+#endif
+
+	runHeadless ();
+
+	::close (s_fd);
+	s_decoder.reset ();
+	ImGui::DestroyContext ();
+	return EXIT_SUCCESS;
+}
@@ -0,0 +1,10 @@
+# ImGui options this app is built with (see source/imgui/imconfig.h)
+IMGUI_OPTIONS := -DIMGUI_ENABLE_HOVER_GRID \
+                 -DIMGUI_ENABLE_INPUT_COALESCING \
+                 -DIMGUI_ENABLE_WINDOW_SORT_CACHE \
+                 -DIMGUI_ENABLE_WINDOW_HOT_DATA \
+                 -DIMGUI_ENABLE_DRAWLIST_CAPACITY_PREDICTION \
+                 -DIMGUI_ENABLE_BOX_SELECT_RANGES \
+                 -DIMGUI_ENABLE_TABLE_COLUMNS_SOA \
+                 -DIMGUI_ENABLE_DETACHED_DRAWLISTS \
+                 -DIMGUI_ENABLE_LITERAL_IDS
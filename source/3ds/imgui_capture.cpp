@@ -0,0 +1,372 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "imgui_capture.h"
+
+#include <algorithm>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+/// \brief Capture file
+std::FILE *s_file = nullptr;
+/// \brief Frames left to capture
+unsigned s_framesLeft = 0;
+/// \brief Frame index
+std::vector<imgui::capture::FrameEntry> s_index;
+/// \brief Current file offset
+std::uint32_t s_offset = 0;
+
+/// \brief Texture IDs seen so far; index is the handle
+std::vector<ImTextureID> s_textures;
+
+/// \brief Frame being serialized
+std::vector<std::uint8_t> s_buffer;
+
+/// \brief Round up to 4-byte alignment
+/// \param size_ Size to align
+constexpr std::size_t align4 (std::size_t const size_)
+{
+	return (size_ + 3) & ~std::size_t (3);
+}
+
+/// \brief Append raw bytes, padded to 4-byte alignment
+/// \param data_ Data to append
+/// \param size_ Size of data
+void put (void const *const data_, std::size_t const size_)
+{
+	auto const base = s_buffer.size ();
+	s_buffer.resize (base + align4 (size_));
+	if (size_)
+		std::memcpy (&s_buffer[base], data_, size_);
+}
+
+/// \brief Map texture ID to a stable handle
+/// \param texture_ Texture ID
+std::uint32_t textureHandle (ImTextureID const texture_)
+{
+	auto const it = std::find (std::begin (s_textures), std::end (s_textures), texture_);
+	if (it != std::end (s_textures))
+		return std::distance (std::begin (s_textures), it);
+
+	s_textures.emplace_back (texture_);
+	return s_textures.size () - 1;
+}
+
+/// \brief Write data to capture file
+/// \param data_ Data to write
+/// \param size_ Size of data
+bool write (void const *const data_, std::size_t const size_)
+{
+	if (std::fwrite (data_, 1, size_, s_file) != size_)
+		return false;
+
+	s_offset += size_;
+	return true;
+}
+}
+
+bool imgui::capture::start (char const *const path_, unsigned const frames_)
+{
+	if (s_file)
+		stop ();
+
+	s_file = std::fopen (path_, "wb");
+	if (!s_file)
+		return false;
+
+	s_framesLeft = frames_;
+	s_offset     = 0;
+	s_index.clear ();
+
+	// handle 0 is always the font atlas
+	s_textures.clear ();
+	s_textures.emplace_back (ImGui::GetIO ().Fonts->TexID);
+
+	// placeholder header; rewritten by stop ()
+	FileHeader header{};
+	if (!write (&header, sizeof (header)))
+	{
+		std::fclose (s_file);
+		s_file = nullptr;
+		return false;
+	}
+
+	return true;
+}
+
+void imgui::capture::stop ()
+{
+	if (!s_file)
+		return;
+
+	FileHeader header;
+	header.magic       = FILE_MAGIC;
+	header.version     = FILE_VERSION;
+	header.frameCount  = s_index.size ();
+	header.indexOffset = s_offset;
+
+	write (s_index.data (), s_index.size () * sizeof (FrameEntry));
+
+	std::fseek (s_file, 0, SEEK_SET);
+	std::fwrite (&header, sizeof (header), 1, s_file);
+	std::fclose (s_file);
+
+	s_file       = nullptr;
+	s_framesLeft = 0;
+	s_index.clear ();
+}
+
+bool imgui::capture::active ()
+{
+	return s_file;
+}
+
+void imgui::capture::frame (ImDrawData const *const drawData_)
+{
+	if (!s_file || !drawData_)
+		return;
+
+	s_buffer.clear ();
+
+	FrameHeader frameHeader;
+	frameHeader.displayPos[0]       = drawData_->DisplayPos.x;
+	frameHeader.displayPos[1]       = drawData_->DisplayPos.y;
+	frameHeader.displaySize[0]      = drawData_->DisplaySize.x;
+	frameHeader.displaySize[1]      = drawData_->DisplaySize.y;
+	frameHeader.framebufferScale[0] = drawData_->FramebufferScale.x;
+	frameHeader.framebufferScale[1] = drawData_->FramebufferScale.y;
+	frameHeader.listCount           = drawData_->CmdListsCount;
+	frameHeader.reserved            = 0;
+	put (&frameHeader, sizeof (frameHeader));
+
+	for (int i = 0; i < drawData_->CmdListsCount; ++i)
+	{
+		auto const &cmdList = *drawData_->CmdLists[i];
+
+		// callbacks can't be replayed; count the rest first
+		ListHeader listHeader;
+		listHeader.vtxCount = cmdList.VtxBuffer.Size;
+		listHeader.idxCount = cmdList.IdxBuffer.Size;
+		listHeader.cmdCount = std::count_if (std::begin (cmdList.CmdBuffer),
+		    std::end (cmdList.CmdBuffer),
+		    [] (auto const &cmd_) { return !cmd_.UserCallback; });
+		listHeader.reserved = 0;
+		put (&listHeader, sizeof (listHeader));
+
+		for (auto const &cmd : cmdList.CmdBuffer)
+		{
+			if (cmd.UserCallback)
+				continue;
+
+			Command packed;
+			packed.clipRect[0] = cmd.ClipRect.x;
+			packed.clipRect[1] = cmd.ClipRect.y;
+			packed.clipRect[2] = cmd.ClipRect.z;
+			packed.clipRect[3] = cmd.ClipRect.w;
+			packed.texture     = textureHandle (cmd.TextureId);
+			packed.vtxOffset   = cmd.VtxOffset;
+			packed.idxOffset   = cmd.IdxOffset;
+			packed.elemCount   = cmd.ElemCount;
+			put (&packed, sizeof (packed));
+		}
+
+		put (cmdList.VtxBuffer.Data, sizeof (ImDrawVert) * cmdList.VtxBuffer.Size);
+		put (cmdList.IdxBuffer.Data, sizeof (ImDrawIdx) * cmdList.IdxBuffer.Size);
+	}
+
+	FrameEntry entry;
+	entry.offset = s_offset;
+	entry.size   = s_buffer.size ();
+	if (!write (s_buffer.data (), s_buffer.size ()))
+	{
+		// keep what we have so far
+		stop ();
+		return;
+	}
+
+	s_index.emplace_back (entry);
+	if (--s_framesLeft == 0)
+		stop ();
+}
+
+///////////////////////////////////////////////////////////////////////////
+imgui::capture::Replay::Replay () = default;
+
+imgui::capture::Replay::~Replay ()
+{
+	for (auto const &list : m_lists)
+		IM_DELETE (list);
+}
+
+bool imgui::capture::Replay::open (char const *const path_)
+{
+	m_data.clear ();
+	m_index.clear ();
+
+	auto const fp = std::fopen (path_, "rb");
+	if (!fp)
+		return false;
+
+	std::fseek (fp, 0, SEEK_END);
+	auto const size = std::ftell (fp);
+	std::fseek (fp, 0, SEEK_SET);
+
+	if (size > 0)
+	{
+		m_data.resize (size);
+		if (std::fread (m_data.data (), 1, size, fp) != static_cast<std::size_t> (size))
+			m_data.clear ();
+	}
+	std::fclose (fp);
+
+	FileHeader header;
+	if (m_data.size () < sizeof (header))
+		return false;
+
+	std::memcpy (&header, m_data.data (), sizeof (header));
+	if (header.magic != FILE_MAGIC || header.version != FILE_VERSION ||
+	    header.indexOffset > m_data.size () ||
+	    (m_data.size () - header.indexOffset) / sizeof (FrameEntry) < header.frameCount)
+		return false;
+
+	m_index.resize (header.frameCount);
+	std::memcpy (
+	    m_index.data (), &m_data[header.indexOffset], header.frameCount * sizeof (FrameEntry));
+
+	for (auto const &entry : m_index)
+	{
+		if (entry.offset > m_data.size () || m_data.size () - entry.offset < entry.size)
+		{
+			m_index.clear ();
+			return false;
+		}
+	}
+
+	return true;
+}
+
+unsigned imgui::capture::Replay::frameCount () const
+{
+	return m_index.size ();
+}
+
+ImDrawData *imgui::capture::Replay::frame (unsigned const index_)
+{
+	if (index_ >= m_index.size ())
+		return nullptr;
+
+	auto pos       = &m_data[m_index[index_].offset];
+	auto const end = pos + m_index[index_].size;
+
+	/// \brief Take next aligned section of count_ elements
+	/// \note The count is checked against the remaining bytes before multiplying, so a corrupt
+	/// count can't wrap the section size
+	auto const take = [&] (std::size_t const count_,
+	                      std::size_t const size_) -> std::uint8_t const * {
+		auto const remaining = static_cast<std::size_t> (end - pos);
+		if (count_ > remaining / size_ || remaining < align4 (count_ * size_))
+			return nullptr;
+
+		auto const section = pos;
+		pos += align4 (count_ * size_);
+		return section;
+	};
+
+	FrameHeader frameHeader;
+	auto section = take (1, sizeof (frameHeader));
+	if (!section)
+		return nullptr;
+	std::memcpy (&frameHeader, section, sizeof (frameHeader));
+
+	m_drawData.Clear ();
+	m_drawData.Valid            = true;
+	m_drawData.DisplayPos       = ImVec2 (frameHeader.displayPos[0], frameHeader.displayPos[1]);
+	m_drawData.DisplaySize      = ImVec2 (frameHeader.displaySize[0], frameHeader.displaySize[1]);
+	m_drawData.FramebufferScale =
+	    ImVec2 (frameHeader.framebufferScale[0], frameHeader.framebufferScale[1]);
+
+	// every list has at least its header left to read
+	if (frameHeader.listCount > static_cast<std::size_t> (end - pos) / sizeof (ListHeader))
+		return nullptr;
+
+	while (m_lists.size () < frameHeader.listCount)
+		m_lists.emplace_back (IM_NEW (ImDrawList) (ImGui::GetDrawListSharedData ()));
+
+	for (std::uint32_t i = 0; i < frameHeader.listCount; ++i)
+	{
+		auto &list = *m_lists[i];
+
+		ListHeader listHeader;
+		if (!(section = take (1, sizeof (listHeader))))
+			return nullptr;
+		std::memcpy (&listHeader, section, sizeof (listHeader));
+
+		auto const cmds = take (listHeader.cmdCount, sizeof (Command));
+		auto const vtx  = cmds ? take (listHeader.vtxCount, sizeof (ImDrawVert)) : nullptr;
+		auto const idx  = vtx ? take (listHeader.idxCount, sizeof (ImDrawIdx)) : nullptr;
+		if (!idx)
+			return nullptr;
+
+		list.VtxBuffer.resize (listHeader.vtxCount);
+		list.IdxBuffer.resize (listHeader.idxCount);
+		std::memcpy (list.VtxBuffer.Data, vtx, sizeof (ImDrawVert) * listHeader.vtxCount);
+		std::memcpy (list.IdxBuffer.Data, idx, sizeof (ImDrawIdx) * listHeader.idxCount);
+
+		list.CmdBuffer.resize (0);
+		for (std::uint32_t j = 0; j < listHeader.cmdCount; ++j)
+		{
+			Command packed;
+			std::memcpy (&packed, cmds + j * sizeof (Command), sizeof (packed));
+			if (packed.idxOffset + std::uint64_t (packed.elemCount) > listHeader.idxCount)
+				return nullptr;
+
+			// every index must land in the list's vertices
+			if (packed.elemCount)
+			{
+				auto const first = list.IdxBuffer.Data + packed.idxOffset;
+				auto const last  = *std::max_element (first, first + packed.elemCount);
+				if (packed.vtxOffset + std::uint64_t (last) >= listHeader.vtxCount)
+					return nullptr;
+			}
+
+			ImDrawCmd cmd;
+			cmd.ClipRect  = ImVec4 (
+			    packed.clipRect[0], packed.clipRect[1], packed.clipRect[2], packed.clipRect[3]);
+			cmd.TextureId = packed.texture < textures.size () ? textures[packed.texture] :
+			                                                    ImGui::GetIO ().Fonts->TexID;
+			cmd.VtxOffset = packed.vtxOffset;
+			cmd.IdxOffset = packed.idxOffset;
+			cmd.ElemCount = packed.elemCount;
+			list.CmdBuffer.push_back (cmd);
+		}
+
+
+		m_drawData.CmdLists.push_back (&list);
+		m_drawData.CmdListsCount += 1;
+		m_drawData.TotalVtxCount += list.VtxBuffer.Size;
+		m_drawData.TotalIdxCount += list.IdxBuffer.Size;
+	}
+
+	return &m_drawData;
+}
@@ -0,0 +1,166 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "../imgui/imgui.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Capture file layout (offsets are relative to start of file, and every section is padded to
+// 4-byte alignment so the file can be used in place once mapped or loaded):
+//
+//   FileHeader
+//   per frame: FrameHeader, then per list: ListHeader, Command[cmdCount],
+//              ImDrawVert[vtxCount], ImDrawIdx[idxCount]
+//   FrameEntry[frameCount] at FileHeader::indexOffset
+
+namespace imgui
+{
+namespace capture
+{
+/// \brief File magic ('IMCP')
+constexpr std::uint32_t FILE_MAGIC = 0x50434D49;
+/// \brief File format version
+constexpr std::uint32_t FILE_VERSION = 1;
+
+/// \brief File header
+struct FileHeader
+{
+	/// \brief FILE_MAGIC
+	std::uint32_t magic;
+	/// \brief FILE_VERSION
+	std::uint32_t version;
+	/// \brief Number of captured frames
+	std::uint32_t frameCount;
+	/// \brief Offset of frame index
+	std::uint32_t indexOffset;
+};
+
+/// \brief Frame index entry
+struct FrameEntry
+{
+	/// \brief Offset of frame
+	std::uint32_t offset;
+	/// \brief Size of frame
+	std::uint32_t size;
+};
+
+/// \brief Frame header
+struct FrameHeader
+{
+	/// \brief ImDrawData::DisplayPos
+	float displayPos[2];
+	/// \brief ImDrawData::DisplaySize
+	float displaySize[2];
+	/// \brief ImDrawData::FramebufferScale
+	float framebufferScale[2];
+	/// \brief Number of draw lists
+	std::uint32_t listCount;
+	/// \brief Padding
+	std::uint32_t reserved;
+};
+
+/// \brief Draw list header
+struct ListHeader
+{
+	/// \brief Number of vertices
+	std::uint32_t vtxCount;
+	/// \brief Number of indices
+	std::uint32_t idxCount;
+	/// \brief Number of commands
+	std::uint32_t cmdCount;
+	/// \brief Padding
+	std::uint32_t reserved;
+};
+
+/// \brief Draw command
+struct Command
+{
+	/// \brief Clip rectangle
+	float clipRect[4];
+	/// \brief Texture handle (0 is the font atlas)
+	std::uint32_t texture;
+	/// \brief Vertex offset
+	std::uint32_t vtxOffset;
+	/// \brief Index offset
+	std::uint32_t idxOffset;
+	/// \brief Element count
+	std::uint32_t elemCount;
+};
+
+/// \brief Start capturing frames
+/// \param path_ Output file
+/// \param frames_ Number of frames to capture
+bool start (char const *path_, unsigned frames_);
+
+/// \brief Finish capture and write frame index
+void stop ();
+
+/// \brief Whether a capture is in progress
+bool active ();
+
+/// \brief Capture frame if a capture is in progress
+/// \param drawData_ Draw data to capture
+/// \note Stops automatically after the requested number of frames
+void frame (ImDrawData const *drawData_);
+
+/// \brief Captured frames loaded for replay
+class Replay
+{
+public:
+	Replay ();
+	~Replay ();
+
+	Replay (Replay const &) = delete;
+	Replay &operator= (Replay const &) = delete;
+
+	/// \brief Load capture file
+	/// \param path_ Capture file
+	bool open (char const *path_);
+
+	/// \brief Number of frames
+	unsigned frameCount () const;
+
+	/// \brief Rebuild frame
+	/// \param index_ Frame index
+	/// \returns Draw data, or nullptr if frame is malformed
+	ImDrawData *frame (unsigned index_);
+
+	/// \brief Texture IDs by handle
+	/// \note Unknown handles fall back to the font atlas
+	std::vector<ImTextureID> textures;
+
+private:
+	/// \brief File contents
+	std::vector<std::uint8_t> m_data;
+	/// \brief Frame index
+	std::vector<FrameEntry> m_index;
+	/// \brief Draw lists
+	std::vector<ImDrawList *> m_lists;
+	/// \brief Draw data
+	ImDrawData m_drawData;
+};
+}
+}
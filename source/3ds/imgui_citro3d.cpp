@@ -26,7 +26,10 @@
 
 #include "vshader_shbin.h"
 
+#include "jobs.h"
+
 #include "../imgui/imgui.h"
+#include "../imgui/imgui_internal.h"
 
 #include <algorithm>
 #include <cstdint>
@@ -51,6 +54,14 @@ C3D_Mtx s_projTop;
 /// \brief Bottom screen projection matrix
 C3D_Mtx s_projBottom;
 
+/// \brief Bottom screen width
+/// \note The bottom screen is centered beneath the top screen, whatever the top screen width
+constexpr float BOTTOM_SCREEN_WIDTH = 320.0f;
+/// \brief Bottom screen left edge (framebuffer space)
+float s_bottomLeft;
+/// \brief Bottom screen right edge (framebuffer space)
+float s_bottomRight;
+
 /// \brief System font textures
 std::vector<C3D_Tex> s_fontTextures;
 /// \brief Text scale
@@ -63,6 +74,24 @@ ImDrawVert *s_boundVtxData;
 /// \brief Currently bound texture
 C3D_Tex *s_boundTexture;
 
+/// \brief Texture combiner configs
+enum class TexEnvMode : std::uint8_t
+{
+	/// \brief Nothing selected yet (marks user callbacks in packed draws)
+	None,
+	/// \brief Vertex color only (ImGui's white pixel)
+	Solid,
+	/// \brief Vertex color with font sheet alpha
+	Font,
+	/// \brief Vertex color modulated by image
+	Image,
+};
+
+/// \brief Precomputed texture combiner configs, indexed by TexEnvMode
+C3D_TexEnv s_texEnvs[4];
+/// \brief Currently selected texture combiner config
+TexEnvMode s_boundTexEnv;
+
 /// \brief Vertex data buffer
 ImDrawVert *s_vtxData = nullptr;
 /// \brief Size of vertex data buffer
@@ -72,6 +101,419 @@ ImDrawIdx *s_idxData = nullptr;
 /// \brief Size of index data buffer
 std::size_t s_idxSize = 0;
 
+/// \brief Vertex offset of each draw list
+std::vector<std::size_t> s_listVtxOffsets;
+/// \brief Index offset of each draw list
+std::vector<std::size_t> s_listIdxOffsets;
+
+/// \brief Render statistics
+imgui::citro3d::Stats s_stats;
+
+/// \brief Approximate command buffer cost of render state setup (bytes)
+constexpr std::size_t CMDBUF_COST_STATE = 96 * sizeof (std::uint32_t);
+/// \brief Approximate command buffer cost of a scissor change (bytes)
+constexpr std::size_t CMDBUF_COST_SCISSOR = 6 * sizeof (std::uint32_t);
+/// \brief Approximate command buffer cost of a vertex buffer bind (bytes)
+constexpr std::size_t CMDBUF_COST_VTXBIND = 16 * sizeof (std::uint32_t);
+/// \brief Approximate command buffer cost of a texture bind (bytes)
+constexpr std::size_t CMDBUF_COST_TEXBIND = 12 * sizeof (std::uint32_t);
+/// \brief Approximate command buffer cost of a texture environment change (bytes)
+constexpr std::size_t CMDBUF_COST_TEXENV = 8 * sizeof (std::uint32_t);
+/// \brief Approximate command buffer cost of a vec4 uniform update (bytes)
+constexpr std::size_t CMDBUF_COST_UNIFORM = 6 * sizeof (std::uint32_t);
+/// \brief Approximate command buffer cost of a draw call (bytes)
+constexpr std::size_t CMDBUF_COST_DRAW = 32 * sizeof (std::uint32_t);
+
+/// \brief Command buffer usage above which draw calls are dropped
+/// \note citro3d silently truncates on overflow, which corrupts the rest of the frame
+constexpr float CMDBUF_LIMIT = 0.95f;
+
+/// \brief Command buffer set up by C3D_Init
+std::uint32_t *s_cmdBuf = nullptr;
+/// \brief Size of command buffer (bytes)
+std::size_t s_cmdBufSize = 0;
+
+/// \brief Get command buffer use so far this frame (bytes)
+/// \note C3D_GetCmdBufUsage is only updated when citro3d submits commands, so this reads libctru's
+/// write position instead. C3D_FrameSplit doesn't give any space back: the rest of the frame
+/// continues after the submitted commands
+std::size_t cmdBufUsed ()
+{
+	std::uint32_t *buf;
+	std::uint32_t size;
+	std::uint32_t offset;
+	GPUCMD_GetBuffer (&buf, &size, &offset);
+	return (buf + offset - s_cmdBuf) * sizeof (std::uint32_t);
+}
+
+/// \brief Check whether the command buffer is too full to issue more draws
+/// \note Once it is, draws are skipped along with their state changes, so CMDBUF_LIMIT leaves room
+/// for at most one draw's worth of state, the render state set up for each target and by
+/// callbacks, which still run, and the end of the frame
+bool cmdBufFull ()
+{
+	return cmdBufUsed () >= CMDBUF_LIMIT * s_cmdBufSize;
+}
+
+/// \brief Render targets a frame is issued to
+enum class Target : std::uint8_t
+{
+	/// \brief Top screen (left eye)
+	Top,
+	/// \brief Top screen right eye
+	Right,
+	/// \brief Bottom screen
+	Bottom,
+};
+
+/// \brief Draw call packed for issuing
+/// \note Font commands are already split at sheet changes and clip rects are already converted
+/// to scissors for every target, so issuing a target is a linear walk which never touches
+/// ImDrawCmd or vertex data
+struct PackedDraw
+{
+	/// \brief Scissor (x1, y1, x2, y2) for each Target
+	std::uint16_t scissor[3][4];
+	/// \brief Targets the draw is visible on (bit per Target)
+	std::uint8_t targets;
+	/// \brief Texture combiner config (None for user callbacks)
+	TexEnvMode texEnv;
+	/// \brief Texture (nullptr if none needs binding)
+	C3D_Tex *texture;
+	/// \brief Offset into vertex data buffer
+	std::uint32_t vtxOffset;
+	/// \brief Offset into index data buffer
+	std::uint32_t idxOffset;
+	/// \brief Number of indices (command index for user callbacks)
+	std::uint32_t count;
+};
+
+/// \brief Packed draws of each draw list
+std::vector<std::vector<PackedDraw>> s_listDraws;
+
+/// \brief Right eye render target (nullptr for mono)
+C3D_RenderTarget *s_stereoTarget = nullptr;
+/// \brief Eye separation for the frontmost window
+float s_parallax = 0.0f;
+/// \brief Left eye shift of each draw list
+std::vector<float> s_listShifts;
+/// \brief Draw list to root window mapping
+std::vector<std::pair<ImDrawList const *, ImGuiWindow const *>> s_listRoots;
+
+/// \brief Eye shift uniform location
+int s_shiftLocation;
+/// \brief Current eye shift
+float s_boundShift;
+
+/// \brief Set scissor test bounds
+/// \param x1_ Left
+/// \param y1_ Top
+/// \param x2_ Right
+/// \param y2_ Bottom
+void setScissor (std::uint32_t const x1_,
+    std::uint32_t const y1_,
+    std::uint32_t const x2_,
+    std::uint32_t const y2_)
+{
+	// check if scissor needs to be updated
+	if (s_boundScissor[0] == x1_ && s_boundScissor[1] == y1_ && s_boundScissor[2] == x2_ &&
+	    s_boundScissor[3] == y2_)
+		return;
+
+	s_boundScissor[0] = x1_;
+	s_boundScissor[1] = y1_;
+	s_boundScissor[2] = x2_;
+	s_boundScissor[3] = y2_;
+	C3D_SetScissor (GPU_SCISSOR_NORMAL, x1_, y1_, x2_, y2_);
+
+	++s_stats.scissors;
+	s_stats.cmdBufEstimate += CMDBUF_COST_SCISSOR;
+}
+
+/// \brief Bind vertex data
+/// \param vtxData_ Vertex data to bind
+void bindVtxData (ImDrawVert *const vtxData_)
+{
+	if (vtxData_ == s_boundVtxData)
+		return;
+
+	s_boundVtxData     = vtxData_;
+	auto const bufInfo = C3D_GetBufInfo ();
+	BufInfo_Init (bufInfo);
+	BufInfo_Add (bufInfo, vtxData_, sizeof (ImDrawVert), 3, 0x210);
+
+	++s_stats.vtxBinds;
+	s_stats.cmdBufEstimate += CMDBUF_COST_VTXBIND;
+}
+
+/// \brief Set horizontal eye shift
+/// \param shift_ Shift applied to vertex positions
+void setEyeShift (float const shift_)
+{
+	if (shift_ == s_boundShift)
+		return;
+
+	s_boundShift = shift_;
+	C3D_FVUnifSet (GPU_VERTEX_SHADER, s_shiftLocation, shift_, 0.0f, 0.0f, 0.0f);
+	s_stats.cmdBufEstimate += CMDBUF_COST_UNIFORM;
+}
+
+/// \brief Bind texture
+/// \param tex_ Texture to bind
+void bindTexture (C3D_Tex *const tex_)
+{
+	if (tex_ == s_boundTexture)
+		return;
+
+	s_boundTexture = tex_;
+	C3D_TexBind (0, tex_);
+
+	++s_stats.texBinds;
+	s_stats.cmdBufEstimate += CMDBUF_COST_TEXBIND;
+}
+
+/// \brief Select texture combiner config
+/// \param mode_ Config to select
+void setTexEnv (TexEnvMode const mode_)
+{
+	if (mode_ == s_boundTexEnv)
+		return;
+
+	s_boundTexEnv = mode_;
+	C3D_SetTexEnv (0, &s_texEnvs[static_cast<unsigned> (mode_)]);
+
+	++s_stats.texEnvs;
+	s_stats.cmdBufEstimate += CMDBUF_COST_TEXENV;
+}
+
+/// \brief Draw triangles
+/// \param count_ Number of indices
+/// \param indices_ Index data
+void drawElements (unsigned const count_, ImDrawIdx const *const indices_)
+{
+	C3D_DrawElements (GPU_TRIANGLES, count_, C3D_UNSIGNED_SHORT, indices_);
+
+	++s_stats.drawCalls;
+	s_stats.cmdBufEstimate += CMDBUF_COST_DRAW;
+}
+
+/// \brief Call function for each draw list of a window, in render order
+/// \param window_ Window
+/// \param function_ Called as function_ (list)
+template <typename F>
+void forEachWindowList (ImGuiWindow const &window_, F &&function_)
+{
+	function_ (&window_.DrawListInst);
+#ifdef IMGUI_ENABLE_DETACHED_DRAWLISTS
+	// lists spliced with ImGui::AddDetachedDrawList belong to the window too
+	for (int i = 0; i < window_.DrawListsDetached.Size; ++i)
+	{
+		function_ (window_.DrawListsDetached[i]);
+		function_ (window_.DrawListsContinued[i]);
+	}
+#endif
+}
+
+/// \brief Late-latch translation for the next render
+ImVec2 s_lateLatch;
+/// \brief Late-latch translation applied by the current render
+ImVec2 s_appliedLatch;
+/// \brief Draw lists which receive the late-latch translation
+std::vector<ImDrawList const *> s_latchedLists;
+
+/// \brief Whether tooltips are placed at the touch position rather than at the nav cursor
+/// \param g_ ImGui context
+/// \note Mirrors the reference position ImGui places tooltips at; drag and drop tooltips always
+/// follow the touch
+bool tooltipsFollowTouch (ImGuiContext const &g_)
+{
+	if (g_.DragDropActive)
+		return true;
+
+	return !g_.NavCursorVisible || !g_.NavHighlightItemUnderNav || !g_.NavWindow;
+}
+
+/// \brief Consume late-latch translation and collect draw lists of everything that follows the
+/// touch: the window being dragged and tooltips placed at the touch position
+void collectLatchedLists ()
+{
+	s_latchedLists.clear ();
+
+	s_appliedLatch = s_lateLatch;
+	s_lateLatch    = ImVec2 (0.0f, 0.0f);
+
+	if (s_appliedLatch.x == 0.0f && s_appliedLatch.y == 0.0f)
+		return;
+
+	auto const &g = *ImGui::GetCurrentContext ();
+
+	// the whole root window moves, including its child windows
+	auto const root     = g.MovingWindow ? g.MovingWindow->RootWindow : nullptr;
+	auto const tooltips = tooltipsFollowTouch (g);
+	for (auto const &window : g.Windows)
+	{
+		if (!window->Active)
+			continue;
+
+		auto const latched = (root && window->RootWindow == root) ||
+		                     (tooltips && (window->RootWindow->Flags & ImGuiWindowFlags_Tooltip));
+		if (latched)
+			forEachWindowList (*window, [] (ImDrawList const *const list_) {
+				s_latchedLists.emplace_back (list_);
+			});
+	}
+}
+
+/// \brief Get late-latch translation for a draw list
+/// \param cmdList_ Draw list
+ImVec2 latchFor (ImDrawList const *const cmdList_)
+{
+	if (std::find (std::begin (s_latchedLists), std::end (s_latchedLists), cmdList_) ==
+	    std::end (s_latchedLists))
+		return ImVec2 (0.0f, 0.0f);
+
+	return s_appliedLatch;
+}
+
+/// \brief Convert framebuffer-space clip rect to scissor
+/// \param clip_ Clip rect
+/// \param screen_ Screen being drawn
+/// \param width_ Framebuffer width
+/// \param height_ Framebuffer height
+/// \param scissor_ Output scissor (x1, y1, x2, y2)
+/// \returns Whether any of the clip rect is on this screen
+bool clipToScissor (ImVec4 clip_,
+    gfxScreen_t const screen_,
+    unsigned const width_,
+    unsigned const height_,
+    std::uint16_t (&scissor_)[4])
+{
+	if (clip_.x >= width_ || clip_.y >= height_ || clip_.z < 0.0f || clip_.w < 0.0f)
+		return false;
+	if (clip_.x < 0.0f)
+		clip_.x = 0.0f;
+	if (clip_.y < 0.0f)
+		clip_.y = 0.0f;
+	if (clip_.z > width_)
+		clip_.z = width_;
+	if (clip_.w > height_)
+		clip_.w = height_;
+
+	if (screen_ == GFX_TOP)
+	{
+		// check if clip starts on bottom screen
+		if (clip_.y > height_ * 0.5f)
+			return false;
+
+		// convert from framebuffer space to screen space (3DS screen rotation)
+		scissor_[0] = std::clamp<unsigned> (height_ * 0.5f - clip_.w, 0, height_ * 0.5f);
+		scissor_[1] = std::clamp<unsigned> (width_ - clip_.z, 0, width_);
+		scissor_[2] = std::clamp<unsigned> (height_ * 0.5f - clip_.y, 0, height_ * 0.5f);
+		scissor_[3] = std::clamp<unsigned> (width_ - clip_.x, 0, width_);
+		return true;
+	}
+
+	// check if clip ends on top screen
+	if (clip_.w < height_ * 0.5f)
+		return false;
+
+	// check if clip ends before left edge of bottom screen
+	if (clip_.z < s_bottomLeft)
+		return false;
+
+	// check if clip starts after right edge of bottom screen
+	if (clip_.x > s_bottomRight)
+		return false;
+
+	// convert from framebuffer space to screen space
+	// (3DS screen rotation + bottom screen offset)
+	auto const bottomWidth = s_bottomRight - s_bottomLeft;
+	scissor_[0] = std::clamp<unsigned> (height_ - clip_.w, 0, height_ * 0.5f);
+	scissor_[1] = std::clamp<unsigned> (s_bottomRight - clip_.z, 0, bottomWidth);
+	scissor_[2] = std::clamp<unsigned> (height_ - clip_.y, 0, height_ * 0.5f);
+	scissor_[3] = std::clamp<unsigned> (s_bottomRight - clip_.x, 0, bottomWidth);
+	return true;
+}
+
+/// \brief Get font sheet number from uv coords
+/// \param vtx_ Vertex data
+/// \param idx_ Triangle indices
+unsigned getSheet (ImDrawVert const *const vtx_, ImDrawIdx const *const idx_)
+{
+	unsigned const sheet = std::min ({vtx_[idx_[0]].uv.y, vtx_[idx_[1]].uv.y, vtx_[idx_[2]].uv.y});
+
+	// assert that these three vertices use the same sheet
+	for (unsigned i = 0; i < 3; ++i)
+		assert (vtx_[idx_[i]].uv.y - sheet <= 1.0f);
+
+	assert (sheet < s_fontTextures.size ());
+	return sheet;
+}
+
+/// \brief Map font uv coords into their sheet and pack one draw per run of triangles on the same
+/// sheet
+/// \param cmdList_ Source draw list
+/// \param cmd_ Font draw command
+/// \param drawVtx_ Copied vertex data for draw list
+/// \param draw_ Packed draw with scissors and offsets filled in
+/// \param draws_ Packed draws to append to
+/// \note Sheets are read from the source list, so the copy can be fixed up in place. Commands
+/// which are not visible on any target are fixed up but not packed.
+void packFontDraws (ImDrawList const &cmdList_,
+    ImDrawCmd const &cmd_,
+    ImDrawVert *const drawVtx_,
+    PackedDraw draw_,
+    std::vector<PackedDraw> &draws_)
+{
+	assert (cmd_.ElemCount % 3 == 0);
+
+	auto const idxOffset = draw_.idxOffset;
+	auto const pack      = [&] (unsigned const sheet_, unsigned const begin_, unsigned const end_) {
+		if (!draw_.targets)
+			return;
+
+		// the last sheet is ImGui's white pixel, which only needs the vertex color
+		auto const solid = sheet_ == s_fontTextures.size () - 1;
+		draw_.texture    = solid ? nullptr : &s_fontTextures[sheet_];
+		draw_.texEnv     = solid ? TexEnvMode::Solid : TexEnvMode::Font;
+		draw_.idxOffset  = idxOffset + begin_;
+		draw_.count      = end_ - begin_;
+		draws_.emplace_back (draw_);
+	};
+
+	auto const vtx      = &cmdList_.VtxBuffer.Data[cmd_.VtxOffset];
+	auto const drawVtx  = &drawVtx_[cmd_.VtxOffset];
+	unsigned boundSheet = 0;
+	unsigned offset     = 0;
+	for (unsigned i = 0; i < cmd_.ElemCount; i += 3)
+	{
+		auto const idx   = &cmdList_.IdxBuffer.Data[cmd_.IdxOffset + i];
+		auto const sheet = getSheet (vtx, idx);
+
+		// check if we're changing textures
+		if (i == 0)
+			boundSheet = sheet;
+		else if (sheet != boundSheet)
+		{
+			pack (boundSheet, offset, i);
+			boundSheet = sheet;
+			offset     = i;
+		}
+
+		if (sheet == 0)
+			continue;
+
+		float dummy;
+		drawVtx[idx[0]].uv.y = std::modf (drawVtx[idx[0]].uv.y, &dummy);
+		drawVtx[idx[1]].uv.y = std::modf (drawVtx[idx[1]].uv.y, &dummy);
+		drawVtx[idx[2]].uv.y = std::modf (drawVtx[idx[2]].uv.y, &dummy);
+	}
+
+	// pack the final set of triangles
+	if (offset < cmd_.ElemCount)
+		pack (boundSheet, offset, cmd_.ElemCount);
+}
+
 /// \brief Get code point from glyph index
 /// \param font_ Font to search
 /// \param glyphIndex_ Glyph index
@@ -125,16 +567,23 @@ void setupRenderState (gfxScreen_t const screen_)
 	AttrInfo_AddLoader (attrInfo, 1, GPU_FLOAT, 2);         // v1 = inUv
 	AttrInfo_AddLoader (attrInfo, 2, GPU_UNSIGNED_BYTE, 4); // v2 = inColor
 
+	s_stats.cmdBufEstimate += CMDBUF_COST_STATE;
+
 	// clear bindings
 	std::memset (s_boundScissor, 0xFF, sizeof (s_boundScissor));
 	s_boundVtxData = nullptr;
 	s_boundTexture = nullptr;
+	s_boundTexEnv  = TexEnvMode::None;
+
+	// clear eye shift
+	s_boundShift = 0.0f;
+	C3D_FVUnifSet (GPU_VERTEX_SHADER, s_shiftLocation, 0.0f, 0.0f, 0.0f, 0.0f);
 
 	// bind program
 	C3D_BindProgram (&s_program);
 
-	// enable depth test
-	C3D_DepthTest (true, GPU_GREATER, GPU_WRITE_COLOR);
+	// disable depth test; ImGui relies on submission order, and render targets need no depth buffer
+	C3D_DepthTest (false, GPU_ALWAYS, GPU_WRITE_COLOR);
 
 	// enable alpha blending
 	C3D_AlphaBlend (GPU_BLEND_ADD,
@@ -150,6 +599,113 @@ void setupRenderState (gfxScreen_t const screen_)
 	else
 		C3D_FVUnifMtx4x4 (GPU_VERTEX_SHADER, s_projLocation, &s_projBottom);
 }
+
+/// \brief Compute left eye shift of each draw list from its window's depth
+/// \param drawData_ Draw data
+/// \note Child windows share their root window's depth so they stay attached to it
+void computeListShifts (ImDrawData const *const drawData_)
+{
+	s_listShifts.assign (drawData_->CmdListsCount, 0.0f);
+	if (!s_stereoTarget || s_parallax == 0.0f)
+		return;
+
+	s_listRoots.clear ();
+	for (auto const &window : ImGui::GetCurrentContext ()->Windows)
+	{
+		if (window->WasActive)
+			forEachWindowList (*window, [&] (ImDrawList const *const list_) {
+				s_listRoots.emplace_back (list_, window->RootWindow);
+			});
+	}
+	std::sort (std::begin (s_listRoots), std::end (s_listRoots));
+
+	// lists are back to front; each new root window (or unowned list) is a new layer
+	ImGuiWindow const *prevRoot = nullptr;
+	unsigned layer              = 0;
+	for (int i = 0; i < drawData_->CmdListsCount; ++i)
+	{
+		auto const list = drawData_->CmdLists[i];
+		auto const it   = std::lower_bound (std::begin (s_listRoots),
+		    std::end (s_listRoots),
+		    list,
+		    [] (auto const &entry_, auto const &list_) { return entry_.first < list_; });
+		auto const root = it != std::end (s_listRoots) && it->first == list ? it->second : nullptr;
+
+		if (i != 0 && (!root || root != prevRoot))
+			++layer;
+		prevRoot = root;
+
+		s_listShifts[i] = layer;
+	}
+
+	// backmost layer sits on the screen plane; frontmost pops out by the full parallax
+	if (layer)
+	{
+		for (auto &shift : s_listShifts)
+			shift *= 0.5f * s_parallax / layer;
+	}
+}
+
+/// \brief Issue packed draws to a render target
+/// \param drawData_ Draw data
+/// \param target_ Target being drawn
+/// \note The right eye shares vertex data and packed draws with the left eye
+void issueDraws (ImDrawData const *const drawData_, Target const target_)
+{
+	auto const screen = target_ == Target::Bottom ? GFX_BOTTOM : GFX_TOP;
+	auto const index  = static_cast<unsigned> (target_);
+	auto const mask   = 1u << index;
+
+	setupRenderState (screen);
+
+	for (int i = 0; i < drawData_->CmdListsCount; ++i)
+	{
+		auto const &cmdList = *drawData_->CmdLists[i];
+
+		// the right eye mirrors the left eye's shift
+		auto shift = 0.0f;
+		if (target_ == Target::Top)
+			shift = s_listShifts[i];
+		else if (target_ == Target::Right)
+			shift = -s_listShifts[i];
+
+		for (auto const &draw : s_listDraws[i])
+		{
+			if (draw.texEnv == TexEnvMode::None)
+			{
+				// user callback, registered via ImDrawList::AddCallback()
+				// (ImDrawCallback_ResetRenderState is a special callback value used by the user to
+				// request the renderer to reset render state.)
+				auto const &cmd = cmdList.CmdBuffer[draw.count];
+				if (cmd.UserCallback == ImDrawCallback_ResetRenderState)
+					setupRenderState (screen);
+				else
+					cmd.UserCallback (&cmdList, &cmd);
+				continue;
+			}
+
+			if (!(draw.targets & mask))
+				continue;
+
+			// refuse to draw rather than overflow the command buffer; callbacks still run, since
+			// they may restore state the rest of the frame relies on
+			if (cmdBufFull ())
+			{
+				++s_stats.droppedDrawCalls;
+				continue;
+			}
+
+			auto const &scissor = draw.scissor[index];
+			setScissor (scissor[0], scissor[1], scissor[2], scissor[3]);
+			bindVtxData (&s_vtxData[draw.vtxOffset]);
+			setEyeShift (shift);
+			if (draw.texture)
+				bindTexture (draw.texture);
+			setTexEnv (draw.texEnv);
+			drawElements (draw.count, &s_idxData[draw.idxOffset]);
+		}
+	}
+}
 }
 
 void imgui::citro3d::init ()
@@ -160,6 +716,14 @@ void imgui::citro3d::init ()
 	io.BackendRendererName = "citro3d";
 	io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;
 
+	// C3D_Init just set up the command buffer, so this is its start and full size
+	std::uint32_t cmdBufWords;
+	GPUCMD_GetBuffer (&s_cmdBuf, &cmdBufWords, nullptr);
+	s_cmdBufSize = cmdBufWords * sizeof (std::uint32_t);
+
+	// high-water marks are since init
+	s_stats = {};
+
 	// load vertex shader
 	s_vsh = DVLB_ParseFile (
 	    const_cast<std::uint32_t *> (reinterpret_cast<std::uint32_t const *> (vshader_shbin)),
@@ -169,8 +733,27 @@ void imgui::citro3d::init ()
 	shaderProgramInit (&s_program);
 	shaderProgramSetVsh (&s_program, &s_vsh->DVLE[0]);
 
-	// get projection matrix uniform location
-	s_projLocation = shaderInstanceGetUniformLocation (s_program.vertexShader, "projection");
+	// get uniform locations
+	s_projLocation  = shaderInstanceGetUniformLocation (s_program.vertexShader, "projection");
+	s_shiftLocation = shaderInstanceGetUniformLocation (s_program.vertexShader, "shift");
+
+	// precompute texture combiner configs
+	for (auto &env : s_texEnvs)
+		C3D_TexEnvInit (&env);
+
+	auto &solidEnv = s_texEnvs[static_cast<unsigned> (TexEnvMode::Solid)];
+	C3D_TexEnvSrc (&solidEnv, C3D_Both, GPU_PRIMARY_COLOR, GPU_PRIMARY_COLOR, GPU_PRIMARY_COLOR);
+	C3D_TexEnvFunc (&solidEnv, C3D_Both, GPU_REPLACE);
+
+	auto &fontEnv = s_texEnvs[static_cast<unsigned> (TexEnvMode::Font)];
+	C3D_TexEnvSrc (&fontEnv, C3D_RGB, GPU_PRIMARY_COLOR, GPU_PRIMARY_COLOR, GPU_PRIMARY_COLOR);
+	C3D_TexEnvFunc (&fontEnv, C3D_RGB, GPU_REPLACE);
+	C3D_TexEnvSrc (&fontEnv, C3D_Alpha, GPU_TEXTURE0, GPU_PRIMARY_COLOR, GPU_PRIMARY_COLOR);
+	C3D_TexEnvFunc (&fontEnv, C3D_Alpha, GPU_MODULATE);
+
+	auto &imageEnv = s_texEnvs[static_cast<unsigned> (TexEnvMode::Image)];
+	C3D_TexEnvSrc (&imageEnv, C3D_Both, GPU_TEXTURE0, GPU_PRIMARY_COLOR, GPU_PRIMARY_COLOR);
+	C3D_TexEnvFunc (&imageEnv, C3D_Both, GPU_MODULATE);
 
 	// allocate vertex data buffer
 	s_vtxSize = 65536;
@@ -280,7 +863,7 @@ void imgui::citro3d::init ()
 	assert (!charSet.empty ());
 
 	// deduplicate character map
-	std::sort (std::begin (charSet), std::end (charSet));
+	jobs::sort (std::begin (charSet), std::end (charSet));
 	charSet.erase (std::unique (std::begin (charSet), std::end (charSet)), std::end (charSet));
 
 	// fill in font glyph ranges
@@ -356,21 +939,30 @@ void imgui::citro3d::init ()
 	imFont->Ascent           = fontInfo->ascent;
 	imFont->Descent          = 0.0f;
 
+	// calculate glyph metrics; lookups only read the shared font, so split them across the pool
+	std::vector<fontGlyphPos_s> glyphPositions (charSet.size ());
+	auto const calcGlyphPositions = [&] (std::size_t const begin_, std::size_t const end_) {
+		for (auto i = begin_; i < end_; ++i)
+		{
+			auto const glyphIndex = fontGlyphIndexFromCodePoint (font, charSet[i]);
+			assert (glyphIndex >= 0);
+			assert (glyphIndex < 0xFFFF);
+
+			fontCalcGlyphPos (&glyphPositions[i],
+			    font,
+			    glyphIndex,
+			    GLYPH_POS_CALC_VTXCOORD | GLYPH_POS_AT_BASELINE,
+			    1.0f,
+			    1.0f);
+		}
+	};
+	jobs::parallelFor (0, charSet.size (), 256, calcGlyphPositions);
+
 	// add glyphs to font
-	fontGlyphPos_s glyphPos;
-	for (auto const &code : charSet)
+	for (std::size_t i = 0; i < charSet.size (); ++i)
 	{
-		auto const glyphIndex = fontGlyphIndexFromCodePoint (font, code);
-		assert (glyphIndex >= 0);
-		assert (glyphIndex < 0xFFFF);
-
-		// calculate glyph metrics
-		fontCalcGlyphPos (&glyphPos,
-		    font,
-		    glyphIndex,
-		    GLYPH_POS_CALC_VTXCOORD | GLYPH_POS_AT_BASELINE,
-		    1.0f,
-		    1.0f);
+		auto const code      = charSet[i];
+		auto const &glyphPos = glyphPositions[i];
 
 		assert (glyphPos.sheetIndex >= 0);
 		assert (static_cast<std::size_t> (glyphPos.sheetIndex) < s_fontTextures.size ());
@@ -405,17 +997,56 @@ void imgui::citro3d::exit ()
 	// delete ImGui white pixel texture
 	assert (!s_fontTextures.empty ());
 	C3D_TexDelete (&s_fontTextures.back ());
+	s_fontTextures.clear ();
+	s_fontRanges.clear ();
 
 	// free shader program
 	shaderProgramFree (&s_program);
 	DVLB_Free (s_vsh);
 }
 
+void imgui::citro3d::setLateLatch (ImVec2 const &delta_)
+{
+	s_lateLatch = delta_;
+}
+
+void imgui::citro3d::setStereo (C3D_RenderTarget *const right_, float const parallax_)
+{
+	s_stereoTarget = right_;
+	s_parallax     = parallax_;
+}
+
 void imgui::citro3d::render (C3D_RenderTarget *const top_, C3D_RenderTarget *const bottom_)
 {
-	// get draw data
-	auto const drawData = ImGui::GetDrawData ();
-	if (drawData->CmdListsCount <= 0)
+	render (top_, bottom_, ImGui::GetDrawData ());
+}
+
+void imgui::citro3d::render (C3D_RenderTarget *const top_,
+    C3D_RenderTarget *const bottom_,
+    ImDrawData *const drawData_)
+{
+	auto const drawData = drawData_;
+
+	// reset per-frame statistics
+	s_stats.drawCalls        = 0;
+	s_stats.droppedDrawCalls = 0;
+	s_stats.vtxBinds         = 0;
+	s_stats.texBinds         = 0;
+	s_stats.texEnvs          = 0;
+	s_stats.scissors         = 0;
+	s_stats.prepareTime      = 0.0f;
+	s_stats.walkTime         = 0.0f;
+	s_stats.stereoTime       = 0.0f;
+	s_stats.cmdBufEstimate   = 0;
+	s_stats.cmdBufUsage      = 0.0f;
+
+	// citro3d measured the whole previous frame when it was submitted
+	s_stats.cmdBufHighWater = std::max (s_stats.cmdBufHighWater, C3D_GetCmdBufUsage ());
+
+	// consume late-latch translation
+	collectLatchedLists ();
+
+	if (!drawData || drawData->CmdListsCount <= 0)
 		return;
 
 	// get framebuffer dimensions
@@ -424,6 +1055,11 @@ void imgui::citro3d::render (C3D_RenderTarget *const top_, C3D_RenderTarget *con
 	if (width <= 0 || height <= 0)
 		return;
 
+	// the top screen is 400px, or 800px in wide mode; the bottom screen is centered below it
+	auto const bottomLeft = (drawData->DisplaySize.x - BOTTOM_SCREEN_WIDTH) * 0.5f;
+	s_bottomLeft          = bottomLeft * drawData->FramebufferScale.x;
+	s_bottomRight         = (bottomLeft + BOTTOM_SCREEN_WIDTH) * drawData->FramebufferScale.x;
+
 	// initialize projection matrices
 	Mtx_OrthoTilt (&s_projTop,
 	    0.0f,
@@ -434,8 +1070,8 @@ void imgui::citro3d::render (C3D_RenderTarget *const top_, C3D_RenderTarget *con
 	    1.0f,
 	    false);
 	Mtx_OrthoTilt (&s_projBottom,
-	    drawData->DisplaySize.x * 0.1f,
-	    drawData->DisplaySize.x * 0.9f,
+	    bottomLeft,
+	    bottomLeft + BOTTOM_SCREEN_WIDTH,
 	    drawData->DisplaySize.y,
 	    drawData->DisplaySize.y * 0.5f,
 	    -1.0f,
@@ -468,261 +1104,159 @@ void imgui::citro3d::render (C3D_RenderTarget *const top_, C3D_RenderTarget *con
 	// (1,1) unless using retina display which are often (2,2)
 	auto const clipScale = drawData->FramebufferScale;
 
-	// copy data into vertex/index buffers
-	std::size_t offsetVtx = 0;
-	std::size_t offsetIdx = 0;
+	// shifts are baked into the packed scissors
+	computeListShifts (drawData);
+
+	auto const prepareStart = svcGetSystemTick ();
+
+	// offsets of every list are known up front, so each list can be prepared independently
+	s_listVtxOffsets.resize (drawData->CmdListsCount + 1);
+	s_listIdxOffsets.resize (drawData->CmdListsCount + 1);
+	s_listVtxOffsets[0] = 0;
+	s_listIdxOffsets[0] = 0;
 	for (int i = 0; i < drawData->CmdListsCount; ++i)
 	{
-		auto const &cmdList = *drawData->CmdLists[i];
-
-		// double check that we don't overrun vertex/index data buffers
-		assert (s_vtxSize - offsetVtx >= static_cast<std::size_t> (cmdList.VtxBuffer.Size));
-		assert (s_idxSize - offsetIdx >= static_cast<std::size_t> (cmdList.IdxBuffer.Size));
-
-		// copy vertex/index data into buffers
-		std::memcpy (&s_vtxData[offsetVtx],
-		    cmdList.VtxBuffer.Data,
-		    sizeof (ImDrawVert) * cmdList.VtxBuffer.Size);
-		std::memcpy (&s_idxData[offsetIdx],
-		    cmdList.IdxBuffer.Data,
-		    sizeof (ImDrawIdx) * cmdList.IdxBuffer.Size);
-
-		offsetVtx += cmdList.VtxBuffer.Size;
-		offsetIdx += cmdList.IdxBuffer.Size;
+		auto const &cmdList     = *drawData->CmdLists[i];
+		s_listVtxOffsets[i + 1] = s_listVtxOffsets[i] + cmdList.VtxBuffer.Size;
+		s_listIdxOffsets[i + 1] = s_listIdxOffsets[i] + cmdList.IdxBuffer.Size;
 	}
 
-	for (auto const &screen : {GFX_TOP, GFX_BOTTOM})
-	{
-		if (screen == GFX_TOP)
-			C3D_FrameDrawOn (top_);
-		else
-			C3D_FrameDrawOn (bottom_);
-
-		setupRenderState (screen);
+	// double check that we don't overrun vertex/index data buffers
+	assert (s_listVtxOffsets.back () <= s_vtxSize);
+	assert (s_listIdxOffsets.back () <= s_idxSize);
 
-		offsetVtx = 0;
-		offsetIdx = 0;
+	// keep packed draw capacity from previous frames
+	if (s_listDraws.size () < static_cast<std::size_t> (drawData->CmdListsCount))
+		s_listDraws.resize (drawData->CmdListsCount);
 
-		// render command lists
-		for (int i = 0; i < drawData->CmdListsCount; ++i)
+	// copy data into vertex/index buffers, fix it up and pack draws before drawing any target
+	auto const prepareLists = [drawData, clipOff, clipScale, width, height] (
+	                              std::size_t const begin_, std::size_t const end_) {
+		for (auto i = begin_; i < end_; ++i)
 		{
 			auto const &cmdList = *drawData->CmdLists[i];
-			for (auto const &cmd : cmdList.CmdBuffer)
+			auto const vtxData  = &s_vtxData[s_listVtxOffsets[i]];
+
+			std::memcpy (
+			    vtxData, cmdList.VtxBuffer.Data, sizeof (ImDrawVert) * cmdList.VtxBuffer.Size);
+			std::memcpy (&s_idxData[s_listIdxOffsets[i]],
+			    cmdList.IdxBuffer.Data,
+			    sizeof (ImDrawIdx) * cmdList.IdxBuffer.Size);
+
+			// translate what follows the touch to the late-latched touch position
+			auto const latch = latchFor (&cmdList);
+			if (latch.x != 0.0f || latch.y != 0.0f)
+			{
+				for (int j = 0; j < cmdList.VtxBuffer.Size; ++j)
+				{
+					vtxData[j].pos.x += latch.x;
+					vtxData[j].pos.y += latch.y;
+				}
+			}
+
+			auto const shift = s_listShifts[i] * clipScale.x;
+			auto &draws      = s_listDraws[i];
+			draws.clear ();
+			for (int j = 0; j < cmdList.CmdBuffer.Size; ++j)
 			{
+				auto const &cmd = cmdList.CmdBuffer[j];
+
+				PackedDraw draw{};
 				if (cmd.UserCallback)
 				{
-					// user callback, registered via ImDrawList::AddCallback()
-					// (ImDrawCallback_ResetRenderState is a special callback value used by the user
-					// to request the renderer to reset render state.)
-					if (cmd.UserCallback == ImDrawCallback_ResetRenderState)
-						setupRenderState (screen);
-					else
-						cmd.UserCallback (&cmdList, &cmd);
+					// runs on every target at the same point
+					draw.texEnv = TexEnvMode::None;
+					draw.count  = j;
+					draws.emplace_back (draw);
+					continue;
 				}
-				else
+
+				// project scissor/clipping rectangles into framebuffer space
+				ImVec4 clip;
+				clip.x = (cmd.ClipRect.x + latch.x - clipOff.x) * clipScale.x;
+				clip.y = (cmd.ClipRect.y + latch.y - clipOff.y) * clipScale.y;
+				clip.z = (cmd.ClipRect.z + latch.x - clipOff.x) * clipScale.x;
+				clip.w = (cmd.ClipRect.w + latch.y - clipOff.y) * clipScale.y;
+
+				auto const addTarget = [&] (Target const target_, float const shift_) {
+					auto const index  = static_cast<unsigned> (target_);
+					auto const screen = target_ == Target::Bottom ? GFX_BOTTOM : GFX_TOP;
+					if (clipToScissor (ImVec4 (clip.x + shift_, clip.y, clip.z + shift_, clip.w),
+					        screen,
+					        width,
+					        height,
+					        draw.scissor[index]))
+						draw.targets |= 1u << index;
+				};
+
+				addTarget (Target::Top, shift);
+				if (s_stereoTarget)
+					addTarget (Target::Right, -shift);
+				addTarget (Target::Bottom, 0.0f);
+
+				draw.vtxOffset = s_listVtxOffsets[i] + cmd.VtxOffset;
+				draw.idxOffset = s_listIdxOffsets[i] + cmd.IdxOffset;
+
+				auto const tex = reinterpret_cast<C3D_Tex *> (cmd.TextureId);
+				if (tex == s_fontTextures.data ())
 				{
-					// project scissor/clipping rectangles into framebuffer space
-					ImVec4 clip;
-					clip.x = (cmd.ClipRect.x - clipOff.x) * clipScale.x;
-					clip.y = (cmd.ClipRect.y - clipOff.y) * clipScale.y;
-					clip.z = (cmd.ClipRect.z - clipOff.x) * clipScale.x;
-					clip.w = (cmd.ClipRect.w - clipOff.y) * clipScale.y;
-
-					if (clip.x >= width || clip.y >= height || clip.z < 0.0f || clip.w < 0.0f)
-						continue;
-					if (clip.x < 0.0f)
-						clip.x = 0.0f;
-					if (clip.y < 0.0f)
-						clip.y = 0.0f;
-					if (clip.z > width)
-						clip.z = width;
-					if (clip.w > height)
-						clip.z = height;
-
-					if (screen == GFX_TOP)
-					{
-						// check if clip starts on bottom screen
-						if (clip.y > height * 0.5f)
-							continue;
-
-						// convert from framebuffer space to screen space (3DS screen rotation)
-						auto const x1 =
-						    std::clamp<unsigned> (height * 0.5f - clip.w, 0, height * 0.5f);
-						auto const y1 = std::clamp<unsigned> (width - clip.z, 0, width);
-						auto const x2 =
-						    std::clamp<unsigned> (height * 0.5f - clip.y, 0, height * 0.5f);
-						auto const y2 = std::clamp<unsigned> (width - clip.x, 0, width);
-
-						// check if scissor needs to be updated
-						if (s_boundScissor[0] != x1 || s_boundScissor[1] != y1 ||
-						    s_boundScissor[2] != x2 || s_boundScissor[3] != y2)
-						{
-							s_boundScissor[0] = x1;
-							s_boundScissor[1] = y1;
-							s_boundScissor[2] = x2;
-							s_boundScissor[3] = y2;
-							C3D_SetScissor (GPU_SCISSOR_NORMAL, x1, y1, x2, y2);
-						}
-					}
-					else
-					{
-						// check if clip ends on top screen
-						if (clip.w < height * 0.5f)
-							continue;
-
-						// check if clip ends before left edge of bottom screen
-						if (clip.z < width * 0.1f)
-							continue;
-
-						// check if clip starts after right edge of bottom screen
-						if (clip.x > width * 0.9f)
-							continue;
-
-						// convert from framebuffer space to screen space
-						// (3DS screen rotation + bottom screen offset)
-						auto const x1 = std::clamp<unsigned> (height - clip.w, 0, height * 0.5f);
-						auto const y1 =
-						    std::clamp<unsigned> (width * 0.9f - clip.z, 0, width * 0.8f);
-						auto const x2 = std::clamp<unsigned> (height - clip.y, 0, height * 0.5f);
-						auto const y2 =
-						    std::clamp<unsigned> (width * 0.9f - clip.x, 0, width * 0.8f);
-
-						// check if scissor needs to be updated
-						if (s_boundScissor[0] != x1 || s_boundScissor[1] != y1 ||
-						    s_boundScissor[2] != x2 || s_boundScissor[3] != y2)
-						{
-							s_boundScissor[0] = x1;
-							s_boundScissor[1] = y1;
-							s_boundScissor[2] = x2;
-							s_boundScissor[3] = y2;
-							C3D_SetScissor (GPU_SCISSOR_NORMAL, x1, y1, x2, y2);
-						}
-					}
-
-					// check if we need to update vertex data binding
-					auto const vtxData = &s_vtxData[cmd.VtxOffset + offsetVtx];
-					if (vtxData != s_boundVtxData)
-					{
-						s_boundVtxData     = vtxData;
-						auto const bufInfo = C3D_GetBufInfo ();
-						BufInfo_Init (bufInfo);
-						BufInfo_Add (bufInfo, vtxData, sizeof (ImDrawVert), 3, 0x210);
-					}
-
-					// check if we need to update texture binding
-					auto tex = reinterpret_cast<C3D_Tex *>(cmd.TextureId);
-					if (tex == s_fontTextures.data ())
-					{
-						assert (cmd.ElemCount % 3 == 0);
-
-						// get sheet number from uv coords
-						auto const getSheet = [] (auto const vtx_, auto const idx_) {
-							unsigned const sheet = std::min (
-							    {vtx_[idx_[0]].uv.y, vtx_[idx_[1]].uv.y, vtx_[idx_[2]].uv.y});
-
-							// assert that these three vertices use the same sheet
-							for (unsigned i = 0; i < 3; ++i)
-								assert (vtx_[idx_[i]].uv.y - sheet <= 1.0f);
-
-							assert (sheet < s_fontTextures.size ());
-							return sheet;
-						};
-
-						/// \todo avoid repeating this work?
-						for (unsigned i = 0; i < cmd.ElemCount; i += 3)
-						{
-							auto const idx = &cmdList.IdxBuffer.Data[cmd.IdxOffset + i];
-							auto const vtx = &cmdList.VtxBuffer.Data[cmd.VtxOffset];
-							auto drawVtx   = &s_vtxData[cmd.VtxOffset + offsetVtx];
-
-							auto const sheet = getSheet (vtx, idx);
-							if (sheet != 0)
-							{
-								float dummy;
-								drawVtx[idx[0]].uv.y = std::modf (drawVtx[idx[0]].uv.y, &dummy);
-								drawVtx[idx[1]].uv.y = std::modf (drawVtx[idx[1]].uv.y, &dummy);
-								drawVtx[idx[2]].uv.y = std::modf (drawVtx[idx[2]].uv.y, &dummy);
-							}
-						}
-
-						// initialize texture binding
-						unsigned boundSheet = getSheet (&cmdList.VtxBuffer.Data[cmd.VtxOffset],
-						    &cmdList.IdxBuffer.Data[cmd.IdxOffset]);
-
-						assert (boundSheet < s_fontTextures.size ());
-						C3D_TexBind (0, &s_fontTextures[boundSheet]);
-
-						unsigned offset = 0;
-
-						// update texture environment for non-image drawing
-						auto const env = C3D_GetTexEnv (0);
-						C3D_TexEnvInit (env);
-						C3D_TexEnvSrc (
-						    env, C3D_RGB, GPU_PRIMARY_COLOR, GPU_PRIMARY_COLOR, GPU_PRIMARY_COLOR);
-						C3D_TexEnvFunc (env, C3D_RGB, GPU_REPLACE);
-						C3D_TexEnvSrc (
-						    env, C3D_Alpha, GPU_TEXTURE0, GPU_PRIMARY_COLOR, GPU_PRIMARY_COLOR);
-						C3D_TexEnvFunc (env, C3D_Alpha, GPU_MODULATE);
-
-						// process one triangle at a time
-						for (unsigned i = 3; i < cmd.ElemCount; i += 3)
-						{
-							// get sheet for this triangle
-							unsigned const sheet = getSheet (&cmdList.VtxBuffer.Data[cmd.VtxOffset],
-							    &cmdList.IdxBuffer.Data[cmd.IdxOffset + i]);
-
-							// check if we're changing textures
-							if (boundSheet != sheet)
-							{
-								// draw everything up until now
-								C3D_DrawElements (GPU_TRIANGLES,
-								    i - offset,
-								    C3D_UNSIGNED_SHORT,
-								    &s_idxData[cmd.IdxOffset + offsetIdx + offset]);
-
-								// bind texture for next draw call
-								boundSheet = sheet;
-								offset     = i;
-								C3D_TexBind (0, &s_fontTextures[boundSheet]);
-							}
-						}
-
-						// draw the final set of triangles
-						assert ((cmd.ElemCount - offset) % 3 == 0);
-						C3D_DrawElements (GPU_TRIANGLES,
-						    cmd.ElemCount - offset,
-						    C3D_UNSIGNED_SHORT,
-						    &s_idxData[cmd.IdxOffset + offsetIdx + offset]);
-					}
-					else
-					{
-						// drawing an image; check if we need to change texture binding
-						if (tex != s_boundTexture)
-						{
-							// bind new texture
-							C3D_TexBind (0, reinterpret_cast<C3D_Tex *>(tex));
-
-							// update texture environment for drawing images
-							auto const env = C3D_GetTexEnv (0);
-							C3D_TexEnvInit (env);
-							C3D_TexEnvSrc (
-							    env, C3D_Both, GPU_TEXTURE0, GPU_PRIMARY_COLOR, GPU_PRIMARY_COLOR);
-							C3D_TexEnvFunc (env, C3D_Both, GPU_MODULATE);
-						}
-
-						// draw triangles
-						C3D_DrawElements (GPU_TRIANGLES,
-						    cmd.ElemCount,
-						    C3D_UNSIGNED_SHORT,
-						    &s_idxData[cmd.IdxOffset + offsetIdx]);
-					}
-
-					s_boundTexture = tex;
+					// font uvs are fixed up even if the command is not visible
+					packFontDraws (cmdList, cmd, vtxData, draw, draws);
+					continue;
 				}
-			}
 
-			offsetVtx += cmdList.VtxBuffer.Size;
-			offsetIdx += cmdList.IdxBuffer.Size;
+				if (!draw.targets)
+					continue;
+
+				// drawing an image
+				draw.texture = tex;
+				draw.texEnv  = TexEnvMode::Image;
+				draw.count   = cmd.ElemCount;
+				draws.emplace_back (draw);
+			}
 		}
+	};
+	jobs::parallelFor (0, drawData->CmdListsCount, 1, prepareLists);
+
+	auto const walkStart = svcGetSystemTick ();
+	s_stats.prepareTime  = (walkStart - prepareStart) / CPU_TICKS_PER_MSEC;
+
+	C3D_FrameDrawOn (top_);
+	issueDraws (drawData, Target::Top);
+
+	C3D_FrameDrawOn (bottom_);
+	issueDraws (drawData, Target::Bottom);
+
+	if (s_stereoTarget)
+	{
+		auto const stereoStart = svcGetSystemTick ();
+		C3D_FrameDrawOn (s_stereoTarget);
+		issueDraws (drawData, Target::Right);
+		s_stats.stereoTime = (svcGetSystemTick () - stereoStart) / CPU_TICKS_PER_MSEC;
 	}
+
+	s_stats.walkTime = (svcGetSystemTick () - walkStart) / CPU_TICKS_PER_MSEC;
+
+	// record command buffer high-water mark
+	s_stats.cmdBufUsage     = static_cast<float> (cmdBufUsed ()) / s_cmdBufSize;
+	s_stats.cmdBufHighWater = std::max (s_stats.cmdBufHighWater, s_stats.cmdBufUsage);
+	s_stats.droppedDrawCallsHighWater =
+	    std::max (s_stats.droppedDrawCallsHighWater, s_stats.droppedDrawCalls);
+	s_stats.cmdBufEstimateHighWater =
+	    std::max (s_stats.cmdBufEstimateHighWater, s_stats.cmdBufEstimate);
+}
+
+imgui::citro3d::Stats const &imgui::citro3d::stats ()
+{
+	return s_stats;
+}
+
+std::size_t imgui::citro3d::suggestedCmdBufSize ()
+{
+	// the measured peak can't exceed CMDBUF_LIMIT, so add what the dropped draw calls would have
+	// taken, then leave 25% headroom and round up to 4KiB
+	auto const peak = static_cast<std::size_t> (s_stats.cmdBufHighWater * s_cmdBufSize) +
+	                  s_stats.droppedDrawCallsHighWater * CMDBUF_COST_DRAW;
+	auto const size = peak * 5 / 4;
+	return std::max<std::size_t> ((size + 0xFFF) & ~std::size_t (0xFFF), 0x1000);
 }
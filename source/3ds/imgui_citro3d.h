@@ -24,16 +24,81 @@
 
 #include <citro3d.h>
 
+#include "../imgui/imgui.h"
+
+#include <cstddef>
+
 namespace imgui
 {
 namespace citro3d
 {
+/// \brief Render statistics
+struct Stats
+{
+	/// \brief Draw calls issued this frame
+	unsigned drawCalls;
+	/// \brief Draw calls dropped this frame to avoid command buffer overflow
+	unsigned droppedDrawCalls;
+	/// \brief Most draw calls dropped in a frame since init
+	unsigned droppedDrawCallsHighWater;
+	/// \brief Vertex buffer binds this frame
+	unsigned vtxBinds;
+	/// \brief Texture binds this frame
+	unsigned texBinds;
+	/// \brief Texture combiner changes this frame
+	unsigned texEnvs;
+	/// \brief Scissor changes this frame
+	unsigned scissors;
+	/// \brief Time spent copying and fixing up vertex/index data and packing draws this frame (ms)
+	float prepareTime;
+	/// \brief Time spent walking the packed draws and issuing them to every target this frame (ms)
+	float walkTime;
+	/// \brief Time spent issuing the right eye this frame, part of walkTime (ms)
+	float stereoTime;
+	/// \brief Estimated command buffer use this frame (bytes)
+	std::size_t cmdBufEstimate;
+	/// \brief Command buffer usage at end of this frame's render (fraction of capacity)
+	float cmdBufUsage;
+	/// \brief Peak command buffer usage of whole frames since init (fraction of capacity)
+	float cmdBufHighWater;
+	/// \brief Peak estimated command buffer use since init (bytes)
+	std::size_t cmdBufEstimateHighWater;
+};
+
 /// \brief Initialize citro3d
+/// \note Must be called after C3D_Init, which sets up the command buffer
 void init ();
 /// \brief Deinitialize citro3d
 void exit ();
 
+/// \brief Set late-latch translation for the next render
+/// \param delta_ Touch movement since the frame was built
+/// \note Applied to the window currently being dragged and to tooltips placed at the touch
+/// position (including drag and drop previews), then reset
+void setLateLatch (ImVec2 const &delta_);
+
+/// \brief Enable stereoscopic top screen
+/// \param right_ Right eye render target, or nullptr for mono
+/// \param parallax_ Eye separation of the frontmost window (pixels), e.g. scaled by the 3D slider
+/// \note The top screen is drawn once for the left eye and the recorded draws are replayed for the
+/// right eye, so the extra CPU cost is bounded by the number of draw calls
+void setStereo (C3D_RenderTarget *right_, float parallax_);
+
 /// \brief Render ImGui draw list
+/// \note The top screen spans DisplaySize.x (400, or 800 in wide mode) and the bottom screen is
+/// centered beneath it
 void render (C3D_RenderTarget *top_, C3D_RenderTarget *bottom_);
+
+/// \brief Render draw data
+/// \param drawData_ Draw data, e.g. a replayed capture
+void render (C3D_RenderTarget *top_, C3D_RenderTarget *bottom_, ImDrawData *drawData_);
+
+/// \brief Get render statistics
+Stats const &stats ();
+
+/// \brief Get suggested command buffer size for C3D_Init
+/// \note Based on the measured command buffer high-water mark so far, plus the estimated cost of
+/// the draw calls that had to be dropped
+std::size_t suggestedCmdBufSize ();
 }
 }
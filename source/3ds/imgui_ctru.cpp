@@ -25,12 +25,18 @@
 #include "../imgui/imgui.h"
 #include "../imgui/imgui_internal.h"
 
+#include <algorithm>
+#include <array>
+#include <bit>
 #include <chrono>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <cstdio>
 #include <cstring>
-#include <functional>
 #include <string>
-#include <tuple>
-#include <cstdint>
+#include <utility>
+#include <vector>
 using namespace std::chrono_literals;
 
 namespace
@@ -55,6 +61,65 @@ void setClipboardText (ImGuiContext *const context_, char const *const text_)
 	s_clipboard = text_;
 }
 
+/// \brief Touch position submitted this frame
+ImVec2 s_touchPos;
+
+/// \brief Transform touch position to bottom-screen space
+/// \param pos_ Touch position
+/// \note The bottom screen is centered beneath the top screen, which is 800px in wide mode
+ImVec2 touchToScreen (touchPosition const &pos_)
+{
+	auto const &io = ImGui::GetIO ();
+	return ImVec2 (pos_.px + (io.DisplaySize.x - 320.0f) * 0.5f, pos_.py + io.DisplaySize.y * 0.5f);
+}
+
+/// \brief Word offset of the touch screen section in HID shared memory
+constexpr std::size_t HID_TOUCH_SECTION = 42;
+/// \brief Word offset of the accelerometer section, which follows the touch screen section
+constexpr std::size_t HID_ACCEL_SECTION = 66;
+/// \brief Word offset in the touch screen section of the index of the latest entry
+constexpr std::size_t HID_TOUCH_LATEST = 4;
+/// \brief Word offset in the touch screen section of the entry ring
+constexpr std::size_t HID_TOUCH_ENTRIES = 8;
+/// \brief Entries in the ring
+constexpr std::size_t HID_TOUCH_ENTRY_COUNT = 8;
+/// \brief Words per entry: position (px | py << 16), then the pressed flag in bit 0
+constexpr std::size_t HID_TOUCH_ENTRY_WORDS = 2;
+
+static_assert (HID_TOUCH_SECTION + HID_TOUCH_ENTRIES + HID_TOUCH_ENTRY_COUNT * HID_TOUCH_ENTRY_WORDS <=
+                   HID_ACCEL_SECTION,
+    "touch entry ring overlaps the accelerometer section");
+static_assert (sizeof (touchPosition::px) == 2 && sizeof (touchPosition::py) == 2,
+    "touch entry position packs two 16-bit coordinates");
+
+/// \brief Read latest touch sample directly from HID shared memory
+/// \param pos_ Touch position output
+/// \returns Whether touch screen is pressed
+/// \note hidTouchRead only returns the sample latched by hidScanInput, and scanning again would
+/// eat the key edges for the next frame
+/// \note The touch screen section holds the index of the latest entry in word 4 and a ring of
+/// entries from word 8, each a position (px | py << 16) followed by the pressed flag. hidScanInput
+/// reads the same layout; if the index is out of range the layout is not the one expected, so this
+/// falls back to the latched sample
+bool readLatestTouch (touchPosition &pos_)
+{
+	auto const section = &hidSharedMem[HID_TOUCH_SECTION];
+
+	auto const index = section[HID_TOUCH_LATEST];
+	if (index >= HID_TOUCH_ENTRY_COUNT)
+	{
+		hidTouchRead (&pos_);
+		return hidKeysHeld () & KEY_TOUCH;
+	}
+
+	auto const entry = &section[HID_TOUCH_ENTRIES + index * HID_TOUCH_ENTRY_WORDS];
+	auto const raw   = entry[0];
+
+	pos_.px = raw & 0xFFFF;
+	pos_.py = raw >> 16;
+	return entry[1] & 1;
+}
+
 /// \brief Update touch position
 /// \param io_ ImGui IO
 void updateTouch (ImGuiIO &io_)
@@ -66,8 +131,9 @@ void updateTouch (ImGuiIO &io_)
 		hidTouchRead (&pos);
 
 		// transform to bottom-screen space
+		s_touchPos = touchToScreen (pos);
 		io_.AddMouseSourceEvent(ImGuiMouseSource_TouchScreen);
-		io_.AddMousePosEvent (pos.px + 40.0f, pos.py + 240.0f);
+		io_.AddMousePosEvent (s_touchPos.x, s_touchPos.y);
 		io_.AddMouseButtonEvent (0, true);
 	}
 	else if (hidKeysUp () & KEY_TOUCH) // touch released
@@ -81,51 +147,386 @@ void updateTouch (ImGuiIO &io_)
 
 }
 
-/// \brief Update gamepad inputs
+/// \brief Default 3DS button to ImGui key mapping
+constexpr std::pair<std::uint32_t, ImGuiKey> BUTTON_MAPPING[] = {
+    {KEY_A, ImGuiKey_GamepadFaceDown},  // A and B are swapped,
+    {KEY_B, ImGuiKey_GamepadFaceRight}, // this is more intuitive
+    {KEY_X, ImGuiKey_GamepadFaceUp},
+    {KEY_Y, ImGuiKey_GamepadFaceLeft},
+    {KEY_L, ImGuiKey_GamepadL1},
+    {KEY_ZL, ImGuiKey_GamepadL1},
+    {KEY_ZR, ImGuiKey_GamepadR1},
+    {KEY_R, ImGuiKey_GamepadR1},
+    {KEY_DUP, ImGuiKey_GamepadDpadUp},
+    {KEY_DRIGHT, ImGuiKey_GamepadDpadRight},
+    {KEY_DDOWN, ImGuiKey_GamepadDpadDown},
+    {KEY_DLEFT, ImGuiKey_GamepadDpadLeft},
+};
+
+/// \brief Settings names of HID button bits (nullptr if not remappable)
+constexpr char const *BUTTON_NAMES[32] = {"A",
+    "B",
+    "Select",
+    "Start",
+    "DRight",
+    "DLeft",
+    "DUp",
+    "DDown",
+    "R",
+    "L",
+    "X",
+    "Y",
+    nullptr,
+    nullptr,
+    "ZL",
+    "ZR",
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr,
+    nullptr, // touch is reported as mouse input
+    nullptr,
+    nullptr,
+    nullptr,
+    "CStickRight",
+    "CStickLeft",
+    "CStickUp",
+    "CStickDown",
+    "CPadRight",
+    "CPadLeft",
+    "CPadUp",
+    "CPadDown"};
+
+/// \brief Circle pad direction
+struct StickMapping
+{
+	/// \brief Whether direction is on the vertical axis
+	bool vertical;
+	/// \brief Axis sign of direction
+	float sign;
+	/// \brief ImGui key
+	ImGuiKey key;
+};
+
+/// \brief Circle pad directions
+constexpr StickMapping STICK_MAPPING[] = {
+    {false, -1.0f, ImGuiKey_GamepadLStickLeft},
+    {false, +1.0f, ImGuiKey_GamepadLStickRight},
+    {true, +1.0f, ImGuiKey_GamepadLStickUp},
+    {true, -1.0f, ImGuiKey_GamepadLStickDown},
+};
+
+/// \brief Circle pad range
+constexpr float CPAD_MAX = 156.0f;
+
+/// \brief Built-in input profile
+constexpr auto DEFAULT_PROFILE = [] {
+	imgui::ctru::InputProfile profile{};
+	for (auto const &[in, out] : BUTTON_MAPPING)
+		profile.buttons[std::countr_zero (in)] = out;
+
+	profile.deadzone   = 0.3f;
+	profile.saturation = 0.9f;
+	profile.curve      = 1.0f;
+	profile.threshold  = 0.1f;
+	return profile;
+}();
+
+static_assert (DEFAULT_PROFILE.buttons[std::countr_zero (std::uint32_t (KEY_A))] ==
+               ImGuiKey_GamepadFaceDown);
+static_assert (DEFAULT_PROFILE.buttons[std::countr_zero (std::uint32_t (KEY_TOUCH))] == ImGuiKey_None);
+
+/// \brief Named input profile
+struct NamedProfile
+{
+	/// \brief Profile name
+	std::string name;
+	/// \brief Profile
+	imgui::ctru::InputProfile profile;
+};
+
+/// \brief Input profiles
+std::vector<NamedProfile> s_profiles = {{"Default", DEFAULT_PROFILE}};
+/// \brief Active input profile index
+std::size_t s_activeProfile = 0;
+
+/// \brief Mapped key with the value last sent to ImGui
+struct KeyState
+{
+	/// \brief ImGui key
+	ImGuiKey key;
+	/// \brief Value last sent
+	float value;
+	/// \brief Value this frame
+	float next;
+};
+
+/// \brief Keys the applied profile reports
+std::vector<KeyState> s_keyStates;
+/// \brief Index into s_keyStates of each HID button bit (-1 if unmapped)
+std::array<int, 32> s_buttonTargets;
+/// \brief Index into s_keyStates of each circle pad direction (-1 if unmapped)
+std::array<int, std::size (STICK_MAPPING)> s_stickTargets;
+/// \brief Circle pad direction values
+std::array<float, std::size (STICK_MAPPING)> s_stickValues;
+/// \brief Profile s_keyStates was built from
+imgui::ctru::InputProfile s_appliedProfile;
+/// \brief Whether a profile has been applied yet
+bool s_profileApplied = false;
+/// \brief Buttons held last frame
+std::uint32_t s_prevHeld = 0;
+/// \brief Circle pad position last frame
+circlePosition s_prevCpad = {0, 0};
+
+/// \brief Find or add key state
+/// \param key_ ImGui key
+int keyStateIndex (ImGuiKey const key_)
+{
+	for (std::size_t i = 0; i < s_keyStates.size (); ++i)
+	{
+		if (s_keyStates[i].key == key_)
+			return i;
+	}
+
+	s_keyStates.emplace_back (KeyState{key_, 0.0f, 0.0f});
+	return s_keyStates.size () - 1;
+}
+
+/// \brief Rebuild key states for profile
 /// \param io_ ImGui IO
-void updateGamepads (ImGuiIO &io_)
+/// \param profile_ Profile to apply
+void applyProfile (ImGuiIO &io_, imgui::ctru::InputProfile const &profile_)
 {
-	auto const buttonMapping = {
-	    std::make_pair (KEY_A, ImGuiKey_GamepadFaceDown),  // A and B are swapped,
-	    std::make_pair (KEY_B, ImGuiKey_GamepadFaceRight), // this is more intuitive
-	    std::make_pair (KEY_X, ImGuiKey_GamepadFaceUp),
-	    std::make_pair (KEY_Y, ImGuiKey_GamepadFaceLeft),
-	    std::make_pair (KEY_L, ImGuiKey_GamepadL1),
-	    std::make_pair (KEY_ZL, ImGuiKey_GamepadL1),
-	    std::make_pair (KEY_ZR, ImGuiKey_GamepadR1),
-	    std::make_pair (KEY_R, ImGuiKey_GamepadR1),
-	    std::make_pair (KEY_DUP, ImGuiKey_GamepadDpadUp),
-	    std::make_pair (KEY_DRIGHT, ImGuiKey_GamepadDpadRight),
-	    std::make_pair (KEY_DDOWN, ImGuiKey_GamepadDpadDown),
-	    std::make_pair (KEY_DLEFT, ImGuiKey_GamepadDpadLeft),
-	};
-
-	// read buttons from 3DS
-	auto const keys_up = hidKeysUp ();
-	auto const keys_down = hidKeysDown ();
-	for (auto const &[in, out] : buttonMapping)
+	auto const previous = std::move (s_keyStates);
+	s_keyStates.clear ();
+
+	for (std::size_t i = 0; i < profile_.buttons.size (); ++i)
+		s_buttonTargets[i] = profile_.buttons[i] == ImGuiKey_None ? -1 : keyStateIndex (profile_.buttons[i]);
+
+	for (std::size_t i = 0; i < std::size (STICK_MAPPING); ++i)
+		s_stickTargets[i] = keyStateIndex (STICK_MAPPING[i].key);
+
+	// carry over what ImGui was last told, and release keys which are no longer mapped
+	for (auto const &state : previous)
 	{
-		if (keys_up & in)
-			io_.AddKeyEvent(out, false);
-		if (keys_down & in)
-			io_.AddKeyEvent(out, true);
+		auto const it = std::find_if (std::begin (s_keyStates),
+		    std::end (s_keyStates),
+		    [&] (auto const &state_) { return state_.key == state.key; });
+		if (it != std::end (s_keyStates))
+			it->value = state.value;
+		else if (state.value != 0.0f)
+			io_.AddKeyAnalogEvent (state.key, false, 0.0f);
 	}
 
-	// update joystick
+	// the circle pad response may have changed
+	s_prevCpad.dx = s_prevCpad.dy = INT16_MIN;
+
+	if (s_profileApplied && !(profile_ == s_appliedProfile))
+		ImGui::MarkIniSettingsDirty ();
+
+	s_appliedProfile = profile_;
+	s_profileApplied = true;
+}
+
+/// \brief Update gamepad inputs
+/// \param io_ ImGui IO
+/// \note Only keys whose value changed are sent to ImGui
+void updateGamepads (ImGuiIO &io_)
+{
+	auto const &profile = s_profiles[s_activeProfile].profile;
+	auto const changed  = !s_profileApplied || !(profile == s_appliedProfile);
+	if (changed)
+		applyProfile (io_, profile);
+
+	auto const held = hidKeysHeld ();
+
 	circlePosition cpad;
-	auto const analogMapping = {
-	    std::make_tuple (std::ref (cpad.dx), ImGuiKey_GamepadLStickLeft, -0.3f, -0.9f),
-	    std::make_tuple (std::ref (cpad.dx), ImGuiKey_GamepadLStickRight, +0.3f, +0.9f),
-	    std::make_tuple (std::ref (cpad.dy), ImGuiKey_GamepadLStickUp, +0.3f, +0.9f),
-	    std::make_tuple (std::ref (cpad.dy), ImGuiKey_GamepadLStickDown, -0.3f, -0.9f),
-	};
-
-	// read left joystick from circle pad
 	hidCircleRead (&cpad);
-	for (auto const &[in, out, min, max] : analogMapping)
+
+	auto const cpadMoved = cpad.dx != s_prevCpad.dx || cpad.dy != s_prevCpad.dy;
+	if (!changed && !cpadMoved && held == s_prevHeld)
+		return;
+
+	// circle pad response is only recomputed when it moves
+	if (cpadMoved)
 	{
-		auto const value = std::clamp ((in / 156.0f - min) / (max - min), 0.0f, 1.0f);
-		io_.AddKeyAnalogEvent(out, value > 0.1f, value);
+		auto const range = std::max (profile.saturation - profile.deadzone, 1e-3f);
+		for (std::size_t i = 0; i < std::size (STICK_MAPPING); ++i)
+		{
+			auto const &mapping = STICK_MAPPING[i];
+			auto const travel   = mapping.sign * (mapping.vertical ? cpad.dy : cpad.dx) / CPAD_MAX;
+			auto const value    = std::clamp ((travel - profile.deadzone) / range, 0.0f, 1.0f);
+			s_stickValues[i]    = profile.curve == 1.0f ? value : std::pow (value, profile.curve);
+		}
+	}
+
+	s_prevHeld = held;
+	s_prevCpad = cpad;
+
+	for (auto &state : s_keyStates)
+		state.next = 0.0f;
+
+	// several buttons may share a key, so it is down while any of them is held
+	for (auto bits = held; bits; bits &= bits - 1)
+	{
+		auto const target = s_buttonTargets[std::countr_zero (bits)];
+		if (target >= 0)
+			s_keyStates[target].next = 1.0f;
+	}
+
+	for (std::size_t i = 0; i < std::size (STICK_MAPPING); ++i)
+	{
+		auto &state = s_keyStates[s_stickTargets[i]];
+		state.next  = std::max (state.next, s_stickValues[i]);
+	}
+
+	for (auto &state : s_keyStates)
+	{
+		if (state.next == state.value)
+			continue;
+
+		state.value = state.next;
+		io_.AddKeyAnalogEvent (state.key, state.value > profile.threshold, state.value);
+	}
+}
+
+/// \brief Find key by name
+/// \param name_ Key name
+/// \param[out] key_ Key
+bool findKey (char const *const name_, ImGuiKey &key_)
+{
+	if (std::strcmp (name_, ImGui::GetKeyName (ImGuiKey_None)) == 0)
+	{
+		key_ = ImGuiKey_None;
+		return true;
+	}
+
+	for (int i = ImGuiKey_NamedKey_BEGIN; i < ImGuiKey_NamedKey_END; ++i)
+	{
+		if (std::strcmp (name_, ImGui::GetKeyName (static_cast<ImGuiKey> (i))) == 0)
+		{
+			key_ = static_cast<ImGuiKey> (i);
+			return true;
+		}
+	}
+
+	return false;
+}
+
+/// \brief Find profile by name
+/// \param name_ Profile name
+std::size_t findProfile (char const *const name_)
+{
+	for (std::size_t i = 0; i < s_profiles.size (); ++i)
+	{
+		if (s_profiles[i].name == name_)
+			return i;
+	}
+
+	s_profiles.emplace_back (NamedProfile{name_, DEFAULT_PROFILE});
+	return s_profiles.size () - 1;
+}
+
+/// \brief Settings handler: reset profiles
+void settingsClearAll (ImGuiContext *const context_, ImGuiSettingsHandler *const handler_)
+{
+	(void)context_;
+	(void)handler_;
+
+	s_profiles.resize (1);
+	s_profiles[0].profile = DEFAULT_PROFILE;
+	s_activeProfile       = 0;
+}
+
+/// \brief Settings handler: open profile section
+/// \note Entries are profile indices plus one, as nullptr skips the section; pointers into
+/// s_profiles wouldn't survive later sections adding profiles
+void *settingsReadOpen (ImGuiContext *const context_,
+    ImGuiSettingsHandler *const handler_,
+    char const *const name_)
+{
+	(void)context_;
+	(void)handler_;
+
+	return reinterpret_cast<void *> (findProfile (name_) + 1);
+}
+
+/// \brief Settings handler: read profile line
+void settingsReadLine (ImGuiContext *const context_,
+    ImGuiSettingsHandler *const handler_,
+    void *const entry_,
+    char const *const line_)
+{
+	(void)context_;
+	(void)handler_;
+
+	auto const index = reinterpret_cast<std::uintptr_t> (entry_) - 1;
+	auto &profile    = s_profiles[index].profile;
+
+	int active;
+	float value;
+	char name[64];
+	if (std::sscanf (line_, "Deadzone=%f", &value) == 1)
+		profile.deadzone = std::clamp (value, 0.0f, 1.0f);
+	else if (std::sscanf (line_, "Saturation=%f", &value) == 1)
+		profile.saturation = std::clamp (value, 0.0f, 1.0f);
+	else if (std::sscanf (line_, "Curve=%f", &value) == 1)
+		profile.curve = std::clamp (value, 0.1f, 10.0f);
+	else if (std::sscanf (line_, "Threshold=%f", &value) == 1)
+		profile.threshold = std::clamp (value, 0.0f, 0.99f);
+	else if (std::sscanf (line_, "Active=%d", &active) == 1)
+	{
+		if (active)
+			s_activeProfile = index;
+	}
+	else if (auto const eq = std::strchr (line_, '='); eq && eq - line_ < int (sizeof (name)))
+	{
+		std::memcpy (name, line_, eq - line_);
+		name[eq - line_] = '\0';
+
+		ImGuiKey key;
+		for (std::size_t i = 0; i < std::size (BUTTON_NAMES); ++i)
+		{
+			if (BUTTON_NAMES[i] && std::strcmp (BUTTON_NAMES[i], name) == 0 && findKey (eq + 1, key))
+				profile.buttons[i] = key;
+		}
+	}
+}
+
+/// \brief Settings handler: write profiles
+/// \note Only entries which differ from the defaults are written
+void settingsWriteAll (ImGuiContext *const context_,
+    ImGuiSettingsHandler *const handler_,
+    ImGuiTextBuffer *const buf_)
+{
+	(void)context_;
+
+	for (std::size_t i = 0; i < s_profiles.size (); ++i)
+	{
+		auto const &[name, profile] = s_profiles[i];
+		if (i != s_activeProfile && profile == DEFAULT_PROFILE)
+			continue;
+
+		buf_->appendf ("[%s][%s]\n", handler_->TypeName, name.c_str ());
+		if (i == s_activeProfile)
+			buf_->append ("Active=1\n");
+
+		for (std::size_t j = 0; j < profile.buttons.size (); ++j)
+		{
+			if (BUTTON_NAMES[j] && profile.buttons[j] != DEFAULT_PROFILE.buttons[j])
+				buf_->appendf ("%s=%s\n", BUTTON_NAMES[j], ImGui::GetKeyName (profile.buttons[j]));
+		}
+
+		if (profile.deadzone != DEFAULT_PROFILE.deadzone)
+			buf_->appendf ("Deadzone=%g\n", profile.deadzone);
+		if (profile.saturation != DEFAULT_PROFILE.saturation)
+			buf_->appendf ("Saturation=%g\n", profile.saturation);
+		if (profile.curve != DEFAULT_PROFILE.curve)
+			buf_->appendf ("Curve=%g\n", profile.curve);
+		if (profile.threshold != DEFAULT_PROFILE.threshold)
+			buf_->appendf ("Threshold=%g\n", profile.threshold);
+
+		buf_->append ("\n");
 	}
 }
 
@@ -139,6 +540,9 @@ void updateKeyboard (ImGuiIO &io_)
 		CLEARED,
 	} state = INACTIVE;
 
+	// whether the keyboard was opened for InputText
+	static bool inputText = false;
+
 	switch (state)
 	{
 	case INACTIVE:
@@ -153,11 +557,18 @@ void updateKeyboard (ImGuiIO &io_)
 		swkbdInit (&kbd, SWKBD_TYPE_NORMAL, 2, -1);
 		swkbdSetButton (&kbd, SWKBD_BUTTON_LEFT, "Cancel", false);
 		swkbdSetButton (&kbd, SWKBD_BUTTON_RIGHT, "OK", true);
-		swkbdSetInitialText (
-		    &kbd, std::string (textState.TextToRevertTo.Data, textState.TextToRevertTo.Size).c_str ());
 
-		if (textState.Flags & ImGuiInputTextFlags_Password)
-			swkbdSetPasswordMode (&kbd, SWKBD_PASSWORD_HIDE_DELAY);
+		// InputText edits its whole text in the keyboard; other widgets (e.g. TextEditor) insert
+		// what was typed at their cursor
+		inputText = textState.ID == ImGui::GetActiveID ();
+		if (inputText)
+		{
+			swkbdSetInitialText (&kbd,
+			    std::string (textState.TextToRevertTo.Data, textState.TextToRevertTo.Size).c_str ());
+
+			if (textState.Flags & ImGuiInputTextFlags_Password)
+				swkbdSetPasswordMode (&kbd, SWKBD_PASSWORD_HIDE_DELAY);
+		}
 
 		char buffer[32]   = {0};
 		auto const button = swkbdInputText (&kbd, buffer, sizeof (buffer));
@@ -169,8 +580,10 @@ void updateKeyboard (ImGuiIO &io_)
 	}
 
 	case KEYBOARD:
-		// need to skip a frame for active id to really be cleared
-		ImGui::ClearActiveID ();
+		// InputText took the keyboard's text as its new value, so it is done; other widgets keep
+		// editing at their cursor. Need to skip a frame for active id to really be cleared
+		if (inputText)
+			ImGui::ClearActiveID ();
 		state = CLEARED;
 		break;
 
@@ -230,6 +643,16 @@ bool imgui::ctru::init ()
 	platformIO.Platform_GetClipboardTextFn = &getClipboardText;
 	platformIO.Platform_ClipboardUserData  = nullptr;
 
+	// input profiles are saved with the rest of the settings
+	ImGuiSettingsHandler handler;
+	handler.TypeName   = "3DSInput";
+	handler.TypeHash   = ImHashStr ("3DSInput");
+	handler.ClearAllFn = &settingsClearAll;
+	handler.ReadOpenFn = &settingsReadOpen;
+	handler.ReadLineFn = &settingsReadLine;
+	handler.WriteAllFn = &settingsWriteAll;
+	ImGui::AddSettingsHandler (&handler);
+
 	return true;
 }
 
@@ -254,3 +677,31 @@ void imgui::ctru::newFrame ()
 	updateGamepads (io);
 	updateKeyboard (io);
 }
+
+imgui::ctru::InputProfile &imgui::ctru::inputProfile ()
+{
+	return s_profiles[s_activeProfile].profile;
+}
+
+void imgui::ctru::setInputProfile (char const *const name_)
+{
+	s_activeProfile = findProfile (name_);
+	ImGui::MarkIniSettingsDirty ();
+}
+
+bool imgui::ctru::lateLatchTouch (ImVec2 &delta_)
+{
+	delta_ = ImVec2 (0.0f, 0.0f);
+
+	// only a touch that was already held this frame can be dragging something
+	if (!(hidKeysHeld () & KEY_TOUCH))
+		return false;
+
+	touchPosition pos;
+	if (!readLatestTouch (pos))
+		return false;
+
+	auto const latest = touchToScreen (pos);
+	delta_            = ImVec2 (latest.x - s_touchPos.x, latest.y - s_touchPos.y);
+	return true;
+}
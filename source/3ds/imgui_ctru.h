@@ -24,14 +24,49 @@
 
 #include <3ds.h>
 
+#include "../imgui/imgui.h"
+
+#include <array>
+
 namespace imgui
 {
 namespace ctru
 {
+/// \brief Input mapping profile
+/// \note Profiles are saved with ImGui settings as the entries which differ from the defaults
+struct InputProfile
+{
+	/// \brief ImGui key for each HID button bit (ImGuiKey_None to ignore)
+	std::array<ImGuiKey, 32> buttons;
+	/// \brief Fraction of circle pad travel ignored around center
+	float deadzone;
+	/// \brief Fraction of circle pad travel which reads as fully pressed
+	float saturation;
+	/// \brief Circle pad response exponent (1 is linear)
+	float curve;
+	/// \brief Value above which a key counts as down
+	float threshold;
+
+	bool operator== (InputProfile const &) const = default;
+};
+
 /// \brief Initialize 3ds platform
 bool init ();
 
 /// \brief Prepare 3ds for a new frame
 void newFrame ();
+
+/// \brief Active input profile
+/// \note Edits take effect on the next newFrame
+InputProfile &inputProfile ();
+
+/// \brief Switch input profile
+/// \param name_ Profile name; created from the defaults if it doesn't exist yet
+void setInputProfile (char const *name_);
+
+/// \brief Re-read touch position right before submission
+/// \param[out] delta_ Touch movement since newFrame
+/// \returns Whether touch is still held
+bool lateLatchTouch (ImVec2 &delta_);
 }
 }
\ No newline at end of file
@@ -0,0 +1,208 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "imgui_log.h"
+
+#include "../imgui/imgui_internal.h"
+
+#ifdef __3DS__
+#include <3ds.h>
+#else
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <cstdarg>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+/// \brief Words per line
+constexpr auto LINE_WORDS = imgui::LogBuffer::LINE_SIZE / sizeof (std::uint32_t);
+
+/// \brief Give up the rest of this time slice
+void relax ()
+{
+#ifdef __3DS__
+	svcSleepThread (0);
+#else
+	sched_yield ();
+#endif
+}
+}
+
+imgui::LogBuffer::LogBuffer (std::size_t const capacity_)
+    : m_slots (std::max<std::size_t> (ImUpperPowerOfTwo (static_cast<int> (capacity_)), 1))
+{
+}
+
+std::uint64_t imgui::LogBuffer::append (char const *const text_, std::size_t const size_)
+{
+	auto const size = std::min (size_, LINE_SIZE);
+
+	auto const index   = m_next.fetch_add (1, std::memory_order_relaxed);
+	auto &slot         = m_slots[index & (m_slots.size () - 1)];
+	auto const writing = 2 * index + 1;
+
+	// take the slot from the line it held one lap ago; only waits if a producer stalled for a
+	// whole lap in the middle of its copy
+	auto sequence = slot.sequence.load (std::memory_order_relaxed);
+	while (true)
+	{
+		// a newer line already took the slot, so this one would have been overwritten anyway
+		if (sequence >= writing)
+			return index;
+
+		if (sequence & 1)
+		{
+			relax ();
+			sequence = slot.sequence.load (std::memory_order_relaxed);
+		}
+		else if (slot.sequence.compare_exchange_weak (
+		             sequence, writing, std::memory_order_acquire, std::memory_order_relaxed))
+			break;
+	}
+
+	// readers that see any of the new text also see the odd sequence number
+	std::atomic_thread_fence (std::memory_order_release);
+
+	// copy straight from the caller's text; the line isn't touched again on this thread
+	slot.size.store (size, std::memory_order_relaxed);
+	std::size_t i = 0;
+	for (; i < size / sizeof (std::uint32_t); ++i)
+	{
+		std::uint32_t word;
+		std::memcpy (&word, &text_[i * sizeof (std::uint32_t)], sizeof (word));
+		slot.text[i].store (word, std::memory_order_relaxed);
+	}
+
+	if (size % sizeof (std::uint32_t))
+	{
+		std::uint32_t word = 0;
+		std::memcpy (&word, &text_[i * sizeof (std::uint32_t)], size % sizeof (std::uint32_t));
+		slot.text[i].store (word, std::memory_order_relaxed);
+	}
+
+	slot.sequence.store (writing + 1, std::memory_order_release);
+	return index;
+}
+
+std::uint64_t imgui::LogBuffer::appendf (char const *const fmt_, ...)
+{
+	char line[LINE_SIZE + 1];
+
+	va_list ap;
+	va_start (ap, fmt_);
+	auto const rc = std::vsnprintf (line, sizeof (line), fmt_, ap);
+	va_end (ap);
+
+	return append (line, std::clamp<int> (rc, 0, LINE_SIZE));
+}
+
+std::uint64_t imgui::LogBuffer::begin () const
+{
+	auto const end = this->end ();
+	return end > m_slots.size () ? end - m_slots.size () : 0;
+}
+
+std::uint64_t imgui::LogBuffer::end () const
+{
+	return m_next.load (std::memory_order_acquire);
+}
+
+int imgui::LogBuffer::read (std::uint64_t const index_, char (&out_)[LINE_SIZE]) const
+{
+	auto const &slot   = m_slots[index_ & (m_slots.size () - 1)];
+	auto const written = 2 * index_ + 2;
+	if (slot.sequence.load (std::memory_order_acquire) != written)
+		return -1;
+
+	auto const size = std::min<std::size_t> (slot.size.load (std::memory_order_relaxed), LINE_SIZE);
+	std::uint32_t words[LINE_WORDS];
+	for (std::size_t i = 0; i < (size + sizeof (std::uint32_t) - 1) / sizeof (std::uint32_t); ++i)
+		words[i] = slot.text[i].load (std::memory_order_relaxed);
+
+	// the copy is only valid if no producer took the slot in the meantime
+	std::atomic_thread_fence (std::memory_order_acquire);
+	if (slot.sequence.load (std::memory_order_relaxed) != written)
+		return -1;
+
+	// newlines are replaced here rather than by producers, and only for lines that are shown
+	std::memcpy (out_, words, size);
+	std::replace (out_, out_ + size, '\n', ' ');
+	return size;
+}
+
+std::size_t imgui::LogBuffer::capacity () const
+{
+	return m_slots.size ();
+}
+
+///////////////////////////////////////////////////////////////////////////
+void imgui::LogView::draw (char const *const label_, LogBuffer const &log_, ImVec2 const &size_)
+{
+	auto const begin      = log_.begin ();
+	auto const end        = log_.end ();
+	auto const lineHeight = ImGui::GetTextLineHeightWithSpacing ();
+
+	// lines keep their index, so while scrolled back keep showing the same lines as the oldest
+	// ones are dropped from the top; the scroll target is shifted too so wheel and drag scrolling
+	// queued this frame still apply
+	auto const window = m_follow ? nullptr : ImGui::FindWindowByID (m_windowId);
+	if (window && begin > m_begin)
+	{
+		auto const shift = (begin - m_begin) * lineHeight;
+		window->Scroll.y = std::max (0.0f, window->Scroll.y - shift);
+		if (window->ScrollTarget.y < FLT_MAX)
+			window->ScrollTarget.y = std::max (0.0f, window->ScrollTarget.y - shift);
+	}
+	m_begin = begin;
+
+	if (!ImGui::BeginChild (
+	        label_, size_, ImGuiChildFlags_Borders, ImGuiWindowFlags_HorizontalScrollbar))
+	{
+		ImGui::EndChild ();
+		return;
+	}
+
+	ImGuiListClipper clipper;
+	clipper.Begin (static_cast<int> (end - begin), lineHeight);
+	while (clipper.Step ())
+	{
+		for (auto i = clipper.DisplayStart; i < clipper.DisplayEnd; ++i)
+		{
+			// lines being written, or overwritten since begin () was read, show up empty this frame
+			auto const size = log_.read (begin + i, m_line);
+			ImGui::TextUnformatted (m_line, m_line + std::max (size, 0));
+		}
+	}
+	clipper.End ();
+
+	m_windowId = ImGui::GetCurrentWindow ()->ID;
+	m_follow   = ImGui::GetScrollY () >= ImGui::GetScrollMaxY ();
+	if (m_follow)
+		ImGui::SetScrollHereY (1.0f);
+
+	ImGui::EndChild ();
+}
@@ -0,0 +1,128 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include "../imgui/imgui.h"
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Log lines written by background threads and shown by the UI thread without either side taking
+// a lock.
+//
+// LogBuffer is a ring of fixed-size line slots. A producer claims the next line index with one
+// atomic increment and copies its line into the slot that index maps to, bracketed by a sequence
+// number (a seqlock per slot); once the ring is full each new line overwrites the oldest one.
+// Line indices only ever grow, so a line keeps its index for as long as it is in the ring, and
+// the reader validates each line it copies against the sequence number instead of blocking
+// producers. Memory is capacity * sizeof (slot), allocated once.
+
+namespace imgui
+{
+/// \brief Bounded multi-producer log of preformatted lines
+class LogBuffer
+{
+public:
+	/// \brief Maximum bytes per line; longer lines are truncated
+	static constexpr std::size_t LINE_SIZE = 116;
+
+	/// \brief Allocate ring
+	/// \param capacity_ Number of lines kept (rounded up to a power of two)
+	explicit LogBuffer (std::size_t capacity_ = 4096);
+
+	LogBuffer (LogBuffer const &) = delete;
+	LogBuffer &operator= (LogBuffer const &) = delete;
+
+	/// \brief Append line
+	/// \param text_ Text (newlines are read back as spaces)
+	/// \param size_ Size of text
+	/// \returns Index of the line
+	/// \note Safe to call from any thread
+	std::uint64_t append (char const *text_, std::size_t size_);
+
+	/// \brief Append formatted line
+	/// \param fmt_ Format string
+	/// \returns Index of the line
+	/// \note Safe to call from any thread
+	std::uint64_t appendf (char const *fmt_, ...) IM_FMTARGS (2);
+
+	/// \brief Index of oldest line still in the ring
+	std::uint64_t begin () const;
+
+	/// \brief One past index of newest line
+	/// \note The newest lines may still be being written
+	std::uint64_t end () const;
+
+	/// \brief Copy line
+	/// \param index_ Line index
+	/// \param out_ Output
+	/// \returns Size of line, or -1 if it was overwritten or is still being written
+	int read (std::uint64_t index_, char (&out_)[LINE_SIZE]) const;
+
+	/// \brief Number of lines kept
+	std::size_t capacity () const;
+
+private:
+	/// \brief Line slot
+	struct Slot
+	{
+		/// \brief 2 * index + 1 while line index is being written, 2 * index + 2 once written
+		std::atomic<std::uint64_t> sequence{0};
+		/// \brief Size of line
+		std::atomic<std::uint32_t> size{0};
+		/// \brief Text, copied a word at a time so readers may race with writers
+		std::atomic<std::uint32_t> text[LINE_SIZE / sizeof (std::uint32_t)];
+	};
+
+	/// \brief Line slots
+	std::vector<Slot> m_slots;
+	/// \brief Index of next line
+	std::atomic<std::uint64_t> m_next = 0;
+};
+
+/// \brief Log widget for a LogBuffer
+class LogView
+{
+public:
+	/// \brief Draw the lines in the ring
+	/// \param label_ Widget label (used as ID)
+	/// \param log_ Log to show
+	/// \param size_ Widget size
+	/// \note Only visible lines are copied out of the log. Follows new lines while scrolled to the
+	/// bottom; otherwise keeps the same lines in view until they are overwritten
+	void draw (char const *label_, LogBuffer const &log_, ImVec2 const &size_);
+
+private:
+	/// \brief Oldest line shown last frame
+	std::uint64_t m_begin = 0;
+	/// \brief Child window showing the lines
+	ImGuiID m_windowId = 0;
+	/// \brief Whether the view was scrolled to the bottom last frame
+	bool m_follow = true;
+	/// \brief Scratch line buffer
+	char m_line[LogBuffer::LINE_SIZE];
+};
+}
@@ -0,0 +1,809 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "imgui_remote.h"
+
+#ifdef __3DS__
+#include <3ds.h>
+#include <malloc.h>
+#else
+#include <chrono>
+#endif
+
+#include <arpa/inet.h>
+#include <fcntl.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstdlib>
+#include <cstring>
+
+namespace
+{
+/// \brief Minimum match length
+constexpr std::size_t LZ_MIN_MATCH = 4;
+/// \brief Maximum match distance
+constexpr std::size_t LZ_MAX_OFFSET = 0xFFFF;
+/// \brief Number of hash table bits
+constexpr unsigned LZ_HASH_BITS = 12;
+/// \brief Most bytes one compressed byte can expand to (a full length extension byte)
+constexpr std::uint64_t LZ_MAX_RATIO = 255;
+
+/// \brief Match table, kept between calls to compress so every frame doesn't allocate it
+std::vector<std::uint32_t> s_lzTable;
+
+#ifdef __3DS__
+/// \brief SOC service buffer size
+constexpr auto SOC_BUFFER_SIZE = 0x100000;
+/// \brief SOC service buffer
+std::uint32_t *s_socBuffer = nullptr;
+#endif
+
+/// \brief Listening socket
+int s_listen = -1;
+/// \brief Viewer socket
+int s_client = -1;
+
+/// \brief Encoder
+imgui::remote::Encoder s_encoder;
+/// \brief Statistics
+imgui::remote::Stats s_stats;
+
+/// \brief Outgoing frame message
+std::vector<std::uint8_t> s_outBuffer;
+/// \brief Amount of outgoing frame message already sent
+std::size_t s_outPos = 0;
+
+/// \brief Incoming input messages
+std::vector<std::uint8_t> s_inBuffer;
+/// \brief Last mouse position received from viewer
+ImVec2 s_remoteMouse (-1.0f, -1.0f);
+/// \brief Last mouse buttons received from viewer
+std::uint32_t s_remoteButtons = 0;
+
+/// \brief Get current time in seconds
+double now ()
+{
+#ifdef __3DS__
+	return static_cast<double> (svcGetSystemTick ()) / SYSCLOCK_ARM11;
+#else
+	return std::chrono::duration<double> (std::chrono::steady_clock::now ().time_since_epoch ())
+	    .count ();
+#endif
+}
+
+/// \brief Append raw bytes
+/// \param out_ Output buffer
+/// \param data_ Data to append
+/// \param size_ Size of data
+void put (std::vector<std::uint8_t> &out_, void const *const data_, std::size_t const size_)
+{
+	auto const p = static_cast<std::uint8_t const *> (data_);
+	out_.insert (std::end (out_), p, p + size_);
+}
+
+/// \brief Append value
+/// \tparam T Value type
+/// \param out_ Output buffer
+/// \param value_ Value to append
+template <typename T>
+void put (std::vector<std::uint8_t> &out_, T const &value_)
+{
+	put (out_, &value_, sizeof (value_));
+}
+
+/// \brief Append data XORed against previous data
+/// \param out_ Output buffer
+/// \param data_ Current data
+/// \param size_ Size of current data
+/// \param prev_ Previous data
+/// \param prevSize_ Size of previous data
+/// \note Unchanged bytes become zero, which the compressor collapses into long matches
+void putDelta (std::vector<std::uint8_t> &out_,
+    void const *const data_,
+    std::size_t const size_,
+    void const *const prev_,
+    std::size_t const prevSize_)
+{
+	auto const cur  = static_cast<std::uint8_t const *> (data_);
+	auto const prev = static_cast<std::uint8_t const *> (prev_);
+	auto const base = out_.size ();
+	out_.resize (base + size_);
+
+	auto const common = std::min (size_, prevSize_);
+	for (std::size_t i = 0; i < common; ++i)
+		out_[base + i] = cur[i] ^ prev[i];
+
+	if (size_ > common)
+		std::memcpy (&out_[base + common], cur + common, size_ - common);
+}
+
+/// \brief Bounds-checked payload reader
+struct Reader
+{
+	/// \brief Read raw bytes
+	/// \param data_ Output
+	/// \param size_ Number of bytes
+	bool get (void *const data_, std::size_t const size_)
+	{
+		if (end - pos < static_cast<std::ptrdiff_t> (size_))
+			return false;
+
+		std::memcpy (data_, pos, size_);
+		pos += size_;
+		return true;
+	}
+
+	/// \brief Read value
+	/// \tparam T Value type
+	/// \param value_ Output
+	template <typename T>
+	bool get (T &value_)
+	{
+		return get (&value_, sizeof (value_));
+	}
+
+	/// \brief Read data XORed against previous data
+	/// \param data_ Output; holds previous data on entry
+	/// \param size_ Size of output
+	/// \param prevSize_ Size of previous data
+	bool getDelta (void *const data_, std::size_t const size_, std::size_t const prevSize_)
+	{
+		if (end - pos < static_cast<std::ptrdiff_t> (size_))
+			return false;
+
+		auto const out    = static_cast<std::uint8_t *> (data_);
+		auto const common = std::min (size_, prevSize_);
+		for (std::size_t i = 0; i < common; ++i)
+			out[i] ^= pos[i];
+
+		if (size_ > common)
+			std::memcpy (out + common, pos + common, size_ - common);
+
+		pos += size_;
+		return true;
+	}
+
+	/// \brief Read position
+	std::uint8_t const *pos;
+	/// \brief End of data
+	std::uint8_t const *end;
+};
+
+/// \brief Read 32-bit value from unaligned address
+/// \param p_ Address to read
+std::uint32_t read32 (std::uint8_t const *const p_)
+{
+	std::uint32_t value;
+	std::memcpy (&value, p_, sizeof (value));
+	return value;
+}
+
+/// \brief Write LZ length extension bytes
+/// \param out_ Output buffer
+/// \param length_ Length beyond the nibble
+void putLength (std::vector<std::uint8_t> &out_, std::size_t length_)
+{
+	while (length_ >= 0xFF)
+	{
+		out_.emplace_back (0xFF);
+		length_ -= 0xFF;
+	}
+	out_.emplace_back (length_);
+}
+
+/// \brief Read LZ length extension bytes
+/// \param reader_ Reader
+/// \param length_ Length to extend
+bool getLength (Reader &reader_, std::size_t &length_)
+{
+	std::uint8_t byte;
+	do
+	{
+		if (!reader_.get (byte))
+			return false;
+		length_ += byte;
+	} while (byte == 0xFF);
+
+	return true;
+}
+
+/// \brief Make socket non-blocking
+/// \param fd_ Socket
+bool setNonBlocking (int const fd_)
+{
+	auto const flags = ::fcntl (fd_, F_GETFL, 0);
+	if (flags < 0)
+		return false;
+
+	return ::fcntl (fd_, F_SETFL, flags | O_NONBLOCK) == 0;
+}
+
+/// \brief Close viewer connection
+void disconnect ()
+{
+	if (s_client >= 0)
+		::close (s_client);
+
+	s_client = -1;
+	s_outBuffer.clear ();
+	s_outPos = 0;
+	s_inBuffer.clear ();
+	s_remoteMouse   = ImVec2 (-1.0f, -1.0f);
+	s_remoteButtons = 0;
+}
+
+/// \brief Send as much of the pending frame as the socket accepts
+/// \returns Whether the pending frame was sent completely
+bool flush ()
+{
+	while (s_outPos < s_outBuffer.size ())
+	{
+		auto const rc =
+		    ::send (s_client, &s_outBuffer[s_outPos], s_outBuffer.size () - s_outPos, 0);
+		if (rc < 0)
+		{
+			if (errno != EAGAIN && errno != EWOULDBLOCK)
+				disconnect ();
+			return false;
+		}
+
+		s_outPos += rc;
+	}
+
+	s_outBuffer.clear ();
+	s_outPos = 0;
+	return true;
+}
+}
+
+///////////////////////////////////////////////////////////////////////////
+void imgui::remote::Encoder::reset ()
+{
+	m_prev.clear ();
+}
+
+std::uint32_t imgui::remote::Encoder::textureHandle (ImTextureID const texture_)
+{
+	// handle 0 is always the font atlas
+	if (m_textures.empty ())
+		m_textures.emplace_back (ImGui::GetIO ().Fonts->TexID);
+
+	auto const it = std::find (std::begin (m_textures), std::end (m_textures), texture_);
+	if (it != std::end (m_textures))
+		return std::distance (std::begin (m_textures), it);
+
+	m_textures.emplace_back (texture_);
+	return m_textures.size () - 1;
+}
+
+void imgui::remote::Encoder::encode (ImDrawData const &drawData_,
+    std::vector<std::uint8_t> &out_,
+    Stats &stats_)
+{
+	auto const start = now ();
+
+	stats_.listsSent      = 0;
+	stats_.listsUnchanged = 0;
+
+	m_payload.clear ();
+	put (m_payload, m_frame++);
+	put (m_payload, drawData_.DisplayPos);
+	put (m_payload, drawData_.DisplaySize);
+	put (m_payload, drawData_.FramebufferScale);
+	put (m_payload, static_cast<std::uint32_t> (drawData_.CmdListsCount));
+
+	m_prev.resize (std::max<std::size_t> (m_prev.size (), drawData_.CmdListsCount));
+	for (int i = 0; i < drawData_.CmdListsCount; ++i)
+	{
+		auto const &cmdList = *drawData_.CmdLists[i];
+		auto &prev          = m_prev[i];
+
+		// pack commands; callbacks can't cross the wire
+		m_cmds.clear ();
+		for (auto const &cmd : cmdList.CmdBuffer)
+		{
+			if (cmd.UserCallback)
+				continue;
+
+			Command packed;
+			packed.clipRect[0] = cmd.ClipRect.x;
+			packed.clipRect[1] = cmd.ClipRect.y;
+			packed.clipRect[2] = cmd.ClipRect.z;
+			packed.clipRect[3] = cmd.ClipRect.w;
+			packed.texture     = textureHandle (cmd.TextureId);
+			packed.vtxOffset   = cmd.VtxOffset;
+			packed.idxOffset   = cmd.IdxOffset;
+			packed.elemCount   = cmd.ElemCount;
+			m_cmds.emplace_back (packed);
+		}
+
+		auto const vtxCount = static_cast<std::size_t> (cmdList.VtxBuffer.Size);
+		auto const idxCount = static_cast<std::size_t> (cmdList.IdxBuffer.Size);
+
+		// skip lists which are identical to what the viewer already has
+		if (prev.vtx.size () == vtxCount && prev.idx.size () == idxCount &&
+		    prev.cmd.size () == m_cmds.size () &&
+		    std::memcmp (prev.vtx.data (), cmdList.VtxBuffer.Data, vtxCount * sizeof (ImDrawVert)) ==
+		        0 &&
+		    std::memcmp (prev.idx.data (), cmdList.IdxBuffer.Data, idxCount * sizeof (ImDrawIdx)) ==
+		        0 &&
+		    std::memcmp (prev.cmd.data (), m_cmds.data (), m_cmds.size () * sizeof (Command)) == 0)
+		{
+			put (m_payload, std::uint8_t (0));
+			++stats_.listsUnchanged;
+			continue;
+		}
+
+		put (m_payload, std::uint8_t (1));
+		put (m_payload, static_cast<std::uint32_t> (vtxCount));
+		put (m_payload, static_cast<std::uint32_t> (idxCount));
+		put (m_payload, static_cast<std::uint32_t> (m_cmds.size ()));
+		put (m_payload, m_cmds.data (), m_cmds.size () * sizeof (Command));
+
+		// delta-encode vertices/indices against the previous frame
+		putDelta (m_payload,
+		    cmdList.VtxBuffer.Data,
+		    vtxCount * sizeof (ImDrawVert),
+		    prev.vtx.data (),
+		    prev.vtx.size () * sizeof (ImDrawVert));
+		putDelta (m_payload,
+		    cmdList.IdxBuffer.Data,
+		    idxCount * sizeof (ImDrawIdx),
+		    prev.idx.data (),
+		    prev.idx.size () * sizeof (ImDrawIdx));
+
+		prev.vtx.assign (cmdList.VtxBuffer.Data, cmdList.VtxBuffer.Data + vtxCount);
+		prev.idx.assign (cmdList.IdxBuffer.Data, cmdList.IdxBuffer.Data + idxCount);
+		prev.cmd.assign (std::begin (m_cmds), std::end (m_cmds));
+		++stats_.listsSent;
+	}
+
+	// write header and compressed payload
+	auto const base = out_.size ();
+	out_.resize (base + sizeof (FrameHeader));
+	compress (m_payload.data (), m_payload.size (), out_);
+
+	FrameHeader header;
+	header.magic          = FRAME_MAGIC;
+	header.compressedSize = out_.size () - base - sizeof (FrameHeader);
+	header.rawSize        = m_payload.size ();
+	std::memcpy (&out_[base], &header, sizeof (header));
+
+	stats_.rawBytes   = m_payload.size ();
+	stats_.wireBytes  = out_.size () - base;
+	stats_.encodeTime = now () - start;
+}
+
+///////////////////////////////////////////////////////////////////////////
+imgui::remote::Decoder::Decoder () = default;
+
+imgui::remote::Decoder::~Decoder ()
+{
+	for (auto const &list : m_lists)
+		IM_DELETE (list);
+}
+
+bool imgui::remote::Decoder::decode (void const *const data_, std::size_t const size_)
+{
+	if (decodeFrame (data_, size_))
+		return true;
+
+	// a later delta would apply to half-decoded lists; start over from empty lists
+	for (auto const &list : m_lists)
+	{
+		list->CmdBuffer.resize (0);
+		list->VtxBuffer.resize (0);
+		list->IdxBuffer.resize (0);
+	}
+
+	m_drawData.CmdLists.resize (0);
+	m_drawData.CmdListsCount = 0;
+	m_drawData.TotalVtxCount = 0;
+	m_drawData.TotalIdxCount = 0;
+	m_drawData.Valid         = false;
+	return false;
+}
+
+bool imgui::remote::Decoder::decodeFrame (void const *const data_, std::size_t const size_)
+{
+	FrameHeader header;
+	if (size_ < sizeof (header))
+		return false;
+
+	std::memcpy (&header, data_, sizeof (header));
+	if (header.magic != FRAME_MAGIC || header.compressedSize != size_ - sizeof (header))
+		return false;
+
+	// don't size the payload from a raw size the compressed data can't expand to
+	if (header.rawSize > header.compressedSize * LZ_MAX_RATIO)
+		return false;
+
+	m_payload.resize (header.rawSize);
+	if (!decompress (
+	        static_cast<std::uint8_t const *> (data_) + sizeof (header), header.compressedSize, m_payload))
+		return false;
+
+	Reader reader{m_payload.data (), m_payload.data () + m_payload.size ()};
+
+	std::uint32_t frame;
+	std::uint32_t count;
+	if (!reader.get (frame) || !reader.get (m_drawData.DisplayPos) ||
+	    !reader.get (m_drawData.DisplaySize) || !reader.get (m_drawData.FramebufferScale) ||
+	    !reader.get (count))
+		return false;
+
+	// every list takes at least its changed flag
+	if (count > static_cast<std::size_t> (reader.end - reader.pos))
+		return false;
+
+	while (m_lists.size () < count)
+		m_lists.emplace_back (IM_NEW (ImDrawList) (ImGui::GetDrawListSharedData ()));
+
+	std::vector<Command> cmds;
+	m_drawData.CmdLists.resize (0);
+	m_drawData.TotalVtxCount = 0;
+	m_drawData.TotalIdxCount = 0;
+	for (std::uint32_t i = 0; i < count; ++i)
+	{
+		auto &list = *m_lists[i];
+
+		std::uint8_t changed;
+		if (!reader.get (changed))
+			return false;
+
+		if (changed)
+		{
+			std::uint32_t vtxCount;
+			std::uint32_t idxCount;
+			std::uint32_t cmdCount;
+			if (!reader.get (vtxCount) || !reader.get (idxCount) || !reader.get (cmdCount))
+				return false;
+
+			// check counts against what is left before sizing anything from them
+			auto const remaining = static_cast<std::uint64_t> (reader.end - reader.pos);
+			if (cmdCount * std::uint64_t (sizeof (Command)) +
+			        vtxCount * std::uint64_t (sizeof (ImDrawVert)) +
+			        idxCount * std::uint64_t (sizeof (ImDrawIdx)) >
+			    remaining)
+				return false;
+
+			cmds.resize (cmdCount);
+			if (!reader.get (cmds.data (), cmdCount * sizeof (Command)))
+				return false;
+
+			auto const prevVtx = list.VtxBuffer.Size;
+			auto const prevIdx = list.IdxBuffer.Size;
+			list.VtxBuffer.resize (vtxCount);
+			list.IdxBuffer.resize (idxCount);
+			if (!reader.getDelta (list.VtxBuffer.Data,
+			        vtxCount * sizeof (ImDrawVert),
+			        prevVtx * sizeof (ImDrawVert)) ||
+			    !reader.getDelta (list.IdxBuffer.Data,
+			        idxCount * sizeof (ImDrawIdx),
+			        prevIdx * sizeof (ImDrawIdx)))
+				return false;
+
+			list.CmdBuffer.resize (0);
+			for (auto const &packed : cmds)
+			{
+				if (packed.idxOffset + std::uint64_t (packed.elemCount) > idxCount)
+					return false;
+
+				// every index must land in the list's vertices
+				if (packed.elemCount)
+				{
+					auto const first = list.IdxBuffer.Data + packed.idxOffset;
+					auto const last  = *std::max_element (first, first + packed.elemCount);
+					if (packed.vtxOffset + std::uint64_t (last) >= vtxCount)
+						return false;
+				}
+
+				ImDrawCmd cmd;
+				cmd.ClipRect  = ImVec4 (
+				    packed.clipRect[0], packed.clipRect[1], packed.clipRect[2], packed.clipRect[3]);
+				cmd.TextureId = packed.texture < textures.size () ? textures[packed.texture] :
+				                                                    ImGui::GetIO ().Fonts->TexID;
+				cmd.VtxOffset = packed.vtxOffset;
+				cmd.IdxOffset = packed.idxOffset;
+				cmd.ElemCount = packed.elemCount;
+				list.CmdBuffer.push_back (cmd);
+			}
+		}
+
+		m_drawData.CmdLists.push_back (&list);
+		m_drawData.TotalVtxCount += list.VtxBuffer.Size;
+		m_drawData.TotalIdxCount += list.IdxBuffer.Size;
+	}
+
+	m_drawData.CmdListsCount = count;
+	m_drawData.Valid         = true;
+	return reader.pos == reader.end;
+}
+
+ImDrawData &imgui::remote::Decoder::drawData ()
+{
+	return m_drawData;
+}
+
+///////////////////////////////////////////////////////////////////////////
+void imgui::remote::compress (void const *const data_,
+    std::size_t const size_,
+    std::vector<std::uint8_t> &out_)
+{
+	auto const src = static_cast<std::uint8_t const *> (data_);
+
+	auto &table = s_lzTable;
+	table.assign (1u << LZ_HASH_BITS, UINT32_MAX);
+
+	/// \brief Emit sequence of literals followed by an optional match
+	auto const emit = [&] (std::size_t const anchor_,
+	                      std::size_t const literals_,
+	                      std::size_t const offset_,
+	                      std::size_t const match_) {
+		auto const matchCode = match_ ? match_ - LZ_MIN_MATCH : 0;
+		out_.emplace_back ((std::min<std::size_t> (literals_, 15) << 4) |
+		                   std::min<std::size_t> (matchCode, 15));
+		if (literals_ >= 15)
+			putLength (out_, literals_ - 15);
+
+		put (out_, src + anchor_, literals_);
+		if (!match_)
+			return;
+
+		out_.emplace_back (offset_ & 0xFF);
+		out_.emplace_back (offset_ >> 8);
+		if (matchCode >= 15)
+			putLength (out_, matchCode - 15);
+	};
+
+	std::size_t anchor = 0;
+	std::size_t pos    = 0;
+	while (pos + LZ_MIN_MATCH <= size_)
+	{
+		auto const seq  = read32 (src + pos);
+		auto const hash = (seq * 2654435761u) >> (32 - LZ_HASH_BITS);
+		auto const ref  = table[hash];
+		table[hash]     = pos;
+
+		if (ref == UINT32_MAX || pos - ref > LZ_MAX_OFFSET || read32 (src + ref) != seq)
+		{
+			++pos;
+			continue;
+		}
+
+		// extend match
+		auto length = LZ_MIN_MATCH;
+		while (pos + length < size_ && src[ref + length] == src[pos + length])
+			++length;
+
+		emit (anchor, pos - anchor, pos - ref, length);
+		pos += length;
+		anchor = pos;
+	}
+
+	// trailing literals
+	emit (anchor, size_ - anchor, 0, 0);
+}
+
+bool imgui::remote::decompress (void const *const data_,
+    std::size_t const size_,
+    std::vector<std::uint8_t> &out_)
+{
+	auto const src = static_cast<std::uint8_t const *> (data_);
+	Reader reader{src, src + size_};
+
+	std::size_t pos = 0;
+	while (reader.pos < reader.end)
+	{
+		std::uint8_t token;
+		if (!reader.get (token))
+			return false;
+
+		std::size_t literals = token >> 4;
+		if (literals == 15 && !getLength (reader, literals))
+			return false;
+
+		if (out_.size () - pos < literals || !reader.get (&out_[pos], literals))
+			return false;
+		pos += literals;
+
+		// last sequence has no match
+		if (reader.pos == reader.end)
+			break;
+
+		std::uint8_t offset[2];
+		if (!reader.get (offset))
+			return false;
+
+		std::size_t const distance = offset[0] | (offset[1] << 8);
+		std::size_t length         = token & 0xF;
+		if (length == 15 && !getLength (reader, length))
+			return false;
+		length += LZ_MIN_MATCH;
+
+		if (distance == 0 || distance > pos || out_.size () - pos < length)
+			return false;
+
+		// byte-wise copy; match may overlap its own output
+		for (std::size_t i = 0; i < length; ++i, ++pos)
+			out_[pos] = out_[pos - distance];
+	}
+
+	return pos == out_.size ();
+}
+
+///////////////////////////////////////////////////////////////////////////
+bool imgui::remote::init (std::uint16_t const port_)
+{
+#ifdef __3DS__
+	s_socBuffer = static_cast<std::uint32_t *> (::memalign (0x1000, SOC_BUFFER_SIZE));
+	if (!s_socBuffer)
+		return false;
+
+	if (R_FAILED (socInit (s_socBuffer, SOC_BUFFER_SIZE)))
+	{
+		std::free (s_socBuffer);
+		s_socBuffer = nullptr;
+		return false;
+	}
+#endif
+
+	s_listen = ::socket (AF_INET, SOCK_STREAM, 0);
+	if (s_listen < 0)
+	{
+		exit ();
+		return false;
+	}
+
+	int const yes = 1;
+	::setsockopt (s_listen, SOL_SOCKET, SO_REUSEADDR, &yes, sizeof (yes));
+
+	struct sockaddr_in addr;
+	std::memset (&addr, 0, sizeof (addr));
+	addr.sin_family      = AF_INET;
+	addr.sin_port        = htons (port_);
+	addr.sin_addr.s_addr = htonl (INADDR_ANY);
+
+	if (::bind (s_listen, reinterpret_cast<struct sockaddr *> (&addr), sizeof (addr)) != 0 ||
+	    ::listen (s_listen, 1) != 0 || !setNonBlocking (s_listen))
+	{
+		exit ();
+		return false;
+	}
+
+	return true;
+}
+
+void imgui::remote::exit ()
+{
+	disconnect ();
+
+	if (s_listen >= 0)
+		::close (s_listen);
+	s_listen = -1;
+
+#ifdef __3DS__
+	if (s_socBuffer)
+	{
+		socExit ();
+		std::free (s_socBuffer);
+	}
+	s_socBuffer = nullptr;
+#endif
+}
+
+void imgui::remote::send (ImDrawData const *const drawData_)
+{
+	if (s_listen < 0 || !drawData_)
+		return;
+
+	// accept a new viewer
+	if (s_client < 0)
+	{
+		s_client = ::accept (s_listen, nullptr, nullptr);
+		if (s_client < 0)
+			return;
+
+		if (!setNonBlocking (s_client))
+		{
+			disconnect ();
+			return;
+		}
+
+		// new viewer has nothing to delta against
+		s_encoder.reset ();
+	}
+
+	// don't queue behind a frame the socket hasn't taken yet
+	if (!flush ())
+	{
+		++s_stats.droppedFrames;
+		return;
+	}
+
+	s_encoder.encode (*drawData_, s_outBuffer, s_stats);
+	flush ();
+}
+
+void imgui::remote::pollInput (ImGuiIO &io_)
+{
+	if (s_client < 0)
+		return;
+
+	std::uint8_t buffer[256];
+	while (true)
+	{
+		auto const rc = ::recv (s_client, buffer, sizeof (buffer), 0);
+		if (rc == 0 || (rc < 0 && errno != EAGAIN && errno != EWOULDBLOCK))
+		{
+			disconnect ();
+			return;
+		}
+
+		if (rc < 0)
+			break;
+
+		s_inBuffer.insert (std::end (s_inBuffer), buffer, buffer + rc);
+	}
+
+	// apply complete input messages in order
+	std::size_t pos = 0;
+	while (s_inBuffer.size () - pos >= sizeof (InputMessage))
+	{
+		InputMessage msg;
+		std::memcpy (&msg, &s_inBuffer[pos], sizeof (msg));
+		pos += sizeof (msg);
+
+		if (msg.magic != INPUT_MAGIC)
+		{
+			disconnect ();
+			return;
+		}
+
+		s_remoteMouse = ImVec2 (msg.x, msg.y);
+		io_.AddMouseSourceEvent (ImGuiMouseSource_Mouse);
+		io_.AddMousePosEvent (msg.x, msg.y);
+
+		for (int button = 0; button < 3; ++button)
+		{
+			auto const mask = 1u << button;
+			if ((msg.buttons ^ s_remoteButtons) & mask)
+				io_.AddMouseButtonEvent (button, msg.buttons & mask);
+		}
+		s_remoteButtons = msg.buttons;
+	}
+	s_inBuffer.erase (std::begin (s_inBuffer), std::begin (s_inBuffer) + pos);
+
+	// the touch screen parks the mouse offscreen every frame; keep the viewer's cursor
+	if (pos == 0 && s_remoteMouse.x >= 0.0f && s_remoteMouse.y >= 0.0f)
+		io_.AddMousePosEvent (s_remoteMouse.x, s_remoteMouse.y);
+}
+
+imgui::remote::Stats const &imgui::remote::stats ()
+{
+	return s_stats;
+}
@@ -0,0 +1,208 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "../imgui/imgui.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace imgui
+{
+namespace remote
+{
+/// \brief Frame message magic ('IMRF')
+constexpr std::uint32_t FRAME_MAGIC = 0x46524D49;
+/// \brief Input message magic ('IMRI')
+constexpr std::uint32_t INPUT_MAGIC = 0x49524D49;
+
+/// \brief Frame message header
+/// \note Followed by compressedSize bytes of compressed frame payload
+struct FrameHeader
+{
+	/// \brief FRAME_MAGIC
+	std::uint32_t magic;
+	/// \brief Size of compressed payload
+	std::uint32_t compressedSize;
+	/// \brief Size of payload after decompression
+	std::uint32_t rawSize;
+};
+
+/// \brief Input message sent back by the viewer
+struct InputMessage
+{
+	/// \brief INPUT_MAGIC
+	std::uint32_t magic;
+	/// \brief Mouse position in display space
+	float x;
+	/// \brief Mouse position in display space
+	float y;
+	/// \brief Mouse button bitmask
+	std::uint32_t buttons;
+};
+
+/// \brief Draw command as sent on the wire
+struct Command
+{
+	/// \brief Clip rectangle
+	float clipRect[4];
+	/// \brief Texture handle
+	std::uint32_t texture;
+	/// \brief Vertex offset
+	std::uint32_t vtxOffset;
+	/// \brief Index offset
+	std::uint32_t idxOffset;
+	/// \brief Element count
+	std::uint32_t elemCount;
+};
+
+/// \brief Streaming statistics
+struct Stats
+{
+	/// \brief Draw lists sent in the last frame
+	unsigned listsSent;
+	/// \brief Draw lists skipped in the last frame because they were unchanged
+	unsigned listsUnchanged;
+	/// \brief Size of the last frame before compression (bytes)
+	std::size_t rawBytes;
+	/// \brief Size of the last frame on the wire (bytes)
+	std::size_t wireBytes;
+	/// \brief Time spent encoding the last frame (seconds)
+	float encodeTime;
+	/// \brief Frames dropped because the socket was still busy
+	unsigned droppedFrames;
+};
+
+/// \brief Serializes draw data, sending only changed draw lists
+class Encoder
+{
+public:
+	/// \brief Forget previous frame; the next frame is sent in full
+	void reset ();
+
+	/// \brief Encode frame
+	/// \param drawData_ Draw data to encode
+	/// \param out_ Frame message output (header + compressed payload)
+	/// \param stats_ Statistics to update
+	void encode (ImDrawData const &drawData_, std::vector<std::uint8_t> &out_, Stats &stats_);
+
+private:
+	/// \brief Draw list as last sent
+	struct List
+	{
+		/// \brief Vertex data
+		std::vector<ImDrawVert> vtx;
+		/// \brief Index data
+		std::vector<ImDrawIdx> idx;
+		/// \brief Commands
+		std::vector<Command> cmd;
+	};
+
+	/// \brief Map texture ID to a stable handle
+	/// \param texture_ Texture ID
+	std::uint32_t textureHandle (ImTextureID texture_);
+
+	/// \brief Draw lists of the previous frame
+	std::vector<List> m_prev;
+	/// \brief Known textures; index is the handle
+	std::vector<ImTextureID> m_textures;
+	/// \brief Scratch commands
+	std::vector<Command> m_cmds;
+	/// \brief Uncompressed payload
+	std::vector<std::uint8_t> m_payload;
+	/// \brief Frame counter
+	std::uint32_t m_frame = 0;
+};
+
+/// \brief Rebuilds draw data from encoded frames
+class Decoder
+{
+public:
+	Decoder ();
+	~Decoder ();
+
+	Decoder (Decoder const &) = delete;
+	Decoder &operator= (Decoder const &) = delete;
+
+	/// \brief Decode frame
+	/// \param data_ Frame message (header + compressed payload)
+	/// \param size_ Size of frame message
+	/// \returns Whether frame was decoded
+	/// \note On failure the decoded lists are emptied, as later frames are deltas against them
+	bool decode (void const *data_, std::size_t size_);
+
+	/// \brief Get decoded draw data
+	ImDrawData &drawData ();
+
+	/// \brief Texture IDs by handle
+	/// \note Handle 0 is the font atlas
+	std::vector<ImTextureID> textures;
+
+private:
+	/// \brief Decode frame, possibly leaving lists half-decoded on failure
+	/// \param data_ Frame message (header + compressed payload)
+	/// \param size_ Size of frame message
+	bool decodeFrame (void const *data_, std::size_t size_);
+
+	/// \brief Decompressed payload
+	std::vector<std::uint8_t> m_payload;
+	/// \brief Decoded draw lists
+	std::vector<ImDrawList *> m_lists;
+	/// \brief Decoded draw data
+	ImDrawData m_drawData;
+};
+
+/// \brief Compress data (LZ77, LZ4-style sequences)
+/// \param data_ Data to compress
+/// \param size_ Size of data
+/// \param out_ Compressed output; appended to
+/// \note Not reentrant: the match table is shared between calls
+void compress (void const *data_, std::size_t size_, std::vector<std::uint8_t> &out_);
+
+/// \brief Decompress data
+/// \param data_ Compressed data
+/// \param size_ Size of compressed data
+/// \param out_ Decompressed output; must already be sized to the raw size
+/// \returns Whether the data decompressed to exactly out_.size () bytes
+bool decompress (void const *data_, std::size_t size_, std::vector<std::uint8_t> &out_);
+
+/// \brief Start listening for a viewer
+/// \param port_ TCP port
+bool init (std::uint16_t port_);
+/// \brief Stop streaming
+void exit ();
+
+/// \brief Send frame to connected viewer
+/// \param drawData_ Draw data to send
+void send (ImDrawData const *drawData_);
+
+/// \brief Apply input received from viewer
+/// \param io_ ImGui IO
+/// \note Call after imgui::ctru::newFrame so remote input wins
+void pollInput (ImGuiIO &io_);
+
+/// \brief Get streaming statistics
+Stats const &stats ();
+}
+}
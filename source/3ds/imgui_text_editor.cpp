@@ -0,0 +1,956 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "imgui_text_editor.h"
+
+#include "../imgui/imgui_internal.h"
+
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+
+namespace
+{
+/// \brief Append text to buffer and index its newlines
+/// \param buffer_ Buffer
+/// \param newlines_ Newline offsets of buffer
+/// \param text_ Text
+/// \param size_ Size of text
+void append (std::string &buffer_,
+    std::vector<std::uint32_t> &newlines_,
+    char const *const text_,
+    std::size_t const size_)
+{
+	auto const base = buffer_.size ();
+	buffer_.append (text_, size_);
+	for (std::size_t i = 0; i < size_; ++i)
+	{
+		if (text_[i] == '\n')
+			newlines_.emplace_back (base + i);
+	}
+}
+
+/// \brief Whether byte continues a UTF-8 sequence
+/// \param c_ Byte
+constexpr bool isContinuation (char const c_)
+{
+	return (static_cast<unsigned char> (c_) & 0xC0) == 0x80;
+}
+}
+
+imgui::TextDocument::TextDocument ()
+{
+	// node 0 is the null node, so its sums must stay zero
+	m_nodes.emplace_back (Node{});
+}
+
+void imgui::TextDocument::assign (char const *const text_, std::size_t const size_)
+{
+	m_original.clear ();
+	m_originalNewlines.clear ();
+	append (m_original, m_originalNewlines, text_, size_);
+
+	m_add.clear ();
+	m_addNewlines.clear ();
+
+	m_nodes.resize (1);
+	m_freeNodes.clear ();
+	m_root = size_ ? alloc (Span{0, 0, static_cast<std::uint32_t> (size_)}) : 0;
+
+	m_undo.clear ();
+	m_removed.clear ();
+	m_undoPos  = 0;
+	m_coalesce = false;
+	++m_revision;
+}
+
+bool imgui::TextDocument::load (char const *const path_)
+{
+	auto const fp = std::fopen (path_, "rb");
+	if (!fp)
+		return false;
+
+	std::fseek (fp, 0, SEEK_END);
+	auto const size = std::ftell (fp);
+	std::fseek (fp, 0, SEEK_SET);
+
+	std::string text (size > 0 ? size : 0, '\0');
+	auto const ok = std::fread (text.data (), 1, text.size (), fp) == text.size ();
+	std::fclose (fp);
+
+	if (!ok)
+		return false;
+
+	assign (text.data (), text.size ());
+	return true;
+}
+
+bool imgui::TextDocument::save (char const *const path_) const
+{
+	auto const fp = std::fopen (path_, "wb");
+	if (!fp)
+		return false;
+
+	std::vector<Span> spans;
+	collect (m_root, spans);
+
+	auto ok = true;
+	for (auto const &span : spans)
+		ok = ok && std::fwrite (&buffer (span)[span.start], 1, span.length, fp) == span.length;
+
+	return std::fclose (fp) == 0 && ok;
+}
+
+std::size_t imgui::TextDocument::size () const
+{
+	return m_nodes[m_root].subtreeLength;
+}
+
+std::size_t imgui::TextDocument::lineCount () const
+{
+	return m_nodes[m_root].subtreeNewlines + 1;
+}
+
+std::size_t imgui::TextDocument::lineStart (std::size_t const line_) const
+{
+	// line N starts after the Nth newline
+	std::size_t remaining = std::min (line_, lineCount () - 1);
+	if (!remaining)
+		return 0;
+
+	std::size_t base = 0;
+	auto node        = m_root;
+	while (node)
+	{
+		auto const &n    = m_nodes[node];
+		auto const &left = m_nodes[n.left];
+		if (remaining <= left.subtreeNewlines)
+		{
+			node = n.left;
+			continue;
+		}
+
+		remaining -= left.subtreeNewlines;
+		base += left.subtreeLength;
+		if (remaining <= n.newlines)
+		{
+			auto const &index = newlines (n.span);
+			auto const first  = std::lower_bound (std::begin (index), std::end (index), n.span.start);
+			return base + first[remaining - 1] - n.span.start + 1;
+		}
+
+		remaining -= n.newlines;
+		base += n.span.length;
+		node = n.right;
+	}
+
+	return size ();
+}
+
+std::size_t imgui::TextDocument::lineEnd (std::size_t const line_) const
+{
+	if (line_ + 1 >= lineCount ())
+		return size ();
+
+	return lineStart (line_ + 1) - 1;
+}
+
+std::size_t imgui::TextDocument::lineOf (std::size_t const offset_) const
+{
+	std::size_t remaining = std::min (offset_, size ());
+	std::size_t line      = 0;
+
+	auto node = m_root;
+	while (node)
+	{
+		auto const &n    = m_nodes[node];
+		auto const &left = m_nodes[n.left];
+		if (remaining <= left.subtreeLength)
+		{
+			node = n.left;
+			continue;
+		}
+
+		remaining -= left.subtreeLength;
+		line += left.subtreeNewlines;
+		if (remaining <= n.span.length)
+		{
+			auto span   = n.span;
+			span.length = remaining;
+			return line + countNewlines (span);
+		}
+
+		remaining -= n.span.length;
+		line += n.newlines;
+		node = n.right;
+	}
+
+	return line;
+}
+
+char imgui::TextDocument::at (std::size_t const offset_) const
+{
+	std::size_t remaining = offset_;
+
+	auto node = m_root;
+	while (node)
+	{
+		auto const &n    = m_nodes[node];
+		auto const &left = m_nodes[n.left];
+		if (remaining < left.subtreeLength)
+		{
+			node = n.left;
+			continue;
+		}
+
+		remaining -= left.subtreeLength;
+		if (remaining < n.span.length)
+			return buffer (n.span)[n.span.start + remaining];
+
+		remaining -= n.span.length;
+		node = n.right;
+	}
+
+	return 0;
+}
+
+void imgui::TextDocument::copy (std::size_t const begin_,
+    std::size_t const end_,
+    std::string &out_) const
+{
+	out_.clear ();
+	if (begin_ < end_)
+		copy (m_root, 0, begin_, end_, out_);
+}
+
+void imgui::TextDocument::replace (std::size_t offset_,
+    std::size_t size_,
+    char const *const text_,
+    std::size_t const textSize_)
+{
+	offset_ = std::min (offset_, size ());
+	size_   = std::min (size_, size () - offset_);
+	if (!size_ && !textSize_)
+		return;
+
+	++m_revision;
+
+	// typing continues the last undo step as long as it extends the same insert
+	if (m_coalesce && !size_ && textSize_ == 1 && text_[0] != '\n' && m_undoPos == m_undo.size ())
+	{
+		auto &last = m_undo.back ();
+		if (last.offset + last.inserted.length == offset_ &&
+		    last.inserted.start + last.inserted.length == m_add.size ())
+		{
+			Span const span{1, static_cast<std::uint32_t> (m_add.size ()), 1};
+			append (m_add, m_addNewlines, text_, 1);
+			insertSpans (offset_, &span, 1);
+			++last.inserted.length;
+			return;
+		}
+	}
+
+	// a new edit drops whatever could be redone
+	m_undo.resize (m_undoPos);
+	m_removed.resize (m_undo.empty () ? 0 : m_undo.back ().removedEnd);
+
+	Edit edit;
+	edit.offset       = offset_;
+	edit.inserted     = Span{1, static_cast<std::uint32_t> (m_add.size ()), 0};
+	edit.removedBegin = m_removed.size ();
+	erase (offset_, size_, m_removed);
+	edit.removedEnd = m_removed.size ();
+
+	if (textSize_)
+	{
+		edit.inserted.length = textSize_;
+		append (m_add, m_addNewlines, text_, textSize_);
+		insertSpans (offset_, &edit.inserted, 1);
+	}
+
+	m_undo.emplace_back (edit);
+	m_undoPos  = m_undo.size ();
+	m_coalesce = !size_ && textSize_ == 1 && text_[0] != '\n';
+}
+
+void imgui::TextDocument::breakUndo ()
+{
+	m_coalesce = false;
+}
+
+bool imgui::TextDocument::undo (std::size_t &cursor_)
+{
+	if (!m_undoPos)
+		return false;
+
+	auto const &edit = m_undo[--m_undoPos];
+
+	std::vector<Span> inserted;
+	erase (edit.offset, edit.inserted.length, inserted);
+	insertSpans (
+	    edit.offset, m_removed.data () + edit.removedBegin, edit.removedEnd - edit.removedBegin);
+
+	cursor_ = edit.offset;
+	for (auto i = edit.removedBegin; i < edit.removedEnd; ++i)
+		cursor_ += m_removed[i].length;
+
+	m_coalesce = false;
+	++m_revision;
+	return true;
+}
+
+bool imgui::TextDocument::redo (std::size_t &cursor_)
+{
+	if (m_undoPos == m_undo.size ())
+		return false;
+
+	auto const &edit = m_undo[m_undoPos++];
+
+	std::size_t removed = 0;
+	for (auto i = edit.removedBegin; i < edit.removedEnd; ++i)
+		removed += m_removed[i].length;
+
+	std::vector<Span> spans;
+	erase (edit.offset, removed, spans);
+	if (edit.inserted.length)
+		insertSpans (edit.offset, &edit.inserted, 1);
+
+	cursor_    = edit.offset + edit.inserted.length;
+	m_coalesce = false;
+	++m_revision;
+	return true;
+}
+
+std::size_t imgui::TextDocument::pieceCount () const
+{
+	return m_nodes.size () - 1 - m_freeNodes.size ();
+}
+
+std::size_t imgui::TextDocument::undoCount () const
+{
+	return m_undoPos;
+}
+
+std::uint32_t imgui::TextDocument::revision () const
+{
+	return m_revision;
+}
+
+std::string const &imgui::TextDocument::buffer (Span const span_) const
+{
+	return span_.add ? m_add : m_original;
+}
+
+std::vector<std::uint32_t> const &imgui::TextDocument::newlines (Span const span_) const
+{
+	return span_.add ? m_addNewlines : m_originalNewlines;
+}
+
+std::uint32_t imgui::TextDocument::countNewlines (Span const span_) const
+{
+	auto const &index = newlines (span_);
+	auto const first  = std::lower_bound (std::begin (index), std::end (index), span_.start);
+	auto const last   = std::lower_bound (first, std::end (index), span_.start + span_.length);
+	return last - first;
+}
+
+std::uint32_t imgui::TextDocument::alloc (Span const span_)
+{
+	// xorshift32
+	m_seed ^= m_seed << 13;
+	m_seed ^= m_seed >> 17;
+	m_seed ^= m_seed << 5;
+
+	Node node{};
+	node.span            = span_;
+	node.newlines        = countNewlines (span_);
+	node.priority        = m_seed;
+	node.subtreeLength   = span_.length;
+	node.subtreeNewlines = node.newlines;
+
+	if (m_freeNodes.empty ())
+	{
+		m_nodes.emplace_back (node);
+		return m_nodes.size () - 1;
+	}
+
+	auto const index = m_freeNodes.back ();
+	m_freeNodes.pop_back ();
+	m_nodes[index] = node;
+	return index;
+}
+
+void imgui::TextDocument::free (std::uint32_t const node_)
+{
+	if (!node_)
+		return;
+
+	free (m_nodes[node_].left);
+	free (m_nodes[node_].right);
+	m_freeNodes.emplace_back (node_);
+}
+
+void imgui::TextDocument::update (std::uint32_t const node_)
+{
+	auto &n           = m_nodes[node_];
+	auto const &left  = m_nodes[n.left];
+	auto const &right = m_nodes[n.right];
+
+	n.subtreeLength   = left.subtreeLength + n.span.length + right.subtreeLength;
+	n.subtreeNewlines = left.subtreeNewlines + n.newlines + right.subtreeNewlines;
+}
+
+void imgui::TextDocument::split (std::uint32_t const node_,
+    std::size_t const offset_,
+    std::uint32_t &left_,
+    std::uint32_t &right_)
+{
+	if (!node_)
+	{
+		left_ = right_ = 0;
+		return;
+	}
+
+	auto const leftLength = m_nodes[m_nodes[node_].left].subtreeLength;
+	auto const span       = m_nodes[node_].span;
+
+	std::uint32_t left;
+	std::uint32_t right;
+	if (offset_ <= leftLength)
+	{
+		split (m_nodes[node_].left, offset_, left, right);
+		m_nodes[node_].left = right;
+		update (node_);
+		left_  = left;
+		right_ = node_;
+	}
+	else if (offset_ >= leftLength + span.length)
+	{
+		split (m_nodes[node_].right, offset_ - leftLength - span.length, left, right);
+		m_nodes[node_].right = left;
+		update (node_);
+		left_  = node_;
+		right_ = right;
+	}
+	else
+	{
+		// split falls inside this piece; the tail becomes a new piece in front of the right subtree
+		auto const cut = offset_ - leftLength;
+
+		auto tail = span;
+		tail.start += cut;
+		tail.length -= cut;
+		auto const tailNode = alloc (tail);
+
+		auto &n         = m_nodes[node_];
+		n.span.length   = cut;
+		n.newlines      = countNewlines (n.span);
+		auto const next = n.right;
+		n.right         = 0;
+		update (node_);
+
+		left_  = node_;
+		right_ = merge (tailNode, next);
+	}
+}
+
+std::uint32_t imgui::TextDocument::merge (std::uint32_t const left_, std::uint32_t const right_)
+{
+	if (!left_)
+		return right_;
+	if (!right_)
+		return left_;
+
+	if (m_nodes[left_].priority > m_nodes[right_].priority)
+	{
+		auto const right      = merge (m_nodes[left_].right, right_);
+		m_nodes[left_].right = right;
+		update (left_);
+		return left_;
+	}
+
+	auto const left      = merge (left_, m_nodes[right_].left);
+	m_nodes[right_].left = left;
+	update (right_);
+	return right_;
+}
+
+bool imgui::TextDocument::extend (std::uint32_t const node_, Span const span_)
+{
+	if (!node_)
+		return false;
+
+	auto const right = m_nodes[node_].right;
+	if (right)
+	{
+		if (!extend (right, span_))
+			return false;
+
+		update (node_);
+		return true;
+	}
+
+	auto &n = m_nodes[node_];
+	if (n.span.add != span_.add || n.span.start + n.span.length != span_.start)
+		return false;
+
+	n.span.length += span_.length;
+	n.newlines = countNewlines (n.span);
+	update (node_);
+	return true;
+}
+
+void imgui::TextDocument::collect (std::uint32_t const node_, std::vector<Span> &out_) const
+{
+	if (!node_)
+		return;
+
+	collect (m_nodes[node_].left, out_);
+	out_.emplace_back (m_nodes[node_].span);
+	collect (m_nodes[node_].right, out_);
+}
+
+void imgui::TextDocument::copy (std::uint32_t const node_,
+    std::size_t const base_,
+    std::size_t const begin_,
+    std::size_t const end_,
+    std::string &out_) const
+{
+	auto const &n = m_nodes[node_];
+	if (!node_ || base_ >= end_ || base_ + n.subtreeLength <= begin_)
+		return;
+
+	copy (n.left, base_, begin_, end_, out_);
+
+	auto const start = base_ + m_nodes[n.left].subtreeLength;
+	auto const stop  = start + n.span.length;
+	if (start < end_ && stop > begin_)
+	{
+		auto const from = std::max (start, begin_);
+		auto const to   = std::min (stop, end_);
+		out_.append (buffer (n.span), n.span.start + from - start, to - from);
+	}
+
+	copy (n.right, stop, begin_, end_, out_);
+}
+
+void imgui::TextDocument::insertSpans (std::size_t const offset_,
+    Span const *const spans_,
+    std::size_t const count_)
+{
+	std::uint32_t left;
+	std::uint32_t right;
+	split (m_root, offset_, left, right);
+
+	for (std::size_t i = 0; i < count_; ++i)
+	{
+		// typing appends to the add buffer right where the previous piece ends
+		if (extend (left, spans_[i]))
+			continue;
+
+		auto const node = alloc (spans_[i]);
+		left            = merge (left, node);
+	}
+
+	m_root = merge (left, right);
+}
+
+void imgui::TextDocument::erase (std::size_t const offset_,
+    std::size_t const size_,
+    std::vector<Span> &removed_)
+{
+	if (!size_)
+		return;
+
+	std::uint32_t left;
+	std::uint32_t middle;
+	std::uint32_t right;
+	split (m_root, offset_, left, middle);
+	split (middle, size_, middle, right);
+
+	collect (middle, removed_);
+	free (middle);
+
+	m_root = merge (left, right);
+}
+
+///////////////////////////////////////////////////////////////////////////
+bool imgui::TextEditor::draw (char const *const label_, ImVec2 const &size_)
+{
+	auto &g             = *ImGui::GetCurrentContext ();
+	auto &io            = g.IO;
+	auto const revision = document.revision ();
+
+	if (!ImGui::BeginChild (
+	        label_, size_, ImGuiChildFlags_Borders, ImGuiWindowFlags_HorizontalScrollbar))
+	{
+		ImGui::EndChild ();
+		return false;
+	}
+
+	auto const window     = ImGui::GetCurrentWindow ();
+	auto const id         = window->GetID ("##text");
+	auto const font       = ImGui::GetFont ();
+	auto const fontSize   = ImGui::GetFontSize ();
+	auto const lineHeight = ImGui::GetTextLineHeight ();
+	auto const origin     = ImGui::GetCursorScreenPos ();
+
+	// lines are only measured when they become visible, so the content width only ever grows to
+	// the widest line seen so far
+	auto const contentSize = ImVec2 (m_width + fontSize, document.lineCount () * lineHeight);
+	ImRect const bb (origin, ImVec2 (origin.x + contentSize.x, origin.y + contentSize.y));
+	ImGui::ItemSize (contentSize);
+	ImGui::ItemAdd (bb, id);
+
+	auto hit = bb;
+	hit.ClipWith (window->InnerClipRect);
+	auto const hovered = ImGui::ItemHoverable (hit, id, ImGuiItemFlags_None);
+	if (hovered)
+		g.MouseCursor = ImGuiMouseCursor_TextInput;
+
+	// navigation activates the editor in place, so it can be used without touching it
+	if (g.NavActivateId == id && g.ActiveId != id)
+	{
+		ImGui::SetActiveID (id, window);
+		ImGui::SetFocusID (id, window);
+		ImGui::FocusWindow (window);
+	}
+
+	// mouse places the cursor and drags the selection
+	if (hovered && io.MouseClicked[0])
+	{
+		ImGui::SetActiveID (id, window);
+		ImGui::SetFocusID (id, window);
+		ImGui::FocusWindow (window);
+		m_dragging = true;
+	}
+	else if (g.ActiveId == id && io.MouseClicked[0])
+		ImGui::ClearActiveID ();
+
+	if (!io.MouseDown[0])
+		m_dragging = false;
+
+	auto const active = g.ActiveId == id;
+	if (active && m_dragging)
+	{
+		auto const line =
+		    static_cast<std::size_t> (std::max (0.0f, (io.MousePos.y - origin.y) / lineHeight));
+		moveTo (offsetAt (std::min (line, document.lineCount () - 1), io.MousePos.x - origin.x),
+		    !io.MouseClicked[0] || io.KeyShift);
+	}
+
+	if (active)
+	{
+		static ImGuiKey const ownedKeys[] = {ImGuiKey_LeftArrow,
+		    ImGuiKey_RightArrow,
+		    ImGuiKey_UpArrow,
+		    ImGuiKey_DownArrow,
+		    ImGuiKey_PageUp,
+		    ImGuiKey_PageDown,
+		    ImGuiKey_Home,
+		    ImGuiKey_End,
+		    ImGuiKey_Enter,
+		    ImGuiKey_KeypadEnter,
+		    ImGuiKey_Delete,
+		    ImGuiKey_Backspace,
+		    ImGuiKey_Tab,
+		    ImGuiKey_GamepadDpadLeft,
+		    ImGuiKey_GamepadDpadRight,
+		    ImGuiKey_GamepadDpadUp,
+		    ImGuiKey_GamepadDpadDown,
+		    ImGuiKey_GamepadL1,
+		    ImGuiKey_GamepadR1,
+		    ImGuiKey_NavGamepadInput};
+		for (auto const key : ownedKeys)
+			ImGui::SetKeyOwner (key, id);
+		g.ActiveIdUsingNavDirMask |=
+		    (1 << ImGuiDir_Left) | (1 << ImGuiDir_Right) | (1 << ImGuiDir_Up) | (1 << ImGuiDir_Down);
+
+		auto const shift      = io.KeyShift;
+		auto const selMin     = std::min (m_cursor, m_anchor);
+		auto const selMax     = std::max (m_cursor, m_anchor);
+		auto const selection  = selMin != selMax;
+		auto const repeat     = ImGuiInputFlags_Repeat;
+		auto const pageLines  = std::max (1.0f, window->InnerRect.GetHeight () / lineHeight);
+		auto const verticalBy = [&] (float const lines_) {
+			auto const x    = m_preferredX >= 0.0f ? m_preferredX : xOf (m_cursor);
+			auto const line = std::clamp (static_cast<float> (document.lineOf (m_cursor)) + lines_,
+			    0.0f,
+			    static_cast<float> (document.lineCount () - 1));
+			moveTo (offsetAt (static_cast<std::size_t> (line), x), shift);
+			m_preferredX = x;
+		};
+
+		// shortcut routes are resolved a frame late, so they must be submitted every frame
+		auto const isUndo      = ImGui::Shortcut (ImGuiMod_Ctrl | ImGuiKey_Z, repeat, id);
+		auto const isRedo      = ImGui::Shortcut (ImGuiMod_Ctrl | ImGuiKey_Y, repeat, id);
+		auto const isSelectAll = ImGui::Shortcut (ImGuiMod_Ctrl | ImGuiKey_A, 0, id);
+		auto const isCopy      = ImGui::Shortcut (ImGuiMod_Ctrl | ImGuiKey_C, 0, id) && selection;
+		auto const isCut       = ImGui::Shortcut (ImGuiMod_Ctrl | ImGuiKey_X, 0, id) && selection;
+		auto const isPaste     = ImGui::Shortcut (ImGuiMod_Ctrl | ImGuiKey_V, repeat, id);
+
+		// the D-pad moves the cursor like the arrows, and the shoulder buttons page like
+		// PageUp/PageDown
+		auto const isPressed = [] (ImGuiKey const key_, ImGuiKey const gamepadKey_) {
+			return ImGui::IsKeyPressed (key_) || ImGui::IsKeyPressed (gamepadKey_);
+		};
+
+		if (isPressed (ImGuiKey_LeftArrow, ImGuiKey_GamepadDpadLeft))
+			moveTo (selection && !shift ? selMin : prevChar (m_cursor), shift);
+		else if (isPressed (ImGuiKey_RightArrow, ImGuiKey_GamepadDpadRight))
+			moveTo (selection && !shift ? selMax : nextChar (m_cursor), shift);
+		else if (isPressed (ImGuiKey_UpArrow, ImGuiKey_GamepadDpadUp))
+			verticalBy (-1.0f);
+		else if (isPressed (ImGuiKey_DownArrow, ImGuiKey_GamepadDpadDown))
+			verticalBy (1.0f);
+		else if (isPressed (ImGuiKey_PageUp, ImGuiKey_GamepadL1))
+			verticalBy (-pageLines);
+		else if (isPressed (ImGuiKey_PageDown, ImGuiKey_GamepadR1))
+			verticalBy (pageLines);
+		else if (ImGui::IsKeyPressed (ImGuiKey_Home))
+			moveTo (io.KeyCtrl ? 0 : document.lineStart (document.lineOf (m_cursor)), shift);
+		else if (ImGui::IsKeyPressed (ImGuiKey_End))
+			moveTo (io.KeyCtrl ? document.size () : document.lineEnd (document.lineOf (m_cursor)),
+			    shift);
+		else if (ImGui::IsKeyPressed (ImGuiKey_Backspace))
+		{
+			if (!selection)
+				m_anchor = prevChar (m_cursor);
+			insert (nullptr, 0);
+		}
+		else if (ImGui::IsKeyPressed (ImGuiKey_Delete))
+		{
+			if (!selection)
+				m_anchor = nextChar (m_cursor);
+			insert (nullptr, 0);
+		}
+		else if (ImGui::IsKeyPressed (ImGuiKey_Enter) || ImGui::IsKeyPressed (ImGuiKey_KeypadEnter))
+			insert ("\n", 1);
+		else if (ImGui::IsKeyPressed (ImGuiKey_Tab))
+			insert ("\t", 1);
+		else if (ImGui::IsKeyPressed (ImGuiKey_Escape))
+			ImGui::ClearActiveID ();
+		else if (isUndo)
+		{
+			if (document.undo (m_cursor))
+				moveTo (m_cursor, false);
+		}
+		else if (isRedo)
+		{
+			if (document.redo (m_cursor))
+				moveTo (m_cursor, false);
+		}
+		else if (isSelectAll)
+		{
+			m_anchor = 0;
+			m_cursor = document.size ();
+		}
+		else if (isCopy || isCut)
+		{
+			document.copy (selMin, selMax, m_line);
+			ImGui::SetClipboardText (m_line.c_str ());
+			if (isCut)
+				insert (nullptr, 0);
+		}
+		else if (isPaste)
+		{
+			if (auto const text = ImGui::GetClipboardText ())
+				insert (text, std::strlen (text));
+		}
+
+		// typed characters; Tab and Enter arrive as keys
+		if (!io.InputQueueCharacters.empty () && !(io.KeyCtrl && !io.KeyAlt))
+		{
+			m_line.clear ();
+			for (auto const c : io.InputQueueCharacters)
+			{
+				if (c < 0x20 && c != '\n')
+					continue;
+
+				char utf8[5];
+				m_line.append (ImTextCharToUtf8 (utf8, c));
+			}
+			io.InputQueueCharacters.resize (0);
+
+			if (!m_line.empty ())
+				insert (m_line.data (), m_line.size ());
+		}
+
+		// on 3DS this brings up the software keyboard, which takes over the screens until it is
+		// closed, so only ask for text input when the gamepad's text input button (X) requests it
+		if (g.ActiveId == id && !m_dragging && ImGui::IsKeyPressed (ImGuiKey_NavGamepadInput, false))
+			g.WantTextInputNextFrame = 1;
+	}
+
+	if (m_scrollToCursor)
+	{
+		m_scrollToCursor = false;
+
+		auto const y = document.lineOf (m_cursor) * lineHeight;
+		if (y < window->Scroll.y)
+			ImGui::SetScrollY (y);
+		else if (y + lineHeight > window->Scroll.y + window->InnerRect.GetHeight ())
+			ImGui::SetScrollY (y + lineHeight - window->InnerRect.GetHeight ());
+
+		auto const x = xOf (m_cursor);
+		if (x < window->Scroll.x)
+			ImGui::SetScrollX (x);
+		else if (x + fontSize > window->Scroll.x + window->InnerRect.GetWidth ())
+			ImGui::SetScrollX (x + fontSize - window->InnerRect.GetWidth ());
+	}
+
+	// only visible lines are copied out of the document
+	auto const &clip     = window->InnerClipRect;
+	auto const drawList  = window->DrawList;
+	auto const lines     = document.lineCount ();
+	auto const firstLine = static_cast<std::size_t> (
+	    std::max (0.0f, std::floor ((clip.Min.y - origin.y) / lineHeight)));
+	auto const lastLine =
+	    std::min (lines, static_cast<std::size_t> (std::max (0.0f, (clip.Max.y - origin.y) / lineHeight)) + 1);
+
+	auto const selMin     = std::min (m_cursor, m_anchor);
+	auto const selMax     = std::max (m_cursor, m_anchor);
+	auto const textColor  = ImGui::GetColorU32 (ImGuiCol_Text);
+	auto const selColor   = ImGui::GetColorU32 (ImGuiCol_TextSelectedBg);
+	auto const clipRect   = ImVec4 (clip.Min.x, clip.Min.y, clip.Max.x, clip.Max.y);
+	auto const showCursor = g.ActiveId == id &&
+	                        (!io.ConfigInputTextCursorBlink || ImFmod (g.Time, 1.2f) <= 0.8f);
+
+	auto begin = document.lineStart (firstLine);
+	for (auto line = firstLine; line < lastLine; ++line)
+	{
+		auto const end = line + 1 < lines ? document.lineStart (line + 1) - 1 : document.size ();
+		document.copy (begin, end, m_line);
+
+		auto const text = m_line.data ();
+		auto const pos  = ImVec2 (origin.x, origin.y + line * lineHeight);
+		auto const textWidth =
+		    font->CalcTextSizeA (fontSize, FLT_MAX, 0.0f, text, text + m_line.size ()).x;
+		m_width = std::max (m_width, textWidth);
+
+		if (selMin < selMax && selMin <= end && selMax > begin)
+		{
+			auto const from = std::max (selMin, begin) - begin;
+			auto const to   = std::min (selMax, end) - begin;
+			auto const x0   = font->CalcTextSizeA (fontSize, FLT_MAX, 0.0f, text, text + from).x;
+			auto x1         = font->CalcTextSizeA (fontSize, FLT_MAX, 0.0f, text, text + to).x;
+			if (selMax > end)
+				x1 += fontSize * 0.4f; // show selected newline
+			drawList->AddRectFilled (
+			    ImVec2 (pos.x + x0, pos.y), ImVec2 (pos.x + x1, pos.y + lineHeight), selColor);
+		}
+
+		drawList->AddText (
+		    font, fontSize, pos, textColor, text, text + m_line.size (), 0.0f, &clipRect);
+
+		if (showCursor && m_cursor >= begin && m_cursor <= end)
+		{
+			auto const x =
+			    pos.x + font->CalcTextSizeA (fontSize, FLT_MAX, 0.0f, text, text + m_cursor - begin).x;
+			drawList->AddLine (ImVec2 (x, pos.y), ImVec2 (x, pos.y + lineHeight - 0.5f), textColor);
+		}
+
+		begin = end + 1;
+	}
+
+	ImGui::EndChild ();
+
+	return document.revision () != revision;
+}
+
+void imgui::TextEditor::insert (char const *const text_, std::size_t const size_)
+{
+	auto const selMin = std::min (m_cursor, m_anchor);
+	auto const selMax = std::max (m_cursor, m_anchor);
+
+	document.replace (selMin, selMax - selMin, text_, size_);
+
+	m_cursor = m_anchor = selMin + size_;
+	m_preferredX        = -1.0f;
+	m_scrollToCursor    = true;
+}
+
+void imgui::TextEditor::moveTo (std::size_t const offset_, bool const select_)
+{
+	if (offset_ != m_cursor)
+		document.breakUndo ();
+
+	m_cursor = std::min (offset_, document.size ());
+	if (!select_)
+		m_anchor = m_cursor;
+
+	m_preferredX     = -1.0f;
+	m_scrollToCursor = true;
+}
+
+std::size_t imgui::TextEditor::prevChar (std::size_t offset_) const
+{
+	while (offset_ > 0 && isContinuation (document.at (--offset_)))
+		;
+
+	return offset_;
+}
+
+std::size_t imgui::TextEditor::nextChar (std::size_t offset_) const
+{
+	auto const size = document.size ();
+	while (offset_ < size && isContinuation (document.at (++offset_)))
+		;
+
+	return std::min (offset_, size);
+}
+
+std::size_t imgui::TextEditor::offsetAt (std::size_t const line_, float const x_)
+{
+	auto const begin = document.lineStart (line_);
+	document.copy (begin, document.lineEnd (line_), m_line);
+
+	auto const font  = ImGui::GetFont ();
+	auto const scale = ImGui::GetFontSize () / font->FontSize;
+
+	auto text       = m_line.data ();
+	auto const end  = text + m_line.size ();
+	float x         = 0.0f;
+	while (text < end)
+	{
+		unsigned c;
+		auto const bytes   = ImTextCharFromUtf8 (&c, text, end);
+		auto const advance = font->GetCharAdvance (static_cast<ImWchar> (c)) * scale;
+		if (x + advance * 0.5f > x_)
+			break;
+
+		x += advance;
+		text += bytes;
+	}
+
+	return begin + (text - m_line.data ());
+}
+
+float imgui::TextEditor::xOf (std::size_t const offset_)
+{
+	document.copy (document.lineStart (document.lineOf (offset_)), offset_, m_line);
+	return ImGui::GetFont ()
+	    ->CalcTextSizeA (
+	        ImGui::GetFontSize (), FLT_MAX, 0.0f, m_line.data (), m_line.data () + m_line.size ())
+	    .x;
+}
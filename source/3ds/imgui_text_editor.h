@@ -0,0 +1,311 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include "../imgui/imgui.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+// Text editing for documents too large for InputTextMultiline, which keeps the whole text in one
+// buffer, moves the tail on every keystroke and copies the text back to the user buffer on every
+// change.
+//
+// TextDocument is a piece table: the original text and an append-only buffer of inserted text
+// are never modified, and the document is the in-order sequence of pieces (spans of either
+// buffer) kept in a treap keyed by length and newline count. Edits split the treap at most twice,
+// so they are O(log n) in the number of pieces regardless of document size. Undo records refer to
+// spans of the immutable buffers instead of copies of the text, so the undo log is cheap to keep
+// growing.
+
+namespace imgui
+{
+/// \brief Editable text stored as a piece table
+class TextDocument
+{
+public:
+	TextDocument ();
+
+	/// \brief Replace contents
+	/// \param text_ Text
+	/// \param size_ Size of text
+	/// \note Clears undo history
+	void assign (char const *text_, std::size_t size_);
+
+	/// \brief Load contents from file
+	/// \param path_ File to load
+	/// \note Clears undo history
+	bool load (char const *path_);
+
+	/// \brief Save contents to file
+	/// \param path_ File to write
+	bool save (char const *path_) const;
+
+	/// \brief Document size in bytes
+	std::size_t size () const;
+
+	/// \brief Number of lines (newlines + 1)
+	std::size_t lineCount () const;
+
+	/// \brief Offset of first byte of line
+	/// \param line_ Line index (clamped)
+	std::size_t lineStart (std::size_t line_) const;
+
+	/// \brief Offset of end of line (its newline, or end of document)
+	/// \param line_ Line index (clamped)
+	std::size_t lineEnd (std::size_t line_) const;
+
+	/// \brief Line containing offset
+	/// \param offset_ Offset (clamped)
+	std::size_t lineOf (std::size_t offset_) const;
+
+	/// \brief Byte at offset
+	/// \param offset_ Offset
+	/// \returns Byte, or 0 if out of range
+	char at (std::size_t offset_) const;
+
+	/// \brief Copy range of text
+	/// \param begin_ Start offset
+	/// \param end_ End offset
+	/// \param out_ Output (replaced)
+	void copy (std::size_t begin_, std::size_t end_, std::string &out_) const;
+
+	/// \brief Replace range of text
+	/// \param offset_ Start offset
+	/// \param size_ Bytes to remove
+	/// \param text_ Text to insert
+	/// \param textSize_ Size of text to insert
+	/// \note Recorded as a single undo step; consecutive single-byte inserts are coalesced
+	void replace (std::size_t offset_, std::size_t size_, char const *text_, std::size_t textSize_);
+
+	/// \brief Stop coalescing typed text into the last undo step
+	void breakUndo ();
+
+	/// \brief Undo last edit
+	/// \param cursor_ Cursor position to restore
+	bool undo (std::size_t &cursor_);
+
+	/// \brief Redo last undone edit
+	/// \param cursor_ Cursor position to restore
+	bool redo (std::size_t &cursor_);
+
+	/// \brief Number of pieces
+	std::size_t pieceCount () const;
+
+	/// \brief Number of undo steps
+	std::size_t undoCount () const;
+
+	/// \brief Bump on every change
+	std::uint32_t revision () const;
+
+private:
+	/// \brief Span of one of the buffers
+	struct Span
+	{
+		/// \brief Whether the span is in the add buffer
+		std::uint32_t add : 1;
+		/// \brief Start offset in buffer
+		std::uint32_t start : 31;
+		/// \brief Length in bytes
+		std::uint32_t length;
+	};
+
+	/// \brief Treap node
+	struct Node
+	{
+		/// \brief Piece
+		Span span;
+		/// \brief Newlines in piece
+		std::uint32_t newlines;
+		/// \brief Left child
+		std::uint32_t left;
+		/// \brief Right child
+		std::uint32_t right;
+		/// \brief Heap priority
+		std::uint32_t priority;
+		/// \brief Bytes in subtree
+		std::uint32_t subtreeLength;
+		/// \brief Newlines in subtree
+		std::uint32_t subtreeNewlines;
+	};
+
+	/// \brief Undo step
+	struct Edit
+	{
+		/// \brief Offset of edit
+		std::size_t offset;
+		/// \brief Inserted span (in the add buffer)
+		Span inserted;
+		/// \brief First removed span in m_removed
+		std::size_t removedBegin;
+		/// \brief End of removed spans in m_removed
+		std::size_t removedEnd;
+	};
+
+	/// \brief Buffer of span
+	/// \param span_ Span
+	std::string const &buffer (Span span_) const;
+	/// \brief Newline offsets of buffer of span
+	/// \param span_ Span
+	std::vector<std::uint32_t> const &newlines (Span span_) const;
+	/// \brief Count newlines in span
+	/// \param span_ Span
+	std::uint32_t countNewlines (Span span_) const;
+
+	/// \brief Allocate node
+	/// \param span_ Piece
+	std::uint32_t alloc (Span span_);
+	/// \brief Free subtree
+	/// \param node_ Subtree root
+	void free (std::uint32_t node_);
+	/// \brief Recompute subtree sums
+	/// \param node_ Node
+	void update (std::uint32_t node_);
+	/// \brief Split subtree at offset
+	/// \param node_ Subtree root
+	/// \param offset_ Offset; bytes before go left
+	/// \param left_ Left result
+	/// \param right_ Right result
+	void split (std::uint32_t node_, std::size_t offset_, std::uint32_t &left_, std::uint32_t &right_);
+	/// \brief Merge subtrees
+	/// \param left_ Left subtree
+	/// \param right_ Right subtree
+	std::uint32_t merge (std::uint32_t left_, std::uint32_t right_);
+	/// \brief Extend last piece of subtree if span continues it
+	/// \param node_ Subtree root
+	/// \param span_ Span to append
+	bool extend (std::uint32_t node_, Span span_);
+	/// \brief Append spans of subtree in order
+	/// \param node_ Subtree root
+	/// \param out_ Output
+	void collect (std::uint32_t node_, std::vector<Span> &out_) const;
+	/// \brief Append text of range
+	/// \param node_ Subtree root
+	/// \param base_ Offset of subtree
+	/// \param begin_ Start offset
+	/// \param end_ End offset
+	/// \param out_ Output
+	void copy (std::uint32_t node_,
+	    std::size_t base_,
+	    std::size_t begin_,
+	    std::size_t end_,
+	    std::string &out_) const;
+
+	/// \brief Insert spans
+	/// \param offset_ Offset
+	/// \param spans_ Spans
+	/// \param count_ Number of spans
+	void insertSpans (std::size_t offset_, Span const *spans_, std::size_t count_);
+	/// \brief Remove range
+	/// \param offset_ Offset
+	/// \param size_ Bytes to remove
+	/// \param removed_ Removed spans are appended here
+	void erase (std::size_t offset_, std::size_t size_, std::vector<Span> &removed_);
+
+	/// \brief Original text
+	std::string m_original;
+	/// \brief Inserted text (append-only)
+	std::string m_add;
+	/// \brief Newline offsets in m_original
+	std::vector<std::uint32_t> m_originalNewlines;
+	/// \brief Newline offsets in m_add
+	std::vector<std::uint32_t> m_addNewlines;
+
+	/// \brief Treap nodes; node 0 is the null node
+	std::vector<Node> m_nodes;
+	/// \brief Free nodes
+	std::vector<std::uint32_t> m_freeNodes;
+	/// \brief Treap root
+	std::uint32_t m_root = 0;
+	/// \brief Priority generator state
+	std::uint32_t m_seed = 0x9E3779B9;
+
+	/// \brief Undo log
+	std::vector<Edit> m_undo;
+	/// \brief Spans removed by undo steps
+	std::vector<Span> m_removed;
+	/// \brief Number of undo steps that are applied (the rest can be redone)
+	std::size_t m_undoPos = 0;
+	/// \brief Whether the last undo step may absorb the next typed byte
+	bool m_coalesce = false;
+	/// \brief Change counter
+	std::uint32_t m_revision = 0;
+};
+
+/// \brief Text editor widget for a TextDocument
+class TextEditor
+{
+public:
+	/// \brief Draw editor and handle input
+	/// \param label_ Widget label (used as ID)
+	/// \param size_ Widget size
+	/// \returns Whether the document changed
+	/// \note Only the visible lines are copied out of the document for rendering
+	/// \note While active, the D-pad moves the cursor, L1/R1 page up/down and the gamepad's text
+	/// input button (ImGuiKey_NavGamepadInput) asks for text input, the software keyboard on 3DS
+	bool draw (char const *label_, ImVec2 const &size_);
+
+	/// \brief Document being edited
+	TextDocument document;
+
+private:
+	/// \brief Replace selection with text
+	/// \param text_ Text
+	/// \param size_ Size of text
+	void insert (char const *text_, std::size_t size_);
+	/// \brief Move cursor
+	/// \param offset_ New cursor offset
+	/// \param select_ Whether to extend selection
+	void moveTo (std::size_t offset_, bool select_);
+	/// \brief Offset of start of previous UTF-8 character
+	/// \param offset_ Offset
+	std::size_t prevChar (std::size_t offset_) const;
+	/// \brief Offset of start of next UTF-8 character
+	/// \param offset_ Offset
+	std::size_t nextChar (std::size_t offset_) const;
+	/// \brief Offset in line closest to x coordinate
+	/// \param line_ Line index
+	/// \param x_ X coordinate relative to start of line
+	std::size_t offsetAt (std::size_t line_, float x_);
+	/// \brief X coordinate of offset relative to start of its line
+	/// \param offset_ Offset
+	float xOf (std::size_t offset_);
+
+	/// \brief Cursor offset
+	std::size_t m_cursor = 0;
+	/// \brief Selection anchor
+	std::size_t m_anchor = 0;
+	/// \brief X coordinate to keep when moving between lines, or negative
+	float m_preferredX = -1.0f;
+	/// \brief Widest line seen so far
+	float m_width = 0.0f;
+	/// \brief Cursor moved and should be scrolled into view
+	bool m_scrollToCursor = false;
+	/// \brief Mouse is selecting text
+	bool m_dragging = false;
+	/// \brief Scratch line buffer
+	std::string m_line;
+};
+}
@@ -0,0 +1,434 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "jobs.h"
+
+#ifdef __3DS__
+#include <3ds.h>
+#else
+#include <pthread.h>
+#include <sched.h>
+#include <unistd.h>
+#endif
+
+#include <cassert>
+#include <cstdint>
+#include <vector>
+
+namespace
+{
+/// \brief Maximum number of worker threads
+constexpr unsigned MAX_WORKERS = 7;
+/// \brief Jobs per queue
+constexpr unsigned QUEUE_SIZE = 256;
+/// \brief Worker thread stack size
+constexpr auto STACK_SIZE = 0x8000;
+
+#ifdef __3DS__
+/// \brief Mutex
+class Mutex
+{
+public:
+	Mutex ()
+	{
+		LightLock_Init (&m_lock);
+	}
+
+	void lock ()
+	{
+		LightLock_Lock (&m_lock);
+	}
+
+	void unlock ()
+	{
+		LightLock_Unlock (&m_lock);
+	}
+
+private:
+	LightLock m_lock;
+};
+
+/// \brief Counting semaphore
+class Semaphore
+{
+public:
+	Semaphore ()
+	{
+		LightSemaphore_Init (&m_sem, 0, 0x7FFF);
+	}
+
+	void acquire ()
+	{
+		LightSemaphore_Acquire (&m_sem, 1);
+	}
+
+	void release (unsigned const count_)
+	{
+		LightSemaphore_Release (&m_sem, count_);
+	}
+
+private:
+	LightSemaphore m_sem;
+};
+
+/// \brief Give up the rest of this time slice
+void relax ()
+{
+	svcSleepThread (0);
+}
+#else
+/// \brief Mutex
+class Mutex
+{
+public:
+	Mutex ()
+	{
+		pthread_mutex_init (&m_mutex, nullptr);
+	}
+
+	~Mutex ()
+	{
+		pthread_mutex_destroy (&m_mutex);
+	}
+
+	void lock ()
+	{
+		pthread_mutex_lock (&m_mutex);
+	}
+
+	void unlock ()
+	{
+		pthread_mutex_unlock (&m_mutex);
+	}
+
+private:
+	pthread_mutex_t m_mutex;
+};
+
+/// \brief Counting semaphore
+class Semaphore
+{
+public:
+	Semaphore ()
+	{
+		pthread_mutex_init (&m_mutex, nullptr);
+		pthread_cond_init (&m_cond, nullptr);
+	}
+
+	~Semaphore ()
+	{
+		pthread_cond_destroy (&m_cond);
+		pthread_mutex_destroy (&m_mutex);
+	}
+
+	void acquire ()
+	{
+		pthread_mutex_lock (&m_mutex);
+		while (!m_count)
+			pthread_cond_wait (&m_cond, &m_mutex);
+		--m_count;
+		pthread_mutex_unlock (&m_mutex);
+	}
+
+	void release (unsigned const count_)
+	{
+		pthread_mutex_lock (&m_mutex);
+		m_count += count_;
+		pthread_cond_broadcast (&m_cond);
+		pthread_mutex_unlock (&m_mutex);
+	}
+
+private:
+	pthread_mutex_t m_mutex;
+	pthread_cond_t m_cond;
+	unsigned m_count = 0;
+};
+
+/// \brief Give up the rest of this time slice
+void relax ()
+{
+	sched_yield ();
+}
+#endif
+
+/// \brief Queued job
+struct Job
+{
+	/// \brief Entry point
+	jobs::Function function;
+	/// \brief User context
+	void *context;
+	/// \brief First index
+	std::size_t begin;
+	/// \brief One past last index
+	std::size_t end;
+	/// \brief Owning group
+	jobs::Group *group;
+};
+
+/// \brief Work-stealing deque
+/// \note The owner pushes and pops at the tail; thieves take from the head. A lock is cheap
+/// next to a job and keeps this simple on ARM11.
+struct Queue
+{
+	/// \brief Push job at tail
+	bool push (Job const &job_)
+	{
+		mutex.lock ();
+		auto const ok = tail - head < QUEUE_SIZE;
+		if (ok)
+			jobs[tail++ % QUEUE_SIZE] = job_;
+		mutex.unlock ();
+		return ok;
+	}
+
+	/// \brief Pop newest job
+	bool pop (Job &job_)
+	{
+		mutex.lock ();
+		auto const ok = tail != head;
+		if (ok)
+			job_ = jobs[--tail % QUEUE_SIZE];
+		mutex.unlock ();
+		return ok;
+	}
+
+	/// \brief Steal oldest job
+	bool steal (Job &job_)
+	{
+		mutex.lock ();
+		auto const ok = tail != head;
+		if (ok)
+			job_ = jobs[head++ % QUEUE_SIZE];
+		mutex.unlock ();
+		return ok;
+	}
+
+	/// \brief Queue lock
+	Mutex mutex;
+	/// \brief Jobs
+	Job jobs[QUEUE_SIZE];
+	/// \brief Index of oldest job
+	unsigned head = 0;
+	/// \brief One past index of newest job
+	unsigned tail = 0;
+};
+
+/// \brief Queues; index 0 belongs to threads outside the pool
+Queue s_queues[MAX_WORKERS + 1];
+
+/// \brief Worker threads
+#ifdef __3DS__
+std::vector<Thread> s_threads;
+#else
+std::vector<pthread_t> s_threads;
+#endif
+
+/// \brief Wakes idle workers
+Semaphore s_wake;
+/// \brief Whether workers should exit
+std::atomic<bool> s_quit = false;
+/// \brief Number of running workers
+/// \note Atomic since workers already look for jobs to steal while init is starting the others;
+/// until it is published they only see their own queue, and nothing is queued before then
+std::atomic<unsigned> s_workerCount = 0;
+
+/// \brief Queue owned by this thread
+thread_local unsigned s_self = 0;
+
+/// \brief Find a job, own queue first
+/// \param job_ Output job
+bool findJob (Job &job_)
+{
+	if (s_queues[s_self].pop (job_))
+		return true;
+
+	auto const workerCount = s_workerCount.load (std::memory_order_acquire);
+	for (unsigned i = 1; i <= workerCount; ++i)
+	{
+		if (s_queues[(s_self + i) % (workerCount + 1)].steal (job_))
+			return true;
+	}
+
+	return false;
+}
+
+/// \brief Run job and signal its group
+/// \param job_ Job to run
+void runJob (Job const &job_)
+{
+	job_.function (job_.context, job_.begin, job_.end);
+	job_.group->finish ();
+}
+
+/// \brief Worker thread entry point
+/// \param arg_ Queue index
+void worker (void *const arg_)
+{
+	s_self = reinterpret_cast<std::uintptr_t> (arg_);
+
+	while (true)
+	{
+		s_wake.acquire ();
+		if (s_quit)
+			break;
+
+		// a wake-up may be for a job another thread already took; that's fine
+		Job job;
+		while (findJob (job))
+			runJob (job);
+	}
+}
+
+#ifndef __3DS__
+/// \brief pthread entry point
+/// \param arg_ Queue index
+void *pthreadWorker (void *const arg_)
+{
+	worker (arg_);
+	return nullptr;
+}
+#endif
+}
+
+///////////////////////////////////////////////////////////////////////////
+jobs::Group::~Group ()
+{
+	wait ();
+}
+
+void jobs::Group::run (Function const function_,
+    void *const context_,
+    std::size_t const begin_,
+    std::size_t const end_)
+{
+	if (s_workerCount.load (std::memory_order_relaxed))
+	{
+		m_pending.fetch_add (1, std::memory_order_relaxed);
+		if (s_queues[s_self].push (Job{function_, context_, begin_, end_, this}))
+		{
+			s_wake.release (1);
+			return;
+		}
+
+		m_pending.fetch_sub (1, std::memory_order_relaxed);
+	}
+
+	function_ (context_, begin_, end_);
+}
+
+void jobs::Group::wait ()
+{
+	// help out instead of blocking; the job we pop may belong to another group
+	while (m_pending.load (std::memory_order_acquire))
+	{
+		Job job;
+		if (findJob (job))
+			runJob (job);
+		else
+			relax ();
+	}
+}
+
+void jobs::Group::finish ()
+{
+	m_pending.fetch_sub (1, std::memory_order_release);
+}
+
+///////////////////////////////////////////////////////////////////////////
+bool jobs::init (unsigned workers_)
+{
+	assert (s_threads.empty ());
+
+	s_quit = false;
+
+#ifdef __3DS__
+	std::vector<int> cores;
+
+	bool isNew3DS = false;
+	APT_CheckNew3DS (&isNew3DS);
+	if (isNew3DS)
+		cores.emplace_back (2);
+
+	// the system core is only usable once the app has been given a share of it
+	u32 timeLimit = 0;
+	if (R_SUCCEEDED (APT_GetAppCpuTimeLimit (&timeLimit)) && timeLimit)
+		cores.emplace_back (1);
+
+	if (!workers_)
+		workers_ = cores.size ();
+
+	s32 priority = 0x30;
+	svcGetThreadPriority (&priority, CUR_THREAD_HANDLE);
+#else
+	if (!workers_)
+		workers_ = std::max (sysconf (_SC_NPROCESSORS_ONLN), 1L) - 1;
+#endif
+
+	workers_ = std::min (workers_, MAX_WORKERS);
+	for (unsigned i = 0; i < workers_; ++i)
+	{
+		auto const arg = reinterpret_cast<void *> (std::uintptr_t (i + 1));
+
+#ifdef __3DS__
+		// extra workers share cores; without spare cores they time-slice with the app core
+		auto const core = cores.empty () ? -2 : cores[i % cores.size ()];
+		auto const thread = threadCreate (&worker, arg, STACK_SIZE, priority, core, false);
+		if (!thread)
+			break;
+#else
+		pthread_t thread;
+		if (pthread_create (&thread, nullptr, &pthreadWorker, arg) != 0)
+			break;
+#endif
+
+		s_threads.emplace_back (thread);
+	}
+
+	s_workerCount.store (s_threads.size (), std::memory_order_release);
+	return s_threads.size () == workers_;
+}
+
+void jobs::exit ()
+{
+	s_quit = true;
+	s_wake.release (s_threads.size ());
+
+	for (auto const &thread : s_threads)
+	{
+#ifdef __3DS__
+		threadJoin (thread, UINT64_MAX);
+		threadFree (thread);
+#else
+		pthread_join (thread, nullptr);
+#endif
+	}
+
+	s_threads.clear ();
+	s_workerCount.store (0, std::memory_order_relaxed);
+}
+
+unsigned jobs::workerCount ()
+{
+	return s_workerCount.load (std::memory_order_relaxed);
+}
@@ -0,0 +1,173 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+
+namespace jobs
+{
+/// \brief Job entry point
+/// \param context_ User context
+/// \param begin_ First index to process
+/// \param end_ One past last index to process
+using Function = void (*) (void *context_, std::size_t begin_, std::size_t end_);
+
+/// \brief Fork-join group
+/// \note Jobs run on the pool; wait () helps run queued jobs until all of them have finished
+class Group
+{
+public:
+	Group () = default;
+	~Group ();
+
+	Group (Group const &) = delete;
+	Group &operator= (Group const &) = delete;
+
+	/// \brief Fork job
+	/// \param function_ Job entry point
+	/// \param context_ User context; must outlive the group
+	/// \param begin_ First index to process
+	/// \param end_ One past last index to process
+	/// \note Runs inline if the pool is not running or the queue is full
+	void run (Function function_, void *context_, std::size_t begin_, std::size_t end_);
+
+	/// \brief Join all forked jobs
+	void wait ();
+
+	/// \brief Mark job finished
+	void finish ();
+
+private:
+	/// \brief Number of unfinished jobs
+	std::atomic<unsigned> m_pending = 0;
+};
+
+/// \brief Start worker pool
+/// \param workers_ Number of worker threads (0 to use one per spare CPU core)
+/// \note On device the spare cores are core 2 on New 3DS, and core 1 if the app has set a
+/// time limit with APT_SetAppCpuTimeLimit
+bool init (unsigned workers_ = 0);
+/// \brief Stop worker pool
+void exit ();
+
+/// \brief Number of worker threads
+/// \note The thread that waits on a group also runs jobs, so this is one less than the
+/// available parallelism
+unsigned workerCount ();
+
+/// \brief Run function over a range in parallel
+/// \param begin_ First index
+/// \param end_ One past last index
+/// \param grain_ Minimum number of indices per job
+/// \param function_ Called as function_ (begin, end) for each chunk
+template <typename F>
+void parallelFor (std::size_t const begin_,
+    std::size_t const end_,
+    std::size_t const grain_,
+    F &&function_)
+{
+	if (begin_ >= end_)
+		return;
+
+	// a few chunks per thread lets stealing even out uneven chunks
+	auto const count = end_ - begin_;
+	auto const chunk =
+	    std::max<std::size_t> ({grain_, 1, (count + 4 * (workerCount () + 1) - 1) /
+	                                           (4 * (workerCount () + 1))});
+	if (count <= chunk || workerCount () == 0)
+	{
+		function_ (begin_, end_);
+		return;
+	}
+
+	using Functor = std::remove_reference_t<F>;
+	auto const thunk = [] (void *const context_, std::size_t const b_, std::size_t const e_) {
+		(*static_cast<Functor *> (context_)) (b_, e_);
+	};
+
+	Group group;
+	for (auto i = begin_; i < end_; i += chunk)
+		group.run (thunk,
+		    const_cast<void *> (static_cast<void const *> (&function_)),
+		    i,
+		    std::min (i + chunk, end_));
+	group.wait ();
+}
+
+/// \brief Sort range in parallel
+/// \param first_ Start of range
+/// \param last_ End of range
+/// \param compare_ Strict weak ordering
+/// \note Sorts one run per thread, then merges runs pairwise; not stable
+template <typename It, typename Compare>
+void sort (It const first_, It const last_, Compare compare_)
+{
+	auto const count = static_cast<std::size_t> (std::distance (first_, last_));
+	auto const runs  = workerCount () + 1;
+
+	// not worth forking for short ranges
+	if (runs == 1 || count < 1024)
+	{
+		std::sort (first_, last_, compare_);
+		return;
+	}
+
+	auto const runSize = (count + runs - 1) / runs;
+	parallelFor (0, runs, 1, [&] (std::size_t const begin_, std::size_t const end_) {
+		for (auto i = begin_; i < end_; ++i)
+			std::sort (first_ + std::min (i * runSize, count),
+			    first_ + std::min ((i + 1) * runSize, count),
+			    compare_);
+	});
+
+	for (auto width = runSize; width < count; width *= 2)
+	{
+		auto const pairs = (count + 2 * width - 1) / (2 * width);
+		parallelFor (0, pairs, 1, [&] (std::size_t const begin_, std::size_t const end_) {
+			for (auto i = begin_; i < end_; ++i)
+			{
+				auto const lo  = i * 2 * width;
+				auto const mid = std::min (lo + width, count);
+				auto const hi  = std::min (lo + 2 * width, count);
+				if (mid < hi)
+					std::inplace_merge (first_ + lo, first_ + mid, first_ + hi, compare_);
+			}
+		});
+	}
+}
+
+/// \brief Sort range in parallel
+/// \param first_ Start of range
+/// \param last_ End of range
+template <typename It>
+void sort (It const first_, It const last_)
+{
+	jobs::sort (first_, last_, std::less<> ());
+}
+}
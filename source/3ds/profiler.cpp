@@ -0,0 +1,236 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "profiler.h"
+
+#ifdef __3DS__
+#include <3ds.h>
+#else
+#include <time.h>
+#endif
+
+#include <algorithm>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+// everything here runs inside the instrumentation hooks, so none of it may be instrumented;
+// that includes templates instantiated here, which is why the hooks avoid the standard library
+#define NO_INSTRUMENT __attribute__ ((no_instrument_function))
+
+namespace
+{
+/// \brief Hash table size (power of two)
+constexpr unsigned TABLE_SIZE = 4096;
+/// \brief Maximum tracked call depth
+constexpr unsigned MAX_DEPTH = 256;
+
+/// \brief Per-function totals
+struct Entry
+{
+	/// \brief Function address (nullptr if unused)
+	void *function;
+	/// \brief Number of calls
+	std::uint64_t calls;
+	/// \brief Ticks including callees
+	std::uint64_t inclusive;
+	/// \brief Ticks excluding callees
+	std::uint64_t exclusive;
+};
+
+/// \brief Active call
+struct Frame
+{
+	/// \brief Function's table entry (nullptr if table was full)
+	Entry *entry;
+	/// \brief Tick at entry
+	std::uint64_t start;
+	/// \brief Ticks spent in callees
+	std::uint64_t children;
+};
+
+/// \brief Per-function totals
+Entry s_table[TABLE_SIZE];
+/// \brief Shadow call stack
+Frame s_stack[MAX_DEPTH];
+/// \brief Current call depth; may exceed MAX_DEPTH
+unsigned s_depth = 0;
+/// \brief Calls not recorded because the table was full or the stack was too deep
+std::uint64_t s_dropped = 0;
+
+/// \brief Whether this thread is being profiled
+thread_local bool s_tracking = false;
+
+/// \brief Current tick
+NO_INSTRUMENT std::uint64_t now ()
+{
+#ifdef __3DS__
+	return svcGetSystemTick ();
+#else
+	timespec ts;
+	clock_gettime (CLOCK_MONOTONIC, &ts);
+	return ts.tv_sec * 1000000000ull + ts.tv_nsec;
+#endif
+}
+
+/// \brief Ticks per second
+NO_INSTRUMENT std::uint64_t tickRate ()
+{
+#ifdef __3DS__
+	return SYSCLOCK_ARM11;
+#else
+	return 1000000000ull;
+#endif
+}
+
+/// \brief Find or insert table entry
+/// \param function_ Function address
+/// \returns nullptr if the table is full
+NO_INSTRUMENT Entry *lookup (void *const function_)
+{
+	// functions are at least 4-byte aligned
+	auto index = (reinterpret_cast<std::uintptr_t> (function_) >> 2) * 2654435761u;
+	for (unsigned probe = 0; probe < TABLE_SIZE; ++probe)
+	{
+		auto &entry = s_table[(index + probe) & (TABLE_SIZE - 1)];
+		if (entry.function == function_)
+			return &entry;
+
+		if (!entry.function)
+		{
+			entry.function = function_;
+			return &entry;
+		}
+	}
+
+	return nullptr;
+}
+}
+
+extern "C" {
+NO_INSTRUMENT void __cyg_profile_func_enter (void *function_, void *callSite_);
+NO_INSTRUMENT void __cyg_profile_func_exit (void *function_, void *callSite_);
+
+void __cyg_profile_func_enter (void *const function_, void *const callSite_)
+{
+	(void)callSite_;
+	if (!s_tracking)
+		return;
+
+	if (s_depth++ >= MAX_DEPTH)
+	{
+		++s_dropped;
+		return;
+	}
+
+	auto &frame    = s_stack[s_depth - 1];
+	frame.entry    = lookup (function_);
+	frame.children = 0;
+	frame.start    = now ();
+}
+
+void __cyg_profile_func_exit (void *const function_, void *const callSite_)
+{
+	(void)function_;
+	(void)callSite_;
+	if (!s_tracking || !s_depth)
+		return;
+
+	if (s_depth-- > MAX_DEPTH)
+		return;
+
+	auto const &frame  = s_stack[s_depth];
+	auto const elapsed = now () - frame.start;
+
+	if (frame.entry)
+	{
+		// recursive calls count their time once per active frame
+		++frame.entry->calls;
+		frame.entry->inclusive += elapsed;
+		frame.entry->exclusive += elapsed > frame.children ? elapsed - frame.children : 0;
+	}
+	else
+		++s_dropped;
+
+	if (s_depth)
+		s_stack[s_depth - 1].children += elapsed;
+}
+}
+
+NO_INSTRUMENT void profiler::init ()
+{
+	reset ();
+	s_tracking = true;
+}
+
+NO_INSTRUMENT void profiler::reset ()
+{
+	// calls in progress keep their frames; only totals are cleared
+	for (auto &entry : s_table)
+	{
+		entry.calls     = 0;
+		entry.inclusive = 0;
+		entry.exclusive = 0;
+	}
+	s_dropped = 0;
+}
+
+NO_INSTRUMENT bool profiler::dump (char const *const path_)
+{
+	// don't record the report itself
+	auto const tracking = s_tracking;
+	s_tracking          = false;
+
+	std::vector<Entry> entries;
+	for (auto const &entry : s_table)
+	{
+		if (entry.function && entry.calls)
+			entries.emplace_back (entry);
+	}
+
+	std::sort (std::begin (entries), std::end (entries), [] (auto const &a_, auto const &b_) {
+		return a_.exclusive > b_.exclusive;
+	});
+
+	auto const fp = std::fopen (path_, "w");
+	if (fp)
+	{
+		std::fprintf (fp,
+		    "# ticks per second: %llu, dropped calls: %llu\n",
+		    static_cast<unsigned long long> (tickRate ()),
+		    static_cast<unsigned long long> (s_dropped));
+		std::fprintf (fp, "address,calls,inclusive,exclusive\n");
+		for (auto const &entry : entries)
+			std::fprintf (fp,
+			    "%p,%llu,%llu,%llu\n",
+			    entry.function,
+			    static_cast<unsigned long long> (entry.calls),
+			    static_cast<unsigned long long> (entry.inclusive),
+			    static_cast<unsigned long long> (entry.exclusive));
+	}
+
+	auto const ok = fp && std::fclose (fp) == 0;
+	s_tracking    = tracking;
+	return ok;
+}
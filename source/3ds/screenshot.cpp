@@ -0,0 +1,181 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#include "screenshot.h"
+#include "screenshot_image.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cassert>
+#include <cstdint>
+#include <cstdio>
+#include <string>
+#include <vector>
+
+namespace
+{
+using screenshot::BOTTOM_WIDTH;
+using screenshot::BPP;
+using screenshot::IMAGE_HEIGHT;
+using screenshot::SCREEN_HEIGHT;
+
+/// \brief Top screen width in wide mode
+constexpr unsigned MAX_TOP_WIDTH = 800;
+
+/// \brief Worker thread stack size
+constexpr auto STACK_SIZE = 0x8000;
+
+/// \brief Transferred top screen
+std::uint8_t *s_top = nullptr;
+/// \brief Transferred bottom screen
+std::uint8_t *s_bottom = nullptr;
+/// \brief Width of transferred top screen (400, or 800 in wide mode)
+unsigned s_topWidth = 0;
+
+/// \brief Worker thread
+Thread s_thread = nullptr;
+/// \brief Signals worker thread
+LightEvent s_event;
+/// \brief Whether worker is encoding
+std::atomic<bool> s_busy = false;
+/// \brief Whether worker should exit
+std::atomic<bool> s_quit = false;
+/// \brief Output path
+std::string s_path;
+
+/// \brief Snapshot render target into linear buffer
+/// \param target_ Render target
+/// \param out_ Output buffer
+/// \param width_ Output width (screen height; buffer is rotated)
+/// \param height_ Output height (screen width; buffer is rotated)
+void transfer (C3D_RenderTarget *const target_,
+    std::uint8_t *const out_,
+    unsigned const width_,
+    unsigned const height_)
+{
+	// the display transfer de-tiles, downscales and converts to RGB8 just like the real
+	// output, but into our linear buffer
+	auto const &fb = target_->frameBuf;
+	C3D_SyncDisplayTransfer (static_cast<std::uint32_t *> (fb.colorBuf),
+	    GX_BUFFER_DIM (fb.width, fb.height),
+	    reinterpret_cast<std::uint32_t *> (out_),
+	    GX_BUFFER_DIM (width_, height_),
+	    target_->transferFlags);
+
+	GSPGPU_InvalidateDataCache (out_, width_ * height_ * BPP);
+}
+
+/// \brief Worker thread entry point
+/// \param arg_ Unused
+void worker (void *const arg_)
+{
+	(void)arg_;
+
+	std::vector<std::uint8_t> image (MAX_TOP_WIDTH * IMAGE_HEIGHT * BPP);
+
+	while (true)
+	{
+		LightEvent_Wait (&s_event);
+		if (s_quit)
+			break;
+
+		auto const width = s_topWidth;
+		screenshot::compose (image.data (), width, s_top, s_bottom);
+
+		if (!screenshot::writePng (s_path.c_str (), image.data (), width, IMAGE_HEIGHT))
+			std::fprintf (stderr, "Failed to write %s\n", s_path.c_str ());
+
+		s_busy = false;
+	}
+}
+}
+
+bool screenshot::init ()
+{
+	s_top    = static_cast<std::uint8_t *> (linearAlloc (MAX_TOP_WIDTH * SCREEN_HEIGHT * BPP));
+	s_bottom = static_cast<std::uint8_t *> (linearAlloc (BOTTOM_WIDTH * SCREEN_HEIGHT * BPP));
+	if (!s_top || !s_bottom)
+	{
+		exit ();
+		return false;
+	}
+
+	LightEvent_Init (&s_event, RESET_ONESHOT);
+
+	// run below the UI thread so encoding only uses time the UI leaves idle
+	s32 priority = 0x30;
+	svcGetThreadPriority (&priority, CUR_THREAD_HANDLE);
+
+	s_quit   = false;
+	s_thread = threadCreate (&worker, nullptr, STACK_SIZE, priority + 1, -2, false);
+	if (!s_thread)
+	{
+		exit ();
+		return false;
+	}
+
+	return true;
+}
+
+void screenshot::exit ()
+{
+	if (s_thread)
+	{
+		s_quit = true;
+		LightEvent_Signal (&s_event);
+		threadJoin (s_thread, UINT64_MAX);
+		threadFree (s_thread);
+		s_thread = nullptr;
+	}
+
+	linearFree (s_bottom);
+	linearFree (s_top);
+	s_bottom = nullptr;
+	s_top    = nullptr;
+}
+
+bool screenshot::capture (C3D_RenderTarget *const top_,
+    C3D_RenderTarget *const bottom_,
+    char const *const path_)
+{
+	if (!s_thread || s_busy)
+		return false;
+
+	// the top screen is 800px in wide mode; match what the display actually shows
+	u16 width  = 0;
+	u16 height = 0;
+	gfxGetFramebuffer (GFX_TOP, GFX_LEFT, &width, &height);
+	s_topWidth = std::min<unsigned> (height, MAX_TOP_WIDTH);
+
+	transfer (top_, s_top, SCREEN_HEIGHT, s_topWidth);
+	transfer (bottom_, s_bottom, SCREEN_HEIGHT, BOTTOM_WIDTH);
+
+	s_path = path_;
+	s_busy = true;
+	LightEvent_Signal (&s_event);
+	return true;
+}
+
+bool screenshot::busy ()
+{
+	return s_busy;
+}
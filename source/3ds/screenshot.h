@@ -0,0 +1,46 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+#pragma once
+
+#include <citro3d.h>
+
+namespace screenshot
+{
+/// \brief Start screenshot worker
+bool init ();
+/// \brief Stop screenshot worker
+/// \note Waits for a pending screenshot to be written
+void exit ();
+
+/// \brief Snapshot render targets and save them as PNG in the background
+/// \param top_ Top screen render target
+/// \param bottom_ Bottom screen render target
+/// \param path_ Output file
+/// \returns Whether the screenshot was started
+/// \note Call after C3D_FrameBegin and before clearing the render targets, while they still
+/// hold the previous frame
+bool capture (C3D_RenderTarget *top_, C3D_RenderTarget *bottom_, char const *path_);
+
+/// \brief Whether a screenshot is still being written
+bool busy ();
+}
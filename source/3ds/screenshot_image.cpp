@@ -0,0 +1,173 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+
+#include "screenshot_image.h"
+
+#include <zlib.h>
+
+#include <cstdio>
+#include <cstring>
+#include <vector>
+
+namespace
+{
+/// \brief Copy rotated screen into image
+/// \param image_ Image (RGB)
+/// \param imageWidth_ Image width
+/// \param screen_ Screen buffer (column-major BGR, bottom-up)
+/// \param width_ Screen width
+/// \param x_ Image x offset
+/// \param y_ Image y offset
+void blit (std::uint8_t *const image_,
+    unsigned const imageWidth_,
+    std::uint8_t const *const screen_,
+    unsigned const width_,
+    unsigned const x_,
+    unsigned const y_)
+{
+	using screenshot::BPP;
+	using screenshot::SCREEN_HEIGHT;
+
+	for (unsigned y = 0; y < SCREEN_HEIGHT; ++y)
+	{
+		auto out = &image_[((y_ + y) * imageWidth_ + x_) * BPP];
+		auto in  = &screen_[(SCREEN_HEIGHT - 1 - y) * BPP];
+		for (unsigned x = 0; x < width_; ++x)
+		{
+			out[0] = in[2];
+			out[1] = in[1];
+			out[2] = in[0];
+
+			out += BPP;
+			in += SCREEN_HEIGHT * BPP;
+		}
+	}
+}
+
+/// \brief Write PNG chunk
+/// \param fp_ Output file
+/// \param type_ Chunk type
+/// \param data_ Chunk data
+/// \param size_ Size of chunk data
+bool writeChunk (std::FILE *const fp_,
+    char const *const type_,
+    void const *const data_,
+    std::uint32_t const size_)
+{
+	std::uint8_t const length[] = {static_cast<std::uint8_t> (size_ >> 24),
+	    static_cast<std::uint8_t> (size_ >> 16),
+	    static_cast<std::uint8_t> (size_ >> 8),
+	    static_cast<std::uint8_t> (size_)};
+
+	auto crc = crc32 (0, reinterpret_cast<Bytef const *> (type_), 4);
+	if (size_)
+		crc = crc32 (crc, static_cast<Bytef const *> (data_), size_);
+
+	std::uint8_t const trailer[] = {static_cast<std::uint8_t> (crc >> 24),
+	    static_cast<std::uint8_t> (crc >> 16),
+	    static_cast<std::uint8_t> (crc >> 8),
+	    static_cast<std::uint8_t> (crc)};
+
+	return std::fwrite (length, sizeof (length), 1, fp_) == 1 &&
+	       std::fwrite (type_, 4, 1, fp_) == 1 &&
+	       (!size_ || std::fwrite (data_, size_, 1, fp_) == 1) &&
+	       std::fwrite (trailer, sizeof (trailer), 1, fp_) == 1;
+}
+}
+
+void screenshot::compose (std::uint8_t *const image_,
+    unsigned const width_,
+    std::uint8_t const *const top_,
+    std::uint8_t const *const bottom_)
+{
+	std::memset (image_, 0, width_ * IMAGE_HEIGHT * BPP);
+	blit (image_, width_, top_, width_, 0, 0);
+	blit (image_, width_, bottom_, BOTTOM_WIDTH, (width_ - BOTTOM_WIDTH) / 2, SCREEN_HEIGHT);
+}
+
+bool screenshot::writePng (char const *const path_,
+    std::uint8_t const *const image_,
+    unsigned const width_,
+    unsigned const height_)
+{
+	auto const fp = std::fopen (path_, "wb");
+	if (!fp)
+		return false;
+
+	static std::uint8_t const signature[] = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+
+	std::uint8_t const ihdr[] = {0,
+	    0,
+	    static_cast<std::uint8_t> (width_ >> 8),
+	    static_cast<std::uint8_t> (width_ & 0xFF),
+	    0,
+	    0,
+	    static_cast<std::uint8_t> (height_ >> 8),
+	    static_cast<std::uint8_t> (height_ & 0xFF),
+	    8, // bit depth
+	    2, // color type: RGB
+	    0, // compression
+	    0, // filter
+	    0}; // interlace
+
+	auto ok = std::fwrite (signature, sizeof (signature), 1, fp) == 1 &&
+	          writeChunk (fp, "IHDR", ihdr, sizeof (ihdr));
+
+	// favor speed; UI screenshots compress well regardless
+	z_stream stream;
+	std::memset (&stream, 0, sizeof (stream));
+	ok = ok && deflateInit (&stream, Z_BEST_SPEED) == Z_OK;
+
+	std::vector<std::uint8_t> row (1 + width_ * BPP);
+	std::vector<std::uint8_t> idat (0x10000);
+	for (unsigned y = 0; ok && y <= height_; ++y)
+	{
+		auto const last = y == height_;
+		if (!last)
+		{
+			// each row is prefixed with its filter type (none)
+			row[0] = 0;
+			std::memcpy (&row[1], &image_[y * width_ * BPP], width_ * BPP);
+		}
+
+		stream.next_in  = row.data ();
+		stream.avail_in = last ? 0 : row.size ();
+
+		int rc;
+		do
+		{
+			stream.next_out  = idat.data ();
+			stream.avail_out = idat.size ();
+			rc               = deflate (&stream, last ? Z_FINISH : Z_NO_FLUSH);
+
+			auto const produced = idat.size () - stream.avail_out;
+			if (produced)
+				ok = ok && writeChunk (fp, "IDAT", idat.data (), produced);
+		} while (ok && rc == Z_OK && (stream.avail_out == 0 || last));
+
+		if (last)
+			ok = ok && rc == Z_STREAM_END;
+	}
+
+	deflateEnd (&stream);
+
+	ok = ok && writeChunk (fp, "IEND", nullptr, 0);
+	return std::fclose (fp) == 0 && ok;
+}
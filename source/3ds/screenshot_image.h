@@ -0,0 +1,57 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+
+// Screenshot image composition and PNG encoding. Nothing here touches the GPU, so the 3DS worker
+// and the host tests share it.
+
+#pragma once
+
+#include <cstdint>
+
+namespace screenshot
+{
+/// \brief Screen height
+constexpr unsigned SCREEN_HEIGHT = 240;
+/// \brief Bottom screen width
+constexpr unsigned BOTTOM_WIDTH = 320;
+/// \brief Screenshot height: the top screen over the bottom screen
+constexpr unsigned IMAGE_HEIGHT = 2 * SCREEN_HEIGHT;
+/// \brief Bytes per pixel, for both the screens and the image
+constexpr unsigned BPP = 3;
+
+/// \brief Compose both screens into one image
+/// \param image_ Image (RGB, row-major), width_ by IMAGE_HEIGHT
+/// \param width_ Image width, which is the top screen width (400, or 800 in wide mode)
+/// \param top_ Top screen as the display transfer leaves it: rotated, so column-major from the
+/// left, each column bottom-up, BGR
+/// \param bottom_ Bottom screen, laid out like top_ and BOTTOM_WIDTH wide
+/// \note The bottom screen is centered beneath the top screen and the rest is black
+void compose (std::uint8_t *image_,
+    unsigned width_,
+    std::uint8_t const *top_,
+    std::uint8_t const *bottom_);
+
+/// \brief Encode image as PNG
+/// \param path_ Output file
+/// \param image_ Image (RGB, row-major)
+/// \param width_ Image width
+/// \param height_ Image height
+bool writePng (char const *path_, std::uint8_t const *image_, unsigned width_, unsigned height_);
+}
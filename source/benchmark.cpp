@@ -0,0 +1,1015 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#include "benchmark.h"
+
+#include "3ds/imgui_log.h"
+#include "3ds/imgui_text_editor.h"
+#include "3ds/jobs.h"
+
+#ifdef __3DS__
+#include <3ds.h>
+#else
+#include <chrono>
+#endif
+
+#include <algorithm>
+#include <atomic>
+#include <cmath>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <string>
+#include <vector>
+
+namespace
+{
+/// \brief Scene description
+struct Scene
+{
+	/// \brief Scene name
+	char const *name;
+	/// \brief Build frame
+	/// \param frame_ Frame number
+	void (*build) (unsigned frame_);
+	/// \brief Queue input for frame
+	/// \param io_ IO to queue events on
+	/// \param frame_ Frame number
+	void (*input) (ImGuiIO &io_, unsigned frame_);
+	/// \brief Worker threads to run the scene with (0 to use the app's pool)
+	unsigned workers;
+};
+
+/// \brief Per-scene totals
+struct Totals
+{
+	/// \brief Time spent in NewFrame (us)
+	std::uint64_t newFrame;
+	/// \brief Time spent building the scene (us)
+	std::uint64_t build;
+	/// \brief Time spent in Render (us)
+	std::uint64_t render;
+	/// \brief Time spent in the backend (us)
+	std::uint64_t backend;
+	/// \brief Vertices
+	std::uint64_t vertices;
+	/// \brief Indices
+	std::uint64_t indices;
+	/// \brief Draw commands
+	std::uint64_t commands;
+	/// \brief Allocations
+	std::uint64_t allocs;
+};
+
+/// \brief Allocations since last reset
+/// \note Atomic since scenes may fill draw lists on worker threads
+std::atomic<std::uint64_t> s_allocs = 0;
+/// \brief Chained allocator
+ImGuiMemAllocFunc s_allocFunc = nullptr;
+/// \brief Chained deallocator
+ImGuiMemFreeFunc s_freeFunc = nullptr;
+/// \brief Chained allocator user data
+void *s_allocUserData = nullptr;
+
+/// \brief Sample Latin text
+constexpr auto LATIN_TEXT = "Lorem ipsum dolor sit amet, consectetur adipiscing elit, sed do "
+                            "eiusmod tempor incididunt ut labore et dolore magna aliqua.";
+/// \brief Sample CJK text
+constexpr auto CJK_TEXT = "\xe5\xa4\xa9\xe5\x9c\xb0\xe7\x8e\x84\xe9\xbb\x84\xe5\xae\x87\xe5\xae"
+                          "\x99\xe6\xb4\xaa\xe8\x8d\x92\xe3\x81\x84\xe3\x82\x8d\xe3\x81\xaf\xe3"
+                          "\x81\xab\xe3\x81\xbb\xe3\x81\xb8\xe3\x81\xa8\xea\xb0\x80\xeb\x82\x98"
+                          "\xeb\x8b\xa4\xeb\x9d\xbc\xeb\xa7\x88\xeb\xb0\x94\xec\x82\xac";
+
+/// \brief Current time (us)
+std::uint64_t now ()
+{
+#ifdef __3DS__
+	return svcGetSystemTick () / (CPU_TICKS_PER_MSEC / 1000.0);
+#else
+	return std::chrono::duration_cast<std::chrono::microseconds> (
+	    std::chrono::steady_clock::now ().time_since_epoch ())
+	    .count ();
+#endif
+}
+
+/// \brief Counting allocator
+/// \param size_ Allocation size
+/// \param userData_ Unused
+void *countingAlloc (std::size_t const size_, void *const userData_)
+{
+	(void)userData_;
+	++s_allocs;
+	return s_allocFunc (size_, s_allocUserData);
+}
+
+/// \brief Counting deallocator
+/// \param ptr_ Allocation
+/// \param userData_ Unused
+void countingFree (void *const ptr_, void *const userData_)
+{
+	(void)userData_;
+	s_freeFunc (ptr_, s_allocUserData);
+}
+
+/// \brief Begin full-screen scene window
+/// \param name_ Window name
+/// \param flags_ Window flags
+void beginFullscreen (char const *const name_, ImGuiWindowFlags const flags_ = 0)
+{
+	ImGui::SetNextWindowPos (ImVec2 (0.0f, 0.0f), ImGuiCond_Always);
+	ImGui::SetNextWindowSize (ImGui::GetIO ().DisplaySize, ImGuiCond_Always);
+	ImGui::Begin (name_, nullptr, flags_ | ImGuiWindowFlags_NoSavedSettings);
+}
+
+/// \brief Scroll the hovered window down at a steady rate
+/// \param io_ IO to queue events on
+/// \param frame_ Frame number
+void scrollInput (ImGuiIO &io_, unsigned const frame_)
+{
+	io_.AddMousePosEvent (io_.DisplaySize.x * 0.5f, io_.DisplaySize.y * 0.5f);
+	io_.AddMouseWheelEvent (0.0f, (frame_ / 60) % 2 ? 1.0f : -1.0f);
+}
+
+/// \brief Scroll the hovered window right and back at a steady rate
+/// \param io_ IO to queue events on
+/// \param frame_ Frame number
+void scrollXInput (ImGuiIO &io_, unsigned const frame_)
+{
+	io_.AddMousePosEvent (io_.DisplaySize.x * 0.5f, io_.DisplaySize.y * 0.5f);
+	io_.AddMouseWheelEvent ((frame_ / 60) % 2 ? 1.0f : -1.0f, 0.0f);
+}
+
+/// \brief Sweep the mouse across the screen
+/// \param io_ IO to queue events on
+/// \param frame_ Frame number
+void sweepInput (ImGuiIO &io_, unsigned const frame_)
+{
+	auto const t = frame_ * 0.05f;
+	io_.AddMousePosEvent (io_.DisplaySize.x * (0.5f + 0.45f * std::sin (t)),
+	    io_.DisplaySize.y * (0.5f + 0.45f * std::cos (t * 0.7f)));
+	io_.AddMouseButtonEvent (0, (frame_ / 30) % 2);
+}
+
+/// \brief Click into the middle of the screen, then type a character every frame
+/// \param io_ IO to queue events on
+/// \param frame_ Frame number
+/// \note The click waits a frame for the scene window to exist
+void typeInput (ImGuiIO &io_, unsigned const frame_)
+{
+	io_.AddMousePosEvent (io_.DisplaySize.x * 0.5f, io_.DisplaySize.y * 0.5f);
+	io_.AddMouseButtonEvent (0, frame_ == 1);
+	if (frame_ >= 3)
+		io_.AddInputCharacter ('a' + frame_ % 26);
+}
+
+/// \brief Drag a selection box from empty space down past the bottom of the screen, wiggling it
+/// sideways, and release it every two seconds
+/// \param io_ IO to queue events on
+/// \param frame_ Frame number
+void boxSelectInput (ImGuiIO &io_, unsigned const frame_)
+{
+	auto const t = frame_ % 120;
+	if (t < 2)
+		io_.AddMousePosEvent (io_.DisplaySize.x - 16.0f, io_.DisplaySize.y * 0.2f);
+	else
+		io_.AddMousePosEvent (io_.DisplaySize.x * ((t / 8) % 2 ? 0.2f : 0.5f), io_.DisplaySize.y - 2.0f);
+	io_.AddMouseButtonEvent (0, t >= 1 && t < 119);
+}
+
+/// \brief Config-style document of about 120KB
+std::string const &largeDocument ()
+{
+	static std::string text;
+	if (text.empty ())
+	{
+		char line[64];
+		for (unsigned i = 0; text.size () < 120 * 1024; ++i)
+		{
+			std::snprintf (line, sizeof (line), "key_%05u = %u # setting %u\n", i, i * 7919u, i);
+			text += line;
+		}
+	}
+
+	return text;
+}
+
+/// \brief Wall of wrapped text
+/// \param text_ Line of text
+void textWall (char const *const text_)
+{
+	for (unsigned i = 0; i < 200; ++i)
+		ImGui::TextWrapped ("%u: %s", i, text_);
+}
+
+/// \brief Latin text wall scene
+void sceneTextLatin (unsigned)
+{
+	beginFullscreen ("Text (Latin)");
+	textWall (LATIN_TEXT);
+	ImGui::End ();
+}
+
+/// \brief CJK text wall scene
+void sceneTextCJK (unsigned)
+{
+	beginFullscreen ("Text (CJK)");
+	textWall (CJK_TEXT);
+	ImGui::End ();
+}
+
+/// \brief Clipped table with 10k rows scene
+void sceneTableTall (unsigned)
+{
+	beginFullscreen ("Table (10k rows)");
+	if (ImGui::BeginTable ("rows",
+	        4,
+	        ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders |
+	            ImGuiTableFlags_Resizable))
+	{
+		ImGui::TableSetupScrollFreeze (0, 1);
+		ImGui::TableSetupColumn ("ID");
+		ImGui::TableSetupColumn ("Name");
+		ImGui::TableSetupColumn ("Value");
+		ImGui::TableSetupColumn ("Flags");
+		ImGui::TableHeadersRow ();
+
+		ImGuiListClipper clipper;
+		clipper.Begin (10000);
+		while (clipper.Step ())
+		{
+			for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
+			{
+				ImGui::TableNextRow ();
+				ImGui::TableNextColumn ();
+				ImGui::Text ("%d", row);
+				ImGui::TableNextColumn ();
+				ImGui::Text ("Item %04d", row);
+				ImGui::TableNextColumn ();
+				ImGui::Text ("%.3f", row * 0.001f);
+				ImGui::TableNextColumn ();
+				ImGui::Text ("0x%08X", row * 2654435761u);
+			}
+		}
+		ImGui::EndTable ();
+	}
+	ImGui::End ();
+}
+
+/// \brief Table with many columns scene
+void sceneTableWide (unsigned)
+{
+	constexpr int COLUMNS = 64;
+
+	beginFullscreen ("Table (wide)");
+	if (ImGui::BeginTable ("columns",
+	        COLUMNS,
+	        ImGuiTableFlags_ScrollX | ImGuiTableFlags_ScrollY | ImGuiTableFlags_Borders |
+	            ImGuiTableFlags_SizingFixedFit))
+	{
+		for (int row = 0; row < 100; ++row)
+		{
+			ImGui::TableNextRow ();
+			for (int column = 0; column < COLUMNS; ++column)
+			{
+				ImGui::TableNextColumn ();
+				ImGui::Text ("%d,%d", row, column);
+			}
+		}
+		ImGui::EndTable ();
+	}
+	ImGui::End ();
+}
+
+/// \brief Table with many resizable columns and few rows, dominated by column layout
+void sceneTableLayout (unsigned)
+{
+	constexpr int COLUMNS = 256;
+
+	beginFullscreen ("Table (layout)");
+	if (ImGui::BeginTable ("layout",
+	        COLUMNS,
+	        ImGuiTableFlags_ScrollX | ImGuiTableFlags_Resizable | ImGuiTableFlags_BordersV |
+	            ImGuiTableFlags_SizingFixedFit))
+	{
+		for (int row = 0; row < 4; ++row)
+		{
+			ImGui::TableNextRow ();
+			for (int column = 0; column < COLUMNS; ++column)
+			{
+				if (ImGui::TableNextColumn ())
+					ImGui::Text ("%d", column);
+			}
+		}
+		ImGui::EndTable ();
+	}
+	ImGui::End ();
+}
+
+/// \brief Rows in sorted table scenes
+constexpr unsigned SORTED_ROWS = 50000;
+
+/// \brief Row of sorted table scenes
+struct SortedRow
+{
+	/// \brief Row ID
+	unsigned id;
+	/// \brief Name, shown as a hash
+	unsigned name;
+	/// \brief Live value
+	float value;
+};
+
+/// \brief Rows of sorted table scenes
+std::vector<SortedRow> s_sortedRows;
+
+/// \brief Compare rows by table sort specs
+/// \param specs_ Sort specs
+/// \param a_ Left row
+/// \param b_ Right row
+bool sortedRowLess (ImGuiTableSortSpecs const &specs_, SortedRow const &a_, SortedRow const &b_)
+{
+	for (int i = 0; i < specs_.SpecsCount; ++i)
+	{
+		auto const &spec = specs_.Specs[i];
+
+		int delta = 0;
+		switch (spec.ColumnIndex)
+		{
+		case 0:
+			delta = (a_.id > b_.id) - (a_.id < b_.id);
+			break;
+
+		case 1:
+			delta = (a_.name > b_.name) - (a_.name < b_.name);
+			break;
+
+		case 2:
+			delta = (a_.value > b_.value) - (a_.value < b_.value);
+			break;
+		}
+
+		if (delta)
+			return spec.SortDirection == ImGuiSortDirection_Ascending ? delta < 0 : delta > 0;
+	}
+
+	return a_.id < b_.id;
+}
+
+/// \brief Sortable table of live values, re-sorted every frame
+/// \param frame_ Frame number
+/// \param parallel_ Whether to sort with jobs::sort
+void sortedTableScene (unsigned const frame_, bool const parallel_)
+{
+	// values change every frame, like a process list, so the rows are sorted every frame
+	s_sortedRows.resize (SORTED_ROWS);
+	for (unsigned i = 0; i < SORTED_ROWS; ++i)
+		s_sortedRows[i] = SortedRow{i, i * 2654435761u, std::sin (i * 0.37f + frame_ * 0.05f)};
+
+	beginFullscreen ("Table (sorted)");
+	if (ImGui::BeginTable ("sorted",
+	        3,
+	        ImGuiTableFlags_ScrollY | ImGuiTableFlags_RowBg | ImGuiTableFlags_Borders |
+	            ImGuiTableFlags_Sortable | ImGuiTableFlags_SortMulti))
+	{
+		ImGui::TableSetupScrollFreeze (0, 1);
+		ImGui::TableSetupColumn ("ID");
+		ImGui::TableSetupColumn ("Name");
+		ImGui::TableSetupColumn ("Value",
+		    ImGuiTableColumnFlags_DefaultSort | ImGuiTableColumnFlags_PreferSortDescending);
+		ImGui::TableHeadersRow ();
+
+		auto const &specs = *ImGui::TableGetSortSpecs ();
+		auto const less   = [&specs] (SortedRow const &a_, SortedRow const &b_) {
+			return sortedRowLess (specs, a_, b_);
+		};
+		if (parallel_)
+			jobs::sort (std::begin (s_sortedRows), std::end (s_sortedRows), less);
+		else
+			std::sort (std::begin (s_sortedRows), std::end (s_sortedRows), less);
+
+		ImGuiListClipper clipper;
+		clipper.Begin (SORTED_ROWS);
+		while (clipper.Step ())
+		{
+			for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
+			{
+				auto const &item = s_sortedRows[row];
+				ImGui::TableNextRow ();
+				ImGui::TableNextColumn ();
+				ImGui::Text ("%u", item.id);
+				ImGui::TableNextColumn ();
+				ImGui::Text ("%08X", item.name);
+				ImGui::TableNextColumn ();
+				ImGui::Text ("%.3f", item.value);
+			}
+		}
+		ImGui::EndTable ();
+	}
+	ImGui::End ();
+}
+
+/// \brief Sorted table scene sorting on the UI thread
+/// \param frame_ Frame number
+void sceneTableSortedInline (unsigned const frame_)
+{
+	sortedTableScene (frame_, false);
+}
+
+/// \brief Sorted table scene sorting with jobs
+/// \param frame_ Frame number
+void sceneTableSortedJobs (unsigned const frame_)
+{
+	sortedTableScene (frame_, true);
+}
+
+/// \brief Nested tree nodes
+/// \param depth_ Remaining depth
+void tree (unsigned const depth_)
+{
+	if (!depth_)
+		return;
+
+	for (unsigned i = 0; i < 2; ++i)
+	{
+		ImGui::PushID (i);
+		if (ImGui::TreeNodeEx ("node", ImGuiTreeNodeFlags_DefaultOpen, "Node %u.%u", depth_, i))
+		{
+			ImGui::BulletText ("Leaf");
+			if (i == 0)
+				tree (depth_ - 1);
+			ImGui::TreePop ();
+		}
+		ImGui::PopID ();
+	}
+}
+
+/// \brief Deep tree scene
+void sceneTreeDeep (unsigned)
+{
+	beginFullscreen ("Tree");
+	tree (48);
+	ImGui::End ();
+}
+
+/// \brief Many overlapping windows scene
+void sceneWindows (unsigned)
+{
+	auto const &size = ImGui::GetIO ().DisplaySize;
+	for (unsigned i = 0; i < 40; ++i)
+	{
+		char name[32];
+		std::snprintf (name, sizeof (name), "Window %u", i);
+
+		ImGui::SetNextWindowPos (
+		    ImVec2 ((i * 37) % unsigned (size.x * 0.6f), (i * 23) % unsigned (size.y * 0.6f)),
+		    ImGuiCond_Always);
+		ImGui::SetNextWindowSize (ImVec2 (size.x * 0.4f, size.y * 0.3f), ImGuiCond_Always);
+		ImGui::Begin (name, nullptr, ImGuiWindowFlags_NoSavedSettings);
+		ImGui::Text ("Window %u", i);
+		ImGui::Button (IM_LITERAL ("Button"));
+		static float value = 0.5f;
+		ImGui::SliderFloat ("Slider", &value, 0.0f, 1.0f);
+		ImGui::End ();
+	}
+}
+
+/// \brief Many windows scene, most of which are not submitted on any given frame
+/// \param frame_ Frame number
+void sceneWindowsMany (unsigned const frame_)
+{
+	auto const &size = ImGui::GetIO ().DisplaySize;
+	for (unsigned i = 0; i < 500; ++i)
+	{
+		// a rotating twentieth of the windows is alive each frame
+		if ((i + frame_) % 20 != 0)
+			continue;
+
+		char name[32];
+		std::snprintf (name, sizeof (name), "Window %u", i);
+
+		ImGui::SetNextWindowPos (
+		    ImVec2 ((i * 37) % unsigned (size.x * 0.8f), (i * 23) % unsigned (size.y * 0.8f)),
+		    ImGuiCond_Always);
+		ImGui::SetNextWindowSize (ImVec2 (size.x * 0.2f, size.y * 0.2f), ImGuiCond_Always);
+		ImGui::Begin (name, nullptr, ImGuiWindowFlags_NoSavedSettings);
+		ImGui::Text ("Window %u", i);
+		ImGui::End ();
+	}
+}
+
+/// \brief Plot scene
+/// \param frame_ Frame number
+void scenePlots (unsigned const frame_)
+{
+	static float values[1000];
+	for (unsigned i = 0; i < IM_ARRAYSIZE (values); ++i)
+		values[i] = std::sin ((i + frame_) * 0.05f) * std::cos ((i + frame_) * 0.013f);
+
+	beginFullscreen ("Plots");
+	for (unsigned i = 0; i < 4; ++i)
+	{
+		ImGui::PushID (i);
+		ImGui::PlotLines ("Lines",
+		    values,
+		    IM_ARRAYSIZE (values),
+		    0,
+		    nullptr,
+		    -1.0f,
+		    1.0f,
+		    ImVec2 (0.0f, 60.0f));
+		ImGui::PlotHistogram ("Histogram",
+		    values,
+		    IM_ARRAYSIZE (values),
+		    0,
+		    nullptr,
+		    -1.0f,
+		    1.0f,
+		    ImVec2 (0.0f, 60.0f));
+		ImGui::PopID ();
+	}
+	ImGui::End ();
+}
+
+/// \brief Color picker scene
+void sceneColorPickers (unsigned)
+{
+	static float colors[4][4] = {{1.0f, 0.0f, 0.0f, 1.0f},
+	    {0.0f, 1.0f, 0.0f, 1.0f},
+	    {0.0f, 0.0f, 1.0f, 1.0f},
+	    {1.0f, 1.0f, 1.0f, 0.5f}};
+
+	beginFullscreen ("Color pickers");
+	for (unsigned i = 0; i < IM_ARRAYSIZE (colors); ++i)
+	{
+		ImGui::PushID (i);
+		ImGui::ColorPicker4 ("Picker", colors[i], ImGuiColorEditFlags_AlphaBar);
+		ImGui::ColorEdit4 ("Edit", colors[i]);
+		ImGui::PopID ();
+	}
+	ImGui::End ();
+}
+
+/// \brief InputTextMultiline on a large document scene
+void sceneInputTextLarge (unsigned)
+{
+	static std::vector<char> buffer;
+	if (buffer.empty ())
+	{
+		auto const &text = largeDocument ();
+		buffer.assign (text.size () + 64 * 1024, '\0');
+		text.copy (buffer.data (), text.size ());
+	}
+
+	beginFullscreen ("InputText (120KB)");
+	ImGui::InputTextMultiline ("##text", buffer.data (), buffer.size (), ImVec2 (-FLT_MIN, -FLT_MIN));
+	ImGui::End ();
+}
+
+/// \brief Piece table text editor on a large document scene
+void sceneTextEditorLarge (unsigned)
+{
+	static imgui::TextEditor editor;
+	if (!editor.document.size ())
+	{
+		auto const &text = largeDocument ();
+		editor.document.assign (text.data (), text.size ());
+	}
+
+	beginFullscreen ("TextEditor (120KB)");
+	editor.draw ("##text", ImVec2 (-FLT_MIN, -FLT_MIN));
+	ImGui::End ();
+}
+
+/// \brief Box-select in a clipped grid of 100k selectables scene
+void sceneBoxSelectGrid (unsigned)
+{
+	constexpr int ITEMS   = 100000;
+	constexpr int COLUMNS = 8;
+
+	static ImGuiSelectionBasicStorage selection;
+
+	beginFullscreen ("Box-select (100k)");
+	auto io = ImGui::BeginMultiSelect (
+	    ImGuiMultiSelectFlags_ClearOnClickVoid | ImGuiMultiSelectFlags_BoxSelect2d, selection.Size, ITEMS);
+	selection.ApplyRequests (io);
+
+	ImGuiListClipper clipper;
+	clipper.Begin ((ITEMS + COLUMNS - 1) / COLUMNS);
+	if (io->RangeSrcItem != -1)
+		clipper.IncludeItemByIndex (static_cast<int> (io->RangeSrcItem / COLUMNS));
+	while (clipper.Step ())
+	{
+		for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; ++row)
+		{
+			for (int column = 0; column < COLUMNS; ++column)
+			{
+				auto const item = row * COLUMNS + column;
+				if (item >= ITEMS)
+					break;
+
+				if (column)
+					ImGui::SameLine ();
+				ImGui::PushID (item);
+				ImGui::SetNextItemSelectionUserData (item);
+				ImGui::Selectable (IM_LITERAL ("##item"), selection.Contains (item), 0, ImVec2 (32.0f, 24.0f));
+				ImGui::PopID ();
+			}
+		}
+	}
+
+	io = ImGui::EndMultiSelect ();
+	selection.ApplyRequests (io);
+	ImGui::End ();
+}
+
+/// \brief Restart the job pool if it doesn't have the requested number of workers
+/// \param workers_ Number of workers (0 to stop the pool)
+void setWorkers (unsigned const workers_)
+{
+	if (workers_ == jobs::workerCount ())
+		return;
+
+	jobs::exit ();
+	if (workers_)
+		jobs::init (workers_);
+}
+
+/// \brief Lines appended to the log per frame
+constexpr unsigned LOG_LINES = 512;
+/// \brief Jobs appending to the log per frame
+constexpr unsigned LOG_PRODUCERS = 4;
+
+/// \brief Job appending a range of lines to the log
+/// \param context_ Log
+/// \param begin_ First line
+/// \param end_ One past last line
+void logJob (void *const context_, std::size_t const begin_, std::size_t const end_)
+{
+	auto &log = *static_cast<imgui::LogBuffer *> (context_);
+	for (auto i = begin_; i < end_; ++i)
+		log.appendf ("[%6zu] frame %zu: worker line %zu", i, i / LOG_LINES, i % LOG_LINES);
+}
+
+/// \brief Log widget while jobs append to the log scene
+/// \param frame_ Frame number
+void sceneLogStream (unsigned const frame_)
+{
+	static imgui::LogBuffer log (1024);
+	static imgui::LogView view;
+
+	// producers keep appending while the log is drawn
+	jobs::Group group;
+	for (unsigned i = 0; i < LOG_PRODUCERS; ++i)
+		group.run (&logJob,
+		    &log,
+		    frame_ * LOG_LINES + i * LOG_LINES / LOG_PRODUCERS,
+		    frame_ * LOG_LINES + (i + 1) * LOG_LINES / LOG_PRODUCERS);
+
+	beginFullscreen ("Log");
+	ImGui::Text ("%llu lines, %zu kept", static_cast<unsigned long long> (log.end ()), log.capacity ());
+	view.draw ("##log", log, ImVec2 (-FLT_MIN, -FLT_MIN));
+	ImGui::End ();
+
+	group.wait ();
+}
+
+#ifdef IMGUI_ENABLE_DETACHED_DRAWLISTS
+/// \brief Number of canvases in canvas scenes
+constexpr unsigned CANVAS_COUNT = 8;
+/// \brief Samples per canvas waveform
+constexpr unsigned CANVAS_SAMPLES = 1024;
+
+/// \brief Custom-drawn canvas
+struct Canvas
+{
+	/// \brief Draw list to draw into
+	ImDrawList *drawList;
+	/// \brief Top-left corner
+	ImVec2 pos;
+	/// \brief Size
+	ImVec2 size;
+	/// \brief Waveform phase
+	unsigned phase;
+};
+
+/// \brief Canvases of the current frame
+Canvas s_canvases[CANVAS_COUNT];
+/// \brief Detached draw lists of the canvases
+/// \note Kept across frames so they don't regrow
+ImDrawList *s_canvasLists[CANVAS_COUNT] = {};
+
+/// \brief Draw canvas with a grid and a waveform
+/// \param canvas_ Canvas to draw
+void drawCanvas (Canvas const &canvas_)
+{
+	auto const drawList = canvas_.drawList;
+	auto const min      = canvas_.pos;
+	auto const max      = ImVec2 (min.x + canvas_.size.x, min.y + canvas_.size.y);
+
+	drawList->AddRectFilled (min, max, IM_COL32 (16, 16, 32, 255));
+	for (unsigned i = 1; i < 8; ++i)
+	{
+		auto const x = min.x + canvas_.size.x * i / 8.0f;
+		drawList->AddLine (ImVec2 (x, min.y), ImVec2 (x, max.y), IM_COL32 (64, 64, 96, 255));
+	}
+
+	ImVec2 points[CANVAS_SAMPLES];
+	auto const mid = (min.y + max.y) * 0.5f;
+	for (unsigned i = 0; i < CANVAS_SAMPLES; ++i)
+	{
+		auto const t = (i + canvas_.phase) * 0.02f;
+		points[i]    = ImVec2 (min.x + canvas_.size.x * i / (CANVAS_SAMPLES - 1),
+		                 mid + std::sin (t) * std::cos (t * 0.31f) * canvas_.size.y * 0.45f);
+	}
+	drawList->AddPolyline (points, CANVAS_SAMPLES, IM_COL32 (255, 200, 64, 255), 0, 1.5f);
+}
+
+/// \brief Job drawing a range of canvases
+/// \param context_ Unused
+/// \param begin_ First canvas
+/// \param end_ One past last canvas
+void canvasJob (void *const context_, std::size_t const begin_, std::size_t const end_)
+{
+	(void)context_;
+	for (auto i = begin_; i < end_; ++i)
+		drawCanvas (s_canvases[i]);
+}
+
+/// \brief Waveform canvases between widgets
+/// \param frame_ Frame number
+/// \param detached_ Whether canvases are drawn by jobs into detached draw lists
+void canvasScene (unsigned const frame_, bool const detached_)
+{
+	beginFullscreen ("Canvases");
+
+	jobs::Group group;
+	for (unsigned i = 0; i < CANVAS_COUNT; ++i)
+	{
+		ImGui::PushID (i);
+		ImGui::Text ("Canvas %u", i);
+
+		auto &canvas = s_canvases[i];
+		canvas.pos   = ImGui::GetCursorScreenPos ();
+		canvas.size  = ImVec2 (ImGui::GetContentRegionAvail ().x, 40.0f);
+		canvas.phase = frame_ * 4 + i * 97;
+		if (detached_)
+		{
+			if (!s_canvasLists[i])
+				s_canvasLists[i] = IM_NEW (ImDrawList) (ImGui::GetDrawListSharedData ());
+
+			// the UI thread carries on submitting widgets while a worker draws the canvas
+			canvas.drawList = s_canvasLists[i];
+			ImGui::AddDetachedDrawList (canvas.drawList);
+			group.run (&canvasJob, nullptr, i, i + 1);
+		}
+		else
+		{
+			canvas.drawList = ImGui::GetWindowDrawList ();
+			drawCanvas (canvas);
+		}
+		ImGui::Dummy (canvas.size);
+
+		ImGui::Button (IM_LITERAL ("Zoom"));
+		ImGui::SameLine ();
+		ImGui::Button (IM_LITERAL ("Pan"));
+		ImGui::SameLine ();
+		ImGui::Text ("%u samples", CANVAS_SAMPLES);
+		ImGui::PopID ();
+	}
+
+	// detached lists must be complete before Render
+	group.wait ();
+	ImGui::End ();
+}
+
+/// \brief Canvases drawn on the UI thread
+/// \param frame_ Frame number
+void sceneCanvasInline (unsigned const frame_)
+{
+	canvasScene (frame_, false);
+}
+
+/// \brief Canvases drawn by jobs
+/// \param frame_ Frame number
+void sceneCanvasDetached (unsigned const frame_)
+{
+	canvasScene (frame_, true);
+}
+#endif
+
+#ifdef IMGUI_ENABLE_LITERAL_IDS
+/// \brief Label rows in the label scenes
+constexpr unsigned LABEL_ROWS = 40;
+
+/// \brief Label as a string and as a compile-time hashed literal
+struct Label
+{
+	/// \brief Label string
+	char const *string;
+	/// \brief Same label hashed at compile time
+	ImGuiLiteral literal;
+};
+
+/// \brief Labels on either side of ImHashLiteral's direct hash limit, with and without "###"
+#define LABEL(str_) {str_, ImGuiLiteral (str_)}
+constexpr Label LABELS[] = {
+    LABEL ("Save"),
+    LABEL ("Enable vertical sync"),
+    LABEL ("Restore defaults###restore"),
+    LABEL ("Show the frame time graph below the main window"),
+    LABEL ("##hidden"),
+};
+#undef LABEL
+
+/// \brief Label-heavy scene
+/// \param literal_ Whether to pass the labels as literals hashed at compile time
+void labelsScene (bool const literal_)
+{
+	beginFullscreen ("Labels");
+
+	// the widgets sharing a label are told apart by an integer ID, which costs the same either way
+	static bool checked[LABEL_ROWS][std::size (LABELS)] = {};
+	auto const widgets = [] (auto const &label_, bool &checked_) {
+		ImGui::PushID (0);
+		ImGui::Button (label_);
+		ImGui::PopID ();
+		ImGui::SameLine ();
+		ImGui::PushID (1);
+		ImGui::Checkbox (label_, &checked_);
+		ImGui::PopID ();
+		ImGui::PushID (2);
+		ImGui::Selectable (label_, checked_);
+		ImGui::PopID ();
+	};
+
+	for (unsigned i = 0; i < LABEL_ROWS; ++i)
+	{
+		ImGui::PushID (i);
+		for (unsigned j = 0; j < std::size (LABELS); ++j)
+		{
+			if (literal_)
+				widgets (LABELS[j].literal, checked[i][j]);
+			else
+				widgets (LABELS[j].string, checked[i][j]);
+		}
+		ImGui::PopID ();
+	}
+
+	ImGui::End ();
+}
+
+/// \brief Labels hashed at compile time
+void sceneLabelsLiteral (unsigned)
+{
+	labelsScene (true);
+}
+
+/// \brief Labels hashed as strings
+void sceneLabelsString (unsigned)
+{
+	labelsScene (false);
+}
+#endif
+
+/// \brief Scenes
+constexpr Scene SCENES[] = {
+    {"text_latin", &sceneTextLatin, &scrollInput},
+    {"text_cjk", &sceneTextCJK, &scrollInput},
+    {"table_10k_rows", &sceneTableTall, &scrollInput},
+    {"table_wide", &sceneTableWide, &scrollInput},
+    {"table_layout_256", &sceneTableLayout, &scrollXInput},
+    {"table_sorted_50k_inline", &sceneTableSortedInline, &scrollInput},
+    {"table_sorted_50k_1w", &sceneTableSortedJobs, &scrollInput, 1},
+    {"table_sorted_50k_2w", &sceneTableSortedJobs, &scrollInput, 2},
+    {"table_sorted_50k_3w", &sceneTableSortedJobs, &scrollInput, 3},
+    {"table_sorted_50k_4w", &sceneTableSortedJobs, &scrollInput, 4},
+    {"tree_deep", &sceneTreeDeep, &scrollInput},
+    {"windows_overlap", &sceneWindows, &sweepInput},
+    {"windows_500", &sceneWindowsMany, &sweepInput},
+    {"plots", &scenePlots, &sweepInput},
+    {"color_pickers", &sceneColorPickers, &sweepInput},
+    {"input_text_120k", &sceneInputTextLarge, &typeInput},
+    {"text_editor_120k", &sceneTextEditorLarge, &typeInput},
+    {"box_select_100k", &sceneBoxSelectGrid, &boxSelectInput},
+#ifdef IMGUI_ENABLE_DETACHED_DRAWLISTS
+    {"canvas_inline", &sceneCanvasInline, &sweepInput},
+    {"canvas_detached_1w", &sceneCanvasDetached, &sweepInput, 1},
+    {"canvas_detached_2w", &sceneCanvasDetached, &sweepInput, 2},
+    {"canvas_detached_3w", &sceneCanvasDetached, &sweepInput, 3},
+    {"canvas_detached_4w", &sceneCanvasDetached, &sweepInput, 4},
+#endif
+#ifdef IMGUI_ENABLE_LITERAL_IDS
+    {"labels_literal", &sceneLabelsLiteral, &scrollInput},
+    {"labels_string", &sceneLabelsString, &scrollInput},
+#endif
+    {"log_stream", &sceneLogStream, &scrollInput},
+};
+}
+
+bool benchmark::run (char const *const path_, unsigned const frames_, RenderFunction const render_)
+{
+	auto const fp = std::fopen (path_, "w");
+	if (!fp)
+		return false;
+
+	std::fprintf (fp,
+	    "scene,frames,newframe_us,build_us,render_us,backend_us,vertices,indices,commands,"
+	    "allocs\n");
+
+	// chain a counting allocator in front of whatever is installed
+	ImGui::GetAllocatorFunctions (&s_allocFunc, &s_freeFunc, &s_allocUserData);
+	ImGui::SetAllocatorFunctions (&countingAlloc, &countingFree, nullptr);
+
+	auto &io        = ImGui::GetIO ();
+	auto const step = io.DeltaTime;
+
+	auto const poolWorkers = jobs::workerCount ();
+
+	for (auto const &scene : SCENES)
+	{
+		// scaling scenes run with a fixed number of workers, the others with the app's pool
+		setWorkers (scene.workers ? scene.workers : poolWorkers);
+
+		Totals totals{};
+		for (unsigned frame = 0; frame < frames_; ++frame)
+		{
+			io.DeltaTime = 1.0f / 60.0f;
+			scene.input (io, frame);
+
+			s_allocs = 0;
+
+			auto const t0 = now ();
+			ImGui::NewFrame ();
+			auto const t1 = now ();
+			scene.build (frame);
+			auto const t2 = now ();
+			ImGui::Render ();
+			auto const t3 = now ();
+
+			auto const drawData = ImGui::GetDrawData ();
+			if (render_)
+				render_ (drawData);
+			auto const t4 = now ();
+
+			totals.newFrame += t1 - t0;
+			totals.build += t2 - t1;
+			totals.render += t3 - t2;
+			totals.backend += t4 - t3;
+			totals.vertices += drawData->TotalVtxCount;
+			totals.indices += drawData->TotalIdxCount;
+			for (auto const &list : drawData->CmdLists)
+				totals.commands += list->CmdBuffer.Size;
+			totals.allocs += s_allocs;
+		}
+
+		// per-frame averages
+		auto const n = frames_ ? frames_ : 1;
+		std::fprintf (fp,
+		    "%s,%u,%llu,%llu,%llu,%llu,%llu,%llu,%llu,%llu\n",
+		    scene.name,
+		    frames_,
+		    static_cast<unsigned long long> (totals.newFrame / n),
+		    static_cast<unsigned long long> (totals.build / n),
+		    static_cast<unsigned long long> (totals.render / n),
+		    static_cast<unsigned long long> (totals.backend / n),
+		    static_cast<unsigned long long> (totals.vertices / n),
+		    static_cast<unsigned long long> (totals.indices / n),
+		    static_cast<unsigned long long> (totals.commands / n),
+		    static_cast<unsigned long long> (totals.allocs / n));
+	}
+
+	setWorkers (poolWorkers);
+
+#ifdef IMGUI_ENABLE_DETACHED_DRAWLISTS
+	for (auto &list : s_canvasLists)
+	{
+		IM_DELETE (list);
+		list = nullptr;
+	}
+#endif
+
+	ImGui::SetAllocatorFunctions (s_allocFunc, s_freeFunc, s_allocUserData);
+	io.DeltaTime = step;
+
+	return std::fclose (fp) == 0;
+}
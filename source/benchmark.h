@@ -0,0 +1,42 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+
+#pragma once
+
+#include "imgui/imgui.h"
+
+namespace benchmark
+{
+/// \brief Backend render hook
+/// \param drawData_ Draw data for the frame
+/// \note Everything the hook does is reported as backend time, including waiting on the GPU
+using RenderFunction = void (*) (ImDrawData *drawData_);
+
+/// \brief Run every scene with scripted input and write results
+/// \param path_ Output file (CSV, one row per scene)
+/// \param frames_ Frames to run per scene
+/// \param render_ Backend render, or nullptr to measure ImGui alone
+/// \note Needs a context with fonts built and DisplaySize set; drives NewFrame itself with a
+/// fixed time step so runs are reproducible
+bool run (char const *path_, unsigned frames_, RenderFunction render_);
+}
@@ -51,6 +51,33 @@
 //#define IMGUI_DISABLE_DEFAULT_FONT                        // Disable default embedded font (ProggyClean.ttf), remove ~9.5 KB from output binary. AddFontDefault() will assert.
 //#define IMGUI_DISABLE_SSE                                 // Disable use of SSE intrinsics even if available
 
+//---- Resolve hovered window through a coarse grid of window rects instead of testing every window (helps with many child windows/popups).
+//#define IMGUI_ENABLE_HOVER_GRID
+
+//---- Merge queued mouse moves and analog key changes which can't affect trickling, instead of queuing every one of them.
+//#define IMGUI_ENABLE_INPUT_COALESCING
+
+//---- Only re-sort g.Windows in EndFrame() when window order, active windows or child window order changed since last frame.
+//#define IMGUI_ENABLE_WINDOW_SORT_CACHE
+
+//---- Mirror the ImGuiWindow fields read by the per-frame loops over all windows (flags, rects, active/visible state) into a compact array parallel to g.Windows.
+//#define IMGUI_ENABLE_WINDOW_HOT_DATA
+
+//---- Reserve each window's draw list buffers once in Begin() from a decaying max of previous frames' vertex/index/command counts, and release excess capacity after a burst.
+//#define IMGUI_ENABLE_DRAWLIST_CAPACITY_PREDICTION
+
+//---- Compute box-select changes of items submitted through ImGuiListClipper from the clipper's index<>position mapping, emitting SetRange requests without submitting the items between the previous and current box.
+//#define IMGUI_ENABLE_BOX_SELECT_RANGES
+
+//---- Keep flags, right edge and horizontal clip range of table columns in per-field arrays, so the border loops over all columns don't load each ImGuiTableColumn.
+//#define IMGUI_ENABLE_TABLE_COLUMNS_SOA
+
+//---- Enable ImGui::AddDetachedDrawList(): splice a draw list filled by another thread into the current window, drawn at the point of the call without copying its vertices.
+//#define IMGUI_ENABLE_DETACHED_DRAWLISTS
+
+//---- Enable ImGuiLiteral overloads of PushID()/GetID() and common widgets, hashing string literal labels at compile time (requires C++20 consteval).
+//#define IMGUI_ENABLE_LITERAL_IDS
+
 //---- Enable Test Engine / Automation features.
 //#define IMGUI_ENABLE_TEST_ENGINE                          // Enable imgui_test_engine hooks. Generally set automatically by include "imgui_te_config.h", see Test Engine for details.
 
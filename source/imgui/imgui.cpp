@@ -1167,6 +1167,10 @@ static const float WINDOWS_HOVER_PADDING                    = 4.0f;     // Exten
 static const float WINDOWS_RESIZE_FROM_EDGES_FEEDBACK_TIMER = 0.04f;    // Reduce visual noise by only highlighting the border after a certain time.
 static const float WINDOWS_MOUSE_WHEEL_SCROLL_LOCK_TIMER    = 0.70f;    // Lock scrolled window (so it doesn't pick child windows that are scrolling through) for a certain time, unless mouse moved.
 
+// Hover grid (when IMGUI_ENABLE_HOVER_GRID is defined)
+static const float WINDOWS_HOVER_GRID_CELL_SIZE             = 32.0f;    // Smallest cell size. Roughly the size of a small child window.
+static const int   WINDOWS_HOVER_GRID_MAX_CELLS             = 64;       // Cells are enlarged past this count per axis.
+
 // Tooltip offset
 static const ImVec2 TOOLTIP_DEFAULT_OFFSET_MOUSE = ImVec2(16, 10);      // Multiplied by g.Style.MouseCursorScale
 static const ImVec2 TOOLTIP_DEFAULT_OFFSET_TOUCH = ImVec2(0, -20);      // Multiplied by g.Style.MouseCursorScale
@@ -1181,6 +1185,10 @@ static ImGuiWindow*     CreateNewWindow(const char* name, ImGuiWindowFlags flags
 static ImVec2           CalcNextScrollFromScrollTargetAndClamp(ImGuiWindow* window);
 
 static void             AddWindowToSortBuffer(ImVector<ImGuiWindow*>* out_sorted_windows, ImGuiWindow* window);
+#ifdef IMGUI_ENABLE_WINDOW_HOT_DATA
+static void             UpdateWindowHotData(ImGuiWindow* window);
+static void             UpdateWindowsHotDataRange(int n_begin, int n_end);
+#endif
 
 // Settings
 static void             WindowSettingsHandler_ClearAll(ImGuiContext*, ImGuiSettingsHandler*);
@@ -1281,6 +1289,12 @@ static void             UpdateViewportsNewFrame();
 ImGuiContext*   GImGui = NULL;
 #endif
 
+#if defined(IMGUI_ENABLE_DETACHED_DRAWLISTS) && !defined(IMGUI_DISABLE_DEBUG_TOOLS)
+// Context whose frames run on this thread. Allocations from other threads (e.g. workers filling detached draw lists)
+// are only counted atomically, as DebugAllocHook() writes DebugAllocInfo without synchronization.
+static thread_local ImGuiContext* GImGuiFrameThreadContext = NULL;
+#endif
+
 // Memory Allocator functions. Use SetAllocatorFunctions() to change them.
 // - You probably don't want to modify that mid-program, and if you use global/static e.g. ImVector<> instances you may need to keep them accessible during program destruction.
 // - DLL users: read comments above.
@@ -1606,6 +1620,42 @@ static ImGuiInputEvent* FindLatestInputEvent(ImGuiContext* ctx, ImGuiInputEventT
     return NULL;
 }
 
+#ifdef IMGUI_ENABLE_INPUT_COALESCING
+// Whether queued key event n presses or releases its key, rather than only changing its analog value
+static bool IsKeyInputEventDownChange(ImGuiContext* ctx, int n)
+{
+    ImGuiContext& g = *ctx;
+    const ImGuiInputEvent* e = &g.InputEventsQueue[n];
+    for (int prev_n = n - 1; prev_n >= 0; prev_n--)
+    {
+        const ImGuiInputEvent* prev = &g.InputEventsQueue[prev_n];
+        if (prev->Type == ImGuiInputEventType_Key && prev->Key.Key == e->Key.Key)
+            return prev->Key.Down != e->Key.Down;
+    }
+    return ImGui::GetKeyData(ctx, e->Key.Key)->Down != e->Key.Down;
+}
+
+// Find latest queued event of given type that a new event may be merged into.
+// Merging is only allowed when no mouse button, wheel, text or focus event was queued after it, as those are the events trickling
+// splits frames on: merging across them would move a click, scroll or character relative to the pointer or key state.
+// Mouse moves additionally stop at key presses and releases, which UpdateInputEvents() also keeps in a frame before a later mouse move.
+static ImGuiInputEvent* FindCoalescableInputEvent(ImGuiContext* ctx, ImGuiInputEventType type, int arg = -1)
+{
+    ImGuiContext& g = *ctx;
+    for (int n = g.InputEventsQueue.Size - 1; n >= 0; n--)
+    {
+        ImGuiInputEvent* e = &g.InputEventsQueue[n];
+        if (e->Type == type && (type != ImGuiInputEventType_Key || e->Key.Key == arg))
+            return e;
+        if (e->Type == ImGuiInputEventType_MouseButton || e->Type == ImGuiInputEventType_MouseWheel || e->Type == ImGuiInputEventType_Text || e->Type == ImGuiInputEventType_Focus)
+            return NULL;
+        if (type == ImGuiInputEventType_MousePos && e->Type == ImGuiInputEventType_Key && IsKeyInputEventDownChange(ctx, n))
+            return NULL;
+    }
+    return NULL;
+}
+#endif
+
 // Queue a new key down/up event.
 // - ImGuiKey key:       Translated key (as in, generally ImGuiKey_A matches the key end-user would use to emit an 'A' character)
 // - bool down:          Is the key down? use false to signify a key release.
@@ -1639,7 +1689,21 @@ void ImGuiIO::AddKeyAnalogEvent(ImGuiKey key, bool down, float analog_value)
     const bool latest_key_down = latest_event ? latest_event->Key.Down : key_data->Down;
     const float latest_key_analog = latest_event ? latest_event->Key.AnalogValue : key_data->AnalogValue;
     if (latest_key_down == down && latest_key_analog == analog_value)
+    {
+        g.InputEventsDroppedCount++;
         return;
+    }
+
+#ifdef IMGUI_ENABLE_INPUT_COALESCING
+    // Coalesce analog changes which don't press or release the key into the queued event
+    if (ImGuiInputEvent* coalesce_event = FindCoalescableInputEvent(&g, ImGuiInputEventType_Key, (int)key))
+        if (coalesce_event->Key.Down == down)
+        {
+            coalesce_event->Key.AnalogValue = analog_value;
+            g.InputEventsDroppedCount++;
+            return;
+        }
+#endif
 
     // Add event
     ImGuiInputEvent e;
@@ -1695,7 +1759,22 @@ void ImGuiIO::AddMousePosEvent(float x, float y)
     const ImGuiInputEvent* latest_event = FindLatestInputEvent(&g, ImGuiInputEventType_MousePos);
     const ImVec2 latest_pos = latest_event ? ImVec2(latest_event->MousePos.PosX, latest_event->MousePos.PosY) : g.IO.MousePos;
     if (latest_pos.x == pos.x && latest_pos.y == pos.y)
+    {
+        g.InputEventsDroppedCount++;
         return;
+    }
+
+#ifdef IMGUI_ENABLE_INPUT_COALESCING
+    // Coalesce consecutive moves from the same source: only the latest position matters until a button changes
+    if (ImGuiInputEvent* coalesce_event = FindCoalescableInputEvent(&g, ImGuiInputEventType_MousePos))
+        if (coalesce_event->MousePos.MouseSource == g.InputEventsNextMouseSource)
+        {
+            coalesce_event->MousePos.PosX = pos.x;
+            coalesce_event->MousePos.PosY = pos.y;
+            g.InputEventsDroppedCount++;
+            return;
+        }
+#endif
 
     ImGuiInputEvent e;
     e.Type = ImGuiInputEventType_MousePos;
@@ -1728,7 +1807,10 @@ void ImGuiIO::AddMouseButtonEvent(int mouse_button, bool down)
     const ImGuiInputEvent* latest_event = FindLatestInputEvent(&g, ImGuiInputEventType_MouseButton, (int)mouse_button);
     const bool latest_button_down = latest_event ? latest_event->MouseButton.Down : g.IO.MouseDown[mouse_button];
     if (latest_button_down == down)
+    {
+        g.InputEventsDroppedCount++;
         return;
+    }
 
     // On MacOS X: Convert Ctrl(Super)+Left click into Right-click.
     // - Note that this is actual physical Ctrl which is ImGuiMod_Super for us.
@@ -2267,6 +2349,42 @@ ImGuiID ImHashStr(const char* data_p, size_t data_size, ImGuiID seed)
     return ~crc;
 }
 
+#ifdef IMGUI_ENABLE_LITERAL_IDS
+// Hash of a compile-time literal, == ImHashStr(lit.Str, 0, seed).
+// CRC is linear: the register after hashing from state 'S' == (S * x^(8*len) mod P) ^ (register after hashing from 0).
+// The constructor precomputed both terms, so we only need a 32-step carryless multiply-mod (same as zlib's crc32_combine()).
+// Short literals are cheaper to hash directly, which we can still do without scanning for "###" or the terminator.
+ImGuiID ImHashLiteral(const ImGuiLiteral& lit, ImGuiID seed)
+{
+    const int LITERAL_DIRECT_HASH_MAX_LEN = 32;
+    ImU32 crc = ~seed;
+    if (lit.HashLen <= LITERAL_DIRECT_HASH_MAX_LEN)
+    {
+        const unsigned char* data = (const unsigned char*)lit.HashStr;
+        const unsigned char* data_end = data + lit.HashLen;
+#ifndef IMGUI_ENABLE_SSE4_2_CRC
+        const ImU32* crc32_lut = GCrc32LookupTable;
+        while (data < data_end)
+            crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ *data++];
+#else
+        while (data < data_end)
+            crc = _mm_crc32_u8(crc, *data++);
+#endif
+        return ~crc;
+    }
+
+    // Multiply seed register by HashShift, walking HashShift from its x^0 (top) bit.
+    ImU32 shift = lit.HashShift;
+    ImU32 product = 0;
+    for (; shift != 0; shift <<= 1)
+    {
+        product ^= crc & (0u - (shift >> 31));
+        crc = (crc >> 1) ^ (ImGuiLiteral::CrcPoly & (0u - (crc & 1)));
+    }
+    return ~(product ^ lit.HashCrc);
+}
+#endif
+
 //-----------------------------------------------------------------------------
 // [SECTION] MISC HELPERS/UTILITIES (File functions)
 //-----------------------------------------------------------------------------
@@ -3052,6 +3170,9 @@ void ImGuiListClipper::Begin(int items_count, float items_height)
         g.ClipperTempData.resize(g.ClipperTempDataStacked, ImGuiListClipperData());
     ImGuiListClipperData* data = &g.ClipperTempData[g.ClipperTempDataStacked - 1];
     data->Reset(this);
+#ifdef IMGUI_ENABLE_BOX_SELECT_RANGES
+    data->BoxSelectRangesAdded = false;
+#endif
     data->LossynessOffset = window->DC.CursorStartPosLossyness.y;
     TempData = data;
     StartSeekOffsetY = data->LossynessOffset;
@@ -3192,7 +3313,16 @@ static bool ImGuiListClipper_StepInternal(ImGuiListClipper* clipper)
 
             // Add box selection range
             ImGuiBoxSelectState* bs = &g.BoxSelectState;
-            if (bs->IsActive && bs->Window == window)
+            bool box_select_unclip = (bs->IsActive && bs->Window == window);
+#ifdef IMGUI_ENABLE_BOX_SELECT_RANGES
+            // Emit changes of items between previous and current box from item indices, so only visible items need to be submitted.
+            if (box_select_unclip && g.CurrentMultiSelect != NULL && data->ItemsFrozen == 0 && ImGui::MultiSelectAddBoxSelectRanges(g.CurrentMultiSelect, clipper))
+            {
+                data->BoxSelectRangesAdded = true;
+                box_select_unclip = false;
+            }
+#endif
+            if (box_select_unclip)
             {
                 // FIXME: Selectable() use of half-ItemSpacing isn't consistent in matter of layout, as ItemAdd(bb) stray above ItemSize()'s CursorPos.
                 // RangeSelect's BoxSelect relies on comparing overlap of previous and current rectangle and is sensitive to that.
@@ -3890,8 +4020,11 @@ ImGuiContext::ImGuiContext(ImFontAtlas* shared_font_atlas)
 
     InputEventsNextMouseSource = ImGuiMouseSource_Mouse;
     InputEventsNextEventId = 1;
+    InputEventsDroppedCount = 0;
 
     WindowsActiveCount = 0;
+    WindowsActiveCountPrev = 0;
+    WindowsSortDirty = true;
     CurrentWindow = NULL;
     HoveredWindow = NULL;
     HoveredWindowUnderMovingWindow = NULL;
@@ -4069,6 +4202,10 @@ ImGuiContext::ImGuiContext(ImFontAtlas* shared_font_atlas)
     DebugItemPickerMouseButton = ImGuiMouseButton_Left;
     DebugItemPickerBreakId = 0;
     DebugFlashStyleColorTime = 0.0f;
+#ifdef IMGUI_ENABLE_DETACHED_DRAWLISTS
+    DebugAllocOtherThreadAllocCount = 0;
+    DebugAllocOtherThreadFreeCount = 0;
+#endif
     DebugFlashStyleColorIdx = ImGuiCol_COUNT;
 
     // Same as DebugBreakClearData(). Those fields are scattered in their respective subsystem to stay in hot-data locations
@@ -4089,6 +4226,9 @@ void ImGui::Initialize()
 {
     ImGuiContext& g = *GImGui;
     IM_ASSERT(!g.Initialized && !g.SettingsLoaded);
+#if defined(IMGUI_ENABLE_DETACHED_DRAWLISTS) && !defined(IMGUI_DISABLE_DEBUG_TOOLS)
+    GImGuiFrameThreadContext = &g;
+#endif
 
     // Add .ini handle for ImGuiWindow and ImGuiTable types
     {
@@ -4161,8 +4301,12 @@ void ImGui::Shutdown()
 
     // Clear everything else
     g.Windows.clear_delete();
+#ifdef IMGUI_ENABLE_WINDOW_HOT_DATA
+    g.WindowsHot.clear();
+#endif
     g.WindowsFocusOrder.clear();
     g.WindowsTempSortBuffer.clear();
+    g.WindowsChildSortPending.clear();
     g.CurrentWindow = NULL;
     g.CurrentWindowStack.clear();
     g.WindowsById.Clear();
@@ -4266,6 +4410,9 @@ ImGuiWindow::ImGuiWindow(ImGuiContext* ctx, const char* name) : DrawListInst(NUL
     ScrollTarget = ImVec2(FLT_MAX, FLT_MAX);
     ScrollTargetCenterRatio = ImVec2(0.5f, 0.5f);
     AutoFitFramesX = AutoFitFramesY = -1;
+#ifdef IMGUI_ENABLE_WINDOW_HOT_DATA
+    DisplayIndex = -1;
+#endif
     AutoPosLastDirection = ImGuiDir_None;
     SetWindowPosAllowFlags = SetWindowSizeAllowFlags = SetWindowCollapsedAllowFlags = 0;
     SetWindowPosVal = SetWindowPosPivot = ImVec2(FLT_MAX, FLT_MAX);
@@ -4279,8 +4426,30 @@ ImGuiWindow::ImGuiWindow(ImGuiContext* ctx, const char* name) : DrawListInst(NUL
     NavPreferredScoringPosRel[0] = NavPreferredScoringPosRel[1] = ImVec2(FLT_MAX, FLT_MAX);
 }
 
+#ifdef IMGUI_ENABLE_DETACHED_DRAWLISTS
+// Point DrawList back to DrawListInst and forget splices. Detached lists are owned by the user.
+static void ClearWindowDetachedDrawLists(ImGuiWindow* window, bool free_memory)
+{
+    if (window->DrawListsDetached.Size > 0 && window->DrawList != NULL)
+    {
+        IM_ASSERT(window->DrawList == window->DrawListsContinued[window->DrawListsDetached.Size - 1]);
+        window->DrawList = &window->DrawListInst;
+    }
+    window->DrawListsDetached.resize(0);
+    if (!free_memory)
+        return;
+    for (ImDrawList* draw_list : window->DrawListsContinued)
+        IM_DELETE(draw_list);
+    window->DrawListsDetached.clear();
+    window->DrawListsContinued.clear();
+}
+#endif
+
 ImGuiWindow::~ImGuiWindow()
 {
+#ifdef IMGUI_ENABLE_DETACHED_DRAWLISTS
+    ClearWindowDetachedDrawLists(this, true);
+#endif
     IM_ASSERT(DrawList == &DrawListInst);
     IM_DELETE(Name);
     ColumnsStorage.clear_destruct();
@@ -4318,6 +4487,12 @@ void ImGui::GcCompactTransientMiscBuffers()
 void ImGui::GcCompactTransientWindowBuffers(ImGuiWindow* window)
 {
     window->MemoryCompacted = true;
+#ifdef IMGUI_ENABLE_WINDOW_HOT_DATA
+    UpdateWindowHotData(window);
+#endif
+#ifdef IMGUI_ENABLE_DETACHED_DRAWLISTS
+    ClearWindowDetachedDrawLists(window, true);
+#endif
     window->MemoryDrawListIdxCapacity = window->DrawList->IdxBuffer.Capacity;
     window->MemoryDrawListVtxCapacity = window->DrawList->VtxBuffer.Capacity;
     window->IDStack.clear();
@@ -4332,11 +4507,58 @@ void ImGui::GcAwakeTransientWindowBuffers(ImGuiWindow* window)
     // We stored capacity of the ImDrawList buffer to reduce growth-caused allocation/copy when awakening.
     // The other buffers tends to amortize much faster.
     window->MemoryCompacted = false;
+#ifdef IMGUI_ENABLE_WINDOW_HOT_DATA
+    UpdateWindowHotData(window);
+#endif
     window->DrawList->IdxBuffer.reserve(window->MemoryDrawListIdxCapacity);
     window->DrawList->VtxBuffer.reserve(window->MemoryDrawListVtxCapacity);
     window->MemoryDrawListIdxCapacity = window->MemoryDrawListVtxCapacity = 0;
 }
 
+#ifdef IMGUI_ENABLE_DRAWLIST_CAPACITY_PREDICTION
+// Grow 'buf' to the predicted size in one go, or release its excess capacity once it is well above the prediction (e.g. after a burst).
+// The 4x + slack margin bounds how often we shrink: a list hovering around its prediction never reallocates, and a list which bursts
+// again within ~44 frames (time for the prediction to decay to a quarter) keeps its capacity.
+template<typename T>
+static void ReserveDrawListBuffer(ImVector<T>& buf, int predicted_size)
+{
+    if (buf.Capacity > predicted_size * 4 + 256)
+    {
+        ImVector<T> shrunk;
+        shrunk.reserve(ImMax(predicted_size, buf.Size));
+        shrunk.resize(buf.Size);
+        if (buf.Size > 0)
+            memcpy(shrunk.Data, buf.Data, (size_t)buf.size_in_bytes());
+        buf.swap(shrunk);
+    }
+    else
+    {
+        buf.reserve(predicted_size);
+    }
+}
+#endif
+
+// Called on the first Begin() of the frame. With IMGUI_ENABLE_DRAWLIST_CAPACITY_PREDICTION, the list still holds last frame's output when we get here:
+// fold its sizes into a max decaying by 1/32th per frame, then reserve for it once.
+static void ResetWindowDrawListForNewFrame(ImGuiWindow* window)
+{
+#ifdef IMGUI_ENABLE_DETACHED_DRAWLISTS
+    ClearWindowDetachedDrawLists(window, false);
+#endif
+    ImDrawList* draw_list = window->DrawList;
+#ifdef IMGUI_ENABLE_DRAWLIST_CAPACITY_PREDICTION
+    window->DrawListPredictedCmdCount = ImMax(draw_list->CmdBuffer.Size, window->DrawListPredictedCmdCount - window->DrawListPredictedCmdCount / 32);
+    window->DrawListPredictedIdxCount = ImMax(draw_list->IdxBuffer.Size, window->DrawListPredictedIdxCount - window->DrawListPredictedIdxCount / 32);
+    window->DrawListPredictedVtxCount = ImMax(draw_list->VtxBuffer.Size, window->DrawListPredictedVtxCount - window->DrawListPredictedVtxCount / 32);
+#endif
+    draw_list->_ResetForNewFrame();
+#ifdef IMGUI_ENABLE_DRAWLIST_CAPACITY_PREDICTION
+    ReserveDrawListBuffer(draw_list->CmdBuffer, window->DrawListPredictedCmdCount);
+    ReserveDrawListBuffer(draw_list->IdxBuffer, window->DrawListPredictedIdxCount);
+    ReserveDrawListBuffer(draw_list->VtxBuffer, window->DrawListPredictedVtxCount);
+#endif
+}
+
 void ImGui::SetActiveID(ImGuiID id, ImGuiWindow* window)
 {
     ImGuiContext& g = *GImGui;
@@ -4718,7 +4940,14 @@ void* ImGui::MemAlloc(size_t size)
     void* ptr = (*GImAllocatorAllocFunc)(size, GImAllocatorUserData);
 #ifndef IMGUI_DISABLE_DEBUG_TOOLS
     if (ImGuiContext* ctx = GImGui)
+    {
+#ifdef IMGUI_ENABLE_DETACHED_DRAWLISTS
+        if (ctx != GImGuiFrameThreadContext)
+            ctx->DebugAllocOtherThreadAllocCount.fetch_add(1, std::memory_order_relaxed);
+        else
+#endif
         DebugAllocHook(&ctx->DebugAllocInfo, ctx->FrameCount, ptr, size);
+    }
 #endif
     return ptr;
 }
@@ -4729,7 +4958,14 @@ void ImGui::MemFree(void* ptr)
 #ifndef IMGUI_DISABLE_DEBUG_TOOLS
     if (ptr != NULL)
         if (ImGuiContext* ctx = GImGui)
+        {
+#ifdef IMGUI_ENABLE_DETACHED_DRAWLISTS
+            if (ctx != GImGuiFrameThreadContext)
+                ctx->DebugAllocOtherThreadFreeCount.fetch_add(1, std::memory_order_relaxed);
+            else
+#endif
             DebugAllocHook(&ctx->DebugAllocInfo, ctx->FrameCount, ptr, (size_t)-1);
+        }
 #endif
     return (*GImAllocatorFreeFunc)(ptr, GImAllocatorUserData);
 }
@@ -5113,6 +5349,15 @@ void ImGui::NewFrame()
     // Load settings on first frame, save settings when modified (after a delay)
     UpdateSettings();
 
+#if defined(IMGUI_ENABLE_DETACHED_DRAWLISTS) && !defined(IMGUI_DISABLE_DEBUG_TOOLS)
+    // Count allocations other threads made during the previous frame in it, and take this thread as the frame thread
+    GImGuiFrameThreadContext = &g;
+    for (int n = g.DebugAllocOtherThreadAllocCount.exchange(0, std::memory_order_relaxed); n > 0; n--)
+        DebugAllocHook(&g.DebugAllocInfo, g.FrameCount, NULL, 0);
+    for (int n = g.DebugAllocOtherThreadFreeCount.exchange(0, std::memory_order_relaxed); n > 0; n--)
+        DebugAllocHook(&g.DebugAllocInfo, g.FrameCount, NULL, (size_t)-1);
+#endif
+
     g.Time += g.IO.DeltaTime;
     g.WithinFrameScope = true;
     g.FrameCount += 1;
@@ -5256,8 +5501,24 @@ void ImGui::NewFrame()
     // Mark all windows as not visible and compact unused memory.
     IM_ASSERT(g.WindowsFocusOrder.Size <= g.Windows.Size);
     const float memory_compact_start_time = (g.GcCompactAll || g.IO.ConfigMemoryCompactTimer < 0.0f) ? FLT_MAX : (float)g.Time - g.IO.ConfigMemoryCompactTimer;
+#ifdef IMGUI_ENABLE_WINDOW_HOT_DATA
+    for (ImGuiWindowHotData& hot : g.WindowsHot)
+    {
+        // Windows not submitted since the previous frame had their per-frame state reset then: only their hot data is needed.
+        // (the implicit "Debug" window is deactivated in EndFrame() after being begun, so it also needs its BeginCount reset)
+        if (!hot.Active && !hot.WasActive && !hot.Begun)
+        {
+            if (!hot.MemoryCompacted && hot.LastTimeActive < memory_compact_start_time)
+                GcCompactTransientWindowBuffers(hot.Window);
+            continue;
+        }
+        hot.WasActive = hot.Active;
+        hot.Active = hot.Begun = false;
+        ImGuiWindow* window = hot.Window;
+#else
     for (ImGuiWindow* window : g.Windows)
     {
+#endif
         window->WasActive = window->Active;
         window->Active = false;
         window->WriteAccessed = false;
@@ -5394,7 +5655,17 @@ static void AddWindowToDrawData(ImGuiWindow* window, int layer)
     g.IO.MetricsRenderWindows++;
     if (window->DrawList->_Splitter._Count > 1)
         window->DrawList->ChannelsMerge(); // Merge if user forgot to merge back. Also required in Docking branch for ImGuiWindowFlags_DockNodeHost windows.
+#ifdef IMGUI_ENABLE_DETACHED_DRAWLISTS
+    // Spliced lists go in between the parts of the window's own output, instead of being copied into it
+    ImGui::AddDrawListToDrawDataEx(&viewport->DrawDataP, viewport->DrawDataBuilder.Layers[layer], &window->DrawListInst);
+    for (int n = 0; n < window->DrawListsDetached.Size; n++)
+    {
+        ImGui::AddDrawListToDrawDataEx(&viewport->DrawDataP, viewport->DrawDataBuilder.Layers[layer], window->DrawListsDetached[n]);
+        ImGui::AddDrawListToDrawDataEx(&viewport->DrawDataP, viewport->DrawDataBuilder.Layers[layer], window->DrawListsContinued[n]);
+    }
+#else
     ImGui::AddDrawListToDrawDataEx(&viewport->DrawDataP, viewport->DrawDataBuilder.Layers[layer], window->DrawList);
+#endif
     for (ImGuiWindow* child : window->DC.ChildWindows)
         if (IsWindowActiveAndVisible(child)) // Clipped children may have been marked not active
             AddWindowToDrawData(child, layer);
@@ -5483,7 +5754,11 @@ static void ImGui::RenderDimmedBackgroundBehindWindow(ImGuiWindow* window, ImU32
         // We've already called AddWindowToDrawData() which called DrawList->ChannelsMerge() on DockNodeHost windows,
         // and draw list have been trimmed already, hence the explicit recreation of a draw command if missing.
         // FIXME: This is creating complication, might be simpler if we could inject a drawlist in drawdata at a given position and not attempt to manipulate ImDrawCmd order.
+#ifdef IMGUI_ENABLE_DETACHED_DRAWLISTS
+        ImDrawList* draw_list = &window->RootWindow->DrawListInst; // Front of the first part when the window has spliced lists
+#else
         ImDrawList* draw_list = window->RootWindow->DrawList;
+#endif
         if (draw_list->CmdBuffer.Size == 0)
             draw_list->AddDrawCmd();
         draw_list->PushClipRect(viewport_rect.Min - ImVec2(1, 1), viewport_rect.Max + ImVec2(1, 1), false); // FIXME: Need to stricty ensure ImDrawCmd are not merged (ElemCount==6 checks below will verify that)
@@ -5583,7 +5858,14 @@ void ImGui::EndFrame()
     // Hide implicit/fallback "Debug" window if it hasn't been used
     g.WithinFrameScopeWithImplicitWindow = false;
     if (g.CurrentWindow && !g.CurrentWindow->WriteAccessed)
+    {
         g.CurrentWindow->Active = false;
+#ifdef IMGUI_ENABLE_WINDOW_HOT_DATA
+        UpdateWindowHotData(g.CurrentWindow);
+#endif
+    }
+    if (g.CurrentWindow && g.CurrentWindow->Active != g.CurrentWindow->WasActive)
+        g.WindowsSortDirty = true;
     End();
 
     // Update navigation: CTRL+Tab, wrap-around requests
@@ -5619,18 +5901,58 @@ void ImGui::EndFrame()
 
     // Sort the window list so that all child windows are after their parent
     // We cannot do that on FocusWindow() because children may not exist yet
-    g.WindowsTempSortBuffer.resize(0);
-    g.WindowsTempSortBuffer.reserve(g.Windows.Size);
-    for (ImGuiWindow* window : g.Windows)
-    {
-        if (window->Active && (window->Flags & ImGuiWindowFlags_ChildWindow))       // if a child is active its parent will add it
-            continue;
-        AddWindowToSortBuffer(&g.WindowsTempSortBuffer, window);
+#ifdef IMGUI_ENABLE_WINDOW_SORT_CACHE
+    // The result only depends on g.Windows order, which windows are active and the order children were submitted in.
+    // When none of them changed since last frame, g.Windows is still sorted and only some DC.ChildWindows[] may need sorting.
+    if (g.WindowsActiveCount != g.WindowsActiveCountPrev)
+        g.WindowsSortDirty = true;
+    g.WindowsActiveCountPrev = g.WindowsActiveCount;
+    if (!g.WindowsSortDirty)
+    {
+        // Same children as last frame, but they were submitted out of sorted order
+        for (ImGuiWindow* window : g.WindowsChildSortPending)
+            ImQsort(window->DC.ChildWindows.Data, (size_t)window->DC.ChildWindows.Size, sizeof(ImGuiWindow*), ChildWindowComparer);
     }
+    else
+#endif
+    {
+        g.WindowsSortDirty = false;
+        g.WindowsTempSortBuffer.resize(0);
+        g.WindowsTempSortBuffer.reserve(g.Windows.Size);
+#ifdef IMGUI_ENABLE_WINDOW_HOT_DATA
+        for (const ImGuiWindowHotData& hot : g.WindowsHot)
+        {
+            if (hot.Active && (hot.Flags & ImGuiWindowFlags_ChildWindow))               // if a child is active its parent will add it
+                continue;
+            AddWindowToSortBuffer(&g.WindowsTempSortBuffer, hot.Window);
+        }
+#else
+        for (ImGuiWindow* window : g.Windows)
+        {
+            if (window->Active && (window->Flags & ImGuiWindowFlags_ChildWindow))       // if a child is active its parent will add it
+                continue;
+            AddWindowToSortBuffer(&g.WindowsTempSortBuffer, window);
+        }
+#endif
 
-    // This usually assert if there is a mismatch between the ImGuiWindowFlags_ChildWindow / ParentWindow values and DC.ChildWindows[] in parents, aka we've done something wrong.
-    IM_ASSERT(g.Windows.Size == g.WindowsTempSortBuffer.Size);
-    g.Windows.swap(g.WindowsTempSortBuffer);
+        // This usually assert if there is a mismatch between the ImGuiWindowFlags_ChildWindow / ParentWindow values and DC.ChildWindows[] in parents, aka we've done something wrong.
+        IM_ASSERT(g.Windows.Size == g.WindowsTempSortBuffer.Size);
+#ifdef IMGUI_ENABLE_HOVER_GRID
+        if (memcmp(g.Windows.Data, g.WindowsTempSortBuffer.Data, (size_t)g.Windows.Size * sizeof(ImGuiWindow*)) != 0)
+            g.WindowsHoverGrid.Dirty = true;
+#endif
+        g.Windows.swap(g.WindowsTempSortBuffer);
+#ifdef IMGUI_ENABLE_WINDOW_HOT_DATA
+        // Only resync the span of g.Windows[] that the sort moved (usually empty)
+        int hot_begin = 0, hot_end = g.Windows.Size;
+        while (hot_begin < hot_end && g.WindowsHot[hot_begin].Window == g.Windows[hot_begin])
+            hot_begin++;
+        while (hot_end > hot_begin && g.WindowsHot[hot_end - 1].Window == g.Windows[hot_end - 1])
+            hot_end--;
+        UpdateWindowsHotDataRange(hot_begin, hot_end);
+#endif
+    }
+    g.WindowsChildSortPending.resize(0);
     g.IO.MetricsActiveWindows = g.WindowsActiveCount;
 
     // Unlock font atlas
@@ -5677,12 +5999,18 @@ void ImGui::Render()
     ImGuiWindow* windows_to_render_top_most[2];
     windows_to_render_top_most[0] = (g.NavWindowingTarget && !(g.NavWindowingTarget->Flags & ImGuiWindowFlags_NoBringToFrontOnFocus)) ? g.NavWindowingTarget->RootWindow : NULL;
     windows_to_render_top_most[1] = (g.NavWindowingTarget ? g.NavWindowingListWindow : NULL);
+#ifdef IMGUI_ENABLE_WINDOW_HOT_DATA
+    for (const ImGuiWindowHotData& hot : g.WindowsHot)
+        if (hot.Active && !hot.Hidden && (hot.Flags & ImGuiWindowFlags_ChildWindow) == 0 && hot.Window != windows_to_render_top_most[0] && hot.Window != windows_to_render_top_most[1])
+            AddRootWindowToDrawData(hot.Window);
+#else
     for (ImGuiWindow* window : g.Windows)
     {
         IM_MSVC_WARNING_SUPPRESS(6011); // Static Analysis false positive "warning C6011: Dereferencing NULL pointer 'window'"
         if (IsWindowActiveAndVisible(window) && (window->Flags & ImGuiWindowFlags_ChildWindow) == 0 && window != windows_to_render_top_most[0] && window != windows_to_render_top_most[1])
             AddRootWindowToDrawData(window);
     }
+#endif
     for (int n = 0; n < IM_ARRAYSIZE(windows_to_render_top_most); n++)
         if (windows_to_render_top_most[n] && IsWindowActiveAndVisible(windows_to_render_top_most[n])) // NavWindowingTarget is always temporarily displayed as the top-most window
             AddRootWindowToDrawData(windows_to_render_top_most[n]);
@@ -5692,7 +6020,7 @@ void ImGui::Render()
         RenderMouseCursor(g.IO.MousePos, g.Style.MouseCursorScale, g.MouseCursor, IM_COL32_WHITE, IM_COL32_BLACK, IM_COL32(0, 0, 0, 48));
 
     // Setup ImDrawData structures for end-user
-    g.IO.MetricsRenderVertices = g.IO.MetricsRenderIndices = 0;
+    g.IO.MetricsRenderVertices = g.IO.MetricsRenderIndices = g.IO.MetricsRenderReallocations = 0;
     for (ImGuiViewportP* viewport : g.Viewports)
     {
         FlattenDrawDataIntoSingleLayer(&viewport->DrawDataBuilder);
@@ -5705,7 +6033,12 @@ void ImGui::Render()
         ImDrawData* draw_data = &viewport->DrawDataP;
         IM_ASSERT(draw_data->CmdLists.Size == draw_data->CmdListsCount);
         for (ImDrawList* draw_list : draw_data->CmdLists)
+        {
             draw_list->_PopUnusedDrawCmd();
+#ifdef IMGUI_ENABLE_DRAWLIST_CAPACITY_PREDICTION
+            g.IO.MetricsRenderReallocations += draw_list->_GrowCount;
+#endif
+        }
 
         g.IO.MetricsRenderVertices += draw_data->TotalVtxCount;
         g.IO.MetricsRenderIndices += draw_data->TotalIdxCount;
@@ -5742,6 +6075,89 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
     return text_size;
 }
 
+#ifdef IMGUI_ENABLE_HOVER_GRID
+static int HoverGridCell(float v, float min, float cell_size, int cells)
+{
+    int cell = (int)((v - min) / cell_size);
+    return cell < 0 ? 0 : cell >= cells ? cells - 1 : cell;
+}
+
+static void HoverGridGetCells(const ImGuiHoverGrid& grid, const ImRect& r, int* x0, int* y0, int* x1, int* y1)
+{
+    *x0 = HoverGridCell(r.Min.x - grid.Padding.x, grid.Bounds.Min.x, grid.CellSize.x, grid.CellsX);
+    *y0 = HoverGridCell(r.Min.y - grid.Padding.y, grid.Bounds.Min.y, grid.CellSize.y, grid.CellsY);
+    *x1 = HoverGridCell(r.Max.x + grid.Padding.x, grid.Bounds.Min.x, grid.CellSize.x, grid.CellsX);
+    *y1 = HoverGridCell(r.Max.y + grid.Padding.y, grid.Bounds.Min.y, grid.CellSize.y, grid.CellsY);
+}
+
+// Rebuild the hover grid if any window rect, the display order or the hit padding changed since last build.
+// Cells are stored compacted: count entries per cell, turn counts into end offsets, then fill back to front so that
+// offsets end up at the start of each cell and entries stay in display order.
+static void UpdateHoverGrid(const ImVec2& padding)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiHoverGrid& grid = g.WindowsHoverGrid;
+    if (!grid.Dirty && grid.Padding == padding)
+        return;
+    grid.Dirty = false;
+    grid.Padding = padding;
+    grid.CellsX = grid.CellsY = 0;
+    grid.CellStart.resize(0);
+    grid.Entries.resize(0);
+    if (g.Windows.Size == 0)
+        return;
+
+    grid.Bounds = ImRect(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+#ifdef IMGUI_ENABLE_WINDOW_HOT_DATA
+    for (const ImGuiWindowHotData& hot : g.WindowsHot)
+        grid.Bounds.Add(ImRect(hot.OuterRectClipped.Min - padding, hot.OuterRectClipped.Max + padding));
+#else
+    for (ImGuiWindow* window : g.Windows)
+        grid.Bounds.Add(ImRect(window->OuterRectClipped.Min - padding, window->OuterRectClipped.Max + padding));
+#endif
+
+    const ImVec2 bounds_size = grid.Bounds.GetSize();
+    grid.CellSize.x = ImMax(WINDOWS_HOVER_GRID_CELL_SIZE, bounds_size.x / WINDOWS_HOVER_GRID_MAX_CELLS);
+    grid.CellSize.y = ImMax(WINDOWS_HOVER_GRID_CELL_SIZE, bounds_size.y / WINDOWS_HOVER_GRID_MAX_CELLS);
+    grid.CellsX = ImClamp((int)ImCeil(bounds_size.x / grid.CellSize.x), 1, WINDOWS_HOVER_GRID_MAX_CELLS);
+    grid.CellsY = ImClamp((int)ImCeil(bounds_size.y / grid.CellSize.y), 1, WINDOWS_HOVER_GRID_MAX_CELLS);
+
+    const int cells_count = grid.CellsX * grid.CellsY;
+    grid.CellStart.resize(cells_count + 1);
+    memset(grid.CellStart.Data, 0, (size_t)grid.CellStart.size_in_bytes());
+
+    int x0, y0, x1, y1;
+#ifdef IMGUI_ENABLE_WINDOW_HOT_DATA
+    for (const ImGuiWindowHotData& hot : g.WindowsHot)
+    {
+        HoverGridGetCells(grid, hot.OuterRectClipped, &x0, &y0, &x1, &y1);
+#else
+    for (ImGuiWindow* window : g.Windows)
+    {
+        HoverGridGetCells(grid, window->OuterRectClipped, &x0, &y0, &x1, &y1);
+#endif
+        for (int y = y0; y <= y1; y++)
+            for (int x = x0; x <= x1; x++)
+                grid.CellStart[y * grid.CellsX + x]++;
+    }
+    for (int n = 1; n <= cells_count; n++)
+        grid.CellStart[n] += grid.CellStart[n - 1];
+
+    grid.Entries.resize(grid.CellStart[cells_count]);
+    for (int i = g.Windows.Size - 1; i >= 0; i--)
+    {
+#ifdef IMGUI_ENABLE_WINDOW_HOT_DATA
+        HoverGridGetCells(grid, g.WindowsHot[i].OuterRectClipped, &x0, &y0, &x1, &y1);
+#else
+        HoverGridGetCells(grid, g.Windows[i]->OuterRectClipped, &x0, &y0, &x1, &y1);
+#endif
+        for (int y = y0; y <= y1; y++)
+            for (int x = x0; x <= x1; x++)
+                grid.Entries[--grid.CellStart[y * grid.CellsX + x]] = i;
+    }
+}
+#endif
+
 // Find window given position, search front-to-back
 // - Typically write output back to g.HoveredWindow and g.HoveredWindowUnderMovingWindow.
 // - FIXME: Note that we have an inconsequential lag here: OuterRectClipped is updated in Begin(), so windows moved programmatically
@@ -5759,8 +6175,40 @@ void ImGui::FindHoveredWindowEx(const ImVec2& pos, bool find_first_and_in_any_vi
 
     ImVec2 padding_regular = g.Style.TouchExtraPadding;
     ImVec2 padding_for_resize = g.IO.ConfigWindowsResizeFromEdges ? g.WindowsHoverPadding : padding_regular;
+#ifdef IMGUI_ENABLE_HOVER_GRID
+    // Only test the windows listed in the cell containing 'pos', which are a superset of the windows containing it
+    UpdateHoverGrid(ImMax(padding_regular, padding_for_resize));
+    const ImGuiHoverGrid& grid = g.WindowsHoverGrid;
+    const int* candidates = NULL;
+    int candidates_count = 0;
+    if (grid.CellsX > 0 && pos.x >= grid.Bounds.Min.x && pos.y >= grid.Bounds.Min.y && pos.x <= grid.Bounds.Max.x && pos.y <= grid.Bounds.Max.y)
+    {
+        const int cell = HoverGridCell(pos.y, grid.Bounds.Min.y, grid.CellSize.y, grid.CellsY) * grid.CellsX + HoverGridCell(pos.x, grid.Bounds.Min.x, grid.CellSize.x, grid.CellsX);
+        candidates = grid.Entries.Data + grid.CellStart[cell];
+        candidates_count = grid.CellStart[cell + 1] - grid.CellStart[cell];
+    }
+    for (int n = candidates_count - 1; n >= 0; n--)
+    {
+        const int i = candidates[n];
+#else
     for (int i = g.Windows.Size - 1; i >= 0; i--)
     {
+#endif
+#ifdef IMGUI_ENABLE_WINDOW_HOT_DATA
+        // Reject windows from their hot data, only touch the ImGuiWindow of windows containing 'pos'
+        const ImGuiWindowHotData& hot = g.WindowsHot[i];
+        if (!hot.WasActive || hot.Hidden)
+            continue;
+        if (hot.Flags & ImGuiWindowFlags_NoMouseInputs)
+            continue;
+        ImVec2 hit_padding = (hot.Flags & (ImGuiWindowFlags_NoResize | ImGuiWindowFlags_AlwaysAutoResize)) ? padding_regular : padding_for_resize;
+        if (!hot.OuterRectClipped.ContainsWithPad(pos, hit_padding))
+            continue;
+        ImGuiWindow* window = hot.Window;
+
+        // Support for one rectangular hole in any given window
+        if (hot.HasHitTestHole)
+#else
         ImGuiWindow* window = g.Windows[i];
         IM_MSVC_WARNING_SUPPRESS(28182); // [Static Analyzer] Dereferencing NULL pointer.
         if (!window->WasActive || window->Hidden)
@@ -5776,6 +6224,7 @@ void ImGui::FindHoveredWindowEx(const ImVec2& pos, bool find_first_and_in_any_vi
         // Support for one rectangular hole in any given window
         // FIXME: Consider generalizing hit-testing override (with more generic data, callback, etc.) (#1512)
         if (window->HitTestHoleSize.x != 0)
+#endif
         {
             ImVec2 hole_pos(window->Pos.x + (float)window->HitTestHoleOffset.x, window->Pos.y + (float)window->HitTestHoleOffset.y);
             ImVec2 hole_size((float)window->HitTestHoleSize.x, (float)window->HitTestHoleSize.y);
@@ -5967,6 +6416,14 @@ bool ImGui::BeginChild(const char* str_id, const ImVec2& size_arg, ImGuiChildFla
     return BeginChildEx(str_id, id, size_arg, child_flags, window_flags);
 }
 
+#ifdef IMGUI_ENABLE_LITERAL_IDS
+bool ImGui::BeginChild(const ImGuiLiteral& str_id, const ImVec2& size_arg, ImGuiChildFlags child_flags, ImGuiWindowFlags window_flags)
+{
+    ImGuiID id = GetCurrentWindow()->GetID(str_id);
+    return BeginChildEx(str_id.Str, id, size_arg, child_flags, window_flags);
+}
+#endif
+
 bool ImGui::BeginChild(ImGuiID id, const ImVec2& size_arg, ImGuiChildFlags child_flags, ImGuiWindowFlags window_flags)
 {
     return BeginChildEx(NULL, id, size_arg, child_flags, window_flags);
@@ -6243,6 +6700,11 @@ static ImGuiWindow* CreateNewWindow(const char* name, ImGuiWindowFlags flags)
         g.Windows.push_front(window); // Quite slow but rare and only once
     else
         g.Windows.push_back(window);
+#ifdef IMGUI_ENABLE_WINDOW_HOT_DATA
+    UpdateWindowsHotDataRange((flags & ImGuiWindowFlags_NoBringToFrontOnFocus) ? 0 : g.Windows.Size - 1, g.Windows.Size);
+#endif
+    g.WindowsHoverGrid.Dirty = true;
+    g.WindowsSortDirty = true;
 
     return window;
 }
@@ -6943,9 +7405,14 @@ void ImGui::UpdateWindowSkipRefresh(ImGuiWindow* window)
 static void SetWindowActiveForSkipRefresh(ImGuiWindow* window)
 {
     window->Active = true;
+#ifdef IMGUI_ENABLE_WINDOW_HOT_DATA
+    UpdateWindowHotData(window);
+#endif
     for (ImGuiWindow* child : window->DC.ChildWindows)
         if (!child->Hidden)
         {
+            if (!child->WasActive)
+                GImGui->WindowsSortDirty = true;
             child->Active = child->SkipRefresh = true;
             SetWindowActiveForSkipRefresh(child);
         }
@@ -7033,9 +7500,12 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
         SetWindowConditionAllowFlags(window, ImGuiCond_Appearing, true);
 
     // Update Flags, LastFrameActive, BeginOrderXXX fields
+    const int begin_order_within_parent_prev = window->BeginOrderWithinParent;
     if (first_begin_of_the_frame)
     {
         UpdateWindowInFocusOrderList(window, window_just_created, flags);
+        if ((!window->WasActive && !window->IsFallbackWindow) || ((window->Flags ^ flags) & (ImGuiWindowFlags_ChildWindow | ImGuiWindowFlags_Popup | ImGuiWindowFlags_Tooltip)))
+            g.WindowsSortDirty = true;
         window->Flags = (ImGuiWindowFlags)flags;
         window->ChildFlags = (g.NextWindowData.Flags & ImGuiNextWindowDataFlags_HasChildFlags) ? g.NextWindowData.ChildFlags : 0;
         window->LastFrameActive = current_frame;
@@ -7072,6 +7542,8 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
     // Update ->RootWindow and others pointers (before any possible call to FocusWindow)
     if (first_begin_of_the_frame)
     {
+        if (window->ParentWindow != parent_window)
+            g.WindowsSortDirty = true;
         UpdateWindowParentAndRootLinks(window, flags, parent_window);
         window->ParentWindowInBeginStack = parent_window_in_stack;
 
@@ -7168,7 +7640,7 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
         window->HasCloseButton = (p_open != NULL);
         window->ClipRect = ImVec4(-FLT_MAX, -FLT_MAX, +FLT_MAX, +FLT_MAX);
         window->IDStack.resize(1);
-        window->DrawList->_ResetForNewFrame();
+        ResetWindowDrawListForNewFrame(window);
         window->DC.CurrentTableIdx = -1;
 
         // Restore buffer capacity when woken from a compacted state, to avoid
@@ -7336,8 +7808,14 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
         if (flags & ImGuiWindowFlags_ChildWindow)
         {
             IM_ASSERT(parent_window && parent_window->Active);
-            window->BeginOrderWithinParent = (short)parent_window->DC.ChildWindows.Size;
-            parent_window->DC.ChildWindows.push_back(window);
+            ImVector<ImGuiWindow*>& siblings = parent_window->DC.ChildWindows;
+            window->BeginOrderWithinParent = (short)siblings.Size;
+            if (begin_order_within_parent_prev != siblings.Size)
+                g.WindowsSortDirty = true;
+            else if (siblings.Size > 0 && ChildWindowComparer(&siblings.Data[siblings.Size - 1], &window) > 0) // e.g. child tooltip submitted before a regular child
+                if (g.WindowsChildSortPending.Size == 0 || g.WindowsChildSortPending.back() != parent_window)
+                    g.WindowsChildSortPending.push_back(parent_window);
+            siblings.push_back(window);
             if (!(flags & ImGuiWindowFlags_Popup) && !window_pos_set_by_api && !window_is_child_tooltip)
                 window->Pos = parent_window->DC.CursorPos;
         }
@@ -7449,8 +7927,11 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
         const ImRect host_rect = ((flags & ImGuiWindowFlags_ChildWindow) && !(flags & ImGuiWindowFlags_Popup) && !window_is_child_tooltip) ? parent_window->ClipRect : viewport_rect;
         const ImRect outer_rect = window->Rect();
         const ImRect title_bar_rect = window->TitleBarRect();
+        const ImRect outer_rect_clipped_prev = window->OuterRectClipped;
         window->OuterRectClipped = outer_rect;
         window->OuterRectClipped.ClipWith(host_rect);
+        if (window->OuterRectClipped.Min != outer_rect_clipped_prev.Min || window->OuterRectClipped.Max != outer_rect_clipped_prev.Max)
+            g.WindowsHoverGrid.Dirty = true;
 
         // Inner rectangle
         // Not affected by window border size. Used by:
@@ -7726,6 +8207,9 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
         // Skip refresh mode
         window->SkipItems = true;
     }
+#ifdef IMGUI_ENABLE_WINDOW_HOT_DATA
+    UpdateWindowHotData(window);
+#endif
 
     // [DEBUG] io.ConfigDebugBeginReturnValue override return value to test Begin/End and BeginChild/EndChild behaviors.
     // (The implicit fallback window is NOT automatically ended allowing it to always be able to receive commands without crashing)
@@ -7834,6 +8318,11 @@ void ImGui::BringWindowToDisplayFront(ImGuiWindow* window)
         {
             memmove(&g.Windows[i], &g.Windows[i + 1], (size_t)(g.Windows.Size - i - 1) * sizeof(ImGuiWindow*));
             g.Windows[g.Windows.Size - 1] = window;
+#ifdef IMGUI_ENABLE_WINDOW_HOT_DATA
+            UpdateWindowsHotDataRange(i, g.Windows.Size);
+#endif
+            g.WindowsHoverGrid.Dirty = true;
+            g.WindowsSortDirty = true;
             break;
         }
 }
@@ -7848,6 +8337,11 @@ void ImGui::BringWindowToDisplayBack(ImGuiWindow* window)
         {
             memmove(&g.Windows[1], &g.Windows[0], (size_t)i * sizeof(ImGuiWindow*));
             g.Windows[0] = window;
+#ifdef IMGUI_ENABLE_WINDOW_HOT_DATA
+            UpdateWindowsHotDataRange(0, i + 1);
+#endif
+            g.WindowsHoverGrid.Dirty = true;
+            g.WindowsSortDirty = true;
             break;
         }
 }
@@ -7872,14 +8366,58 @@ void ImGui::BringWindowToDisplayBehind(ImGuiWindow* window, ImGuiWindow* behind_
         memmove(&g.Windows.Data[pos_beh + 1], &g.Windows.Data[pos_beh], copy_bytes);
         g.Windows[pos_beh] = window;
     }
+#ifdef IMGUI_ENABLE_WINDOW_HOT_DATA
+    UpdateWindowsHotDataRange(ImMin(pos_wnd, pos_beh), ImMax(pos_wnd, pos_beh) + 1);
+#endif
+    g.WindowsHoverGrid.Dirty = true;
+    g.WindowsSortDirty = true;
 }
 
 int ImGui::FindWindowDisplayIndex(ImGuiWindow* window)
 {
+#ifdef IMGUI_ENABLE_WINDOW_HOT_DATA
+    return window->DisplayIndex;
+#else
     ImGuiContext& g = *GImGui;
     return g.Windows.index_from_ptr(g.Windows.find(window));
+#endif
+}
+
+#ifdef IMGUI_ENABLE_WINDOW_HOT_DATA
+// Copy the fields mirrored in g.WindowsHot[]. Call after changing any of them outside of Begin().
+static void UpdateWindowHotData(ImGuiWindow* window)
+{
+    ImGuiContext& g = *GImGui;
+    if (window->DisplayIndex < 0) // Not in g.Windows[] yet
+        return;
+    ImGuiWindowHotData& hot = g.WindowsHot[window->DisplayIndex];
+    IM_ASSERT(hot.Window == window);
+    hot.Flags = window->Flags;
+    hot.OuterRectClipped = window->OuterRectClipped;
+    hot.LastTimeActive = window->LastTimeActive;
+    hot.Active = window->Active;
+    hot.WasActive = window->WasActive;
+    hot.Hidden = window->Hidden;
+    hot.Begun = window->BeginCount > 0;
+    hot.MemoryCompacted = window->MemoryCompacted;
+    hot.HasHitTestHole = window->HitTestHoleSize.x != 0;
 }
 
+// Resync g.WindowsHot[n_begin..n_end) after g.Windows[] was reordered or grown within that range.
+static void UpdateWindowsHotDataRange(int n_begin, int n_end)
+{
+    ImGuiContext& g = *GImGui;
+    g.WindowsHot.resize(g.Windows.Size);
+    for (int n = n_begin; n < n_end; n++)
+    {
+        ImGuiWindow* window = g.Windows[n];
+        window->DisplayIndex = n;
+        g.WindowsHot[n].Window = window;
+        UpdateWindowHotData(window);
+    }
+}
+#endif
+
 // Moving window to front of display and set focus (which happens to be back of our sorted list)
 void ImGui::FocusWindow(ImGuiWindow* window, ImGuiFocusRequestFlags flags)
 {
@@ -8386,12 +8924,18 @@ void ImGui::SetWindowHitTestHole(ImGuiWindow* window, const ImVec2& pos, const I
 {
     IM_ASSERT(window->HitTestHoleSize.x == 0);     // We don't support multiple holes/hit test filters
     window->HitTestHoleSize = ImVec2ih(size);
+#ifdef IMGUI_ENABLE_WINDOW_HOT_DATA
+    UpdateWindowHotData(window);
+#endif
     window->HitTestHoleOffset = ImVec2ih(pos - window->Pos);
 }
 
 void ImGui::SetWindowHiddenAndSkipItemsForCurrentFrame(ImGuiWindow* window)
 {
     window->Hidden = window->SkipItems = true;
+#ifdef IMGUI_ENABLE_WINDOW_HOT_DATA
+    UpdateWindowHotData(window);
+#endif
     window->HiddenFramesCanSkipItems = 1;
 }
 
@@ -8520,6 +9064,50 @@ ImDrawList* ImGui::GetWindowDrawList()
     return window->DrawList;
 }
 
+#ifdef IMGUI_ENABLE_DETACHED_DRAWLISTS
+// Splice 'draw_list' into the current window at the current position, e.g. so a worker thread can build a heavy custom canvas
+// while the UI thread submits the rest of the frame. Nothing is copied: the window continues into a new list of its own,
+// and Render() adds its lists to the draw data in order (first part, detached list, continuation, ...).
+// 'draw_list' must be created with GetDrawListSharedData() and outlive the frame. It is reset here with the current clip rect
+// and texture, then may be filled from any thread (see ImDrawListFlags_Detached) until Render().
+void ImGui::AddDetachedDrawList(ImDrawList* draw_list)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    IM_ASSERT(draw_list != NULL && draw_list->_Data == &g.DrawListSharedData);
+    IM_ASSERT(window->DrawList != draw_list && !window->DrawListsDetached.contains(draw_list));
+
+    draw_list->_ResetForNewFrame();
+    draw_list->Flags |= ImDrawListFlags_Detached;
+    draw_list->PushTextureID(g.Font->ContainerAtlas->TexID);
+    draw_list->PushClipRect(window->ClipRect.Min, window->ClipRect.Max);
+    if (window->SkipItems || window->SkipRefresh)
+        return; // Still filled, but not rendered
+
+    ImDrawList* prev_list = window->DrawList;
+    IM_ASSERT(prev_list->_Splitter._Count <= 1 && "Can't splice a draw list while channels are split (e.g. inside a table).");
+
+    // Continue the window in a list which inherits the clip rect and texture stacks, so pushes and pops keep balancing
+    const int n = window->DrawListsDetached.Size;
+    if (n == window->DrawListsContinued.Size)
+        window->DrawListsContinued.push_back(IM_NEW(ImDrawList)(&g.DrawListSharedData));
+    ImDrawList* next_list = window->DrawListsContinued[n];
+    next_list->_ResetForNewFrame();
+    next_list->Flags = prev_list->Flags;
+    next_list->_OwnerName = prev_list->_OwnerName;
+    next_list->_FringeScale = prev_list->_FringeScale;
+    next_list->_ClipRectStack.resize(prev_list->_ClipRectStack.Size); // Not operator=, which frees the capacity we keep across frames
+    memcpy(next_list->_ClipRectStack.Data, prev_list->_ClipRectStack.Data, (size_t)prev_list->_ClipRectStack.size_in_bytes());
+    next_list->_TextureIdStack.resize(prev_list->_TextureIdStack.Size);
+    memcpy(next_list->_TextureIdStack.Data, prev_list->_TextureIdStack.Data, (size_t)prev_list->_TextureIdStack.size_in_bytes());
+    next_list->_CmdHeader.ClipRect = next_list->CmdBuffer[0].ClipRect = prev_list->_CmdHeader.ClipRect;
+    next_list->_CmdHeader.TextureId = next_list->CmdBuffer[0].TextureId = prev_list->_CmdHeader.TextureId;
+
+    window->DrawListsDetached.push_back(draw_list);
+    window->DrawList = next_list;
+}
+#endif
+
 ImFont* ImGui::GetFont()
 {
     return GImGui->Font;
@@ -8716,6 +9304,20 @@ ImGuiID ImGuiWindow::GetID(const char* str, const char* str_end)
     return id;
 }
 
+#ifdef IMGUI_ENABLE_LITERAL_IDS
+ImGuiID ImGuiWindow::GetID(const ImGuiLiteral& lit)
+{
+    ImGuiID seed = IDStack.back();
+    ImGuiID id = ImHashLiteral(lit, seed);
+#ifndef IMGUI_DISABLE_DEBUG_TOOLS
+    ImGuiContext& g = *Ctx;
+    if (g.DebugHookIdInfo == id)
+        ImGui::DebugHookIdInfo(id, ImGuiDataType_String, lit.Str, NULL);
+#endif
+    return id;
+}
+#endif
+
 ImGuiID ImGuiWindow::GetID(const void* ptr)
 {
     ImGuiID seed = IDStack.back();
@@ -8767,6 +9369,16 @@ void ImGui::PushID(const char* str_id)
     window->IDStack.push_back(id);
 }
 
+#ifdef IMGUI_ENABLE_LITERAL_IDS
+void ImGui::PushID(const ImGuiLiteral& str_id)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    ImGuiID id = window->GetID(str_id);
+    window->IDStack.push_back(id);
+}
+#endif
+
 void ImGui::PushID(const char* str_id_begin, const char* str_id_end)
 {
     ImGuiContext& g = *GImGui;
@@ -8845,6 +9457,14 @@ ImGuiID ImGui::GetID(const char* str_id)
     return window->GetID(str_id);
 }
 
+#ifdef IMGUI_ENABLE_LITERAL_IDS
+ImGuiID ImGui::GetID(const ImGuiLiteral& str_id)
+{
+    ImGuiWindow* window = GImGui->CurrentWindow;
+    return window->GetID(str_id);
+}
+#endif
+
 ImGuiID ImGui::GetID(const char* str_id_begin, const char* str_id_end)
 {
     ImGuiWindow* window = GImGui->CurrentWindow;
@@ -14649,6 +15269,9 @@ void ImGui::ClearWindowSettings(const char* name)
     if (window != NULL)
     {
         window->Flags |= ImGuiWindowFlags_NoSavedSettings;
+#ifdef IMGUI_ENABLE_WINDOW_HOT_DATA
+        UpdateWindowHotData(window);
+#endif
         InitOrLoadWindowSettings(window, NULL);
     }
     if (ImGuiWindowSettings* settings = window ? FindWindowSettingsByWindow(window) : FindWindowSettingsByID(ImHashStr(name)))
@@ -15300,7 +15923,11 @@ void ImGui::ShowMetricsWindow(bool* p_open)
         Text("(Context Name: \"%s\")", g.ContextName);
     }
     Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / io.Framerate, io.Framerate);
+#ifdef IMGUI_ENABLE_DRAWLIST_CAPACITY_PREDICTION
+    Text("%d vertices, %d indices (%d triangles), %d buffer reallocations", io.MetricsRenderVertices, io.MetricsRenderIndices, io.MetricsRenderIndices / 3, io.MetricsRenderReallocations);
+#else
     Text("%d vertices, %d indices (%d triangles)", io.MetricsRenderVertices, io.MetricsRenderIndices, io.MetricsRenderIndices / 3);
+#endif
     Text("%d visible windows, %d current allocations", io.MetricsRenderWindows, g.DebugAllocInfo.TotalAllocCount - g.DebugAllocInfo.TotalFreeCount);
     //SameLine(); if (SmallButton("GC")) { g.GcCompactAll = true; }
 
@@ -15690,6 +16317,7 @@ void ImGui::ShowMetricsWindow(bool* p_open)
             Text("MouseStationaryTimer: %.2f", g.MouseStationaryTimer);
             Text("Mouse source: %s", GetMouseSourceName(io.MouseSource));
             Text("Pen Pressure: %.1f", io.PenPressure); // Note: currently unused
+            Text("Input events queued: %d, dropped: %d", g.InputEventsQueue.Size, g.InputEventsDroppedCount);
             Unindent();
         }
 
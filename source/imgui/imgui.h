@@ -177,6 +177,7 @@ struct ImGuiIO;                     // Main configuration and I/O between your a
 struct ImGuiInputTextCallbackData;  // Shared state of InputText() when using custom ImGuiInputTextCallback (rare/advanced use)
 struct ImGuiKeyData;                // Storage for ImGuiIO and IsKeyDown(), IsKeyPressed() etc functions.
 struct ImGuiListClipper;            // Helper to manually clip large list of items
+struct ImGuiLiteral;                // String literal label/id hashed at compile time (with IMGUI_ENABLE_LITERAL_IDS)
 struct ImGuiMultiSelectIO;          // Structure to interact with a BeginMultiSelect()/EndMultiSelect() block
 struct ImGuiOnceUponAFrame;         // Helper for running a block of code not more than once a frame
 struct ImGuiPayload;                // User data payload for drag and drop operations
@@ -312,6 +313,60 @@ struct ImVec4
 };
 IM_MSVC_RUNTIME_CHECKS_RESTORE
 
+// ImGuiLiteral: string literal label/id hashed at compile time. [Requires C++20, enabled with IMGUI_ENABLE_LITERAL_IDS in imconfig.h]
+// - Pass to the overloads of PushID(), GetID() and common widgets, e.g. 'ImGui::Button(ImGuiLiteral("Save"))'.
+// - Produces the same ID as passing the string itself, including "label###id" where only the part from the last "###" is hashed.
+// - The CRC of that part is computed from a zero state here, the seed (current ID stack) is applied at runtime by ImHashLiteral().
+// - IM_LITERAL("Save") expands to ImGuiLiteral("Save") when enabled and to "Save" otherwise.
+#ifdef IMGUI_ENABLE_LITERAL_IDS
+#ifndef __cpp_consteval
+#error "IMGUI_ENABLE_LITERAL_IDS requires a C++20 compiler with consteval support."
+#endif
+struct ImGuiLiteral
+{
+    const char*     Str;        // Full label (zero-terminated, static storage)
+    const char*     HashStr;    // Hashed part of the label: from the last "###" if any, else == Str
+    ImU32           HashLen;    // Length of hashed part
+    ImU32           HashCrc;    // CRC32 register after hashed part, starting from 0
+    ImU32           HashShift;  // x^(8*HashLen) modulo the CRC32 polynomial (bit-reflected), used to fold in the seed
+
+#ifdef IMGUI_USE_LEGACY_CRC32_ADLER
+    static constexpr ImU32 CrcPoly = 0xEDB88320;    // Must match GCrc32LookupTable[128]
+#else
+    static constexpr ImU32 CrcPoly = 0x82F63B78;    // CRC32c, must match GCrc32LookupTable[128]
+#endif
+
+    template<size_t N>
+    consteval ImGuiLiteral(const char (&str)[N]) : Str(str), HashStr(str), HashLen(0), HashCrc(0), HashShift(0x80000000)
+    {
+        size_t len = 0;
+        while (len < N && str[len] != 0)
+            len++;
+        size_t begin = 0;
+        for (size_t i = 0; i + 2 < len; i++)
+            if (str[i] == '#' && str[i + 1] == '#' && str[i + 2] == '#')
+                begin = i;
+        HashStr = str + begin;
+        HashLen = (ImU32)(len - begin);
+        for (size_t i = begin; i < len; i++)
+        {
+            HashCrc = CrcStep(HashCrc, (unsigned char)str[i]);
+            HashShift = CrcStep(HashShift, 0);
+        }
+    }
+    static consteval ImU32 CrcStep(ImU32 crc, unsigned char c)
+    {
+        crc ^= c;
+        for (int bit = 0; bit < 8; bit++)
+            crc = (crc >> 1) ^ (CrcPoly & (0u - (crc & 1)));
+        return crc;
+    }
+};
+#define IM_LITERAL(_STR)    ImGuiLiteral(_STR)
+#else
+#define IM_LITERAL(_STR)    _STR        // Plain string without IMGUI_ENABLE_LITERAL_IDS, so call sites can use IM_LITERAL() unconditionally
+#endif
+
 //-----------------------------------------------------------------------------
 // [SECTION] Dear ImGui end-user API functions
 // (Note that ImGui:: being a namespace, you can add extra ImGui:: functions in your own separate file. Please don't modify imgui source files!)
@@ -398,6 +453,9 @@ namespace ImGui
     IMGUI_API bool          IsWindowFocused(ImGuiFocusedFlags flags=0); // is current window focused? or its root/child, depending on flags. see flags for options.
     IMGUI_API bool          IsWindowHovered(ImGuiHoveredFlags flags=0); // is current window hovered and hoverable (e.g. not blocked by a popup/modal)? See ImGuiHoveredFlags_ for options. IMPORTANT: If you are trying to check whether your mouse should be dispatched to Dear ImGui or to your underlying app, you should not use this function! Use the 'io.WantCaptureMouse' boolean for that! Refer to FAQ entry "How can I tell whether to dispatch mouse/keyboard to Dear ImGui or my application?" for details.
     IMGUI_API ImDrawList*   GetWindowDrawList();                        // get draw list associated to the current window, to append your own drawing primitives
+#ifdef IMGUI_ENABLE_DETACHED_DRAWLISTS
+    IMGUI_API void          AddDetachedDrawList(ImDrawList* draw_list); // reset a draw list you own and splice it into the current window at the current position. Another thread may fill it until Render(). See ImDrawListFlags_Detached.
+#endif
     IMGUI_API ImVec2        GetWindowPos();                             // get current window position in screen space (IT IS UNLIKELY YOU EVER NEED TO USE THIS. Consider always using GetCursorScreenPos() and GetContentRegionAvail() instead)
     IMGUI_API ImVec2        GetWindowSize();                            // get current window size (IT IS UNLIKELY YOU EVER NEED TO USE THIS. Consider always using GetCursorScreenPos() and GetContentRegionAvail() instead)
     IMGUI_API float         GetWindowWidth();                           // get current window width (IT IS UNLIKELY YOU EVER NEED TO USE THIS). Shortcut for GetWindowSize().x.
@@ -526,6 +584,19 @@ namespace ImGui
     IMGUI_API ImGuiID       GetID(const char* str_id_begin, const char* str_id_end);
     IMGUI_API ImGuiID       GetID(const void* ptr_id);
     IMGUI_API ImGuiID       GetID(int int_id);
+#ifdef IMGUI_ENABLE_LITERAL_IDS
+    IMGUI_API void          PushID(const ImGuiLiteral& str_id);                             // push string literal into the ID stack (hashed at compile time). e.g. PushID(ImGuiLiteral("row"))
+    IMGUI_API ImGuiID       GetID(const ImGuiLiteral& str_id);
+    // Same as the 'const char* label' versions, with the label's ID hashed at compile time. e.g. Button(ImGuiLiteral("Save"))
+    IMGUI_API bool          BeginChild(const ImGuiLiteral& str_id, const ImVec2& size = ImVec2(0, 0), ImGuiChildFlags child_flags = 0, ImGuiWindowFlags window_flags = 0);
+    IMGUI_API bool          Button(const ImGuiLiteral& label, const ImVec2& size = ImVec2(0, 0));
+    IMGUI_API bool          SmallButton(const ImGuiLiteral& label);
+    IMGUI_API bool          Checkbox(const ImGuiLiteral& label, bool* v);
+    IMGUI_API bool          TreeNode(const ImGuiLiteral& label);
+    IMGUI_API bool          CollapsingHeader(const ImGuiLiteral& label, ImGuiTreeNodeFlags flags = 0);
+    IMGUI_API bool          Selectable(const ImGuiLiteral& label, bool selected = false, ImGuiSelectableFlags flags = 0, const ImVec2& size = ImVec2(0, 0));
+    IMGUI_API bool          Selectable(const ImGuiLiteral& label, bool* p_selected, ImGuiSelectableFlags flags = 0, const ImVec2& size = ImVec2(0, 0));
+#endif
 
     // Widgets: Text
     IMGUI_API void          TextUnformatted(const char* text, const char* text_end = NULL); // raw text without formatting. Roughly equivalent to Text("%s", text) but: A) doesn't require null terminated string if 'text_end' is specified, B) it's faster, no memory copy is done, no buffer size limits, recommended for long chunks of text.
@@ -2362,6 +2433,7 @@ struct ImGuiIO
     float       Framerate;                          // Estimate of application framerate (rolling average over 60 frames, based on io.DeltaTime), in frame per second. Solely for convenience. Slow applications may not want to use a moving average or may want to reset underlying buffers occasionally.
     int         MetricsRenderVertices;              // Vertices output during last call to Render()
     int         MetricsRenderIndices;               // Indices output during last call to Render() = number of triangles * 3
+    int         MetricsRenderReallocations;         // Draw list buffer reallocations while building the lists output during last call to Render(). Only counted with IMGUI_ENABLE_DRAWLIST_CAPACITY_PREDICTION.
     int         MetricsRenderWindows;               // Number of visible windows
     int         MetricsActiveWindows;               // Number of active windows
     ImVec2      MouseDelta;                         // Mouse delta. Note that this is zero if either current or previous position are invalid (-FLT_MAX,-FLT_MAX), so a disappearing/reappearing mouse won't have a huge delta.
@@ -3037,6 +3109,11 @@ enum ImDrawListFlags_
     ImDrawListFlags_AntiAliasedLinesUseTex  = 1 << 1,  // Enable anti-aliased lines/borders using textures when possible. Require backend to render with bilinear filtering (NOT point/nearest filtering).
     ImDrawListFlags_AntiAliasedFill         = 1 << 2,  // Enable anti-aliased edge around filled shapes (rounded rectangles, circles).
     ImDrawListFlags_AllowVtxOffset          = 1 << 3,  // Can emit 'VtxOffset > 0' to allow large meshes. Set when 'ImGuiBackendFlags_RendererHasVtxOffset' is enabled.
+#ifdef IMGUI_ENABLE_DETACHED_DRAWLISTS
+    ImDrawListFlags_Detached                = 1 << 4,  // Set by ImGui::AddDetachedDrawList(). The list only reads the shared ImDrawListSharedData (it uses its own scratch buffer), so it can be filled by another thread while the UI thread keeps submitting windows.
+                                                       // Pass the font explicitly to AddText(): the shared font changes with PushFont(). The list must be complete before Render().
+                                                       // Keep the list across frames: it keeps its capacity, so filling it stops allocating (allocations from other threads are counted in the next NewFrame()).
+#endif
 };
 
 // Draw command list
@@ -3069,6 +3146,12 @@ struct ImDrawList
     ImVector<ImU8>          _CallbacksDataBuf;  // [Internal]
     float                   _FringeScale;       // [Internal] anti-alias fringe is scaled by this value, this helps to keep things sharp while zooming at vertex buffer content
     const char*             _OwnerName;         // Pointer to owner window's name for debugging
+#ifdef IMGUI_ENABLE_DRAWLIST_CAPACITY_PREDICTION
+    int                     _GrowCount;         // [Internal] number of times CmdBuffer/IdxBuffer/VtxBuffer/_CallbacksDataBuf had to grow since _ResetForNewFrame()
+#endif
+#ifdef IMGUI_ENABLE_DETACHED_DRAWLISTS
+    ImVector<ImVec2>        _TempBuffer;        // [Internal] scratch buffer used instead of _Data->TempBuffer when ImDrawListFlags_Detached is set
+#endif
 
     // If you want to create ImDrawList instances, pass them ImGui::GetDrawListSharedData().
     // (advanced: you may create and use your own ImDrawListSharedData so you can use ImDrawList without ImGui, but that's more involved)
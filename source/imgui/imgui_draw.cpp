@@ -394,6 +394,14 @@ void ImDrawListSharedData::SetCircleTessellationMaxError(float max_error)
     ArcFastRadiusCutoff = IM_DRAWLIST_CIRCLE_AUTO_SEGMENT_CALC_R(IM_DRAWLIST_ARCFAST_SAMPLE_MAX, CircleSegmentMaxError);
 }
 
+// Scratch buffer for polyline normals and polygon triangulation.
+#ifdef IMGUI_ENABLE_DETACHED_DRAWLISTS
+// Detached lists may be filled by other threads at the same time as the UI thread, so they can't write to the shared one.
+static inline ImVector<ImVec2>& GetTempBuffer(ImDrawList* draw_list) { return (draw_list->Flags & ImDrawListFlags_Detached) ? draw_list->_TempBuffer : draw_list->_Data->TempBuffer; }
+#else
+static inline ImVector<ImVec2>& GetTempBuffer(ImDrawList* draw_list) { return draw_list->_Data->TempBuffer; }
+#endif
+
 ImDrawList::ImDrawList(ImDrawListSharedData* shared_data)
 {
     memset(this, 0, sizeof(*this));
@@ -431,6 +439,9 @@ void ImDrawList::_ResetForNewFrame()
     _Splitter.Clear();
     CmdBuffer.push_back(ImDrawCmd());
     _FringeScale = 1.0f;
+#ifdef IMGUI_ENABLE_DRAWLIST_CAPACITY_PREDICTION
+    _GrowCount = 0;
+#endif
 }
 
 void ImDrawList::_ClearFreeMemory()
@@ -447,6 +458,9 @@ void ImDrawList::_ClearFreeMemory()
     _CallbacksDataBuf.clear();
     _Path.clear();
     _Splitter.ClearFreeMemory();
+#ifdef IMGUI_ENABLE_DETACHED_DRAWLISTS
+    _TempBuffer.clear();
+#endif
 }
 
 ImDrawList* ImDrawList::CloneOutput() const
@@ -468,6 +482,10 @@ void ImDrawList::AddDrawCmd()
     draw_cmd.IdxOffset = IdxBuffer.Size;
 
     IM_ASSERT(draw_cmd.ClipRect.x <= draw_cmd.ClipRect.z && draw_cmd.ClipRect.y <= draw_cmd.ClipRect.w);
+#ifdef IMGUI_ENABLE_DRAWLIST_CAPACITY_PREDICTION
+    if (CmdBuffer.Size == CmdBuffer.Capacity)
+        _GrowCount++;
+#endif
     CmdBuffer.push_back(draw_cmd);
 }
 
@@ -511,6 +529,10 @@ void ImDrawList::AddCallback(ImDrawCallback callback, void* userdata, size_t use
         curr_cmd->UserCallbackData = NULL; // Will be resolved during Render()
         curr_cmd->UserCallbackDataSize = (int)userdata_size;
         curr_cmd->UserCallbackDataOffset = _CallbacksDataBuf.Size;
+#ifdef IMGUI_ENABLE_DRAWLIST_CAPACITY_PREDICTION
+        if (_CallbacksDataBuf.Size + (int)userdata_size > _CallbacksDataBuf.Capacity)
+            _GrowCount++;
+#endif
         _CallbacksDataBuf.resize(_CallbacksDataBuf.Size + (int)userdata_size);
         memcpy(_CallbacksDataBuf.Data + (size_t)curr_cmd->UserCallbackDataOffset, userdata, userdata_size);
     }
@@ -684,10 +706,13 @@ void ImDrawList::PrimReserve(int idx_count, int vtx_count)
     draw_cmd->ElemCount += idx_count;
 
     int vtx_buffer_old_size = VtxBuffer.Size;
+    int idx_buffer_old_size = IdxBuffer.Size;
+#ifdef IMGUI_ENABLE_DRAWLIST_CAPACITY_PREDICTION
+    _GrowCount += (vtx_buffer_old_size + vtx_count > VtxBuffer.Capacity) + (idx_buffer_old_size + idx_count > IdxBuffer.Capacity);
+#endif
     VtxBuffer.resize(vtx_buffer_old_size + vtx_count);
     _VtxWritePtr = VtxBuffer.Data + vtx_buffer_old_size;
 
-    int idx_buffer_old_size = IdxBuffer.Size;
     IdxBuffer.resize(idx_buffer_old_size + idx_count);
     _IdxWritePtr = IdxBuffer.Data + idx_buffer_old_size;
 }
@@ -792,8 +817,8 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
 
         // Temporary buffer
         // The first <points_count> items are normals at each line point, then after that there are either 2 or 4 temp points for each line point
-        _Data->TempBuffer.reserve_discard(points_count * ((use_texture || !thick_line) ? 3 : 5));
-        ImVec2* temp_normals = _Data->TempBuffer.Data;
+        GetTempBuffer(this).reserve_discard(points_count * ((use_texture || !thick_line) ? 3 : 5));
+        ImVec2* temp_normals = GetTempBuffer(this).Data;
         ImVec2* temp_points = temp_normals + points_count;
 
         // Calculate normals (tangents) for each line segment
@@ -1041,8 +1066,8 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
         }
 
         // Compute normals
-        _Data->TempBuffer.reserve_discard(points_count);
-        ImVec2* temp_normals = _Data->TempBuffer.Data;
+        GetTempBuffer(this).reserve_discard(points_count);
+        ImVec2* temp_normals = GetTempBuffer(this).Data;
         for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
         {
             const ImVec2& p0 = points[i0];
@@ -1993,8 +2018,8 @@ void ImDrawList::AddConcavePolyFilled(const ImVec2* points, const int points_cou
         unsigned int vtx_inner_idx = _VtxCurrentIdx;
         unsigned int vtx_outer_idx = _VtxCurrentIdx + 1;
 
-        _Data->TempBuffer.reserve_discard((ImTriangulator::EstimateScratchBufferSize(points_count) + sizeof(ImVec2)) / sizeof(ImVec2));
-        triangulator.Init(points, points_count, _Data->TempBuffer.Data);
+        GetTempBuffer(this).reserve_discard((ImTriangulator::EstimateScratchBufferSize(points_count) + sizeof(ImVec2)) / sizeof(ImVec2));
+        triangulator.Init(points, points_count, GetTempBuffer(this).Data);
         while (triangulator._TrianglesLeft > 0)
         {
             triangulator.GetNextTriangle(triangle);
@@ -2003,8 +2028,8 @@ void ImDrawList::AddConcavePolyFilled(const ImVec2* points, const int points_cou
         }
 
         // Compute normals
-        _Data->TempBuffer.reserve_discard(points_count);
-        ImVec2* temp_normals = _Data->TempBuffer.Data;
+        GetTempBuffer(this).reserve_discard(points_count);
+        ImVec2* temp_normals = GetTempBuffer(this).Data;
         for (int i0 = points_count - 1, i1 = 0; i1 < points_count; i0 = i1++)
         {
             const ImVec2& p0 = points[i0];
@@ -2050,8 +2075,8 @@ void ImDrawList::AddConcavePolyFilled(const ImVec2* points, const int points_cou
             _VtxWritePtr[0].pos = points[i]; _VtxWritePtr[0].uv = uv; _VtxWritePtr[0].col = col;
             _VtxWritePtr++;
         }
-        _Data->TempBuffer.reserve_discard((ImTriangulator::EstimateScratchBufferSize(points_count) + sizeof(ImVec2)) / sizeof(ImVec2));
-        triangulator.Init(points, points_count, _Data->TempBuffer.Data);
+        GetTempBuffer(this).reserve_discard((ImTriangulator::EstimateScratchBufferSize(points_count) + sizeof(ImVec2)) / sizeof(ImVec2));
+        triangulator.Init(points, points_count, GetTempBuffer(this).Data);
         while (triangulator._TrianglesLeft > 0)
         {
             triangulator.GetNextTriangle(triangle);
@@ -2155,6 +2180,9 @@ void ImDrawListSplitter::Merge(ImDrawList* draw_list)
             idx_offset += ch._CmdBuffer.Data[cmd_n].ElemCount;
         }
     }
+#ifdef IMGUI_ENABLE_DRAWLIST_CAPACITY_PREDICTION
+    draw_list->_GrowCount += (draw_list->CmdBuffer.Size + new_cmd_buffer_count > draw_list->CmdBuffer.Capacity) + (draw_list->IdxBuffer.Size + new_idx_buffer_count > draw_list->IdxBuffer.Capacity);
+#endif
     draw_list->CmdBuffer.resize(draw_list->CmdBuffer.Size + new_cmd_buffer_count);
     draw_list->IdxBuffer.resize(draw_list->IdxBuffer.Size + new_idx_buffer_count);
 
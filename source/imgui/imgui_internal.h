@@ -56,6 +56,9 @@ Index of this file:
 #include <stdlib.h>     // NULL, malloc, free, qsort, atoi, atof
 #include <math.h>       // sqrtf, fabsf, fmodf, powf, floorf, ceilf, cosf, sinf
 #include <limits.h>     // INT_MIN, INT_MAX
+#ifdef IMGUI_ENABLE_DETACHED_DRAWLISTS
+#include <atomic>       // std::atomic
+#endif
 
 // Enable SSE intrinsics if available
 #if (defined __SSE__ || defined __x86_64__ || defined _M_X64 || (defined(_M_IX86_FP) && (_M_IX86_FP >= 1))) && !defined(IMGUI_DISABLE_SSE)
@@ -170,6 +173,7 @@ struct ImGuiTreeNodeStackData;      // Temporary storage for TreeNode().
 struct ImGuiTypingSelectState;      // Storage for GetTypingSelectRequest()
 struct ImGuiTypingSelectRequest;    // Storage for GetTypingSelectRequest() (aimed to be public)
 struct ImGuiWindow;                 // Storage for one window
+struct ImGuiWindowHotData;          // Copy of the ImGuiWindow fields read by per-frame loops over all windows
 struct ImGuiWindowTempData;         // Temporary storage for one window (that's the data which in theory we could ditch at the end of the frame, in practice we currently keep it for each window)
 struct ImGuiWindowSettings;         // Storage for a window .ini settings (we keep one of those even if the actual window wasn't instanced during this session)
 
@@ -347,6 +351,9 @@ extern IMGUI_API ImGuiContext* GImGui;  // Current implicit context pointer
 // Helpers: Hashing
 IMGUI_API ImGuiID       ImHashData(const void* data, size_t data_size, ImGuiID seed = 0);
 IMGUI_API ImGuiID       ImHashStr(const char* data, size_t data_size = 0, ImGuiID seed = 0);
+#ifdef IMGUI_ENABLE_LITERAL_IDS
+IMGUI_API ImGuiID       ImHashLiteral(const ImGuiLiteral& lit, ImGuiID seed = 0);           // == ImHashStr(lit.Str, 0, seed)
+#endif
 
 // Helpers: Sorting
 #ifndef ImQsort
@@ -1313,6 +1320,23 @@ struct ImGuiPtrOrIndex
     ImGuiPtrOrIndex(int index)  { Ptr = NULL; Index = index; }
 };
 
+// Coarse grid of screen cells used by FindHoveredWindowEx() when IMGUI_ENABLE_HOVER_GRID is defined.
+// Each cell lists, in display order, every window whose padded OuterRectClipped overlaps it. Windows are listed regardless
+// of their active/hidden/flags state (which are still tested on lookup), so the grid only needs rebuilding when a rect or
+// the display order changes.
+struct ImGuiHoverGrid
+{
+    bool                    Dirty;          // Set when a window rect or g.Windows order changed since last build
+    ImVec2                  Padding;        // Hit padding the grid was built with
+    ImRect                  Bounds;         // Area covered by cells
+    ImVec2                  CellSize;
+    int                     CellsX, CellsY;
+    ImVector<int>           CellStart;      // [CellsX * CellsY + 1] offsets into Entries
+    ImVector<int>           Entries;        // Indices into g.Windows, ascending within each cell
+
+    ImGuiHoverGrid()        { Dirty = true; CellsX = CellsY = 0; }
+};
+
 //-----------------------------------------------------------------------------
 // [SECTION] Popup support
 //-----------------------------------------------------------------------------
@@ -1529,6 +1553,10 @@ struct ImGuiListClipperData
     int                             ItemsFrozen;
     ImVector<ImGuiListClipperRange> Ranges;
 
+#ifdef IMGUI_ENABLE_BOX_SELECT_RANGES
+    bool                            BoxSelectRangesAdded;   // Set when MultiSelectAddBoxSelectRanges() emitted the box-select changes of all items of this clipper.
+#endif
+
     ImGuiListClipperData()          { memset(this, 0, sizeof(*this)); }
     void                            Reset(ImGuiListClipper* clipper) { ListClipper = clipper; StepNo = ItemsFrozen = 0; Ranges.resize(0); }
 };
@@ -1726,6 +1754,28 @@ struct ImGuiOldColumns
 // [SECTION] Box-select support
 //-----------------------------------------------------------------------------
 
+#ifdef IMGUI_ENABLE_BOX_SELECT_RANGES
+// Layout of the items submitted through a clipper while box-selecting, learned from the items submitted in one frame and used on the next one.
+// Row N of the clipper holds items [N*Columns, N*Columns+Columns) (as SetNextItemSelectionUserData() values) with the same rect in every row.
+struct ImGuiBoxSelectLayout
+{
+    int                     Columns;            // Items per clipper row. 0 when unknown or when submitted items didn't fit.
+    float                   ItemOffsetY;        // Item rect top, relative to clipper row position.
+    float                   ItemHeight;
+    ImVector<ImVec2>        ColumnsX;           // Min/max x of item rect for each column, in window-contents relative space.
+
+    // Learning state
+    int                     RowsCount;          // Clipper items count (last row may be partial).
+    int                     Rows;               // Number of rows seen.
+    int                     Row;                // Current row (-1 if none).
+    int                     RowItems;           // Items seen in current row.
+    ImGuiSelectionUserData  RowFirstItem;
+    bool                    Failed;             // Submitted items didn't fit a grid layout.
+
+    void    Clear()         { Columns = RowsCount = Rows = RowItems = 0; Row = -1; ItemOffsetY = ItemHeight = 0.0f; ColumnsX.resize(0); Failed = false; }
+};
+#endif
+
 struct ImGuiBoxSelectState
 {
     // Active box-selection data (persistent, 1 active at a time)
@@ -1746,6 +1796,10 @@ struct ImGuiBoxSelectState
     ImRect                  UnclipRect;         // Rectangle where ItemAdd() clipping may be temporarily disabled. Need support by multi-select supporting widgets.
     ImRect                  BoxSelectRectPrev;  // Selection rectangle in absolute coordinates (derived every frame from BoxSelectStartPosRel and MousePos)
     ImRect                  BoxSelectRectCurr;
+#ifdef IMGUI_ENABLE_BOX_SELECT_RANGES
+    ImGuiBoxSelectLayout    Layout;             // Layout learned on previous frame, used by MultiSelectAddBoxSelectRanges().
+    ImGuiBoxSelectLayout    LayoutNext;         // Layout being learned from the items submitted on this frame.
+#endif
 
     ImGuiBoxSelectState()   { memset(this, 0, sizeof(*this)); }
 };
@@ -2056,15 +2110,23 @@ struct ImGuiContext
     ImVector<ImGuiInputEvent> InputEventsTrail;                 // Past input events processed in NewFrame(). This is to allow domain-specific application to access e.g mouse/pen trail.
     ImGuiMouseSource        InputEventsNextMouseSource;
     ImU32                   InputEventsNextEventId;
+    int                     InputEventsDroppedCount;            // Input events filtered as duplicates or merged into a queued event (IMGUI_ENABLE_INPUT_COALESCING), since context creation.
 
     // Windows state
     ImVector<ImGuiWindow*>  Windows;                            // Windows, sorted in display order, back to front
+#ifdef IMGUI_ENABLE_WINDOW_HOT_DATA
+    ImVector<ImGuiWindowHotData> WindowsHot;                    // WindowsHot[n] mirrors the fields of Windows[n] read by per-frame loops over all windows.
+#endif
     ImVector<ImGuiWindow*>  WindowsFocusOrder;                  // Root windows, sorted in focus order, back to front.
     ImVector<ImGuiWindow*>  WindowsTempSortBuffer;              // Temporary buffer used in EndFrame() to reorder windows so parents are kept before their child
     ImVector<ImGuiWindowStackData> CurrentWindowStack;
     ImGuiStorage            WindowsById;                        // Map window's ImGuiID to ImGuiWindow*
     int                     WindowsActiveCount;                 // Number of unique windows submitted by frame
+    int                     WindowsActiveCountPrev;             // WindowsActiveCount of last frame, a drop means some window became inactive.
+    bool                    WindowsSortDirty;                   // Set when anything affecting the EndFrame() sort of g.Windows changed. Sort is skipped otherwise with IMGUI_ENABLE_WINDOW_SORT_CACHE.
+    ImVector<ImGuiWindow*>  WindowsChildSortPending;            // Windows whose DC.ChildWindows[] were submitted out of sorted order this frame.
     ImVec2                  WindowsHoverPadding;                // Padding around resizable windows for which hovering on counts as hovering the window == ImMax(style.TouchExtraPadding, WINDOWS_HOVER_PADDING).
+    ImGuiHoverGrid          WindowsHoverGrid;                   // Spatial index of window hit rects, used by FindHoveredWindowEx() with IMGUI_ENABLE_HOVER_GRID.
     ImGuiID                 DebugBreakInWindow;                 // Set to break in Begin() call.
     ImGuiWindow*            CurrentWindow;                      // Window being drawn into
     ImGuiWindow*            HoveredWindow;                      // Window the mouse is hovering. Will typically catch mouse inputs.
@@ -2376,6 +2438,10 @@ struct ImGuiContext
     ImGuiMetricsConfig      DebugMetricsConfig;
     ImGuiIDStackTool        DebugIDStackTool;
     ImGuiDebugAllocInfo     DebugAllocInfo;
+#ifdef IMGUI_ENABLE_DETACHED_DRAWLISTS
+    std::atomic<int>        DebugAllocOtherThreadAllocCount;    // MemAlloc() calls from threads not running this context's frames (e.g. workers growing detached draw lists). Folded into DebugAllocInfo by NewFrame()
+    std::atomic<int>        DebugAllocOtherThreadFreeCount;
+#endif
 
     // Misc
     float                   FramerateSecPerFrame[60];           // Calculate estimate of framerate for user over the last 60 frames..
@@ -2447,6 +2513,25 @@ struct IMGUI_API ImGuiWindowTempData
     ImVector<float>         TextWrapPosStack;       // Store text wrap pos to restore (attention: .back() is not == TextWrapPos)
 };
 
+#ifdef IMGUI_ENABLE_WINDOW_HOT_DATA
+// Copy of the ImGuiWindow fields read by the per-frame loops over all windows (NewFrame(), FindHoveredWindowEx(), EndFrame() sort, Render()).
+// Those loops skip most windows after reading a few scattered fields, which would otherwise pull several cache lines of each ImGuiWindow.
+// Updated wherever g.Windows[] is reordered and wherever Begin() or other functions change the mirrored fields.
+struct ImGuiWindowHotData
+{
+    ImGuiWindow*            Window;
+    ImGuiWindowFlags        Flags;
+    ImRect                  OuterRectClipped;
+    float                   LastTimeActive;
+    bool                    Active;
+    bool                    WasActive;
+    bool                    Hidden;
+    bool                    Begun;                              // BeginCount > 0
+    bool                    MemoryCompacted;
+    bool                    HasHitTestHole;
+};
+#endif
+
 // Storage for one window
 struct IMGUI_API ImGuiWindow
 {
@@ -2554,6 +2639,18 @@ struct IMGUI_API ImGuiWindow
     int                     MemoryDrawListIdxCapacity;          // Backup of last idx/vtx count, so when waking up the window we can preallocate and avoid iterative alloc/copy
     int                     MemoryDrawListVtxCapacity;
     bool                    MemoryCompacted;                    // Set when window extraneous data have been garbage collected
+#ifdef IMGUI_ENABLE_WINDOW_HOT_DATA
+    int                     DisplayIndex;                       // Index in g.Windows[] and g.WindowsHot[]
+#endif
+#ifdef IMGUI_ENABLE_DRAWLIST_CAPACITY_PREDICTION
+    int                     DrawListPredictedCmdCount;          // Decaying max of previous frames' draw list sizes, reserved once in Begin() so the list doesn't regrow while being built
+    int                     DrawListPredictedIdxCount;
+    int                     DrawListPredictedVtxCount;
+#endif
+#ifdef IMGUI_ENABLE_DETACHED_DRAWLISTS
+    ImVector<ImDrawList*>   DrawListsDetached;                  // Lists spliced by AddDetachedDrawList() since the window was reset. Render order is DrawListInst, then each DrawListsDetached[n] followed by DrawListsContinued[n]
+    ImVector<ImDrawList*>   DrawListsContinued;                 // Lists DrawList moved to after each splice (owned, reused across frames). DrawList == DrawListsContinued[DrawListsDetached.Size - 1] when there are splices
+#endif
 
 public:
     ImGuiWindow(ImGuiContext* context, const char* name);
@@ -2562,6 +2659,9 @@ public:
     ImGuiID     GetID(const char* str, const char* str_end = NULL);
     ImGuiID     GetID(const void* ptr);
     ImGuiID     GetID(int n);
+#ifdef IMGUI_ENABLE_LITERAL_IDS
+    ImGuiID     GetID(const ImGuiLiteral& lit);
+#endif
     ImGuiID     GetIDFromPos(const ImVec2& p_abs);
     ImGuiID     GetIDFromRectangle(const ImRect& r_abs);
 
@@ -2771,6 +2871,11 @@ struct IMGUI_API ImGuiTable
     ImBitArrayPtr               EnabledMaskByDisplayOrder;  // Column DisplayOrder -> IsEnabled map
     ImBitArrayPtr               EnabledMaskByIndex;         // Column Index -> IsEnabled map (== not hidden by user/api) in a format adequate for iterating column without touching cold data
     ImBitArrayPtr               VisibleMaskByIndex;         // Column Index -> IsVisibleX|IsVisibleY map (== not hidden by user/api && not hidden by scrolling/cliprect)
+#ifdef IMGUI_ENABLE_TABLE_COLUMNS_SOA
+    ImSpan<ImGuiTableColumnFlags> ColumnsFlags;             // Point within RawData[]. Column Index -> Flags, copied when TableUpdateLayout() locks them
+    ImSpan<float>               ColumnsMaxX;                // Point within RawData[]. Column Index -> MaxX
+    ImSpan<ImVec2>              ColumnsClipX;               // Point within RawData[]. Column Index -> ClipRect.Min.x, ClipRect.Max.x
+#endif
     ImGuiTableFlags             SettingsLoadedFlags;        // Which data were loaded from the .ini file (e.g. when order is not altered we won't save order)
     int                         SettingsOffset;             // Offset in g.SettingsTables
     int                         LastFrameActive;
@@ -3268,6 +3373,9 @@ namespace ImGui
     IMGUI_API void          MultiSelectItemFooter(ImGuiID id, bool* p_selected, bool* p_pressed);
     IMGUI_API void          MultiSelectAddSetAll(ImGuiMultiSelectTempData* ms, bool selected);
     IMGUI_API void          MultiSelectAddSetRange(ImGuiMultiSelectTempData* ms, bool selected, int range_dir, ImGuiSelectionUserData first_item, ImGuiSelectionUserData last_item);
+#ifdef IMGUI_ENABLE_BOX_SELECT_RANGES
+    IMGUI_API bool          MultiSelectAddBoxSelectRanges(ImGuiMultiSelectTempData* ms, ImGuiListClipper* clipper);
+#endif
     inline ImGuiBoxSelectState*     GetBoxSelectState(ImGuiID id)   { ImGuiContext& g = *GImGui; return (id != 0 && g.BoxSelectState.ID == id && g.BoxSelectState.IsActive) ? &g.BoxSelectState : NULL; }
     inline ImGuiMultiSelectState*   GetMultiSelectState(ImGuiID id) { ImGuiContext& g = *GImGui; return g.MultiSelectStorage.GetByKey(id); }
 
@@ -3389,6 +3497,9 @@ namespace ImGui
     // Widgets
     IMGUI_API void          TextEx(const char* text, const char* text_end = NULL, ImGuiTextFlags flags = 0);
     IMGUI_API bool          ButtonEx(const char* label, const ImVec2& size_arg = ImVec2(0, 0), ImGuiButtonFlags flags = 0);
+    IMGUI_API bool          ButtonEx(const char* label, ImGuiID id, const ImVec2& size_arg, ImGuiButtonFlags flags);   // With precomputed id (e.g. from an ImGuiLiteral)
+    IMGUI_API bool          CheckboxEx(const char* label, ImGuiID id, bool* v);
+    IMGUI_API bool          SelectableEx(const char* label, ImGuiID id, bool selected, ImGuiSelectableFlags flags, const ImVec2& size_arg);
     IMGUI_API bool          ArrowButtonEx(const char* str_id, ImGuiDir dir, ImVec2 size_arg, ImGuiButtonFlags flags = 0);
     IMGUI_API bool          ImageButtonEx(ImGuiID id, ImTextureID user_texture_id, const ImVec2& image_size, const ImVec2& uv0, const ImVec2& uv1, const ImVec4& bg_col, const ImVec4& tint_col, ImGuiButtonFlags flags = 0);
     IMGUI_API void          SeparatorEx(ImGuiSeparatorFlags flags, float thickness = 1.0f);
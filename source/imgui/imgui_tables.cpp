@@ -643,12 +643,21 @@ void ImGui::TableBeginInitMemory(ImGuiTable* table, int columns_count)
 {
     // Allocate single buffer for our arrays
     const int columns_bit_array_size = (int)ImBitArrayGetStorageSizeInBytes(columns_count);
+#ifdef IMGUI_ENABLE_TABLE_COLUMNS_SOA
+    ImSpanAllocator<9> span_allocator;
+#else
     ImSpanAllocator<6> span_allocator;
+#endif
     span_allocator.Reserve(0, columns_count * sizeof(ImGuiTableColumn));
     span_allocator.Reserve(1, columns_count * sizeof(ImGuiTableColumnIdx));
     span_allocator.Reserve(2, columns_count * sizeof(ImGuiTableCellData), 4);
     for (int n = 3; n < 6; n++)
         span_allocator.Reserve(n, columns_bit_array_size);
+#ifdef IMGUI_ENABLE_TABLE_COLUMNS_SOA
+    span_allocator.Reserve(6, columns_count * sizeof(ImGuiTableColumnFlags));
+    span_allocator.Reserve(7, columns_count * sizeof(float));
+    span_allocator.Reserve(8, columns_count * sizeof(ImVec2));
+#endif
     table->RawData = IM_ALLOC(span_allocator.GetArenaSizeInBytes());
     memset(table->RawData, 0, span_allocator.GetArenaSizeInBytes());
     span_allocator.SetArenaBasePtr(table->RawData);
@@ -658,6 +667,11 @@ void ImGui::TableBeginInitMemory(ImGuiTable* table, int columns_count)
     table->EnabledMaskByDisplayOrder = (ImU32*)span_allocator.GetSpanPtrBegin(3);
     table->EnabledMaskByIndex = (ImU32*)span_allocator.GetSpanPtrBegin(4);
     table->VisibleMaskByIndex = (ImU32*)span_allocator.GetSpanPtrBegin(5);
+#ifdef IMGUI_ENABLE_TABLE_COLUMNS_SOA
+    span_allocator.GetSpan(6, &table->ColumnsFlags);
+    span_allocator.GetSpan(7, &table->ColumnsMaxX);
+    span_allocator.GetSpan(8, &table->ColumnsClipX);
+#endif
 }
 
 // Apply queued resizing/reordering/hiding requests
@@ -1069,6 +1083,11 @@ void ImGui::TableUpdateLayout(ImGuiTable* table)
             column->IsVisibleX = column->IsVisibleY = column->IsRequestOutput = false;
             column->IsSkipItems = true;
             column->ItemWidth = 1.0f;
+#ifdef IMGUI_ENABLE_TABLE_COLUMNS_SOA
+            table->ColumnsFlags[column_n] = column->Flags;
+            table->ColumnsMaxX[column_n] = column->MaxX;
+            table->ColumnsClipX[column_n] = ImVec2(column->ClipRect.Min.x, column->ClipRect.Max.x);
+#endif
             continue;
         }
 
@@ -1133,6 +1152,11 @@ void ImGui::TableUpdateLayout(ImGuiTable* table)
             column->Flags |= ImGuiTableColumnFlags_IsHovered;
             table->HoveredColumnBody = (ImGuiTableColumnIdx)column_n;
         }
+#ifdef IMGUI_ENABLE_TABLE_COLUMNS_SOA
+        table->ColumnsFlags[column_n] = column->Flags;
+        table->ColumnsMaxX[column_n] = column->MaxX;
+        table->ColumnsClipX[column_n] = ImVec2(column->ClipRect.Min.x, column->ClipRect.Max.x);
+#endif
 
         // Alignment
         // FIXME-TABLE: This align based on the whole column width, not per-cell, and therefore isn't useful in
@@ -1289,8 +1313,17 @@ void ImGui::TableUpdateBorders(ImGuiTable* table)
             continue;
 
         const int column_n = table->DisplayOrderToIndex[order_n];
+#ifdef IMGUI_ENABLE_TABLE_COLUMNS_SOA
+        const ImGuiTableColumnFlags column_flags = table->ColumnsFlags[column_n];
+        const bool column_is_visible_x = IM_BITARRAY_TESTBIT(table->VisibleMaskByIndex, column_n);
+        const float column_max_x = table->ColumnsMaxX[column_n];
+#else
         ImGuiTableColumn* column = &table->Columns[column_n];
-        if (column->Flags & (ImGuiTableColumnFlags_NoResize | ImGuiTableColumnFlags_NoDirectResize_))
+        const ImGuiTableColumnFlags column_flags = column->Flags;
+        const bool column_is_visible_x = column->IsVisibleX;
+        const float column_max_x = column->MaxX;
+#endif
+        if (column_flags & (ImGuiTableColumnFlags_NoResize | ImGuiTableColumnFlags_NoDirectResize_))
             continue;
 
         // ImGuiTableFlags_NoBordersInBodyUntilResize will be honored in TableDrawBorders()
@@ -1298,11 +1331,11 @@ void ImGui::TableUpdateBorders(ImGuiTable* table)
         if ((table->Flags & ImGuiTableFlags_NoBordersInBody) && table->IsUsingHeaders == false)
             continue;
 
-        if (!column->IsVisibleX && table->LastResizedColumn != column_n)
+        if (!column_is_visible_x && table->LastResizedColumn != column_n)
             continue;
 
         ImGuiID column_id = TableGetColumnResizeID(table, column_n, table->InstanceCurrent);
-        ImRect hit_rect(column->MaxX - hit_half_width, hit_y1, column->MaxX + hit_half_width, border_y2_hit);
+        ImRect hit_rect(column_max_x - hit_half_width, hit_y1, column_max_x + hit_half_width, border_y2_hit);
         ItemAdd(hit_rect, column_id, NULL, ImGuiItemFlags_NoNav);
         //GetForegroundDrawList()->AddRect(hit_rect.Min, hit_rect.Max, IM_COL32(255, 0, 0, 100));
 
@@ -2723,26 +2756,37 @@ void ImGui::TableDrawBorders(ImGuiTable* table)
                 continue;
 
             const int column_n = table->DisplayOrderToIndex[order_n];
+#ifdef IMGUI_ENABLE_TABLE_COLUMNS_SOA
+            const ImGuiTableColumnFlags column_flags = table->ColumnsFlags[column_n];
+            const float column_max_x = table->ColumnsMaxX[column_n];
+            const float column_clip_min_x = table->ColumnsClipX[column_n].x;
+            const bool column_is_last_enabled = (table->RightMostEnabledColumn == column_n);
+#else
             ImGuiTableColumn* column = &table->Columns[column_n];
+            const ImGuiTableColumnFlags column_flags = column->Flags;
+            const float column_max_x = column->MaxX;
+            const float column_clip_min_x = column->ClipRect.Min.x;
+            const bool column_is_last_enabled = (column->NextEnabledColumn == -1);
+#endif
             const bool is_hovered = (table->HoveredColumnBorder == column_n);
             const bool is_resized = (table->ResizedColumn == column_n) && (table->InstanceInteracted == table->InstanceCurrent);
-            const bool is_resizable = (column->Flags & (ImGuiTableColumnFlags_NoResize | ImGuiTableColumnFlags_NoDirectResize_)) == 0;
+            const bool is_resizable = (column_flags & (ImGuiTableColumnFlags_NoResize | ImGuiTableColumnFlags_NoDirectResize_)) == 0;
             const bool is_frozen_separator = (table->FreezeColumnsCount == order_n + 1);
-            if (column->MaxX > table->InnerClipRect.Max.x && !is_resized)
+            if (column_max_x > table->InnerClipRect.Max.x && !is_resized)
                 continue;
 
             // Decide whether right-most column is visible
-            if (column->NextEnabledColumn == -1 && !is_resizable)
+            if (column_is_last_enabled && !is_resizable)
                 if ((table->Flags & ImGuiTableFlags_SizingMask_) != ImGuiTableFlags_SizingFixedSame || (table->Flags & ImGuiTableFlags_NoHostExtendX))
                     continue;
-            if (column->MaxX <= column->ClipRect.Min.x) // FIXME-TABLE FIXME-STYLE: Assume BorderSize==1, this is problematic if we want to increase the border size..
+            if (column_max_x <= column_clip_min_x) // FIXME-TABLE FIXME-STYLE: Assume BorderSize==1, this is problematic if we want to increase the border size..
                 continue;
 
             // Draw in outer window so right-most column won't be clipped
             // Always draw full height border when being resized/hovered, or on the delimitation of frozen column scrolling.
             float draw_y2 = (is_hovered || is_resized || is_frozen_separator || (table->Flags & (ImGuiTableFlags_NoBordersInBody | ImGuiTableFlags_NoBordersInBodyUntilResize)) == 0) ? draw_y2_body : draw_y2_head;
             if (draw_y2 > draw_y1)
-                inner_drawlist->AddLine(ImVec2(column->MaxX, draw_y1), ImVec2(column->MaxX, draw_y2), TableGetColumnBorderCol(table, order_n, column_n), border_size);
+                inner_drawlist->AddLine(ImVec2(column_max_x, draw_y1), ImVec2(column_max_x, draw_y2), TableGetColumnBorderCol(table, order_n, column_n), border_size);
         }
     }
 
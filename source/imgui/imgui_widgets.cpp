@@ -715,6 +715,14 @@ bool ImGui::ButtonBehavior(const ImRect& bb, ImGuiID id, bool* out_hovered, bool
 }
 
 bool ImGui::ButtonEx(const char* label, const ImVec2& size_arg, ImGuiButtonFlags flags)
+{
+    ImGuiWindow* window = GetCurrentWindow();
+    if (window->SkipItems)
+        return false;
+    return ButtonEx(label, window->GetID(label), size_arg, flags);
+}
+
+bool ImGui::ButtonEx(const char* label, ImGuiID id, const ImVec2& size_arg, ImGuiButtonFlags flags)
 {
     ImGuiWindow* window = GetCurrentWindow();
     if (window->SkipItems)
@@ -722,7 +730,6 @@ bool ImGui::ButtonEx(const char* label, const ImVec2& size_arg, ImGuiButtonFlags
 
     ImGuiContext& g = *GImGui;
     const ImGuiStyle& style = g.Style;
-    const ImGuiID id = window->GetID(label);
     const ImVec2 label_size = CalcTextSize(label, NULL, true);
 
     ImVec2 pos = window->DC.CursorPos;
@@ -771,6 +778,29 @@ bool ImGui::SmallButton(const char* label)
     return pressed;
 }
 
+#ifdef IMGUI_ENABLE_LITERAL_IDS
+bool ImGui::Button(const ImGuiLiteral& label, const ImVec2& size_arg)
+{
+    ImGuiWindow* window = GetCurrentWindow();
+    if (window->SkipItems)
+        return false;
+    return ButtonEx(label.Str, window->GetID(label), size_arg, ImGuiButtonFlags_None);
+}
+
+bool ImGui::SmallButton(const ImGuiLiteral& label)
+{
+    ImGuiWindow* window = GetCurrentWindow();
+    if (window->SkipItems)
+        return false;
+    ImGuiContext& g = *GImGui;
+    float backup_padding_y = g.Style.FramePadding.y;
+    g.Style.FramePadding.y = 0.0f;
+    bool pressed = ButtonEx(label.Str, window->GetID(label), ImVec2(0, 0), ImGuiButtonFlags_AlignTextBaseLine);
+    g.Style.FramePadding.y = backup_padding_y;
+    return pressed;
+}
+#endif
+
 // Tip: use ImGui::PushID()/PopID() to push indices or pointers in the ID stack.
 // Then you can keep 'str_id' empty or the same for all your buttons (instead of creating a string based on a non-string id)
 bool ImGui::InvisibleButton(const char* str_id, const ImVec2& size_arg, ImGuiButtonFlags flags)
@@ -1135,6 +1165,24 @@ bool ImGui::ImageButton(ImTextureID user_texture_id, const ImVec2& size, const I
 #endif // #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
 
 bool ImGui::Checkbox(const char* label, bool* v)
+{
+    ImGuiWindow* window = GetCurrentWindow();
+    if (window->SkipItems)
+        return false;
+    return CheckboxEx(label, window->GetID(label), v);
+}
+
+#ifdef IMGUI_ENABLE_LITERAL_IDS
+bool ImGui::Checkbox(const ImGuiLiteral& label, bool* v)
+{
+    ImGuiWindow* window = GetCurrentWindow();
+    if (window->SkipItems)
+        return false;
+    return CheckboxEx(label.Str, window->GetID(label), v);
+}
+#endif
+
+bool ImGui::CheckboxEx(const char* label, ImGuiID id, bool* v)
 {
     ImGuiWindow* window = GetCurrentWindow();
     if (window->SkipItems)
@@ -1142,7 +1190,6 @@ bool ImGui::Checkbox(const char* label, bool* v)
 
     ImGuiContext& g = *GImGui;
     const ImGuiStyle& style = g.Style;
-    const ImGuiID id = window->GetID(label);
     const ImVec2 label_size = CalcTextSize(label, NULL, true);
 
     const float square_sz = GetFrameHeight();
@@ -6348,6 +6395,17 @@ bool ImGui::TreeNode(const char* label)
     return TreeNodeBehavior(id, ImGuiTreeNodeFlags_None, label, NULL);
 }
 
+#ifdef IMGUI_ENABLE_LITERAL_IDS
+bool ImGui::TreeNode(const ImGuiLiteral& label)
+{
+    ImGuiWindow* window = GetCurrentWindow();
+    if (window->SkipItems)
+        return false;
+    ImGuiID id = window->GetID(label);
+    return TreeNodeBehavior(id, ImGuiTreeNodeFlags_None, label.Str, NULL);
+}
+#endif
+
 bool ImGui::TreeNodeV(const char* str_id, const char* fmt, va_list args)
 {
     return TreeNodeExV(str_id, 0, fmt, args);
@@ -6837,6 +6895,17 @@ bool ImGui::CollapsingHeader(const char* label, ImGuiTreeNodeFlags flags)
     return TreeNodeBehavior(id, flags | ImGuiTreeNodeFlags_CollapsingHeader, label);
 }
 
+#ifdef IMGUI_ENABLE_LITERAL_IDS
+bool ImGui::CollapsingHeader(const ImGuiLiteral& label, ImGuiTreeNodeFlags flags)
+{
+    ImGuiWindow* window = GetCurrentWindow();
+    if (window->SkipItems)
+        return false;
+    ImGuiID id = window->GetID(label);
+    return TreeNodeBehavior(id, flags | ImGuiTreeNodeFlags_CollapsingHeader, label.Str);
+}
+#endif
+
 // p_visible == NULL                        : regular collapsing header
 // p_visible != NULL && *p_visible == true  : show a small close button on the corner of the header, clicking the button will set *p_visible = false
 // p_visible != NULL && *p_visible == false : do not show the header at all
@@ -6885,6 +6954,14 @@ bool ImGui::CollapsingHeader(const char* label, bool* p_visible, ImGuiTreeNodeFl
 // With this scheme, ImGuiSelectableFlags_SpanAllColumns and ImGuiSelectableFlags_AllowOverlap are also frequently used flags.
 // FIXME: Selectable() with (size.x == 0.0f) and (SelectableTextAlign.x > 0.0f) followed by SameLine() is currently not supported.
 bool ImGui::Selectable(const char* label, bool selected, ImGuiSelectableFlags flags, const ImVec2& size_arg)
+{
+    ImGuiWindow* window = GetCurrentWindow();
+    if (window->SkipItems)
+        return false;
+    return SelectableEx(label, window->GetID(label), selected, flags, size_arg);
+}
+
+bool ImGui::SelectableEx(const char* label, ImGuiID id, bool selected, ImGuiSelectableFlags flags, const ImVec2& size_arg)
 {
     ImGuiWindow* window = GetCurrentWindow();
     if (window->SkipItems)
@@ -6894,7 +6971,6 @@ bool ImGui::Selectable(const char* label, bool selected, ImGuiSelectableFlags fl
     const ImGuiStyle& style = g.Style;
 
     // Submit label or explicit size to ItemSize(), whereas ItemAdd() will submit a larger/spanning rectangle.
-    ImGuiID id = window->GetID(label);
     ImVec2 label_size = CalcTextSize(label, NULL, true);
     ImVec2 size(size_arg.x != 0.0f ? size_arg.x : label_size.x, size_arg.y != 0.0f ? size_arg.y : label_size.y);
     ImVec2 pos = window->DC.CursorPos;
@@ -7078,6 +7154,26 @@ bool ImGui::Selectable(const char* label, bool* p_selected, ImGuiSelectableFlags
     return false;
 }
 
+#ifdef IMGUI_ENABLE_LITERAL_IDS
+bool ImGui::Selectable(const ImGuiLiteral& label, bool selected, ImGuiSelectableFlags flags, const ImVec2& size_arg)
+{
+    ImGuiWindow* window = GetCurrentWindow();
+    if (window->SkipItems)
+        return false;
+    return SelectableEx(label.Str, window->GetID(label), selected, flags, size_arg);
+}
+
+bool ImGui::Selectable(const ImGuiLiteral& label, bool* p_selected, ImGuiSelectableFlags flags, const ImVec2& size_arg)
+{
+    if (Selectable(label, *p_selected, flags, size_arg))
+    {
+        *p_selected = !*p_selected;
+        return true;
+    }
+    return false;
+}
+#endif
+
 
 //-------------------------------------------------------------------------
 // [SECTION] Widgets: Typing-Select support
@@ -7279,6 +7375,8 @@ void ImGui::DebugNodeTypingSelectState(ImGuiTypingSelectState* data)
 // - BoxSelectActivateDrag() [Internal]
 // - BoxSelectDeactivateDrag() [Internal]
 // - BoxSelectScrollWithMouseDrag() [Internal]
+// - BoxSelectLayoutAddItem() [Internal]
+// - BoxSelectLayoutCommit() [Internal]
 // - BeginBoxSelect() [Internal]
 // - EndBoxSelect() [Internal]
 //-------------------------------------------------------------------------
@@ -7308,6 +7406,10 @@ static void BoxSelectActivateDrag(ImGuiBoxSelectState* bs, ImGuiWindow* window)
     ImGui::SetActiveIdUsingAllKeyboardKeys();
     if (bs->IsStartedFromVoid && (bs->KeyMods & (ImGuiMod_Ctrl | ImGuiMod_Shift)) == 0)
         bs->RequestClear = true;
+#ifdef IMGUI_ENABLE_BOX_SELECT_RANGES
+    bs->Layout.Clear();
+    bs->LayoutNext.Clear();
+#endif
 }
 
 static void BoxSelectDeactivateDrag(ImGuiBoxSelectState* bs)
@@ -7350,6 +7452,92 @@ static void BoxSelectScrollWithMouseDrag(ImGuiBoxSelectState* bs, ImGuiWindow* w
     }
 }
 
+#ifdef IMGUI_ENABLE_BOX_SELECT_RANGES
+static void BoxSelectLayoutEndRow(ImGuiBoxSelectLayout* layout)
+{
+    if (layout->Row < 0 || layout->Failed)
+        return;
+    if (layout->Columns == 0)
+        layout->Columns = layout->RowItems;
+    if (layout->RowItems != layout->Columns && (layout->RowItems > layout->Columns || layout->Row != layout->RowsCount - 1)) // Only last row may be partial
+        layout->Failed = true;
+    if (layout->RowFirstItem != (ImGuiSelectionUserData)layout->Row * layout->Columns)
+        layout->Failed = true;
+    layout->Rows++;
+    layout->Row = -1;
+}
+
+// Called by MultiSelectItemFooter() for every item submitted while box-selecting.
+// Items not submitted through a clipper, or not laid out as a grid of clipper rows, make the layout unusable for this frame.
+static void BoxSelectLayoutAddItem(ImGuiBoxSelectLayout* layout, ImGuiWindow* window, ImGuiListClipper* clipper, const ImRect& rect, ImGuiSelectionUserData item_data)
+{
+    if (layout->Failed)
+        return;
+    if (clipper != NULL && clipper->ItemsHeight <= 0.0f) // Item submitted by clipper to measure height
+        return;
+    if (clipper == NULL || item_data == ImGuiSelectionUserData_Invalid)
+    {
+        layout->Failed = true;
+        return;
+    }
+
+    const double row0_y = (double)clipper->StartPosY + clipper->StartSeekOffsetY;
+    const int row = (int)ImFloor((float)(((double)rect.GetCenter().y - row0_y) / clipper->ItemsHeight));
+    if (row != layout->Row)
+    {
+        BoxSelectLayoutEndRow(layout);
+        layout->RowsCount = clipper->ItemsCount;
+        layout->Row = row;
+        layout->RowItems = 0;
+        layout->RowFirstItem = item_data;
+    }
+    const int column = layout->RowItems++;
+    const float offset_y = (float)((double)rect.Min.y - (row0_y + (double)row * clipper->ItemsHeight));
+    const ImVec2 x_rel(rect.Min.x - window->Pos.x + window->Scroll.x, rect.Max.x - window->Pos.x + window->Scroll.x);
+    if (item_data != layout->RowFirstItem + column)
+        layout->Failed = true;
+    if (layout->ColumnsX.Size == 0)
+    {
+        layout->ItemOffsetY = offset_y;
+        layout->ItemHeight = rect.GetHeight();
+    }
+    else if (ImAbs(offset_y - layout->ItemOffsetY) > 0.5f || ImAbs(rect.GetHeight() - layout->ItemHeight) > 0.5f)
+    {
+        layout->Failed = true;
+    }
+    if (column == layout->ColumnsX.Size)
+    {
+        // Columns are left to right, so the columns overlapping a box are contiguous
+        if (column > 0 && (x_rel.x < layout->ColumnsX[column - 1].x || x_rel.y < layout->ColumnsX[column - 1].y))
+            layout->Failed = true;
+        layout->ColumnsX.push_back(x_rel);
+    }
+    else if (ImAbs(x_rel.x - layout->ColumnsX[column].x) > 0.5f || ImAbs(x_rel.y - layout->ColumnsX[column].y) > 0.5f)
+    {
+        layout->Failed = true;
+    }
+}
+
+// Use layout learned on the previous frame, start learning a new one.
+static void BoxSelectLayoutCommit(ImGuiBoxSelectState* bs)
+{
+    ImGuiBoxSelectLayout* next = &bs->LayoutNext;
+    BoxSelectLayoutEndRow(next);
+    if (next->Failed || next->Rows < 2 || next->ColumnsX.Size != next->Columns)
+    {
+        bs->Layout.Clear();
+    }
+    else
+    {
+        bs->Layout.Columns = next->Columns;
+        bs->Layout.ItemOffsetY = next->ItemOffsetY;
+        bs->Layout.ItemHeight = next->ItemHeight;
+        bs->Layout.ColumnsX.swap(next->ColumnsX);
+    }
+    next->Clear();
+}
+#endif
+
 bool ImGui::BeginBoxSelect(const ImRect& scope_rect, ImGuiWindow* window, ImGuiID box_select_id, ImGuiMultiSelectFlags ms_flags)
 {
     ImGuiContext& g = *GImGui;
@@ -7367,6 +7555,9 @@ bool ImGui::BeginBoxSelect(const ImRect& scope_rect, ImGuiWindow* window, ImGuiI
         BoxSelectDeactivateDrag(bs);
     if (!bs->IsActive)
         return false;
+#ifdef IMGUI_ENABLE_BOX_SELECT_RANGES
+    BoxSelectLayoutCommit(bs);
+#endif
 
     // Current frame absolute prev/current rectangles are used to toggle selection.
     // They are derived from positions relative to scrolling space.
@@ -7433,6 +7624,7 @@ void ImGui::EndBoxSelect(const ImRect& scope_rect, ImGuiMultiSelectFlags ms_flag
 // - SetNextItemSelectionUserData()
 // - MultiSelectItemHeader() [Internal]
 // - MultiSelectItemFooter() [Internal]
+// - MultiSelectAddBoxSelectRanges() [Internal]
 // - DebugNodeMultiSelectState() [Internal]
 //-------------------------------------------------------------------------
 
@@ -7831,8 +8023,15 @@ void ImGui::MultiSelectItemFooter(ImGuiID id, bool* p_selected, bool* p_pressed)
     if (ms->BoxSelectId != 0)
         if (ImGuiBoxSelectState* bs = GetBoxSelectState(ms->BoxSelectId))
         {
-            const bool rect_overlap_curr = bs->BoxSelectRectCurr.Overlaps(g.LastItemData.Rect);
-            const bool rect_overlap_prev = bs->BoxSelectRectPrev.Overlaps(g.LastItemData.Rect);
+            bool rect_overlap_curr = bs->BoxSelectRectCurr.Overlaps(g.LastItemData.Rect);
+            bool rect_overlap_prev = bs->BoxSelectRectPrev.Overlaps(g.LastItemData.Rect);
+#ifdef IMGUI_ENABLE_BOX_SELECT_RANGES
+            ImGuiListClipperData* clipper_data = (g.ClipperTempDataStacked > 0) ? &g.ClipperTempData[g.ClipperTempDataStacked - 1] : NULL;
+            if (g.LastItemData.StatusFlags & ImGuiItemStatusFlags_Visible) // Skip e.g. NavId item kept alive out of view
+                BoxSelectLayoutAddItem(&bs->LayoutNext, window, clipper_data ? clipper_data->ListClipper : NULL, g.LastItemData.Rect, item_data);
+            if (clipper_data && clipper_data->BoxSelectRangesAdded)
+                rect_overlap_curr = rect_overlap_prev = false; // Already emitted by MultiSelectAddBoxSelectRanges()
+#endif
             if ((rect_overlap_curr && !rect_overlap_prev && !selected) || (rect_overlap_prev && !rect_overlap_curr))
             {
                 if (storage->LastSelectionSize <= 0 && bs->IsStartedSetNavIdOnce)
@@ -7987,6 +8186,115 @@ void ImGui::MultiSelectAddSetRange(ImGuiMultiSelectTempData* ms, bool selected,
     ms->IO.Requests.push_back(req); // Add new request
 }
 
+#ifdef IMGUI_ENABLE_BOX_SELECT_RANGES
+// Items of a clipper row overlapping a box, using the same test as the ImRect::Overlaps() call in MultiSelectItemFooter().
+// Return false if the box doesn't overlap any item.
+static bool BoxSelectCalcLayoutBox(const ImGuiBoxSelectLayout* layout, ImGuiWindow* window, ImGuiListClipper* clipper, const ImRect& box, int* out_rows, int* out_cols)
+{
+    const double row0_y = (double)clipper->StartPosY + clipper->StartSeekOffsetY + layout->ItemOffsetY;
+    out_rows[0] = ImMax((int)ImFloor((float)(((double)box.Min.y - layout->ItemHeight - row0_y) / clipper->ItemsHeight)) + 1, 0);
+    out_rows[1] = ImMin((int)-ImFloor((float)-(((double)box.Max.y - row0_y) / clipper->ItemsHeight)) - 1, clipper->ItemsCount - 1);
+
+    const float box_min_x = box.Min.x - window->Pos.x + window->Scroll.x;
+    const float box_max_x = box.Max.x - window->Pos.x + window->Scroll.x;
+    out_cols[0] = 0;
+    out_cols[1] = -1;
+    for (int column = 0; column < layout->Columns; column++)
+        if (layout->ColumnsX[column].x < box_max_x && layout->ColumnsX[column].y > box_min_x)
+        {
+            if (out_cols[1] < 0)
+                out_cols[0] = column;
+            out_cols[1] = column;
+        }
+    return out_rows[0] <= out_rows[1] && out_cols[0] <= out_cols[1];
+}
+
+static void BoxSelectAddRange(ImGuiMultiSelectTempData* ms, bool selected, ImGuiSelectionUserData first_item, ImGuiSelectionUserData last_item)
+{
+    if (first_item > last_item)
+        return;
+    if (ms->IO.Requests.Size > 0)
+    {
+        ImGuiSelectionRequest* prev = &ms->IO.Requests.Data[ms->IO.Requests.Size - 1];
+        if (prev->Type == ImGuiSelectionRequestType_SetRange && prev->Selected == selected && prev->RangeDirection > 0 && prev->RangeLastItem + 1 == first_item)
+        {
+            prev->RangeLastItem = last_item;
+            return;
+        }
+    }
+    ImGui::MultiSelectAddSetRange(ms, selected, +1, first_item, last_item);
+}
+
+static void BoxSelectAddRows(ImGuiMultiSelectTempData* ms, bool selected, int columns, ImGuiSelectionUserData items_count, int row_min, int row_max, int col_min, int col_max)
+{
+    if (row_min > row_max || col_min > col_max)
+        return;
+    if (col_min == 0 && col_max == columns - 1)
+        BoxSelectAddRange(ms, selected, (ImGuiSelectionUserData)row_min * columns, ImMin((ImGuiSelectionUserData)row_max * columns + col_max, items_count - 1));
+    else
+        for (int row = row_min; row <= row_max; row++)
+            BoxSelectAddRange(ms, selected, (ImGuiSelectionUserData)row * columns + col_min, ImMin((ImGuiSelectionUserData)row * columns + col_max, items_count - 1));
+}
+
+// Called by clipper when calculating its visible ranges.
+// Items entering the box are selected and items leaving it are unselected, which is what MultiSelectItemFooter() toggling ends up doing,
+// but computed from item indices using the clipper's index<>position mapping and the layout learned on previous frame.
+// This is what makes box-selecting cheap on large lists and grids: only visible items still need to be submitted, and whole rows are emitted as a single SetRange.
+// Return false if the clipper needs to submit items between previous and current box for MultiSelectItemFooter() to toggle them.
+bool ImGui::MultiSelectAddBoxSelectRanges(ImGuiMultiSelectTempData* ms, ImGuiListClipper* clipper)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiBoxSelectState* bs = GetBoxSelectState(ms->BoxSelectId);
+    if (bs == NULL || !ms->IsFocused || (ms->Flags & ImGuiMultiSelectFlags_NoRangeSelect))
+        return false;
+    const ImGuiBoxSelectLayout* layout = &bs->Layout;
+    if (layout->Columns <= 0 || clipper->ItemsHeight <= 0.0f || clipper->ItemsCount == INT_MAX)
+        return false;
+    if (ms->LoopRequestSetAll != -1 || (ms->Storage->LastSelectionSize <= 0 && bs->IsStartedSetNavIdOnce)) // Let first toggled item set NavId
+        return false;
+    const int columns = layout->Columns;
+    const ImGuiSelectionUserData items_count = (ms->IO.ItemsCount != -1) ? ms->IO.ItemsCount : (columns == 1) ? clipper->ItemsCount : -1;
+    if (items_count < 0)
+        return false;
+
+    if (ms->IsEndIO == false)
+    {
+        ms->IO.Requests.resize(0);
+        ms->IsEndIO = true;
+    }
+
+    ImGuiWindow* window = g.CurrentWindow;
+    int rows[2][2], cols[2][2];
+    bool overlaps[2];
+    overlaps[0] = BoxSelectCalcLayoutBox(layout, window, clipper, bs->BoxSelectRectPrev, rows[0], cols[0]);
+    overlaps[1] = BoxSelectCalcLayoutBox(layout, window, clipper, bs->BoxSelectRectCurr, rows[1], cols[1]);
+
+    const int requests_count = ms->IO.Requests.Size;
+    for (int n = 0; n < 2; n++)
+    {
+        // n == 0: unselect items in previous box and not in current box, n == 1: select items in current box and not in previous box
+        const int a = n, b = n ^ 1;
+        const bool selected = (n == 1);
+        if (!overlaps[a])
+            continue;
+        if (!overlaps[b])
+        {
+            BoxSelectAddRows(ms, selected, columns, items_count, rows[a][0], rows[a][1], cols[a][0], cols[a][1]);
+            continue;
+        }
+        BoxSelectAddRows(ms, selected, columns, items_count, rows[a][0], ImMin(rows[a][1], rows[b][0] - 1), cols[a][0], cols[a][1]);
+        BoxSelectAddRows(ms, selected, columns, items_count, ImMax(rows[a][0], rows[b][1] + 1), rows[a][1], cols[a][0], cols[a][1]);
+        const int row_min = ImMax(rows[a][0], rows[b][0]);
+        const int row_max = ImMin(rows[a][1], rows[b][1]);
+        BoxSelectAddRows(ms, selected, columns, items_count, row_min, row_max, cols[a][0], ImMin(cols[a][1], cols[b][0] - 1));
+        BoxSelectAddRows(ms, selected, columns, items_count, row_min, row_max, ImMax(cols[a][0], cols[b][1] + 1), cols[a][1]);
+    }
+    if (ms->IO.Requests.Size != requests_count)
+        ms->Storage->LastSelectionSize = ImMax(ms->Storage->LastSelectionSize + 1, 1);
+    return true;
+}
+#endif
+
 void ImGui::DebugNodeMultiSelectState(ImGuiMultiSelectState* storage)
 {
 #ifndef IMGUI_DISABLE_DEBUG_TOOLS
@@ -1,7 +1,19 @@
+#include "3ds/imgui_capture.h"
 #include "3ds/imgui_citro3d.h"
 #include "3ds/imgui_ctru.h"
+#include "3ds/imgui_remote.h"
+#include "3ds/jobs.h"
+#ifdef BENCHMARK
+#include "benchmark.h"
+#endif
+#ifdef PROFILE
+#include "3ds/profiler.h"
+#endif
+#include "3ds/screenshot.h"
 #include "imgui/imgui.h"
+#include "wide_mode.h"
 
+#include <algorithm>
 #include <cstdio>
 #include <cstdlib>
 #include <citro3d.h>
@@ -20,11 +32,17 @@ constexpr auto FB_SCALE = 1.0f;
 
 /// \brief Top screen render target
 C3D_RenderTarget *s_top = nullptr;
+/// \brief Top screen right eye render target
+C3D_RenderTarget *s_topRight = nullptr;
 /// \brief Bottom screen render target
 C3D_RenderTarget *s_bottom = nullptr;
 
 /// \brief Screen width
 constexpr auto SCREEN_WIDTH = 400.0f;
+/// \brief Top screen width in wide mode
+constexpr auto WIDE_SCREEN_WIDTH = 800.0f;
+/// \brief Bottom screen width
+constexpr auto BOTTOM_SCREEN_WIDTH = 320.0f;
 /// \brief Screen height
 constexpr auto SCREEN_HEIGHT = 480.0f;
 /// \brief Framebuffer width
@@ -32,11 +50,28 @@ constexpr auto FB_WIDTH = SCREEN_WIDTH * FB_SCALE;
 /// \brief Framebuffer height
 constexpr auto FB_HEIGHT = SCREEN_HEIGHT * FB_SCALE;
 
-/// \brief Display transfer flags
-constexpr auto DISPLAY_TRANSFER_FLAGS =
+/// \brief Display transfer flags, without scaling
+constexpr auto BASE_TRANSFER_FLAGS =
 	GX_TRANSFER_FLIP_VERT (0) | GX_TRANSFER_OUT_TILED (0) | GX_TRANSFER_RAW_COPY (0) |
-	GX_TRANSFER_IN_FORMAT (GX_TRANSFER_FMT_RGBA8) | GX_TRANSFER_OUT_FORMAT (GX_TRANSFER_FMT_RGB8) |
-	GX_TRANSFER_SCALING (TRANSFER_SCALING);
+	GX_TRANSFER_IN_FORMAT (GX_TRANSFER_FMT_RGBA8) | GX_TRANSFER_OUT_FORMAT (GX_TRANSFER_FMT_RGB8);
+/// \brief Display transfer flags
+constexpr auto DISPLAY_TRANSFER_FLAGS = BASE_TRANSFER_FLAGS | GX_TRANSFER_SCALING (TRANSFER_SCALING);
+/// \brief Display transfer flags in wide mode
+/// \note A 1600px anti-aliased target would exceed the GPU's 1024px limit, so wide mode is 1:1
+constexpr auto WIDE_TRANSFER_FLAGS = BASE_TRANSFER_FLAGS | GX_TRANSFER_SCALING (GX_TRANSFER_SCALE_NO);
+
+/// \brief Whether the top screen is in 800px wide mode
+bool s_wide = false;
+/// \brief Whether wide mode is requested
+bool s_wantWide = false;
+/// \brief Whether this console has wide mode (all but the original 2DS)
+bool s_wideSupported = false;
+/// \brief Wide mode frames over the GPU budget
+wide_mode::Budget s_wideBudget;
+/// \brief Whether windows must follow a screen width change
+bool s_layoutChanged = false;
+/// \brief Why wide mode was last turned off automatically
+char s_wideStatus[64] = "";
 
 /// \brief Window flags
 constexpr auto WINDOW_FLAGS = ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMove | ImGuiWindowFlags_NoCollapse;
@@ -44,11 +79,61 @@ constexpr auto WINDOW_FLAGS = ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoMov
 /// \brief Clear color
 constexpr auto CLEAR_COLOR = 0x808080FF;
 
+/// \brief GPU command buffer size
+/// \note imgui::citro3d::suggestedCmdBufSize reports what the UI actually needs
+constexpr auto CMDBUF_SIZE = 2 * C3D_DEFAULT_CMDBUF_SIZE;
+
+/// \brief Capture file
+constexpr auto CAPTURE_PATH = "sdmc:/imgui-capture.bin";
+/// \brief Number of frames to capture
+constexpr auto CAPTURE_FRAMES = 300;
+
+/// \brief Screenshot file name format
+constexpr auto SCREENSHOT_PATH = "sdmc:/imgui-screenshot-%u.png";
+
+/// \brief Whether to stream the UI to a remote viewer
+constexpr auto REMOTE_UI = false;
+/// \brief Remote viewer port
+constexpr std::uint16_t REMOTE_UI_PORT = 5001;
+
+/// \brief Whether to re-read touch right before submission
+constexpr auto LATE_LATCH_TOUCH = true;
+
+/// \brief Eye separation of the frontmost window with the 3D slider at maximum (pixels)
+constexpr auto MAX_PARALLAX = 10.0f;
+
+#ifdef PROFILE
+/// \brief Profile report file
+constexpr auto PROFILE_PATH = "sdmc:/imgui-profile.csv";
+#endif
+
+#ifdef BENCHMARK
+/// \brief Benchmark results file
+constexpr auto BENCHMARK_PATH = "sdmc:/imgui-benchmark.csv";
+/// \brief Frames per benchmark scene
+constexpr auto BENCHMARK_FRAMES = 300;
+#endif
+
+void create_targets();
+void destroy_targets();
+void clear_targets();
+void set_wide(bool wide_);
 void top_window();
 void bottom_window();
+void replay_benchmark();
+#ifdef BENCHMARK
+void benchmark_render(ImDrawData *drawData_);
+#endif
+
+/// \brief Result of last replay benchmark
+char s_benchmarkResult[128] = "SELECT: capture, L+SELECT: replay, R+SELECT: screenshot";
 
 int main(int argc_, char *argv_[]) {
 
+#ifdef PROFILE
+	profiler::init();
+#endif
+
 	IMGUI_CHECKVERSION();
 	ImGui::CreateContext();
 
@@ -57,42 +142,78 @@ int main(int argc_, char *argv_[]) {
 
 	// init services
 	gfxInitDefault();
-	gfxSet3D(false);
 
-	// initialize citro3d
-	C3D_Init (2 * C3D_DEFAULT_CMDBUF_SIZE);
+	// the original 2DS can't drive the top screen at 800px
+	u8 model = CFG_MODEL_2DS;
+	if (R_SUCCEEDED(cfguInit())) {
+		CFGU_GetSystemModel(&model);
+		cfguExit();
+	}
+	s_wideSupported = model != CFG_MODEL_2DS;
 
-	// create top screen render target
-	s_top = C3D_RenderTargetCreate(FB_HEIGHT * 0.5f, FB_WIDTH, GPU_RB_RGBA8, GPU_RB_DEPTH24_STENCIL8);
-	C3D_RenderTargetSetOutput(s_top, GFX_TOP, GFX_LEFT, DISPLAY_TRANSFER_FLAGS);
+	// initialize citro3d
+	C3D_Init (CMDBUF_SIZE);
 
-	// create bottom screen render target
-	s_bottom = C3D_RenderTargetCreate(FB_HEIGHT * 0.5f, FB_WIDTH * 0.8f, GPU_RB_RGBA8, GPU_RB_DEPTH24_STENCIL8);
-	C3D_RenderTargetSetOutput(s_bottom, GFX_BOTTOM, GFX_LEFT, DISPLAY_TRANSFER_FLAGS);
+	// create render targets and setup display metrics
+	set_wide(false);
 
 	if (!imgui::ctru::init())
 		return false;
 
+	// start worker threads on any spare cores before the backend uses them
+	if (!jobs::init())
+		std::fprintf(stderr, "Failed to start job workers\n");
+
 	imgui::citro3d::init();
 
+	if (!screenshot::init())
+		std::fprintf(stderr, "Failed to start screenshot worker\n");
+
+	if (REMOTE_UI && !imgui::remote::init(REMOTE_UI_PORT))
+		std::fprintf(stderr, "Failed to start remote UI\n");
+
 	auto &io    = ImGui::GetIO();
 
 	// disable imgui.ini file
 	io.IniFilename = nullptr;
 
-	// setup display metrics
-	io.DisplaySize = ImVec2(SCREEN_WIDTH, SCREEN_HEIGHT);
-	io.DisplayFramebufferScale = ImVec2(FB_SCALE, FB_SCALE);
+#ifdef BENCHMARK
+	// run the scripted scenes before handing over to the demo
+	if (benchmark::run(BENCHMARK_PATH, BENCHMARK_FRAMES, &benchmark_render))
+		std::snprintf(s_benchmarkResult, sizeof(s_benchmarkResult), "Benchmark written to %s", BENCHMARK_PATH);
+	else
+		std::snprintf(s_benchmarkResult, sizeof(s_benchmarkResult), "Failed to write %s", BENCHMARK_PATH);
+#endif
 
 	while (aptMainLoop()) {
 
+		// render targets can only be swapped between frames
+		if (s_wantWide != s_wide)
+			set_wide(s_wantWide);
+
 		hidScanInput();
 
 		u32 kDown = hidKeysDown();
 		if (kDown & KEY_START)
-			return false;
+			break;
+
+		u32 kHeld = hidKeysHeld();
+		bool takeScreenshot = (kDown & KEY_SELECT) && (kHeld & KEY_R);
+		if ((kDown & KEY_SELECT) && (kHeld & KEY_L))
+			replay_benchmark();
+		else if ((kDown & KEY_SELECT) && !takeScreenshot && !imgui::capture::active())
+			imgui::capture::start(CAPTURE_PATH, CAPTURE_FRAMES);
+
+#ifdef PROFILE
+		// L+R writes what has been recorded so far and starts over
+		if ((kDown & (KEY_L | KEY_R)) && (kHeld & KEY_L) && (kHeld & KEY_R)) {
+			profiler::dump(PROFILE_PATH);
+			profiler::reset();
+		}
+#endif
 
 		imgui::ctru::newFrame();
+		imgui::remote::pollInput(io);
 		ImGui::NewFrame();
 
 		top_window();
@@ -100,23 +221,58 @@ int main(int argc_, char *argv_[]) {
 
 		// render frame
 		ImGui::Render();
+		imgui::remote::send(ImGui::GetDrawData());
+		imgui::capture::frame(ImGui::GetDrawData());
+
 		C3D_FrameBegin(C3D_FRAME_SYNCDRAW);
 
-		// clear frame/depth buffers
-		C3D_RenderTargetClear(s_top, C3D_CLEAR_ALL, CLEAR_COLOR, 0);
-		C3D_RenderTargetClear(s_bottom, C3D_CLEAR_ALL, CLEAR_COLOR, 0);
+		// hide a frame of latency on what follows the touch (dragged window, tooltips)
+		ImVec2 latch;
+		if (LATE_LATCH_TOUCH && imgui::ctru::lateLatchTouch(latch))
+			imgui::citro3d::setLateLatch(latch);
+
+		// render targets still hold the last presented frame until cleared
+		if (takeScreenshot) {
+			static unsigned count = 0;
+			char path[64];
+			std::snprintf(path, sizeof(path), SCREENSHOT_PATH, count);
+			if (screenshot::capture(s_top, s_bottom, path))
+				++count;
+		}
+
+		// windows pop out of the screen by their depth, scaled by the 3D slider; with the slider
+		// down only the left eye is shown, so don't draw the right eye at all
+		auto const slider = osGet3DSliderState();
+		imgui::citro3d::setStereo(slider > 0.0f ? s_topRight : nullptr, slider * MAX_PARALLAX);
+
+		// clear frame buffers
+		clear_targets();
 
 		imgui::citro3d::render(s_top, s_bottom);
 
 		C3D_FrameEnd(0);
+
+		// wide mode fills twice the pixels of the top screen; give it up if the GPU can't keep up
+		auto const gpuTime = C3D_GetDrawingTime();
+		if (s_wideBudget.frame(s_wide, gpuTime)) {
+			std::snprintf(s_wideStatus, sizeof(s_wideStatus), "Wide mode off: GPU %.1f ms", gpuTime);
+			s_wantWide = false;
+		}
 	}
 
+#ifdef PROFILE
+	profiler::dump(PROFILE_PATH);
+#endif
+
 	// clean up resources
+	screenshot::exit();
+	imgui::capture::stop();
+	imgui::remote::exit();
 	imgui::citro3d::exit();
+	jobs::exit();
 
 	// free render targets
-	C3D_RenderTargetDelete(s_bottom);
-	C3D_RenderTargetDelete(s_top);
+	destroy_targets();
 
 	// deinitialize
 	C3D_Fini();
@@ -126,8 +282,66 @@ int main(int argc_, char *argv_[]) {
 	ImGui::DestroyContext();
 }
 
+void create_targets() {
+	if (s_wide) {
+		// wide mode is neither stereoscopic nor anti-aliased
+		s_top = C3D_RenderTargetCreate(SCREEN_HEIGHT * 0.5f, WIDE_SCREEN_WIDTH, GPU_RB_RGBA8, -1);
+		C3D_RenderTargetSetOutput(s_top, GFX_TOP, GFX_LEFT, WIDE_TRANSFER_FLAGS);
+
+		s_bottom = C3D_RenderTargetCreate(SCREEN_HEIGHT * 0.5f, BOTTOM_SCREEN_WIDTH, GPU_RB_RGBA8, -1);
+		C3D_RenderTargetSetOutput(s_bottom, GFX_BOTTOM, GFX_LEFT, WIDE_TRANSFER_FLAGS);
+		return;
+	}
+
+	// create top screen render target
+	s_top = C3D_RenderTargetCreate(FB_HEIGHT * 0.5f, FB_WIDTH, GPU_RB_RGBA8, -1);
+	C3D_RenderTargetSetOutput(s_top, GFX_TOP, GFX_LEFT, DISPLAY_TRANSFER_FLAGS);
+
+	// create top screen right eye render target
+	s_topRight = C3D_RenderTargetCreate(FB_HEIGHT * 0.5f, FB_WIDTH, GPU_RB_RGBA8, -1);
+	C3D_RenderTargetSetOutput(s_topRight, GFX_TOP, GFX_RIGHT, DISPLAY_TRANSFER_FLAGS);
+
+	// create bottom screen render target
+	s_bottom = C3D_RenderTargetCreate(FB_HEIGHT * 0.5f, FB_WIDTH * 0.8f, GPU_RB_RGBA8, -1);
+	C3D_RenderTargetSetOutput(s_bottom, GFX_BOTTOM, GFX_LEFT, DISPLAY_TRANSFER_FLAGS);
+}
+
+void destroy_targets() {
+	for (auto target : {&s_bottom, &s_topRight, &s_top}) {
+		if (*target)
+			C3D_RenderTargetDelete(*target);
+		*target = nullptr;
+	}
+}
+
+void clear_targets() {
+	C3D_RenderTargetClear(s_top, C3D_CLEAR_COLOR, CLEAR_COLOR, 0);
+	if (s_topRight)
+		C3D_RenderTargetClear(s_topRight, C3D_CLEAR_COLOR, CLEAR_COLOR, 0);
+	C3D_RenderTargetClear(s_bottom, C3D_CLEAR_COLOR, CLEAR_COLOR, 0);
+}
+
+void set_wide(bool wide_) {
+	// only one mode's targets fit in VRAM at a time
+	destroy_targets();
+
+	s_wide = wide_;
+	s_wideBudget.reset();
+
+	// the top screen can't be wide and stereoscopic at once
+	gfxSetWide(wide_);
+	gfxSet3D(!wide_);
+
+	create_targets();
+
+	auto &io = ImGui::GetIO();
+	io.DisplaySize = ImVec2(wide_ ? WIDE_SCREEN_WIDTH : SCREEN_WIDTH, SCREEN_HEIGHT);
+	io.DisplayFramebufferScale = wide_ ? ImVec2(1.0f, 1.0f) : ImVec2(FB_SCALE, FB_SCALE);
+	s_layoutChanged = true;
+}
+
 void top_window() {
-	ImGui::SetNextWindowSize(ImVec2(SCREEN_WIDTH, SCREEN_HEIGHT * 0.5f));
+	ImGui::SetNextWindowSize(ImVec2(ImGui::GetIO().DisplaySize.x, SCREEN_HEIGHT * 0.5f));
 	ImGui::SetNextWindowPos(ImVec2(0, 0), ImGuiCond_FirstUseEver);
 
 	if (!ImGui::Begin("Demo Top Screen", NULL, WINDOW_FLAGS)) {
@@ -137,21 +351,94 @@ void top_window() {
 
 	ImGui::Text("Hello!");
 
+	auto const &stats = imgui::citro3d::stats();
+	ImGui::Text("Command buffer: %.1f%% (peak %.1f%%)",
+	    stats.cmdBufUsage * 100.0f, stats.cmdBufHighWater * 100.0f);
+	ImGui::Text("Suggested size: %zu KiB", imgui::citro3d::suggestedCmdBufSize() / 1024);
+	ImGui::Text("Prepare: %.2f ms (%u workers), walk: %.2f ms",
+	    stats.prepareTime, jobs::workerCount(), stats.walkTime);
+	ImGui::Text("Draws: %u, textures: %u, combiners: %u", stats.drawCalls, stats.texBinds, stats.texEnvs);
+	if (stats.droppedDrawCallsHighWater)
+		ImGui::Text("Dropped draw calls: %u (peak %u)", stats.droppedDrawCalls, stats.droppedDrawCallsHighWater);
+
+	ImGui::TextUnformatted(imgui::capture::active() ? "Capturing..." : s_benchmarkResult);
+
+	if (s_wideSupported) {
+		if (ImGui::Checkbox(IM_LITERAL("Wide mode (800px)"), &s_wantWide))
+			s_wideStatus[0] = '\0';
+		ImGui::SameLine();
+		ImGui::Text("GPU: %.2f ms", C3D_GetDrawingTime());
+		if (s_wideStatus[0])
+			ImGui::TextUnformatted(s_wideStatus);
+	}
+
 	ImGui::End();
 	return;
 }
 
 void bottom_window() {
-	ImGui::SetNextWindowSize(ImVec2(SCREEN_WIDTH * 0.8f, SCREEN_HEIGHT * 0.5f));
-	ImGui::SetNextWindowPos(ImVec2(SCREEN_WIDTH * 0.1f, SCREEN_HEIGHT * 0.5f), ImGuiCond_FirstUseEver);
+	// keep the window on the bottom screen, which is centered beneath the top screen
+	auto const left = (ImGui::GetIO().DisplaySize.x - BOTTOM_SCREEN_WIDTH) * 0.5f;
+	ImGui::SetNextWindowSize(ImVec2(BOTTOM_SCREEN_WIDTH, SCREEN_HEIGHT * 0.5f));
+	ImGui::SetNextWindowPos(ImVec2(left, SCREEN_HEIGHT * 0.5f),
+	    s_layoutChanged ? ImGuiCond_Always : ImGuiCond_FirstUseEver);
+	s_layoutChanged = false;
 
 	if (!ImGui::Begin("Demo Bottom Screen", NULL, WINDOW_FLAGS)) {
    	    ImGui::End();
    	    return;
    	}
 
-	ImGui::Button("Hello!");
+	ImGui::Button(IM_LITERAL("Hello!"));
 
 	ImGui::End();
 	return;
-}
\ No newline at end of file
+}
+
+void replay_benchmark() {
+	imgui::capture::Replay replay;
+	if (!replay.open(CAPTURE_PATH) || !replay.frameCount()) {
+		std::snprintf(s_benchmarkResult, sizeof(s_benchmarkResult), "No capture at %s", CAPTURE_PATH);
+		return;
+	}
+
+	// time only the backend; rebuilding frames from the capture is excluded
+	u64 total = 0;
+	u64 worst = 0;
+	unsigned frames = 0;
+	for (; frames < replay.frameCount(); ++frames) {
+		auto const drawData = replay.frame(frames);
+		if (!drawData)
+			break;
+
+		C3D_FrameBegin(C3D_FRAME_SYNCDRAW);
+		clear_targets();
+
+		auto const start = svcGetSystemTick();
+		imgui::citro3d::render(s_top, s_bottom, drawData);
+		auto const ticks = svcGetSystemTick() - start;
+
+		C3D_FrameEnd(0);
+
+		total += ticks;
+		worst = std::max(worst, ticks);
+	}
+
+	if (!frames) {
+		std::snprintf(s_benchmarkResult, sizeof(s_benchmarkResult), "Malformed capture");
+		return;
+	}
+
+	auto const toUs = [](u64 ticks_) { return ticks_ * 1000000.0 / SYSCLOCK_ARM11; };
+	std::snprintf(s_benchmarkResult, sizeof(s_benchmarkResult),
+	    "Replay %u frames: avg %.0fus, worst %.0fus", frames, toUs(total / frames), toUs(worst));
+}
+
+#ifdef BENCHMARK
+void benchmark_render(ImDrawData *drawData_) {
+	C3D_FrameBegin(C3D_FRAME_SYNCDRAW);
+	clear_targets();
+	imgui::citro3d::render(s_top, s_bottom, drawData_);
+	C3D_FrameEnd(0);
+}
+#endif
@@ -0,0 +1,56 @@
+// The MIT License (MIT)
+//
+// Copyright (C) 2020 Michael Theall
+//
+// Permission is hereby granted, free of charge, to any person obtaining a copy
+// of this software and associated documentation files (the "Software"), to deal
+// in the Software without restriction, including without limitation the rights
+// to use, copy, modify, merge, publish, distribute, sublicense, and/or sell
+// copies of the Software, and to permit persons to whom the Software is
+// furnished to do so, subject to the following conditions:
+//
+// The above copyright notice and this permission notice shall be included in all
+// copies or substantial portions of the Software.
+//
+// THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+// IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+// FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+// AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+// LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+// OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+// SOFTWARE.
+
+// When the demo gives up the 800px wide top screen: wide mode fills twice the pixels, and if the
+// GPU can't keep up for long it falls back to 400px. Nothing here touches the GPU, so the host
+// tests share it.
+
+#pragma once
+
+namespace wide_mode
+{
+/// \brief GPU drawing time per frame wide mode may use (ms)
+/// \note Leaves headroom below the 16.7ms refresh for the display transfer
+constexpr auto GPU_BUDGET = 15.0f;
+/// \brief Consecutive frames over budget before falling back to 400px mode
+constexpr auto OVER_BUDGET_FRAMES = 30u;
+
+/// \brief Counts wide mode frames over the GPU budget
+class Budget
+{
+public:
+	/// \brief Start counting again, as after a mode change
+	void reset ();
+
+	/// \brief Account for a frame
+	/// \param wide_ Whether the frame was drawn in wide mode
+	/// \param gpuTime_ GPU drawing time of the frame (ms)
+	/// \returns Whether to fall back to 400px mode
+	/// \note Only OVER_BUDGET_FRAMES consecutive wide frames over GPU_BUDGET fall back; a frame in
+	/// budget or in 400px mode starts over
+	bool frame (bool wide_, float gpuTime_);
+
+private:
+	/// \brief Consecutive wide mode frames over the GPU budget
+	unsigned m_overBudget = 0;
+};
+}